@@ -2,8 +2,10 @@
 
 #include "AbilitySystem/Abilities/BSGA_FireGun.h"
 #include "AbilitySystemComponent.h"
+#include "AbilitySystem/Globals/BSAttributeSetBase.h"
 #include "AbilitySystem/Tasks/BSAT_PerformWeaponTraceSingle.h"
 #include "Character/BSCharacter.h"
+#include "Target/Target.h"
 
 UBSGA_FireGun::UBSGA_FireGun()
 {
@@ -69,6 +71,7 @@ void UBSGA_FireGun::OnTargetDataReadyCallback(const FGameplayAbilityTargetDataHa
 		if (CommitAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo))
 		{
 			// Let the blueprint do stuff like apply effects to the targets
+			ApplyLightweightDamage(LocalTargetDataHandle);
 			OnTargetDataReady(LocalTargetDataHandle);
 		}
 		else
@@ -82,6 +85,28 @@ void UBSGA_FireGun::OnTargetDataReadyCallback(const FGameplayAbilityTargetDataHa
 		CurrentActivationInfo.GetActivationPredictionKey());
 }
 
+void UBSGA_FireGun::ApplyLightweightDamage(const FGameplayAbilityTargetDataHandle& TargetData) const
+{
+	if (!CurrentActorInfo->IsNetAuthority())
+	{
+		return;
+	}
+
+	const UAbilitySystemComponent* Component = CurrentActorInfo->AbilitySystemComponent.Get();
+	const float HitDamage = Component->GetNumericAttribute(UBSAttributeSetBase::GetHitDamageAttribute());
+	for (int32 i = 0; i < TargetData.Num(); i++)
+	{
+		const FGameplayAbilityTargetData* Data = TargetData.Get(i);
+		const FHitResult* HitResult = Data ? Data->GetHitResult() : nullptr;
+		ATarget* Target = HitResult ? Cast<ATarget>(HitResult->GetActor()) : nullptr;
+		if (Target && Target->UsesLightweightDamage())
+		{
+			Target->ApplyLightweightDamage(HitDamage, ETargetDamageType::Hit, CurrentActorInfo->OwnerActor.Get(),
+				CurrentActorInfo->AvatarActor.Get());
+		}
+	}
+}
+
 void UBSGA_FireGun::StartTargeting()
 {
 	const auto Trace = UBSAT_PerformWeaponTraceSingle::PerformWeaponTraceSingle(this, FName(), TraceDistance);
@@ -6,7 +6,7 @@
 #include "Character/BSCharacterBase.h"
 #include "Character/BSRecoilComponent.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Physics/BSCollisionChannels.h"
+#include "Target/TargetQuerySubsystem.h"
 
 UBSAT_PerformWeaponTraceSingle::UBSAT_PerformWeaponTraceSingle()
 {
@@ -68,7 +68,7 @@ bool UBSAT_PerformWeaponTraceSingle::LineTraceSingle(FHitResult& HitResult) cons
 		RecoilComponent->GetUpVector());
 	const FVector EndTrace = RecoilComponent->GetComponentLocation() + RotatedVector2 * TraceDistance;
 	const FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), true);
-	GetWorld()->LineTraceSingleByChannel(HitResult, RecoilComponent->GetComponentLocation(), EndTrace,
-		BS_TraceChannel_Weapon, TraceParams);
+	GetWorld()->GetSubsystem<UTargetQuerySubsystem>()->WeaponTrace(HitResult,
+		RecoilComponent->GetComponentLocation(), EndTrace, TraceParams);
 	return true;
 }
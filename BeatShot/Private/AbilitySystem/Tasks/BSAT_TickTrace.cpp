@@ -5,7 +5,7 @@
 #include "Character/BSCharacterBase.h"
 #include "Character/BSRecoilComponent.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Physics/BSCollisionChannels.h"
+#include "Target/TargetQuerySubsystem.h"
 
 UBSAT_TickTrace::UBSAT_TickTrace(): Character(nullptr), bStopWhenAbilityEnds(false)
 {
@@ -70,8 +70,8 @@ void UBSAT_TickTrace::PerformSingleWeaponTrace()
 		RecoilComponent->GetUpVector());
 	const FVector EndTrace = RecoilComponent->GetComponentLocation() + RotatedVector2 * TraceDistance;
 	const FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), true, Character);
-	GetWorld()->LineTraceSingleByChannel(HitResult, RecoilComponent->GetComponentLocation(), EndTrace,
-		BS_TraceChannel_Weapon, TraceParams);
+	GetWorld()->GetSubsystem<UTargetQuerySubsystem>()->WeaponTrace(HitResult,
+		RecoilComponent->GetComponentLocation(), EndTrace, TraceParams);
 
 	OnTickTraceHit.Broadcast(HitResult);
 }
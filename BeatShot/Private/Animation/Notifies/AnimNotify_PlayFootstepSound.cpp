@@ -3,6 +3,7 @@
 
 #include "Animation/Notifies/AnimNotify_PlayFootstepSound.h"
 #include "Audio/BSMovementSoundInterface.h"
+#include "Physics/BSSceneQuerySubsystem.h"
 
 UAnimNotify_PlayFootstepSound::UAnimNotify_PlayFootstepSound(): bAttached(1), bPerformTrace(0)
 {
@@ -24,68 +25,79 @@ void UAnimNotify_PlayFootstepSound::Notify(USkeletalMeshComponent* MeshComp, UAn
 {
 	Super::Notify(MeshComp, Animation, EventReference);
 
-	if (MeshComp)
+	// Make sure both MeshComp and Owning Actor is valid
+	if (!MeshComp || !MeshComp->GetOwner())
 	{
-		// Make sure both MeshComp and Owning Actor is valid
-		if (AActor* OwningActor = MeshComp->GetOwner())
-		{
-			// Prepare Trace Data
-			FHitResult HitResult;
-			FCollisionQueryParams QueryParams;
+		return;
+	}
 
-			if (TraceProperties.bIgnoreActor)
-			{
-				QueryParams.AddIgnoredActor(OwningActor);
-			}
+	UWorld* World = MeshComp->GetOwner()->GetWorld();
+	if (!bPerformTrace || !World)
+	{
+		PlayMovementSound(MeshComp, Animation, FHitResult());
+		return;
+	}
 
-			QueryParams.bReturnPhysicalMaterial = true;
+	// If trace is needed, set up Start Location to Attached
+	FBSSceneQuery Query;
+	Query.Start = bAttached ? MeshComp->GetSocketLocation(SocketName) : MeshComp->GetComponentLocation();
+	Query.End = Query.Start + TraceProperties.EndTraceLocationOffset;
+	Query.Channel = TraceProperties.TraceChannel;
+	Query.Params.bReturnPhysicalMaterial = true;
+	// Never drop the trace, since the sound is played when the trace completes
+	Query.LatencyTolerance = -1;
+	if (TraceProperties.bIgnoreActor)
+	{
+		Query.Params.AddIgnoredActor(MeshComp->GetOwner());
+	}
 
-			if (bPerformTrace)
+	// The sound only needs the surface type, so it can play once the trace completes in a later frame
+	TWeakObjectPtr<const ThisClass> WeakThis(this);
+	TWeakObjectPtr<UAnimSequenceBase> WeakAnimation(Animation);
+	World->GetSubsystem<UBSSceneQuerySubsystem>()->Submit(Query, FBSSceneQueryDelegate::CreateWeakLambda(MeshComp,
+		[WeakThis, MeshComp, WeakAnimation](const FHitResult& HitResult)
+		{
+			if (WeakThis.IsValid() && MeshComp->GetOwner())
 			{
-				// If trace is needed, set up Start Location to Attached
-				FVector TraceStart = bAttached
-					? MeshComp->GetSocketLocation(SocketName)
-					: MeshComp->GetComponentLocation();
-
-				if (UWorld* World = OwningActor->GetWorld())
-				{
-					World->LineTraceSingleByChannel(HitResult, TraceStart,
-						(TraceStart + TraceProperties.EndTraceLocationOffset), TraceProperties.TraceChannel,
-						QueryParams, FCollisionResponseParams::DefaultResponseParam);
-				}
+				WeakThis->PlayMovementSound(MeshComp, WeakAnimation.Get(), HitResult);
 			}
+		}));
+}
 
-			// Prepare Contexts in advance
-			FGameplayTagContainer Context;
+void UAnimNotify_PlayFootstepSound::PlayMovementSound(USkeletalMeshComponent* MeshComp,
+	UAnimSequenceBase* Animation, const FHitResult& HitResult) const
+{
+	AActor* OwningActor = MeshComp->GetOwner();
 
-			// Set up Array of Objects that implement the Context Effects Interface
-			TArray<UObject*> ImplementingObjects;
+	// Prepare Contexts in advance
+	FGameplayTagContainer Context;
 
-			// Determine if the Owning Actor is one of the Objects that implements the Context Effects Interface
-			if (OwningActor->Implements<UBSMovementSoundInterface>())
-			{
-				// If so, add it to the Array
-				ImplementingObjects.Add(OwningActor);
-			}
+	// Set up Array of Objects that implement the Context Effects Interface
+	TArray<UObject*> ImplementingObjects;
 
-			for (const auto Component : OwningActor->GetComponents())
-			{
-				if (Component && Component->Implements<UBSMovementSoundInterface>())
-				{
-					ImplementingObjects.Add(Component);
-				}
-			}
+	// Determine if the Owning Actor is one of the Objects that implements the Context Effects Interface
+	if (OwningActor->Implements<UBSMovementSoundInterface>())
+	{
+		// If so, add it to the Array
+		ImplementingObjects.Add(OwningActor);
+	}
 
-			// Cycle through all objects implementing the Context Effect Interface
-			for (UObject* ImplementingObject : ImplementingObjects)
-			{
-				// If the object is still valid, Execute the AnimMotionEffect Event on it, passing in relevant data
-				IBSMovementSoundInterface::Execute_PlayMovementSound(ImplementingObject,
-					bAttached ? SocketName : FName("None"), Effect, MeshComp, LocationOffset, RotationOffset, Animation,
-					HitResult, Context, AudioProperties.VolumeMultiplier, AudioProperties.PitchMultiplier);
-			}
+	for (const auto Component : OwningActor->GetComponents())
+	{
+		if (Component && Component->Implements<UBSMovementSoundInterface>())
+		{
+			ImplementingObjects.Add(Component);
 		}
 	}
+
+	// Cycle through all objects implementing the Context Effect Interface
+	for (UObject* ImplementingObject : ImplementingObjects)
+	{
+		// If the object is still valid, Execute the AnimMotionEffect Event on it, passing in relevant data
+		IBSMovementSoundInterface::Execute_PlayMovementSound(ImplementingObject,
+			bAttached ? SocketName : FName("None"), Effect, MeshComp, LocationOffset, RotationOffset, Animation,
+			HitResult, Context, AudioProperties.VolumeMultiplier, AudioProperties.PitchMultiplier);
+	}
 }
 
 #if WITH_EDITOR
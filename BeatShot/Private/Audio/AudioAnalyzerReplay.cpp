@@ -0,0 +1,192 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Audio/AudioAnalyzerReplay.h"
+#include "BSGameModeConfig/BSConfig.h"
+#include "Misc/App.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** "BSAR" */
+	constexpr uint32 AudioAnalyzerReplayMagic = 0x52415342;
+
+	/** Incremented whenever the layout of the serialized recording changes. */
+	constexpr int32 AudioAnalyzerReplayVersion = 1;
+
+	/** Appends NumChannels values from Source to Dest, using zero for any missing values. */
+	void AppendChannels(TArray<float>& Dest, const TArray<float>& Source, const int32 NumChannels)
+	{
+		for (int i = 0; i < NumChannels; i++)
+		{
+			Dest.Add(Source.IsValidIndex(i) ? Source[i] : 0.f);
+		}
+	}
+}
+
+FAudioAnalyzerReplay::FAudioAnalyzerReplay(): RandomSeed(0), FixedDeltaTime(0.f), NumFrames(0), NumBeatChannels(0),
+                                              NumSpectrumChannels(0), PlaybackFrame(0)
+{
+}
+
+void FAudioAnalyzerReplay::BeginRecording(const int32 InRandomSeed, const FBSConfig& InConfig)
+{
+	RandomSeed = InRandomSeed;
+	FixedDeltaTime = FApp::UseFixedTimeStep() ? FApp::GetFixedDeltaTime() : 0.f;
+	ConfigString = InConfig.ToString();
+	NumFrames = 0;
+	NumBeatChannels = 0;
+	NumSpectrumChannels = 0;
+	DeltaSeconds.Empty();
+	BeatBits.Empty();
+	SpectrumData.Empty();
+	AvgSpectrumData.Empty();
+	PlaybackFrame = 0;
+}
+
+void FAudioAnalyzerReplay::RecordFrame(const float InDeltaSeconds, const TArray<bool>& Beats,
+	const TArray<float>& SpectrumValues, const TArray<float>& AvgSpectrumValues)
+{
+	if (NumFrames == 0)
+	{
+		NumBeatChannels = Beats.Num();
+		NumSpectrumChannels = SpectrumValues.Num();
+	}
+
+	DeltaSeconds.Add(InDeltaSeconds);
+	for (int i = 0; i < NumBeatChannels; i++)
+	{
+		BeatBits.Add(Beats.IsValidIndex(i) && Beats[i]);
+	}
+	AppendChannels(SpectrumData, SpectrumValues, NumSpectrumChannels);
+	AppendChannels(AvgSpectrumData, AvgSpectrumValues, NumSpectrumChannels);
+	NumFrames++;
+}
+
+bool FAudioAnalyzerReplay::ReadNextFrame(FAudioAnalyzerReplayFrame& OutFrame)
+{
+	if (PlaybackFrame >= NumFrames)
+	{
+		return false;
+	}
+
+	OutFrame.DeltaSeconds = DeltaSeconds[PlaybackFrame];
+
+	OutFrame.Beats.SetNumUninitialized(NumBeatChannels);
+	const int32 BeatOffset = PlaybackFrame * NumBeatChannels;
+	for (int i = 0; i < NumBeatChannels; i++)
+	{
+		OutFrame.Beats[i] = BeatBits[BeatOffset + i];
+	}
+
+	const int32 SpectrumOffset = PlaybackFrame * NumSpectrumChannels;
+	OutFrame.SpectrumValues.SetNumUninitialized(NumSpectrumChannels);
+	OutFrame.AvgSpectrumValues.SetNumUninitialized(NumSpectrumChannels);
+	FMemory::Memcpy(OutFrame.SpectrumValues.GetData(), SpectrumData.GetData() + SpectrumOffset,
+		NumSpectrumChannels * sizeof(float));
+	FMemory::Memcpy(OutFrame.AvgSpectrumValues.GetData(), AvgSpectrumData.GetData() + SpectrumOffset,
+		NumSpectrumChannels * sizeof(float));
+
+	PlaybackFrame++;
+	return true;
+}
+
+float FAudioAnalyzerReplay::GetNextFrameDeltaSeconds() const
+{
+	return DeltaSeconds.IsValidIndex(PlaybackFrame) ? DeltaSeconds[PlaybackFrame] : 0.f;
+}
+
+bool FAudioAnalyzerReplay::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> Uncompressed;
+	FMemoryWriter Writer(Uncompressed);
+	Writer << const_cast<FAudioAnalyzerReplay&>(*this);
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Uncompressed.Num());
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Uncompressed.GetData(),
+		Uncompressed.Num()))
+	{
+		return false;
+	}
+
+	TArray<uint8> FileData;
+	FMemoryWriter FileWriter(FileData);
+	uint32 Magic = AudioAnalyzerReplayMagic;
+	int32 Version = AudioAnalyzerReplayVersion;
+	int32 UncompressedSize = Uncompressed.Num();
+	FileWriter << Magic << Version << UncompressedSize;
+	FileWriter.Serialize(Compressed.GetData(), CompressedSize);
+
+	return FFileHelper::SaveArrayToFile(FileData, *GetReplayFilePath(FilePath));
+}
+
+bool FAudioAnalyzerReplay::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *GetReplayFilePath(FilePath)))
+	{
+		return false;
+	}
+
+	FMemoryReader FileReader(FileData);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 UncompressedSize = 0;
+	FileReader << Magic << Version << UncompressedSize;
+	if (FileReader.IsError() || Magic != AudioAnalyzerReplayMagic || Version != AudioAnalyzerReplayVersion ||
+		UncompressedSize <= 0)
+	{
+		return false;
+	}
+
+	const int64 CompressedOffset = FileReader.Tell();
+	TArray<uint8> Uncompressed;
+	Uncompressed.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Zlib, Uncompressed.GetData(), UncompressedSize,
+		FileData.GetData() + CompressedOffset, FileData.Num() - CompressedOffset))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Uncompressed);
+	Reader << *this;
+	PlaybackFrame = 0;
+
+	return !Reader.IsError() && DeltaSeconds.Num() == NumFrames && BeatBits.Num() == NumFrames * NumBeatChannels &&
+		SpectrumData.Num() == NumFrames * NumSpectrumChannels && AvgSpectrumData.Num() == SpectrumData.Num();
+}
+
+bool FAudioAnalyzerReplay::GetConfig(FBSConfig& OutConfig) const
+{
+	return FBSConfig::FromString(ConfigString, OutConfig);
+}
+
+FString FAudioAnalyzerReplay::GetReplayFilePath(const FString& FilePath)
+{
+	if (FPaths::IsRelative(FilePath))
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AudioAnalyzerReplays"), FilePath);
+	}
+	return FilePath;
+}
+
+FArchive& operator<<(FArchive& Ar, FAudioAnalyzerReplay& Replay)
+{
+	Ar << Replay.RandomSeed;
+	Ar << Replay.FixedDeltaTime;
+	Ar << Replay.ConfigString;
+	Ar << Replay.NumFrames;
+	Ar << Replay.NumBeatChannels;
+	Ar << Replay.NumSpectrumChannels;
+	Ar << Replay.DeltaSeconds;
+	Ar << Replay.BeatBits;
+	Ar << Replay.SpectrumData;
+	Ar << Replay.AvgSpectrumData;
+	return Ar;
+}
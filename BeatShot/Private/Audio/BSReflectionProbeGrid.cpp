@@ -0,0 +1,408 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "Audio/BSReflectionProbeGrid.h"
+#include "Components/PrimitiveComponent.h"
+#include "RangeActors/RangeLevelScriptActor.h"
+#include "UObject/UObjectArray.h"
+
+namespace
+{
+	TAutoConsoleVariable CVarReflectionProbesEnabled(TEXT("bs_reflectionprobes.enable"), 1,
+		TEXT("Look up early reflections for weapon audio from the level's baked reflection probe grid instead of\n")
+		TEXT("tracing the scene.\n")
+		TEXT("0: Disabled, 1: Enabled"));
+
+	/** The distance stored for directions without a reflection within MaxDistance. */
+	constexpr uint32 NoReflection = MAX_uint16;
+
+	double SignNotZero(const double Value)
+	{
+		return Value >= 0.0 ? 1.0 : -1.0;
+	}
+
+	/** Traces the static geometry of the world. */
+	bool TraceStaticGeometry(const UWorld* World, const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		return World->LineTraceSingleByObjectType(OutHit, Start, End,
+			FCollisionObjectQueryParams(UBSReflectionProbeGrid::BakedObjectType),
+			FCollisionQueryParams(SCENE_QUERY_STAT(BSReflectionProbe)));
+	}
+
+	/** Returns the grid of the level for the console commands, or logs why there isn't one. */
+	UBSReflectionProbeGrid* GetGridForCommand(const UWorld* World)
+	{
+		const ARangeLevelScriptActor* LevelScriptActor = World
+			? Cast<ARangeLevelScriptActor>(World->GetLevelScriptActor())
+			: nullptr;
+		UBSReflectionProbeGrid* Grid = LevelScriptActor ? LevelScriptActor->GetReflectionProbeGrid() : nullptr;
+		if (!Grid)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("The current level doesn't have a reflection probe grid."));
+		}
+		return Grid;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs BakeReflectionProbesCommand(TEXT("bs_reflectionprobes.bake"),
+		TEXT("Bakes the reflection probe grid of the current level. The grid asset must be saved afterwards."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UBSReflectionProbeGrid* Grid = GetGridForCommand(World))
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				Grid->Bake(World);
+				UE_LOG(LogTemp, Display, TEXT("Baked reflection probe grid %s in %.2f seconds."), *Grid->GetName(),
+					FPlatformTime::Seconds() - StartTime);
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs ValidateReflectionProbesCommand(TEXT("bs_reflectionprobes.validate"),
+		TEXT("Compares the reflection probe grid of the current level against live traces.\n")
+		TEXT("Usage: bs_reflectionprobes.validate [NumSamples]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const UBSReflectionProbeGrid* Grid = GetGridForCommand(World);
+			if (!Grid)
+			{
+				return;
+			}
+			if (!Grid->IsBaked())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s needs to be baked with bs_reflectionprobes.bake."),
+					*Grid->GetName());
+				return;
+			}
+			const int32 NumSamples = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+			const FBSReflectionProbeValidation Result = Grid->Validate(World, NumSamples, 0);
+			UE_LOG(LogTemp, Display, TEXT("%s: %d rays, %d skipped, %d hit mismatches, distance error mean %.1f, ")
+				TEXT("median %.1f, max %.1f"), *Grid->GetName(), Result.NumSamples, Result.NumSkipped,
+				Result.NumHitMismatches, Result.MeanDistanceError, Result.MedianDistanceError,
+				Result.MaxDistanceError);
+		}));
+}
+
+const UBSReflectionProbeGrid* UBSReflectionProbeGrid::Get(const UWorld* World)
+{
+	if (!World || !CVarReflectionProbesEnabled.GetValueOnGameThread())
+	{
+		return nullptr;
+	}
+	const ARangeLevelScriptActor* LevelScriptActor = Cast<ARangeLevelScriptActor>(World->GetLevelScriptActor());
+	const UBSReflectionProbeGrid* Grid = LevelScriptActor ? LevelScriptActor->GetReflectionProbeGrid() : nullptr;
+	return Grid && Grid->IsBaked() ? Grid : nullptr;
+}
+
+const TArray<FVector>& UBSReflectionProbeGrid::GetDirections()
+{
+	// Fibonacci sphere
+	static const TArray<FVector> Directions = []
+	{
+		TArray<FVector> Result;
+		const double GoldenAngle = UE_DOUBLE_PI * (3.0 - FMath::Sqrt(5.0));
+		for (int32 i = 0; i < NumDirections; i++)
+		{
+			const double Z = 1.0 - (i + 0.5) * 2.0 / NumDirections;
+			const double Radius = FMath::Sqrt(1.0 - Z * Z);
+			const double Angle = GoldenAngle * i;
+			Result.Emplace(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, Z);
+		}
+		return Result;
+	}();
+	return Directions;
+}
+
+bool UBSReflectionProbeGrid::CanAnswer(const ECollisionChannel Channel, const FCollisionQueryParams& Params)
+{
+	if (Channel != AnsweredChannel || !Params.GetIgnoredComponents().IsEmpty())
+	{
+		return false;
+	}
+
+	// Ignoring an actor only changes the result if the actor is part of the baked geometry
+	for (const uint32 ActorID : Params.GetIgnoredActors())
+	{
+		const FUObjectItem* Item = GUObjectArray.IndexToObject(ActorID);
+		const AActor* Actor = Item ? Cast<AActor>(static_cast<UObject*>(Item->Object)) : nullptr;
+		if (!Actor)
+		{
+			return false;
+		}
+		bool bBaked = false;
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [&bBaked](const UPrimitiveComponent* Component)
+		{
+			bBaked |= Component->GetCollisionObjectType() == BakedObjectType && Component->IsCollisionEnabled();
+		});
+		if (bBaked)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UBSReflectionProbeGrid::Trace(const FVector& Start, const FVector& End, FHitResult& OutHit,
+	const FVector& SurfaceNormal) const
+{
+	if (!IsBaked() || !BakedBounds.IsInsideOrOn(Start))
+	{
+		return false;
+	}
+
+	FVector Direction;
+	double Length;
+	(End - Start).ToDirectionAndLength(Direction, Length);
+	const int32 DirectionIndex = FindNearestDirection(Direction);
+
+	// The cell containing Start and the position of Start inside of it
+	const FVector GridLocation = (Start - BakedBounds.Min) / BakedProbeSpacing;
+	const FIntVector Cell(FMath::Clamp(FMath::FloorToInt32(GridLocation.X), 0, Dimensions.X - 2),
+		FMath::Clamp(FMath::FloorToInt32(GridLocation.Y), 0, Dimensions.Y - 2),
+		FMath::Clamp(FMath::FloorToInt32(GridLocation.Z), 0, Dimensions.Z - 2));
+	const FVector Alpha = (GridLocation - FVector(Cell)).BoundToBox(FVector::ZeroVector, FVector::OneVector);
+
+	double TotalWeight = 0.0;
+	double HitWeight = 0.0;
+	double Distance = 0.0;
+	FVector Normal = FVector::ZeroVector;
+	for (int32 Corner = 0; Corner < 8; Corner++)
+	{
+		const FIntVector Offset(Corner & 1, Corner >> 1 & 1, Corner >> 2 & 1);
+		const int32 ProbeIndex = GetProbeIndex(Cell.X + Offset.X, Cell.Y + Offset.Y, Cell.Z + Offset.Z);
+		if (!(ValidProbes[ProbeIndex / 32] & 1u << ProbeIndex % 32))
+		{
+			continue;
+		}
+
+		// Probes behind the surface the trace starts on see the other side of it
+		const FVector ProbeLocation = BakedBounds.Min + FVector(Cell + Offset) * BakedProbeSpacing;
+		if (((ProbeLocation - Start) | SurfaceNormal) < 0.0)
+		{
+			continue;
+		}
+
+		const double Weight = (Offset.X ? Alpha.X : 1.0 - Alpha.X) * (Offset.Y ? Alpha.Y : 1.0 - Alpha.Y) *
+			(Offset.Z ? Alpha.Z : 1.0 - Alpha.Z);
+		TotalWeight += Weight;
+
+		float SampleDistance;
+		FVector SampleNormal;
+		if (DecodeSample(Samples[ProbeIndex * NumDirections + DirectionIndex], SampleDistance, SampleNormal))
+		{
+			HitWeight += Weight;
+			Distance += Weight * SampleDistance;
+			Normal += Weight * SampleNormal;
+		}
+	}
+
+	if (TotalWeight <= UE_KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	OutHit = FHitResult(Start, End);
+
+	// Most of the surrounding probes didn't find a reflection
+	if (HitWeight < TotalWeight * 0.5)
+	{
+		return true;
+	}
+	Distance /= HitWeight;
+	if (Distance > Length)
+	{
+		return true;
+	}
+
+	OutHit.bBlockingHit = true;
+	OutHit.Distance = Distance;
+	OutHit.Time = Length > 0.0 ? Distance / Length : 0.0;
+	OutHit.Location = Start + Direction * Distance;
+	OutHit.ImpactPoint = OutHit.Location;
+	OutHit.Normal = Normal.GetSafeNormal();
+	OutHit.ImpactNormal = OutHit.Normal;
+	return true;
+}
+
+void UBSReflectionProbeGrid::Bake(const FBSReflectionProbeTraceFunction& TraceFunction)
+{
+	Dimensions = GetDesiredDimensions();
+	BakedBounds = Bounds;
+	BakedProbeSpacing = ProbeSpacing;
+	BakedMaxDistance = MaxDistance;
+	BakedNumDirections = NumDirections;
+
+	const int32 NumProbes = Dimensions.X * Dimensions.Y * Dimensions.Z;
+	Samples.Init(0, NumProbes * NumDirections);
+	ValidProbes.Init(0, FMath::DivideAndRoundUp(NumProbes, 32));
+
+	const TArray<FVector>& Directions = GetDirections();
+	for (int32 Z = 0; Z < Dimensions.Z; Z++)
+	{
+		for (int32 Y = 0; Y < Dimensions.Y; Y++)
+		{
+			for (int32 X = 0; X < Dimensions.X; X++)
+			{
+				const int32 ProbeIndex = GetProbeIndex(X, Y, Z);
+				const FVector Location = BakedBounds.Min + FVector(X, Y, Z) * BakedProbeSpacing;
+				bool bInsideGeometry = false;
+				for (int32 i = 0; i < NumDirections; i++)
+				{
+					FHitResult Hit;
+					TraceFunction(Location, Location + Directions[i] * BakedMaxDistance, Hit);
+					bInsideGeometry |= Hit.bStartPenetrating || (Hit.bBlockingHit && Hit.Distance < 1.f);
+					Samples[ProbeIndex * NumDirections + i] = EncodeSample(Hit);
+				}
+				if (!bInsideGeometry)
+				{
+					ValidProbes[ProbeIndex / 32] |= 1u << ProbeIndex % 32;
+				}
+			}
+		}
+	}
+	MarkPackageDirty();
+}
+
+void UBSReflectionProbeGrid::Bake(const UWorld* World)
+{
+	Bake([World](const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		return TraceStaticGeometry(World, Start, End, OutHit);
+	});
+}
+
+FBSReflectionProbeValidation UBSReflectionProbeGrid::Validate(const FBSReflectionProbeTraceFunction& TraceFunction,
+	const int32 NumSamples, const int32 RandomSeed) const
+{
+	FBSReflectionProbeValidation Result;
+	Result.NumSamples = NumSamples;
+
+	FRandomStream Stream(RandomSeed);
+	TArray<double> DistanceErrors;
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		const FVector Start(Stream.FRandRange(BakedBounds.Min.X, BakedBounds.Max.X),
+			Stream.FRandRange(BakedBounds.Min.Y, BakedBounds.Max.Y),
+			Stream.FRandRange(BakedBounds.Min.Z, BakedBounds.Max.Z));
+		const FVector End = Start + Stream.GetUnitVector() * BakedMaxDistance;
+		FHitResult GridHit, LiveHit;
+		if (!Trace(Start, End, GridHit))
+		{
+			Result.NumSkipped++;
+			continue;
+		}
+		TraceFunction(Start, End, LiveHit);
+		if (LiveHit.bStartPenetrating)
+		{
+			Result.NumSkipped++;
+			continue;
+		}
+		if (GridHit.bBlockingHit != LiveHit.bBlockingHit)
+		{
+			Result.NumHitMismatches++;
+			continue;
+		}
+		if (LiveHit.bBlockingHit)
+		{
+			DistanceErrors.Add(FMath::Abs(GridHit.Distance - LiveHit.Distance));
+		}
+	}
+
+	if (!DistanceErrors.IsEmpty())
+	{
+		DistanceErrors.Sort();
+		double Sum = 0.0;
+		for (const double Error : DistanceErrors)
+		{
+			Sum += Error;
+		}
+		Result.MeanDistanceError = Sum / DistanceErrors.Num();
+		Result.MedianDistanceError = DistanceErrors[DistanceErrors.Num() / 2];
+		Result.MaxDistanceError = DistanceErrors.Last();
+	}
+	return Result;
+}
+
+FBSReflectionProbeValidation UBSReflectionProbeGrid::Validate(const UWorld* World, const int32 NumSamples,
+	const int32 RandomSeed) const
+{
+	return Validate([World](const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		return TraceStaticGeometry(World, Start, End, OutHit);
+	}, NumSamples, RandomSeed);
+}
+
+bool UBSReflectionProbeGrid::IsBaked() const
+{
+	return BakedNumDirections == NumDirections && BakedBounds == Bounds && BakedProbeSpacing == ProbeSpacing &&
+		BakedMaxDistance == MaxDistance && Dimensions == GetDesiredDimensions() &&
+		Samples.Num() == Dimensions.X * Dimensions.Y * Dimensions.Z * NumDirections;
+}
+
+FIntVector UBSReflectionProbeGrid::GetDesiredDimensions() const
+{
+	const FVector Size = Bounds.GetSize() / FMath::Max(ProbeSpacing, 1.f);
+	return FIntVector(FMath::Max(FMath::FloorToInt32(Size.X) + 1, 2), FMath::Max(FMath::FloorToInt32(Size.Y) + 1, 2),
+		FMath::Max(FMath::FloorToInt32(Size.Z) + 1, 2));
+}
+
+int32 UBSReflectionProbeGrid::GetProbeIndex(const int32 X, const int32 Y, const int32 Z) const
+{
+	return (Z * Dimensions.Y + Y) * Dimensions.X + X;
+}
+
+int32 UBSReflectionProbeGrid::FindNearestDirection(const FVector& Direction)
+{
+	const TArray<FVector>& Directions = GetDirections();
+	int32 NearestIndex = 0;
+	double NearestDot = -2.0;
+	for (int32 i = 0; i < Directions.Num(); i++)
+	{
+		const double Dot = Directions[i] | Direction;
+		if (Dot > NearestDot)
+		{
+			NearestIndex = i;
+			NearestDot = Dot;
+		}
+	}
+	return NearestIndex;
+}
+
+uint32 UBSReflectionProbeGrid::EncodeSample(const FHitResult& Hit) const
+{
+	if (!Hit.bBlockingHit || Hit.bStartPenetrating || Hit.Distance > BakedMaxDistance)
+	{
+		return NoReflection;
+	}
+
+	const uint32 Distance = FMath::Min<uint32>(FMath::RoundToInt32(Hit.Distance / BakedMaxDistance *
+		(NoReflection - 1)), NoReflection - 1);
+
+	// Project the normal onto an octahedron and fold the lower half over the upper half
+	FVector Normal = Hit.ImpactNormal / (FMath::Abs(Hit.ImpactNormal.X) + FMath::Abs(Hit.ImpactNormal.Y) +
+		FMath::Abs(Hit.ImpactNormal.Z) + UE_SMALL_NUMBER);
+	if (Normal.Z < 0.0)
+	{
+		Normal = FVector((1.0 - FMath::Abs(Normal.Y)) * SignNotZero(Normal.X),
+			(1.0 - FMath::Abs(Normal.X)) * SignNotZero(Normal.Y), Normal.Z);
+	}
+	const uint32 NormalX = FMath::Clamp(FMath::RoundToInt32((Normal.X * 0.5 + 0.5) * 255.0), 0, 255);
+	const uint32 NormalY = FMath::Clamp(FMath::RoundToInt32((Normal.Y * 0.5 + 0.5) * 255.0), 0, 255);
+	return Distance | NormalX << 16 | NormalY << 24;
+}
+
+bool UBSReflectionProbeGrid::DecodeSample(const uint32 Sample, float& OutDistance, FVector& OutNormal) const
+{
+	const uint32 Distance = Sample & 0xFFFF;
+	if (Distance == NoReflection)
+	{
+		return false;
+	}
+	OutDistance = Distance * BakedMaxDistance / (NoReflection - 1);
+
+	const double X = (Sample >> 16 & 0xFF) / 255.0 * 2.0 - 1.0;
+	const double Y = (Sample >> 24) / 255.0 * 2.0 - 1.0;
+	const double Z = 1.0 - FMath::Abs(X) - FMath::Abs(Y);
+	OutNormal = Z < 0.0
+		? FVector((1.0 - FMath::Abs(Y)) * SignNotZero(X), (1.0 - FMath::Abs(X)) * SignNotZero(Y), Z)
+		: FVector(X, Y, Z);
+	OutNormal.Normalize();
+	return true;
+}
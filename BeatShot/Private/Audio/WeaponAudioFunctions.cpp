@@ -2,14 +2,36 @@
 
 
 #include "Audio/WeaponAudioFunctions.h"
+#include "BSConstants.h"
 #include "GameplayCueNotifyTypes.h"
+#include "Audio/BSReflectionProbeGrid.h"
 #include "Camera/CameraComponent.h"
 #include "Character/BSCharacterBase.h"
 #include "Components/AudioComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Physics/BSSceneQuerySubsystem.h"
 #include "SubmixEffects/SubmixEffectTapDelay.h"
 
+namespace
+{
+	/** Looks up the reflection from the level's probe grid, falling back to a deferred trace if the grid is missing
+	 *  or can't answer the query. SurfaceNormal is the normal of the surface the query starts on, if any. */
+	void TraceReflection(const UWorld* World, const FBSSceneQuery& Query, FBSSceneQueryDelegate&& Delegate,
+		const FVector& SurfaceNormal = FVector::ZeroVector)
+	{
+		FHitResult Hit;
+		const UBSReflectionProbeGrid* ProbeGrid = UBSReflectionProbeGrid::Get(World);
+		if (ProbeGrid && UBSReflectionProbeGrid::CanAnswer(Query.Channel, Query.Params) &&
+			ProbeGrid->Trace(Query.Start, Query.End, Hit, SurfaceNormal))
+		{
+			Delegate.ExecuteIfBound(Hit);
+			return;
+		}
+		World->GetSubsystem<UBSSceneQuerySubsystem>()->Submit(Query, MoveTemp(Delegate));
+	}
+}
+
 void UWeaponAudioFunctions::SetWeaponSoundParams(AActor* Actor, const FGameplayCueNotify_SpawnResult& SpawnResult)
 {
 	if (Actor->IsA<APawn>())
@@ -64,70 +86,84 @@ void UWeaponAudioFunctions::SetEarlyReflections(AActor* Target, const FGameplayC
 	TArray<int32> TapIDs;
 	SubmixEffect->GetTapIds(TapIDs);
 
-	FCollisionQueryParams CParams;
-	CParams.AddIgnoredActor(Target);
-
 	// Direct hit (HitResult from GCN)
 	CalculateTapProperties("Direct.Primary", SubmixEffect, Camera, ListenerLoc, HitLoc, TapIDs[0], DirectHitDist, bHit);
 
+	// The reflections are looked up from the level's probe grid when possible. Otherwise they are traced
+	// asynchronously, and each tap is set once its trace completes in a later frame
+	TWeakObjectPtr<UWorld> WeakWorld(World);
+	TWeakObjectPtr<UCameraComponent> WeakCamera(Camera);
+	FBSSceneQuery Query;
+	Query.Channel = UBSReflectionProbeGrid::AnsweredChannel;
+	Query.Params.AddIgnoredActor(Target);
+	Query.LatencyTolerance = Constants::EarlyReflectionTraceLatencyTolerance;
+
+	// Sets a tap from the result of a reflection trace, adding the distance traveled before the reflection
+	auto MakeTapDelegate = [SubmixEffect, WeakCamera](const FString& DebugString, const FVector& Listener,
+		const int32 TapID, const float TraveledDistance)
+	{
+		return FBSSceneQueryDelegate::CreateWeakLambda(SubmixEffect,
+			[SubmixEffect, WeakCamera, DebugString, Listener, TapID, TraveledDistance](const FHitResult& Hit)
+			{
+				if (UCameraComponent* CameraComponent = WeakCamera.Get())
+				{
+					CalculateTapProperties(DebugString, SubmixEffect, CameraComponent, Listener, Hit.Location, TapID,
+						Hit.Distance + TraveledDistance, Hit.bBlockingHit);
+				}
+			});
+	};
+
 	// Direct reflection from line of sight (Center)
-	FHitResult DirectLOS;
-	const FVector DirectFromLOSEnd = HitLoc + HitNormal * 4000.f;
-	bHit = World->LineTraceSingleByChannel(DirectLOS, HitLoc, DirectFromLOSEnd, ECC_Visibility, CParams);
-	DirectLOS.Distance += DirectHitDist;
-	CalculateTapProperties("Direct.Second.C", SubmixEffect, Camera, ListenerLoc, DirectLOS.Location, TapIDs[1],
-		DirectLOS.Distance, bHit);
+	Query.Start = HitLoc;
+	Query.End = HitLoc + HitNormal * 4000.f;
+	TraceReflection(World, Query, FBSSceneQueryDelegate::CreateWeakLambda(SubmixEffect,
+		[WeakWorld, Query, MakeTapDelegate, ListenerLoc, DirectHitDist, TapIDs](const FHitResult& DirectLOS)
+		mutable
+		{
+			MakeTapDelegate("Direct.Second.C", ListenerLoc, TapIDs[1], DirectHitDist).ExecuteIfBound(DirectLOS);
+
+			// Side Reflections from Line of Sight's Direct Reflection, which can't reflect if it didn't hit anything
+			const float DirectLOSDistance = DirectLOS.Distance + DirectHitDist;
+			if (!DirectLOS.bBlockingHit || !WeakWorld.IsValid())
+			{
+				MakeTapDelegate("Direct.Second.L", ListenerLoc, TapIDs[2], DirectLOSDistance).ExecuteIfBound(DirectLOS);
+				MakeTapDelegate("Direct.Second.R", ListenerLoc, TapIDs[3], DirectLOSDistance).ExecuteIfBound(DirectLOS);
+				return;
+			}
+
+			FVector LeftAngle, RightAngle;
+			const FVector UpVector = FRotationMatrix(DirectLOS.Normal.ToOrientationRotator()).GetScaledAxis(EAxis::Z);
+			GetSideReflectionAngles(DirectLOS.Location, DirectLOS.Normal, 4000.f, UpVector, LeftAngle, RightAngle);
+			Query.Start = DirectLOS.Location;
+			Query.End = LeftAngle;
+			TraceReflection(WeakWorld.Get(), Query,
+				MakeTapDelegate("Direct.Second.L", ListenerLoc, TapIDs[2], DirectLOSDistance), DirectLOS.Normal);
+			Query.End = RightAngle;
+			TraceReflection(WeakWorld.Get(), Query,
+				MakeTapDelegate("Direct.Second.R", ListenerLoc, TapIDs[3], DirectLOSDistance), DirectLOS.Normal);
+		}), HitNormal);
 
 	// Side Reflections from line of sight
 	FVector LeftAngle, RightAngle;
-	FVector UpVector = FRotationMatrix(HitNormal.ToOrientationRotator()).GetScaledAxis(EAxis::Z);
+	const FVector UpVector = FRotationMatrix(HitNormal.ToOrientationRotator()).GetScaledAxis(EAxis::Z);
 	GetSideReflectionAngles(HitLoc, HitNormal, 4000.f, UpVector, LeftAngle, RightAngle);
-
-	FHitResult LeftLOS;
-	bHit = Target->GetWorld()->LineTraceSingleByChannel(LeftLOS, HitLoc, LeftAngle, ECC_Visibility, CParams);
-	LeftLOS.Distance += DirectHitDist;
-	CalculateTapProperties("Side.Second.L", SubmixEffect, Camera, ListenerLoc, LeftLOS.Location, TapIDs[4],
-		LeftLOS.Distance, bHit);
-
-	FHitResult RightLOS;
-	bHit = Target->GetWorld()->LineTraceSingleByChannel(RightLOS, HitLoc, RightAngle, ECC_Visibility, CParams);
-	RightLOS.Distance += DirectHitDist;
-	CalculateTapProperties("Side.Second.R", SubmixEffect, Camera, ListenerLoc, RightLOS.Location, TapIDs[5],
-		RightLOS.Distance, bHit);
-
-	// Side Reflections from Line of Sight's Direct Reflection
-	UpVector = FRotationMatrix(DirectLOS.Normal.ToOrientationRotator()).GetScaledAxis(EAxis::Z);
-	GetSideReflectionAngles(DirectLOS.Location, DirectLOS.Normal, 4000.f, UpVector, LeftAngle, RightAngle);
-
-	FHitResult LeftLOSDirect;
-	bHit = Target->GetWorld()->LineTraceSingleByChannel(LeftLOSDirect, DirectLOS.Location, LeftAngle, ECC_Visibility,
-		CParams);
-	LeftLOSDirect.Distance += DirectLOS.Distance;
-	CalculateTapProperties("Direct.Second.L", SubmixEffect, Camera, ListenerLoc, LeftLOSDirect.Location, TapIDs[2],
-		LeftLOSDirect.Distance, bHit);
-
-	FHitResult RightLOSDirect;
-	bHit = Target->GetWorld()->LineTraceSingleByChannel(RightLOSDirect, DirectLOS.Location, RightAngle, ECC_Visibility,
-		CParams);
-	RightLOSDirect.Distance += DirectLOS.Distance;
-	CalculateTapProperties("Direct.Second.R", SubmixEffect, Camera, ListenerLoc, RightLOSDirect.Location, TapIDs[3],
-		RightLOSDirect.Distance, bHit);
+	Query.End = LeftAngle;
+	TraceReflection(World, Query, MakeTapDelegate("Side.Second.L", ListenerLoc, TapIDs[4], DirectHitDist),
+		HitNormal);
+	Query.End = RightAngle;
+	TraceReflection(World, Query, MakeTapDelegate("Side.Second.R", ListenerLoc, TapIDs[5], DirectHitDist),
+		HitNormal);
 
 	// Side Reflections from Weapon
 	FVector CameraNormal = Camera->GetComponentLocation() - HitLoc;
 	CameraNormal.Normalize();
 	FVector UpVectorWeapon = FRotationMatrix(Camera->GetComponentRotation()).GetScaledAxis(EAxis::Z);
 	GetSideReflectionAngles(PawnLoc, CameraNormal, 4000.f, UpVectorWeapon, LeftAngle, RightAngle);
-
-	FHitResult LeftWeapon;
-	bHit = Target->GetWorld()->LineTraceSingleByChannel(LeftWeapon, PawnLoc, LeftAngle, ECC_Visibility, CParams);
-	CalculateTapProperties("Side.First.L", SubmixEffect, Camera, FVector(0.f), LeftWeapon.Location, TapIDs[6],
-		LeftWeapon.Distance, bHit);
-
-	FHitResult RightWeapon;
-	bHit = Target->GetWorld()->LineTraceSingleByChannel(RightWeapon, PawnLoc, RightAngle, ECC_Visibility, CParams);
-	CalculateTapProperties("Side.First.R", SubmixEffect, Camera, FVector(0.f), RightWeapon.Location, TapIDs[7],
-		RightWeapon.Distance, bHit);
+	Query.Start = PawnLoc;
+	Query.End = LeftAngle;
+	TraceReflection(World, Query, MakeTapDelegate("Side.First.L", FVector(0.f), TapIDs[6], 0.f));
+	Query.End = RightAngle;
+	TraceReflection(World, Query, MakeTapDelegate("Side.First.R", FVector(0.f), TapIDs[7], 0.f));
 }
 
 void UWeaponAudioFunctions::CalculateTapProperties(const FString& DebugString,
@@ -3,11 +3,13 @@
 
 #include "BSGameInstance.h"
 #include "BSGameMode.h"
+#include "BSGameModeInterface.h"
 #include "BSGameUserSettings.h"
 #include "MetasoundGeneratorHandle.h"
 #include "MetasoundOutput.h"
 #include "MetasoundOutputSubsystem.h"
 #include "MoviePlayer.h"
+#include "ScoreUploadOutbox.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/AudioComponent.h"
 #include "DeveloperSettings/BSLoadingScreenSettings.h"
@@ -23,6 +25,9 @@ void UBSGameInstance::Init()
 {
 	Super::Init();
 
+	// Upgrade any old Custom Game Modes in the background before the menus need them
+	IBSGameModeInterface::PreloadCustomGameModes();
+
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnPostLoadMapWithWorld);
 #if !WITH_EDITOR
 	FCoreUObjectDelegates::PreLoadMapWithContext.AddUObject(this, &ThisClass::OnPreLoadMapWithContext);
@@ -253,7 +258,7 @@ void UBSGameInstance::SetLoadingScreenAudioComponentState(const float FadeTarget
 }
 
 void UBSGameInstance::SavePlayerScoresToDatabase(ABSPlayerController* PlayerController, const bool bWasValidToSave,
-	const bool bQuitToDesktopAfterSave) const
+	const bool bQuitToDesktopAfterSave)
 {
 	const FPlayerSettings_User PlayerSettings = PlayerController->GetPlayerSettings().User;
 	// If game mode encountered a reason not to save to database
@@ -280,53 +285,45 @@ void UBSGameInstance::SavePlayerScoresToDatabase(ABSPlayerController* PlayerCont
 		return;
 	}
 
-	// Acquire access token
-	TSharedPtr<FAccessTokenResponse> AccessTokenResponse = MakeShareable(new FAccessTokenResponse());
-	AccessTokenResponse->OnHttpResponseReceived.BindLambda(
-		[this, AccessTokenResponse, UserID = PlayerSettings.UserID, bQuitToDesktopAfterSave]
+	if (!ScoreUploadOutbox || ScoreUploadOutbox->GetUserID() != PlayerSettings.UserID)
+	{
+		// Always uses the latest refresh cookie, since it can change while scores are still being uploaded
+		ScoreUploadOutbox = MakeShared<FScoreUploadOutbox, ESPMode::ThreadSafe>(PlayerSettings.UserID,
+			[](TFunction<void(const FString&)> OnAccessToken)
+			{
+				TSharedPtr<FAccessTokenResponse> AccessTokenResponse = MakeShareable(new FAccessTokenResponse());
+				AccessTokenResponse->OnHttpResponseReceived.BindLambda([AccessTokenResponse, OnAccessToken]
+				{
+					OnAccessToken(AccessTokenResponse->OK ? AccessTokenResponse->AccessToken : FString());
+				});
+				RequestAccessToken(LoadPlayerSettings().User.RefreshCookie, AccessTokenResponse);
+			});
+		ScoreUploadOutbox->OnScoresAcknowledged = [](const TArray<FString>& Times)
+		{
+			SetPlayerScoresSavedToDatabase(Times);
+		};
+	}
+
+	ScoreUploadOutbox->Enqueue(LoadPlayerScores_UnsavedToDatabase());
+	ScoreUploadOutbox->Flush([this, bQuitToDesktopAfterSave](const bool bUploaded)
+	{
+		if (ABSPlayerController* Controller = Cast<ABSPlayerController>(GetFirstLocalPlayerController(GetWorld())))
 		{
-			if (AccessTokenResponse->OK) // Successful access token retrieval
+			if (bUploaded) // Successful scores post
 			{
-				TSharedPtr<FBSHttpResponse> PostScoresResponse = MakeShareable(new FBSHttpResponse());
-				PostScoresResponse->OnHttpResponseReceived.BindLambda(
-					[this, PostScoresResponse, bQuitToDesktopAfterSave]
-					{
-						if (ABSPlayerController* Controller = Cast<ABSPlayerController>(
-							GetFirstLocalPlayerController(GetWorld())))
-						{
-							if (PostScoresResponse->OK) // Successful scores post
-							{
-								SetAllPlayerScoresSavedToDatabase();
-								Controller->OnPostScoresResponseReceived();
-							}
-							else // Unsuccessful scores post
-							{
-								Controller->OnPostScoresResponseReceived("SBW_SavedScoresLocallyOnly");
-							}
-
-							if (bQuitToDesktopAfterSave)
-							{
-								UKismetSystemLibrary::QuitGame(GetWorld(), Controller, EQuitPreference::Quit, false);
-							}
-						}
-					});
-				PostPlayerScores(LoadPlayerScores_UnsavedToDatabase(), UserID, AccessTokenResponse->AccessToken,
-					PostScoresResponse);
+				Controller->OnPostScoresResponseReceived();
 			}
-			else // Unsuccessful access token retrieval
+			else // Unsuccessful scores post, keeps retrying in the background
 			{
-				if (ABSPlayerController* Controller = Cast<ABSPlayerController>(
-					GetFirstLocalPlayerController(GetWorld())))
-				{
-					Controller->OnPostScoresResponseReceived("SBW_SavedScoresLocallyOnly");
-					if (bQuitToDesktopAfterSave)
-					{
-						UKismetSystemLibrary::QuitGame(GetWorld(), Controller, EQuitPreference::Quit, false);
-					}
-				}
+				Controller->OnPostScoresResponseReceived("SBW_SavedScoresLocallyOnly");
 			}
-		});
-	RequestAccessToken(PlayerSettings.RefreshCookie, AccessTokenResponse);
+
+			if (bQuitToDesktopAfterSave)
+			{
+				UKismetSystemLibrary::QuitGame(GetWorld(), Controller, EQuitPreference::Quit, false);
+			}
+		}
+	});
 }
 
 void UBSGameInstance::RemoveLoadingScreen()
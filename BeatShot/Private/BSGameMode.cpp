@@ -15,6 +15,9 @@
 #include "Equipment/BSGun.h"
 #include "GameFramework/PlayerStart.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 #include "Player/BSPlayerController.h"
 #include "Sound/CapturableSoundWave.h"
 #include "System/SteamManager.h"
@@ -48,12 +51,22 @@ void ABSGameMode::BeginPlay()
 	InitializeGameMode(GI->GetBSConfig());
 }
 
+void ABSGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RestoreFixedTimeStep();
+	Super::EndPlay(EndPlayReason);
+}
+
 void ABSGameMode::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 	if (bShouldTick && GetWorldTimerManager().IsTimerActive(GameModeLengthTimer))
 	{
-		OnTick_AudioAnalyzers(DeltaSeconds);
+		// Beats come from real time audio, so the analyzers are still polled once per frame, while the target spawn
+		// cooldown only advances in whole steps
+		OnTick_AudioAnalyzers(DeltaSeconds, SimulationTimestep.IsEnabled()
+			? SimulationTimestep.Advance(DeltaSeconds) * SimulationTimestep.GetStepSeconds()
+			: DeltaSeconds);
 	}
 }
 
@@ -137,6 +150,9 @@ void ABSGameMode::InitializeGameMode(const TSharedPtr<FBSConfig>& InConfig)
 
 	check(InConfig);
 	BSConfig = InConfig;
+	InitializeAudioAnalyzerReplay();
+	SimulationTimestep = FBSFixedTimestep::FromConsoleVariables();
+	InitializeFastForward();
 
 	if (!TargetManager)
 	{
@@ -147,7 +163,7 @@ void ABSGameMode::InitializeGameMode(const TSharedPtr<FBSConfig>& InConfig)
 	}
 	const FCommonScoreInfo CommonScoreInfo =
 		IBSPlayerScoreInterface::FindOrAddCommonScoreInfo(BSConfig->DefiningConfig);
-	TargetManager->Init(BSConfig, CommonScoreInfo, PlayerSettings.Game);
+	TargetManager->Init(BSConfig, CommonScoreInfo, PlayerSettings.Game, RandomSeed);
 
 	if (!VisualizerManager)
 	{
@@ -283,6 +299,17 @@ void ABSGameMode::EndGameMode(const bool bSaveScores, const ETransitionState Tra
 	AudioComponent->Stop();
 	AudioComponent->SetSound(nullptr);
 
+	if (AudioAnalyzerRecording)
+	{
+		if (!AudioAnalyzerRecording->SaveToFile(AudioAnalyzerRecordingPath))
+		{
+			UE_LOG(LogBSGameMode, Warning, TEXT("Failed to save AudioAnalyzer recording to %s"),
+				*FAudioAnalyzerReplay::GetReplayFilePath(AudioAnalyzerRecordingPath));
+		}
+		AudioAnalyzerRecording.Reset();
+	}
+	RestoreFixedTimeStep();
+
 	bool bQuitToDesktopAfterSave = false;
 	for (ABSPlayerController* Controller : Controllers)
 	{
@@ -330,8 +357,8 @@ void ABSGameMode::EndGameMode(const bool bSaveScores, const ETransitionState Tra
 		}
 	}
 
-	// Handle saving scores before resetting Target Manager
-	HandleScoreSaving(bSaveScores, bQuitToDesktopAfterSave);
+	// Handle saving scores before resetting Target Manager, never saving scores from a replay
+	HandleScoreSaving(bSaveScores && !AudioAnalyzerPlayback, bQuitToDesktopAfterSave);
 
 	TargetManager->Clear();
 
@@ -363,6 +390,10 @@ void ABSGameMode::SpawnNewTarget(const bool bNewTargetState)
 
 void ABSGameMode::StartAAManagerPlayback()
 {
+	if (AudioAnalyzerPlayback)
+	{
+		return;
+	}
 	switch (BSConfig->AudioConfig.AudioFormat)
 	{
 	case EAudioFormat::File:
@@ -436,6 +467,12 @@ void ABSGameMode::RegisterGun(ABSGun* InGun)
 
 bool ABSGameMode::InitializeAudioManagers()
 {
+	// The recorded AudioAnalyzer output is used instead
+	if (AudioAnalyzerPlayback)
+	{
+		return true;
+	}
+
 	AATracker = NewObject<UAudioAnalyzerManager>(this);
 	UBSGameUserSettings* GameUserSettings = UBSGameUserSettings::Get();
 
@@ -519,9 +556,15 @@ bool ABSGameMode::InitializeAudioManagers()
 	return true;
 }
 
-void ABSGameMode::OnTick_AudioAnalyzers(const float DeltaSeconds)
+void ABSGameMode::OnTick_AudioAnalyzers(const float DeltaSeconds, const float SimulatedSeconds)
 {
-	Elapsed += DeltaSeconds;
+	if (AudioAnalyzerPlayback)
+	{
+		OnTick_AudioAnalyzerReplay(SimulatedSeconds);
+		return;
+	}
+
+	Elapsed += SimulatedSeconds;
 
 	AATracker->GetBeatTrackingWLimitsWThreshold(Beats, SpectrumValues, BpmCurrent, BpmTotal,
 		AASettings.BandLimitsThreshold);
@@ -529,6 +572,10 @@ void ABSGameMode::OnTick_AudioAnalyzers(const float DeltaSeconds)
 	{
 		SpawnNewTarget(Beat);
 	}
+	if (AudioAnalyzerRecording)
+	{
+		RecordedBeats = Beats;
+	}
 
 	if (AAPlayer)
 	{
@@ -541,6 +588,129 @@ void ABSGameMode::OnTick_AudioAnalyzers(const float DeltaSeconds)
 		AATracker->GetBeatTrackingAverageAndVariance(SpectrumVariance, VisualizerManager->AvgSpectrumValues);
 	}
 	VisualizerManager->UpdateVisualizers(SpectrumValues);
+
+	if (AudioAnalyzerRecording)
+	{
+		AudioAnalyzerRecording->RecordFrame(DeltaSeconds, RecordedBeats, SpectrumValues,
+			VisualizerManager->AvgSpectrumValues);
+	}
+}
+
+void ABSGameMode::InitializeAudioAnalyzerReplay()
+{
+	RandomSeed = FMath::Rand();
+
+	FString FilePath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("BSReplayAudioAnalyzer="), FilePath))
+	{
+		if (!AudioAnalyzerPlayback)
+		{
+			AudioAnalyzerPlayback = MakeUnique<FAudioAnalyzerReplay>();
+			if (!AudioAnalyzerPlayback->LoadFromFile(FilePath))
+			{
+				UE_LOG(LogBSGameMode, Error, TEXT("Failed to load AudioAnalyzer recording from %s"),
+					*FAudioAnalyzerReplay::GetReplayFilePath(FilePath));
+				AudioAnalyzerPlayback.Reset();
+				return;
+			}
+		}
+		AudioAnalyzerPlayback->RewindPlayback();
+
+		FBSConfig RecordedConfig;
+		if (AudioAnalyzerPlayback->GetConfig(RecordedConfig))
+		{
+			BSConfig = MakeShared<FBSConfig>(RecordedConfig);
+		}
+		UpdateReplayFixedTimeStep();
+		RandomSeed = AudioAnalyzerPlayback->GetRandomSeed();
+
+		UE_LOG(LogBSGameMode, Display, TEXT("Replaying %d AudioAnalyzer frames from %s"),
+			AudioAnalyzerPlayback->GetNumFrames(), *FAudioAnalyzerReplay::GetReplayFilePath(FilePath));
+		return;
+	}
+
+	if (FParse::Value(FCommandLine::Get(), TEXT("BSRecordAudioAnalyzer="), AudioAnalyzerRecordingPath))
+	{
+		AudioAnalyzerRecording = MakeUnique<FAudioAnalyzerReplay>();
+		AudioAnalyzerRecording->BeginRecording(RandomSeed, *BSConfig);
+	}
+}
+
+void ABSGameMode::OnTick_AudioAnalyzerReplay(const float SimulatedSeconds)
+{
+	if (!AudioAnalyzerPlayback->ReadNextFrame(AudioAnalyzerPlaybackFrame))
+	{
+		EndGameMode(false, ETransitionState::None);
+		return;
+	}
+	UpdateReplayFixedTimeStep();
+
+	// The engine is stepped by the recorded frame time, so the cooldown advances the same as while recording
+	Elapsed += SimulatedSeconds;
+	for (const bool Beat : AudioAnalyzerPlaybackFrame.Beats)
+	{
+		SpawnNewTarget(Beat);
+	}
+
+	VisualizerManager->AvgSpectrumValues = AudioAnalyzerPlaybackFrame.AvgSpectrumValues;
+	VisualizerManager->UpdateVisualizers(AudioAnalyzerPlaybackFrame.SpectrumValues);
+}
+
+void ABSGameMode::UpdateReplayFixedTimeStep()
+{
+	const float DeltaSeconds = AudioAnalyzerPlayback->GetNextFrameDeltaSeconds();
+	if (DeltaSeconds > 0.f)
+	{
+		OverrideFixedTimeStep(DeltaSeconds);
+	}
+}
+
+void ABSGameMode::OverrideFixedTimeStep(const double DeltaSeconds)
+{
+	if (!bOverridingFixedTimeStep)
+	{
+		bUseFixedTimeStepBeforeOverride = FApp::UseFixedTimeStep();
+		FixedDeltaTimeBeforeOverride = FApp::GetFixedDeltaTime();
+		bOverridingFixedTimeStep = true;
+	}
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(DeltaSeconds);
+}
+
+void ABSGameMode::RestoreFixedTimeStep()
+{
+	if (bOverridingFixedTimeStep)
+	{
+		FApp::SetUseFixedTimeStep(bUseFixedTimeStepBeforeOverride);
+		FApp::SetFixedDeltaTime(FixedDeltaTimeBeforeOverride);
+		bOverridingFixedTimeStep = false;
+	}
+}
+
+void ABSGameMode::InitializeFastForward()
+{
+	const int32 NumSteps = FBSFixedTimestep::GetFastForwardSteps();
+	if (NumSteps <= 0)
+	{
+		return;
+	}
+
+	const double DeltaSeconds = FBSFixedTimestep::GetFastForwardDeltaSeconds(NumSteps);
+	if (DeltaSeconds <= 0.0)
+	{
+		UE_LOG(LogBSGameMode, Warning, TEXT("-BSFastForward has no effect while bs_sim.fixedtimestep is 0"));
+	}
+	else if (AudioAnalyzerPlayback)
+	{
+		UE_LOG(LogBSGameMode, Warning, TEXT("-BSFastForward has no effect while replaying an AudioAnalyzer ")
+			TEXT("recording, which runs at the recorded frame times"));
+	}
+	else
+	{
+		OverrideFixedTimeStep(DeltaSeconds);
+		UE_LOG(LogBSGameMode, Display, TEXT("Fast forwarding %d steps of %.4f seconds per frame"), NumSteps,
+			SimulationTimestep.GetStepSeconds());
+	}
 }
 
 void ABSGameMode::HandleSecondPassed() const
@@ -562,15 +732,7 @@ void ABSGameMode::GoToMainMenu()
 
 void ABSGameMode::LoadMatchingPlayerScores()
 {
-	if (BSConfig->AudioConfig.SongLength == 0.f)
-	{
-		MaxScorePerTarget = 1000.f;
-	}
-	else
-	{
-		MaxScorePerTarget = 100000.f / ((BSConfig->AudioConfig.SongLength - 1.f) / BSConfig->TargetConfig.
-			TargetSpawnCD);
-	}
+	MaxScorePerTarget = GetMaxScorePerTarget(*BSConfig);
 
 	for (auto& CurrentPlayerScore : CurrentPlayerScores)
 	{
@@ -580,15 +742,8 @@ void ABSGameMode::LoadMatchingPlayerScores()
 		CurrentPlayerScore.Value.SongLength = BSConfig->AudioConfig.SongLength;
 		CurrentPlayerScore.Value.TotalPossibleDamage = 0.f;
 
-		const TArray<FPlayerScore> PlayerScores = CurrentPlayerScore.Key->LoadPlayerScores().FilterByPredicate(
-			[&](const FPlayerScore& PlayerScore)
-			{
-				if (PlayerScore == CurrentPlayerScore.Value)
-				{
-					return true;
-				}
-				return false;
-			});
+		const TArray<FPlayerScore> PlayerScores = CurrentPlayerScore.Key->GetMatchingPlayerScores(
+			CurrentPlayerScore.Value);
 
 		for (const FPlayerScore& ScoreObject : PlayerScores)
 		{
@@ -666,10 +821,24 @@ void ABSGameMode::HandleScoreSaving(const bool bExternalSaveScores, const bool b
 }
 
 void ABSGameMode::FinalizePlayerScore(FPlayerScore& InScore) const
+{
+	FinalizePlayerScore(*BSConfig, InScore);
+}
+
+float ABSGameMode::GetMaxScorePerTarget(const FBSConfig& InConfig)
+{
+	if (InConfig.AudioConfig.SongLength == 0.f)
+	{
+		return 1000.f;
+	}
+	return 100000.f / ((InConfig.AudioConfig.SongLength - 1.f) / InConfig.TargetConfig.TargetSpawnCD);
+}
+
+void ABSGameMode::FinalizePlayerScore(const FBSConfig& InConfig, FPlayerScore& InScore)
 {
 	InScore.Time = FDateTime::UtcNow().ToIso8601();
 
-	if (BSConfig->TargetConfig.TargetDamageType == ETargetDamageType::Tracking)
+	if (InConfig.TargetConfig.TargetDamageType == ETargetDamageType::Tracking)
 	{
 		InScore.Accuracy = FloatDivide(InScore.Score, InScore.TotalPossibleDamage);
 		InScore.Completion = FloatDivide(InScore.Score, InScore.TotalPossibleDamage);
@@ -822,35 +991,41 @@ float ABSGameMode::FloatDivide(const float Numerator, const float Denominator)
 }
 
 float ABSGameMode::GetScoreFromTimeAlive(const float InTimeAlive) const
+{
+	return GetScoreFromTimeAlive(BSConfig->TargetConfig, MaxScorePerTarget, InTimeAlive);
+}
+
+float ABSGameMode::GetScoreFromTimeAlive(const FBS_TargetConfig& InTargetConfig, const float InMaxScorePerTarget,
+	const float InTimeAlive)
 {
 	// Perfect shot
-	if (GetAbsHitTimingError(InTimeAlive) < Constants::PerfectScoreTimeThreshold / 2.f)
+	if (FMath::Abs(InTimeAlive - InTargetConfig.SpawnBeatDelay) < Constants::PerfectScoreTimeThreshold / 2.f)
 	{
-		return MaxScorePerTarget;
+		return InMaxScorePerTarget;
 	}
 
-	const float MinScorePerTarget = MaxScorePerTarget / 2.f;
+	const float MinScorePerTarget = InMaxScorePerTarget / 2.f;
 	// Early shot
-	if (InTimeAlive < BSConfig->TargetConfig.SpawnBeatDelay)
+	if (InTimeAlive < InTargetConfig.SpawnBeatDelay)
 	{
 		constexpr float MinEarlyShot = 0.f;
-		const float MaxEarlyShot = BSConfig->TargetConfig.SpawnBeatDelay - Constants::PerfectScoreTimeThreshold / 2.f;
+		const float MaxEarlyShot = InTargetConfig.SpawnBeatDelay - Constants::PerfectScoreTimeThreshold / 2.f;
 		const FVector2d InputRange = FVector2d(MinEarlyShot, MaxEarlyShot);
 		const float LerpValue = FMath::GetMappedRangeValueClamped(InputRange, FVector2D(0.f, 1.f), InTimeAlive);
 
 		// interp between half perfect score at MinEarlyShot to perfect score at MaxEarlyShot
-		return MinScorePerTarget + LerpValue * (MaxScorePerTarget - MinScorePerTarget);
+		return MinScorePerTarget + LerpValue * (InMaxScorePerTarget - MinScorePerTarget);
 		//return FMath::Lerp<float>(MaxScorePerTarget / 2.f, MaxScorePerTarget, LerpValue);
 	}
 
 	// Late shot
-	const float MinLateShot = BSConfig->TargetConfig.SpawnBeatDelay + Constants::PerfectScoreTimeThreshold / 2.f;
-	const float MaxLateShot = BSConfig->TargetConfig.TargetMaxLifeSpan;
+	const float MinLateShot = InTargetConfig.SpawnBeatDelay + Constants::PerfectScoreTimeThreshold / 2.f;
+	const float MaxLateShot = InTargetConfig.TargetMaxLifeSpan;
 	const FVector2d InputRange = FVector2d(MinLateShot, MaxLateShot);
 	const float LerpValue = FMath::GetMappedRangeValueClamped(InputRange, FVector2D(0.f, 1.f), InTimeAlive);
 
 	// interp between perfect score at MinLateShot to half perfect score at MaxLateShot
-	return MaxScorePerTarget + LerpValue * (MinScorePerTarget - MaxScorePerTarget);
+	return InMaxScorePerTarget + LerpValue * (MinScorePerTarget - InMaxScorePerTarget);
 	//return FMath::Lerp<float>(MaxScorePerTarget, MaxScorePerTarget / 2.f, LerpValue);
 }
 
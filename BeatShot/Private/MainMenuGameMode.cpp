@@ -32,7 +32,7 @@ void AMainMenuGameMode::SetupTargetManager(UGameModeMenuWidget* GameModesWidget)
 	TargetManager = GetWorld()->SpawnActor<ATargetManagerPreview>(TargetManagerClass, FVector::Zero(),
 		FRotator::ZeroRotator);
 	TargetManager->InitBoxBoundsWidget(GameModesWidget->CustomGameModesWidget_CreatorView->Widget_Preview);
-	TargetManager->Init(BSConfig, FCommonScoreInfo(), PlayerSettings_Game);
+	TargetManager->Init(BSConfig, FCommonScoreInfo(), PlayerSettings_Game, FMath::Rand());
 
 	GameModesWidget->RequestSimulateTargetManagerStateChange.AddUObject(this,
 		&ThisClass::OnRequestSimulationStateChange);
@@ -68,7 +68,7 @@ void AMainMenuGameMode::StartSimulation()
 		return;
 	}
 
-	TargetManager->Init(BSConfig, FCommonScoreInfo(), PlayerSettings_Game);
+	TargetManager->Init(BSConfig, FCommonScoreInfo(), PlayerSettings_Game, FMath::Rand());
 	TargetManager->SetSimulatePlayerDestroyingTargets(true);
 	TargetManager->SetShouldSpawn(true);
 
@@ -0,0 +1,258 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "Physics/BSSceneQuerySubsystem.h"
+
+DECLARE_STATS_GROUP(TEXT("BeatShot Scene Queries"), STATGROUP_BSSceneQuery, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Critical Queries"), STAT_BSSceneQueryCritical, STATGROUP_BSSceneQuery);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred Queries"), STAT_BSSceneQueryDeferred, STATGROUP_BSSceneQuery);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Merged Queries"), STAT_BSSceneQueryMerged, STATGROUP_BSSceneQuery);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped Queries"), STAT_BSSceneQueryDropped, STATGROUP_BSSceneQuery);
+
+namespace
+{
+	TAutoConsoleVariable CVarSceneQueryBudget(TEXT("bs_scenequery.budget"), 32,
+		TEXT("The maximum number of scene queries issued per frame. Critical queries always run and count against\n")
+		TEXT("the budget first, while deferred queries wait for a later frame.\n")
+		TEXT("0: Unlimited"));
+
+	TAutoConsoleVariable CVarSceneQueryAsync(TEXT("bs_scenequery.async"), 1,
+		TEXT("Issue deferred scene queries as async traces instead of tracing them on the game thread.\n")
+		TEXT("0: Disabled, 1: Enabled"));
+
+	TAutoConsoleVariable CVarSceneQueryMergeTolerance(TEXT("bs_scenequery.mergetolerance"), 1.f,
+		TEXT("How close the start and end of two deferred rays must be for them to be merged into one query."));
+
+	FInt64Vector Quantize(const FVector& Vector, const double Tolerance)
+	{
+		const FVector Scaled = Vector / FMath::Max(Tolerance, UE_KINDA_SMALL_NUMBER);
+		return FInt64Vector(FMath::RoundToInt64(Scaled.X), FMath::RoundToInt64(Scaled.Y),
+			FMath::RoundToInt64(Scaled.Z));
+	}
+
+	uint32 HashQuantized(const FVector& Vector, const double Tolerance, const uint32 Hash)
+	{
+		const FInt64Vector Quantized = Quantize(Vector, Tolerance);
+		return HashCombineFast(HashCombineFast(HashCombineFast(Hash, GetTypeHash(Quantized.X)),
+			GetTypeHash(Quantized.Y)), GetTypeHash(Quantized.Z));
+	}
+}
+
+bool FBSSceneQueryBatch::Add(const FBSSceneQuery& Query, FBSSceneQueryDelegate&& Delegate, const uint64 FrameNumber,
+	const double MergeTolerance)
+{
+	const uint64 LastFrame = Query.LatencyTolerance < 0 ? MAX_uint64 : FrameNumber + Query.LatencyTolerance;
+	const uint64 PriorityFrame = Query.LatencyTolerance < 0 ? FrameNumber + NeverDropPriorityLatency : LastFrame;
+	const uint32 Hash = GetQueryHash(Query, MergeTolerance);
+
+	for (auto It = PendingIndices.CreateConstKeyIterator(Hash); It; ++It)
+	{
+		FBSPendingSceneQuery& Existing = Pending[It.Value()];
+		if (CanMerge(Existing.Query, Query, MergeTolerance))
+		{
+			Existing.Delegates.Add(MoveTemp(Delegate));
+			Existing.LastFrame = FMath::Min(Existing.LastFrame, LastFrame);
+			Existing.PriorityFrame = FMath::Min(Existing.PriorityFrame, PriorityFrame);
+			return true;
+		}
+	}
+
+	FBSPendingSceneQuery& NewQuery = Pending.AddDefaulted_GetRef();
+	NewQuery.Query = Query;
+	NewQuery.Delegates.Add(MoveTemp(Delegate));
+	NewQuery.LastFrame = LastFrame;
+	NewQuery.PriorityFrame = PriorityFrame;
+	NewQuery.Hash = Hash;
+	PendingIndices.Add(Hash, Pending.Num() - 1);
+	return false;
+}
+
+int32 FBSSceneQueryBatch::Take(const int32 MaxQueries, const uint64 FrameNumber,
+	TArray<FBSPendingSceneQuery>& OutQueries)
+{
+	// Issue the queries with the least latency tolerance left first, and queries that are never dropped once they
+	// have waited long enough
+	Pending.StableSort([](const FBSPendingSceneQuery& A, const FBSPendingSceneQuery& B)
+	{
+		return A.PriorityFrame < B.PriorityFrame;
+	});
+
+	int32 NumDropped = 0;
+	int32 NumTaken = 0;
+	TArray<FBSPendingSceneQuery> Remaining;
+	for (FBSPendingSceneQuery& Query : Pending)
+	{
+		if (Query.LastFrame < FrameNumber)
+		{
+			NumDropped++;
+		}
+		else if (NumTaken < MaxQueries)
+		{
+			OutQueries.Add(MoveTemp(Query));
+			NumTaken++;
+		}
+		else
+		{
+			Remaining.Add(MoveTemp(Query));
+		}
+	}
+
+	Pending = MoveTemp(Remaining);
+	PendingIndices.Reset();
+	for (int32 i = 0; i < Pending.Num(); i++)
+	{
+		PendingIndices.Add(Pending[i].Hash, i);
+	}
+	return NumDropped;
+}
+
+void FBSSceneQueryBatch::Reset()
+{
+	Pending.Reset();
+	PendingIndices.Reset();
+}
+
+bool FBSSceneQueryBatch::CanMerge(const FBSSceneQuery& A, const FBSSceneQuery& B, const double MergeTolerance)
+{
+	return A.Channel == B.Channel && Quantize(A.Start, MergeTolerance) == Quantize(B.Start, MergeTolerance) &&
+		Quantize(A.End, MergeTolerance) == Quantize(B.End, MergeTolerance) &&
+		A.Params.TraceTag == B.Params.TraceTag && A.Params.bTraceComplex == B.Params.bTraceComplex &&
+		A.Params.bReturnPhysicalMaterial == B.Params.bReturnPhysicalMaterial &&
+		A.Params.bReturnFaceIndex == B.Params.bReturnFaceIndex && A.Params.bIgnoreBlocks == B.Params.bIgnoreBlocks &&
+		A.Params.bIgnoreTouches == B.Params.bIgnoreTouches && A.Params.MobilityType == B.Params.MobilityType &&
+		A.Params.GetIgnoredActors() == B.Params.GetIgnoredActors() &&
+		A.Params.GetIgnoredComponents() == B.Params.GetIgnoredComponents();
+}
+
+uint32 FBSSceneQueryBatch::GetQueryHash(const FBSSceneQuery& Query, const double MergeTolerance)
+{
+	uint32 Hash = HashCombineFast(GetTypeHash(Query.Channel), GetTypeHash(Query.Params.TraceTag));
+	Hash = HashQuantized(Query.Start, MergeTolerance, Hash);
+	Hash = HashQuantized(Query.End, MergeTolerance, Hash);
+	for (const uint32 ActorID : Query.Params.GetIgnoredActors())
+	{
+		Hash = HashCombineFast(Hash, ActorID);
+	}
+	return Hash;
+}
+
+void UBSSceneQuerySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	AsyncTraceDelegate.BindUObject(this, &UBSSceneQuerySubsystem::OnAsyncTraceCompleted);
+}
+
+void UBSSceneQuerySubsystem::Deinitialize()
+{
+	AsyncTraceDelegate.Unbind();
+	Batch.Reset();
+	InFlight.Empty();
+	Super::Deinitialize();
+}
+
+void UBSSceneQuerySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	IssuePendingQueries();
+
+	CurrentFrameStats.NumWaiting = Batch.Num();
+	LastFrameStats = CurrentFrameStats;
+	CurrentFrameStats = FBSSceneQueryStats();
+}
+
+TStatId UBSSceneQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBSSceneQuerySubsystem, STATGROUP_Tickables);
+}
+
+bool UBSSceneQuerySubsystem::LineTrace(FHitResult& OutHit, const FVector& Start, const FVector& End,
+	const ECollisionChannel Channel, const FCollisionQueryParams& Params)
+{
+	CurrentFrameStats.NumCritical++;
+	INC_DWORD_STAT(STAT_BSSceneQueryCritical);
+	return GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, Channel, Params);
+}
+
+void UBSSceneQuerySubsystem::Submit(const FBSSceneQuery& Query, FBSSceneQueryDelegate&& Delegate)
+{
+	// Nothing ticks the subsystem outside of game worlds, e.g. when previewing an animation in the editor
+	if (Query.Priority == EBSSceneQueryPriority::Critical || !GetWorld()->IsGameWorld())
+	{
+		FHitResult Hit;
+		LineTrace(Hit, Query.Start, Query.End, Query.Channel, Query.Params);
+		Delegate.ExecuteIfBound(Hit);
+		return;
+	}
+
+	if (Batch.Add(Query, MoveTemp(Delegate), GFrameCounter, CVarSceneQueryMergeTolerance.GetValueOnGameThread()))
+	{
+		CurrentFrameStats.NumMerged++;
+		INC_DWORD_STAT(STAT_BSSceneQueryMerged);
+	}
+}
+
+void UBSSceneQuerySubsystem::IssuePendingQueries()
+{
+	if (Batch.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 Budget = CVarSceneQueryBudget.GetValueOnGameThread();
+	const int32 MaxQueries = Budget > 0 ? FMath::Max(Budget - CurrentFrameStats.NumCritical, 0) : MAX_int32;
+
+	TArray<FBSPendingSceneQuery> Queries;
+	const int32 NumDropped = Batch.Take(MaxQueries, GFrameCounter, Queries);
+	CurrentFrameStats.NumDropped += NumDropped;
+	CurrentFrameStats.NumDeferred += Queries.Num();
+	INC_DWORD_STAT_BY(STAT_BSSceneQueryDropped, NumDropped);
+	INC_DWORD_STAT_BY(STAT_BSSceneQueryDeferred, Queries.Num());
+
+	UWorld* World = GetWorld();
+	const bool bAsync = CVarSceneQueryAsync.GetValueOnGameThread() != 0;
+	for (FBSPendingSceneQuery& Pending : Queries)
+	{
+		const FBSSceneQuery& Query = Pending.Query;
+		if (bAsync)
+		{
+			const uint32 ID = NextAsyncTraceID++;
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Query.Start, Query.End, Query.Channel,
+				Query.Params, FCollisionResponseParams::DefaultResponseParam, &AsyncTraceDelegate, ID);
+			InFlight.Add(ID, MoveTemp(Pending.Delegates));
+		}
+		else
+		{
+			FHitResult Hit;
+			World->LineTraceSingleByChannel(Hit, Query.Start, Query.End, Query.Channel, Query.Params);
+			Deliver(Hit, Pending.Delegates);
+		}
+	}
+}
+
+void UBSSceneQuerySubsystem::OnAsyncTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	TArray<FBSSceneQueryDelegate, TInlineAllocator<1>> Delegates;
+	if (!InFlight.RemoveAndCopyValue(Datum.UserData, Delegates))
+	{
+		return;
+	}
+
+	FHitResult Hit(Datum.Start, Datum.End);
+	for (const FHitResult& OutHit : Datum.OutHits)
+	{
+		if (OutHit.bBlockingHit)
+		{
+			Hit = OutHit;
+			break;
+		}
+	}
+	Deliver(Hit, Delegates);
+}
+
+void UBSSceneQuerySubsystem::Deliver(const FHitResult& Hit, TConstArrayView<FBSSceneQueryDelegate> Delegates)
+{
+	for (const FBSSceneQueryDelegate& Delegate : Delegates)
+	{
+		Delegate.ExecuteIfBound(Hit);
+	}
+}
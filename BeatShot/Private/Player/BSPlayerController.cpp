@@ -88,15 +88,23 @@ void ABSPlayerController::BeginPlay()
 
 	if (!PlayerSettings.User.bNightModeUnlocked)
 	{
-		for (const TArray<FPlayerScore>& PlayerScores = LoadPlayerScores(); const FPlayerScore& Score : PlayerScores)
+		LoadPlayerScoresAsync([WeakThis = TWeakObjectPtr<ThisClass>(this)](const TArray<FPlayerScore>& PlayerScores)
 		{
-			if (Score.Streak > 50)
+			ABSPlayerController* Controller = WeakThis.Get();
+			if (!Controller || Controller->PlayerSettings.User.bNightModeUnlocked)
 			{
-				PlayerSettings.User.bNightModeUnlocked = true;
-				SavePlayerSettings(PlayerSettings.User);
-				break;
+				return;
 			}
-		}
+			for (const FPlayerScore& Score : PlayerScores)
+			{
+				if (Score.Streak > 50)
+				{
+					Controller->PlayerSettings.User.bNightModeUnlocked = true;
+					Controller->SavePlayerSettings(Controller->PlayerSettings.User);
+					break;
+				}
+			}
+		});
 	}
 
 	if (UGameplayStatics::GetCurrentLevelName(GetWorld()).Equals(GI->GetMainMenuLevelName().ToString()))
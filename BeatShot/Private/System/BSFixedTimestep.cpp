@@ -0,0 +1,71 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "System/BSFixedTimestep.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+	TAutoConsoleVariable CVarSimFixedTimestep(TEXT("bs_sim.fixedtimestep"), 0.f,
+		TEXT("Rate in Hz that targets and target spawning are simulated at, independent of the frame rate.\n")
+		TEXT("Applies to game modes started afterwards. 0 simulates once per frame."));
+
+	TAutoConsoleVariable CVarSimMaxStepsPerFrame(TEXT("bs_sim.maxstepsperframe"), 8,
+		TEXT("The most fixed steps simulated in one frame. Time beyond this is dropped."));
+
+	/** Fraction of a step that accumulated time may be short of a whole step and still count as one, so that frame
+	 *  times that are exact multiples of the step aren't lost to rounding. */
+	constexpr double StepTolerance = 1e-4;
+}
+
+FBSFixedTimestep::FBSFixedTimestep(const double InStepSeconds, const int32 InMaxStepsPerFrame) :
+	StepSeconds(FMath::Max(InStepSeconds, 0.0)), MaxStepsPerFrame(FMath::Max(InMaxStepsPerFrame, 1))
+{
+}
+
+FBSFixedTimestep FBSFixedTimestep::FromConsoleVariables()
+{
+	const float Rate = CVarSimFixedTimestep.GetValueOnGameThread();
+	if (Rate <= 0.f)
+	{
+		return FBSFixedTimestep();
+	}
+	return FBSFixedTimestep(1.0 / Rate, FMath::Max(CVarSimMaxStepsPerFrame.GetValueOnGameThread(),
+		GetFastForwardSteps()));
+}
+
+double FBSFixedTimestep::GetFastForwardDeltaSeconds(const int32 NumSteps)
+{
+	const float Rate = CVarSimFixedTimestep.GetValueOnGameThread();
+	if (Rate <= 0.f || NumSteps <= 0)
+	{
+		return 0.0;
+	}
+	return NumSteps / static_cast<double>(Rate);
+}
+
+int32 FBSFixedTimestep::GetFastForwardSteps()
+{
+	int32 NumSteps = 0;
+	FParse::Value(FCommandLine::Get(), TEXT("BSFastForward="), NumSteps);
+	return FMath::Max(NumSteps, 0);
+}
+
+int32 FBSFixedTimestep::Advance(const double DeltaSeconds)
+{
+	if (!IsEnabled())
+	{
+		return 0;
+	}
+
+	Accumulator += FMath::Max(DeltaSeconds, 0.0);
+	int32 NumSteps = FMath::FloorToInt32(Accumulator / StepSeconds + StepTolerance);
+	if (NumSteps > MaxStepsPerFrame)
+	{
+		NumSteps = MaxStepsPerFrame;
+		Accumulator = NumSteps * StepSeconds;
+	}
+	Accumulator = FMath::Max(Accumulator - NumSteps * StepSeconds, 0.0);
+	NumStepsSimulated += NumSteps;
+	return NumSteps;
+}
@@ -0,0 +1,79 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "Target/MovingTargetDirectionTable.h"
+
+namespace
+{
+	/** Direction of each sector from the origin of the spawn box, indexed by sector. */
+	const FVector SectorMultipliers[FMovingTargetDirectionTable::NumSectors] = {
+		FVector(0, -1, -1), FVector(0, 1, -1), FVector(0, -1, 1), FVector(0, 1, 1)
+	};
+}
+
+bool FMovingTargetDirectionTable::Update(const FVector& InOrigin, const FVector& InExtents, const float InDepth,
+	const FRandomStream& Stream)
+{
+	if (!IsEmpty() && Origin.Equals(InOrigin) && Extents.Equals(InExtents) && Depth == InDepth)
+	{
+		return false;
+	}
+
+	Origin = InOrigin;
+	Extents = InExtents;
+	Depth = InDepth;
+
+	// Each sector is 1/4 of the spawn box, pushed back by a random amount up to Depth
+	const FVector SectorExtents = Extents * 0.5f;
+	Locations.Reset(NumSectors * NumLocationsPerSector);
+	for (int32 SectorIndex = 0; SectorIndex < NumSectors; SectorIndex++)
+	{
+		const FVector Center = Origin + SectorMultipliers[SectorIndex] * SectorExtents;
+		for (int32 i = 0; i < NumLocationsPerSector; i++)
+		{
+			Locations.Emplace(Center.X - Stream.FRandRange(0.f, Depth) + Stream.FRandRange(-1.f, 1.f) * SectorExtents.X,
+				Center.Y + Stream.FRandRange(-1.f, 1.f) * SectorExtents.Y,
+				Center.Z + Stream.FRandRange(-1.f, 1.f) * SectorExtents.Z);
+		}
+	}
+	return true;
+}
+
+FVector FMovingTargetDirectionTable::SampleDirection(const FVector& LocationBeforeChange, const FRandomStream& Stream,
+	FVector* OutLocation) const
+{
+	if (IsEmpty())
+	{
+		return FVector::ZeroVector;
+	}
+
+	// Choose from the other three sectors by skipping over the current one
+	const int32 CurrentSectorIndex = GetSectorIndex(LocationBeforeChange);
+	int32 SectorIndex = Stream.RandRange(0, NumSectors - 2);
+	if (SectorIndex >= CurrentSectorIndex)
+	{
+		SectorIndex++;
+	}
+
+	const FVector& Location = Locations[SectorIndex * NumLocationsPerSector + Stream.RandRange(0,
+		NumLocationsPerSector - 1)];
+	if (OutLocation)
+	{
+		*OutLocation = Location;
+	}
+	return (Location - LocationBeforeChange).GetSafeNormal();
+}
+
+int32 FMovingTargetDirectionTable::GetSectorIndex(const FVector& Location) const
+{
+	return (Location.Y < 0.f ? 0 : 1) + (Location.Z < Origin.Z ? 0 : 2);
+}
+
+FVector FMovingTargetDirectionTable::GetSectorCenter(const int32 SectorIndex) const
+{
+	return Origin - FVector(Depth * 0.5f, 0.f, 0.f) + SectorMultipliers[SectorIndex] * Extents * 0.5f;
+}
+
+FVector FMovingTargetDirectionTable::GetSectorExtents() const
+{
+	return Extents * 0.5f + FVector(Depth * 0.5f, 0.f, 0.f);
+}
@@ -54,8 +54,9 @@ void UReinforcementLearningComponent::DestroyComponent(bool bPromoteChildren)
 	Super::DestroyComponent(bPromoteChildren);
 }
 
-void UReinforcementLearningComponent::Init(const FRLAgentParams& AgentParams)
+void UReinforcementLearningComponent::Init(const FRLAgentParams& AgentParams, const int32 InRandomSeed)
 {
+	RandomStream.Initialize(InRandomSeed);
 	Alpha = AgentParams.AIConfig.Alpha;
 	Gamma = AgentParams.AIConfig.Gamma;
 	Epsilon = AgentParams.AIConfig.Epsilon;
@@ -200,7 +201,7 @@ int32 UReinforcementLearningComponent::ChooseNextActionIndex(const int32 Previou
 		return INDEX_NONE;
 	}
 
-	if (FMath::FRandRange(0, 1.f) > Epsilon)
+	if (RandomStream.FRandRange(0, 1.f) > Epsilon)
 	{
 		const int32 BestActionIndex = ChooseBestActionIndex(PreviousSpawnAreaIndex, SpawnAreaIndices);
 		if (BestActionIndex == INDEX_NONE)
@@ -219,9 +220,9 @@ int32 UReinforcementLearningComponent::ChooseNextActionIndex(const int32 Previou
 	return ChooseRandomActionIndex(SpawnAreaIndices);
 }
 
-int32 UReinforcementLearningComponent::ChooseRandomActionIndex(const TArray<int32>& SpawnAreaIndices)
+int32 UReinforcementLearningComponent::ChooseRandomActionIndex(const TArray<int32>& SpawnAreaIndices) const
 {
-	return SpawnAreaIndices[FMath::RandRange(0, SpawnAreaIndices.Num() - 1)];
+	return SpawnAreaIndices[RandomStream.RandRange(0, SpawnAreaIndices.Num() - 1)];
 }
 
 int32 UReinforcementLearningComponent::ChooseBestActionIndex(const int32 PreviousSpawnAreaIndex,
@@ -257,7 +258,7 @@ int32 UReinforcementLearningComponent::ChooseBestActionIndex(const int32 Previou
 		/* Return a random point inside the filtered spawn indices if not empty */
 		if (!FilteredSpawnAreaIndices.IsEmpty())
 		{
-			const int32 RandomIndex = FMath::RandRange(0, FilteredSpawnAreaIndices.Num() - 1);
+			const int32 RandomIndex = RandomStream.RandRange(0, FilteredSpawnAreaIndices.Num() - 1);
 			ReturnIndex = FilteredSpawnAreaIndices[RandomIndex];
 			break;
 		}
@@ -284,7 +285,7 @@ void UReinforcementLearningComponent::UpdateQTable(FQTableUpdateParams& UpdatePa
 
 	// Choose a random max value
 	const TArray<int32> MaxIndex_2_Candidates = GetIndices_MaximizeSecond(UpdateParams.StateIndex_2);
-	UpdateParams.ActionIndex_2 = FMath::RandRange(0, MaxIndex_2_Candidates.Num() - 1);
+	UpdateParams.ActionIndex_2 = RandomStream.RandRange(0, MaxIndex_2_Candidates.Num() - 1);
 
 	// Q value for starting at State 1 and taking Action 1 (State 1, Action 1)
 	const float Predict = QTable(UpdateParams.StateIndex, UpdateParams.ActionIndex);
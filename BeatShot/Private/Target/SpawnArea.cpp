@@ -329,12 +329,12 @@ void USpawnArea::SetTotalSpawnAreaExtrema(const FExtrema& InExtrema)
 	TotalSpawnAreaExtrema = InExtrema;
 }
 
-FVector USpawnArea::GenerateRandomOffset()
+FVector USpawnArea::GenerateRandomOffset(const FRandomStream& Stream)
 {
 #if !UE_BUILD_SHIPPING
 	if (GIsAutomationTesting)
 	{
-		const int32 RandomNum = FMath::RandRange(0, 3);
+		const int32 RandomNum = Stream.RandRange(0, 3);
 		if (RandomNum == 0)
 		{
 			return FVector(0.f, 0.f, 0.f);
@@ -354,8 +354,8 @@ FVector USpawnArea::GenerateRandomOffset()
 	}
 #endif
 
-	const float Y = roundf(FMath::FRandRange(0.f, Width - 1.f));
-	const float Z = roundf(FMath::FRandRange(0.f, Height - 1.f));
+	const float Y = roundf(Stream.FRandRange(0.f, Width - 1.f));
+	const float Z = roundf(Stream.FRandRange(0.f, Height - 1.f));
 	return FVector(0.f, Y, Z);
 }
 
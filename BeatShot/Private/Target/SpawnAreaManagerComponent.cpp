@@ -3,7 +3,6 @@
 
 #include "Target/SpawnAreaManagerComponent.h"
 #include <stack>
-#include "Algo/RandomShuffle.h"
 #include "Target/MatrixFunctions.h"
 #include "Target/SpawnArea.h"
 #include "Target/Target.h"
@@ -11,6 +10,19 @@
 #include "Target/TargetManager.h"
 #endif
 
+namespace
+{
+	/** Shuffles Array using Stream, so that the order only depends on the seed of Stream. */
+	template <typename T>
+	void RandomShuffle(TArray<T>& Array, const FRandomStream& Stream)
+	{
+		for (int32 Index = Array.Num() - 1; Index > 0; Index--)
+		{
+			Array.Swap(Index, Stream.RandRange(0, Index));
+		}
+	}
+}
+
 void FRectCandidate::MergeSubRectangles()
 {
 	if (SubRectangles.IsEmpty())
@@ -105,11 +117,12 @@ void USpawnAreaManagerComponent::DestroyComponent(bool bPromoteChildren)
 }
 
 FIntVector3 USpawnAreaManagerComponent::Init(const TSharedPtr<FBSConfig>& InConfig, const FVector& InOrigin,
-	const FVector& InStaticExtents, const FExtrema& InStaticExtrema)
+	const FVector& InStaticExtents, const FExtrema& InStaticExtrema, const int32 InRandomSeed)
 {
 	Clear();
 
 	BSConfig = InConfig;
+	RandomStream.Initialize(InRandomSeed);
 	Origin = InOrigin;
 	StaticExtents = InStaticExtents;
 	StaticExtrema = InStaticExtrema;
@@ -901,7 +914,7 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 		case ERuntimeTargetSpawningLocationSelectionMode::Random:
 			{
 				TArray<USpawnArea*> Temp = ValidSpawnAreas.Array();
-				Algo::RandomShuffle(Temp);
+				RandomShuffle(Temp, RandomStream);
 				ValidSpawnAreas = TSet(MoveTemp(Temp));
 			}
 			break;
@@ -1024,7 +1037,7 @@ TSet<FTargetSpawnParams> USpawnAreaManagerComponent::GetTargetSpawnParams(const
 				{
 					if (GetOriginSpawnArea() && Chosen->GetIndex() != GetOriginSpawnArea()->GetIndex())
 					{
-						Chosen->SetChosenPoint(USpawnArea::GenerateRandomOffset());
+						Chosen->SetChosenPoint(USpawnArea::GenerateRandomOffset(RandomStream));
 					}
 				}
 				// Set the scale for the target to be spawned
@@ -1109,7 +1122,7 @@ USpawnArea* USpawnAreaManagerComponent::ChooseActivatableSpawnArea(const USpawnA
 	// 4th priority: Randomly select an index from ValidSpawnAreas
 	if (!ValidSpawnAreas.IsEmpty())
 	{
-		const int32 RandomIndex = FMath::RandRange(0, ValidSpawnAreas.Num() - 1);
+		const int32 RandomIndex = RandomStream.RandRange(0, ValidSpawnAreas.Num() - 1);
 		USpawnArea* RandomSpawnArea = ValidSpawnAreas.Array()[RandomIndex];
 		if (RandomSpawnArea && RandomSpawnArea->GetGuid().IsValid())
 		{
@@ -1171,7 +1184,7 @@ USpawnArea* USpawnAreaManagerComponent::ChooseSpawnableSpawnArea(const USpawnAre
 	// 4th priority: Randomly select an index from ValidSpawnAreas
 	if (!ValidSpawnAreas.IsEmpty())
 	{
-		return ValidSpawnAreas.Array()[FMath::RandRange(0, ValidSpawnAreas.Num() - 1)];
+		return ValidSpawnAreas.Array()[RandomStream.RandRange(0, ValidSpawnAreas.Num() - 1)];
 	}
 
 	// No valid spawn area found
@@ -1212,7 +1225,7 @@ void USpawnAreaManagerComponent::FindAdjacentGridUsingDFS(TSet<USpawnArea*>& Val
 		{
 			break;
 		}
-		USpawnArea* StartNode = StartNodeCandidates[FMath::RandRange(0, StartNodeCandidates.Num() - 1)];
+		USpawnArea* StartNode = StartNodeCandidates[RandomStream.RandRange(0, StartNodeCandidates.Num() - 1)];
 		StartNodeCandidates.RemoveSwap(StartNode);
 
 		TSet<USpawnArea*> Visited;
@@ -1243,7 +1256,7 @@ void USpawnAreaManagerComponent::FindAdjacentGridUsingDFS(TSet<USpawnArea*>& Val
 			}
 
 			TArray<int32> AdjacentIndices = Vertex->GetAdjacentIndices().Array();
-			Algo::RandomShuffle(AdjacentIndices);
+			RandomShuffle(AdjacentIndices, RandomStream);
 
 			for (const int32 Index : AdjacentIndices)
 			{
@@ -1299,7 +1312,7 @@ void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(TSet<USpawnA
 	}
 
 	// Choose a rectangle
-	FRectCandidate&& ChosenRectangle = ChooseRectangleCandidate(Rectangles, bBordering, BlockSize);
+	FRectCandidate&& ChosenRectangle = ChooseRectangleCandidate(Rectangles, bBordering, BlockSize, RandomStream);
 	if (!ChosenRectangle.HasChosenSubRectangle())
 	{
 #if !UE_BUILD_SHIPPING
@@ -1309,10 +1322,10 @@ void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(TSet<USpawnA
 	}
 
 	// Choose a rectangle orientation
-	const FIndexPair Orientation = ChooseRectangleOrientation(ChosenRectangle, ChosenRectangle.Factor);
+	const FIndexPair Orientation = ChooseRectangleOrientation(ChosenRectangle, ChosenRectangle.Factor, RandomStream);
 
 	// Choose the position and start/end indices within the chosen rectangle's available area
-	const auto [bIAsRow, bIncrement] = ChooseRectanglePosition(ChosenRectangle, Orientation, bBordering);
+	const auto [bIAsRow, bIncrement] = ChooseRectanglePosition(ChosenRectangle, Orientation, bBordering, RandomStream);
 
 #if !UE_BUILD_SHIPPING
 	if (bPrintDebug_Grid)
@@ -1364,7 +1377,8 @@ void USpawnAreaManagerComponent::FindGridBlockUsingLargestRectangle(TSet<USpawnA
 		const TSet<int32>&& RemainderSet = GetAdjacentSpawnAreas<int32>(ValidSpawnAreas, DirectionTypes::GridBlock);
 		if (!RemainderSet.IsEmpty())
 		{
-			if (USpawnArea* SpawnArea = GetSpawnArea(RemainderSet.Array()[FMath::RandRange(0, RemainderSet.Num() - 1)]))
+			const int32 RandomIndex = RandomStream.RandRange(0, RemainderSet.Num() - 1);
+			if (USpawnArea* SpawnArea = GetSpawnArea(RemainderSet.Array()[RandomIndex]))
 			{
 				ValidSpawnAreas.Add(SpawnArea);
 			}
@@ -1642,7 +1656,7 @@ void USpawnAreaManagerComponent::UpdateSubRectangles(FRectangleSet& Rectangles,
 }
 
 FRectCandidate USpawnAreaManagerComponent::ChooseRectangleCandidate(const FRectangleSet& Rectangles,
-	const bool bBordering, const int32 BlockSize)
+	const bool bBordering, const int32 BlockSize, const FRandomStream& Stream)
 {
 	// Convert to array and sort based on FRectCandidate < operator
 	TArray<FRectCandidate> RectanglesArr = Rectangles.Array();
@@ -1653,7 +1667,7 @@ FRectCandidate USpawnAreaManagerComponent::ChooseRectangleCandidate(const FRecta
 		for (auto& Rectangle : RectanglesArr)
 		{
 			TArray<FSubRectangle> SortedSubRectangles = Rectangle.SubRectangles.Array();
-			Algo::RandomShuffle(SortedSubRectangles);
+			RandomShuffle(SortedSubRectangles, Stream);
 			for (const auto& SubRectangle : SortedSubRectangles)
 			{
 				if (!SubRectangle.StartIndexCandidates.IsEmpty())
@@ -1672,7 +1686,7 @@ FRectCandidate USpawnAreaManagerComponent::ChooseRectangleCandidate(const FRecta
 		if (!Rectangle.SubRectangles.IsEmpty())
 		{
 			TArray<FSubRectangle> SubRectangles = Rectangle.SubRectangles.Array();
-			Rectangle.SetChosenSubRectangle(SubRectangles[FMath::RandRange(0, SubRectangles.Num() - 1)], BlockSize);
+			Rectangle.SetChosenSubRectangle(SubRectangles[Stream.RandRange(0, SubRectangles.Num() - 1)], BlockSize);
 			return Rectangle;
 		}
 	}
@@ -1680,7 +1694,8 @@ FRectCandidate USpawnAreaManagerComponent::ChooseRectangleCandidate(const FRecta
 	return FRectCandidate();
 }
 
-FIndexPair USpawnAreaManagerComponent::ChooseRectangleOrientation(const FRectCandidate& Rect, const FFactor& Factor)
+FIndexPair USpawnAreaManagerComponent::ChooseRectangleOrientation(const FRectCandidate& Rect, const FFactor& Factor,
+	const FRandomStream& Stream)
 {
 	int32 SubRowSize = -1;
 	int32 SubColSize = -1;
@@ -1688,7 +1703,7 @@ FIndexPair USpawnAreaManagerComponent::ChooseRectangleOrientation(const FRectCan
 	// All fit, choose random
 	if (Rect.AllFactorsFit())
 	{
-		const bool bRandom = FMath::RandBool();
+		const bool bRandom = Stream.RandRange(0, 1) == 1;
 		SubRowSize = bRandom ? Factor.Factor1 : Factor.Factor2;
 		SubColSize = bRandom ? Factor.Factor2 : Factor.Factor1;
 	}
@@ -1706,7 +1721,7 @@ FIndexPair USpawnAreaManagerComponent::ChooseRectangleOrientation(const FRectCan
 }
 
 std::pair<bool, bool> USpawnAreaManagerComponent::ChooseRectanglePosition(FRectCandidate& ChosenRectangle,
-	const FIndexPair& Orientation, const bool bBordering)
+	const FIndexPair& Orientation, const bool bBordering, const FRandomStream& Stream)
 {
 	// ChosenRow and ChosenCol are initialized to the chosen sub rectangles full Row, Col
 	const int32 MaxStartRowIndex = ChosenRectangle.ChosenRow.EndIndex - Orientation.StartIndex + 1;
@@ -1715,15 +1730,15 @@ std::pair<bool, bool> USpawnAreaManagerComponent::ChooseRectanglePosition(FRectC
 
 	if (bBordering && !ChosenRectangle.ChosenSubRectangle.StartIndexCandidates.IsEmpty())
 	{
-		const auto RandomAdjacent = ChosenRectangle.ChosenSubRectangle.StartIndexCandidates[FMath::RandRange(0,
+		const auto RandomAdjacent = ChosenRectangle.ChosenSubRectangle.StartIndexCandidates[Stream.RandRange(0,
 			ChosenRectangle.ChosenSubRectangle.StartIndexCandidates.Num() - 1)];
 		ChosenRectangle.ChosenRow.StartIndex = RandomAdjacent.StartIndex;
 		ChosenRectangle.ChosenCol.StartIndex = RandomAdjacent.EndIndex;
 	}
 	else
 	{
-		ChosenRectangle.ChosenRow.StartIndex = FMath::RandRange(ChosenRectangle.ChosenRow.StartIndex, MaxStartRowIndex);
-		ChosenRectangle.ChosenCol.StartIndex = FMath::RandRange(ChosenRectangle.ChosenRow.StartIndex, MaxStartColIndex);
+		ChosenRectangle.ChosenRow.StartIndex = Stream.RandRange(ChosenRectangle.ChosenRow.StartIndex, MaxStartRowIndex);
+		ChosenRectangle.ChosenCol.StartIndex = Stream.RandRange(ChosenRectangle.ChosenRow.StartIndex, MaxStartColIndex);
 	}
 
 	ChosenRectangle.ChosenRow.EndIndex = ChosenRectangle.ChosenRow.StartIndex + Orientation.StartIndex - 1;
@@ -1735,8 +1750,8 @@ std::pair<bool, bool> USpawnAreaManagerComponent::ChooseRectanglePosition(FRectC
 	// Randomize the start indices if it will get chopped off
 	if (ChosenRectangle.ChosenBlockSize > ChosenRectangle.ActualBlockSize)
 	{
-		bIAsRow = FMath::RandBool();
-		bIncrement = FMath::RandBool();
+		bIAsRow = Stream.RandRange(0, 1) == 1;
+		bIncrement = Stream.RandRange(0, 1) == 1;
 
 		// Swap rows and columns
 		if (!bIAsRow)
@@ -15,13 +15,36 @@
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Materials/MaterialInterface.h"
 #include "SaveGames/SaveGamePlayerSettings.h"
+#include "Target/TargetQuerySubsystem.h"
+
+namespace
+{
+	TAutoConsoleVariable CVarTargetAnalyticMovement(TEXT("bs_target.analyticmovement"), 1,
+		TEXT("Move targets along a closed form path that reflects off the spawn volume instead of simulating them\n")
+		TEXT("with the projectile movement component. Applies to targets spawned afterwards.\n")
+		TEXT("0: Disabled, 1: Enabled"));
+
+	/** The most bounces off the walls handled by one UpdateAnalyticMovement, in case of a very small movement box. */
+	constexpr int32 MaxBouncesPerUpdate = 16;
+
+	TAutoConsoleVariable CVarTargetLightweightDamage(TEXT("bs_target.lightweightdamage"), 1,
+		TEXT("Skip the ability system for one-hit targets that only take hit damage and never change immunity,\n")
+		TEXT("applying weapon damage to them directly. Applies to targets spawned afterwards.\n")
+		TEXT("0: Disabled, 1: Enabled"));
+
+	TAutoConsoleVariable CVarTargetCustomPrimitiveData(TEXT("bs_target.customprimitivedata"), 1,
+		TEXT("Set target material parameters through custom primitive data instead of creating a Dynamic Material\n")
+		TEXT("Instance for each target, if the target material supports it. Applies to targets spawned afterwards.\n")
+		TEXT("0: Disabled, 1: Enabled"));
+}
 
 
 FTargetDamageEvent::FTargetDamageEvent(const FDamageEventData& InData, const float InTimeAlive, ATarget* InTarget)
 {
 	Target = InTarget;
 	// For testing and main menu purposes
-	if (InData.EffectSpec->GetDynamicAssetTags().HasTagExact(BSGameplayTags::Target_TreatAsExternalDamage))
+	if (InData.EffectSpec ? InData.EffectSpec->GetDynamicAssetTags().HasTagExact(
+		BSGameplayTags::Target_TreatAsExternalDamage) : InData.bTreatAsExternalDamage)
 	{
 		bDamagedSelf = false;
 		DamageType = InTarget->GetTargetDamageType();
@@ -128,10 +151,21 @@ ATarget::ATarget()
 	TargetScale_Activation = FVector::ZeroVector;
 	TargetScale_Deactivation = FVector::ZeroVector;
 	ColorWhenDamageTaken = FLinearColor();
+	CurrentTargetColor = FLinearColor();
 	StartToPeakTimelinePlayRate = 1.f;
 	PeakToEndTimelinePlayRate = 1.f;
 	bApplyLifetimeTargetScaling = false;
 	bHasBeenActivated = false;
+	bUseLightweightDamage = false;
+	LightweightHealth = 0.f;
+	LightweightMaxHealth = 0.f;
+	bUseAnalyticMovement = false;
+	MovementBounds = FBox(ForceInit);
+	LastTrajectoryLocation = FVector::ZeroVector;
+	LastTrajectoryVelocity = FVector::ZeroVector;
+	LastTrajectoryTime = 0.0;
+	LastTrajectoryRadius = 0.f;
+	bTrajectoryDirty = true;
 }
 
 void ATarget::BeginPlay()
@@ -144,9 +178,12 @@ void ATarget::BeginPlay()
 		return;
 	}
 #endif
-	/* Use Color Changing Material, this is required in order to change color using C++ */
-	TargetColorChangeMaterial = UMaterialInstanceDynamic::Create(SphereMesh->GetMaterial(0), this);
-	SphereMesh->SetMaterial(0, TargetColorChangeMaterial);
+	/* Materials that don't read every target color from custom primitive data need a Dynamic Material Instance */
+	if (!InitMaterialParameters())
+	{
+		TargetColorChangeMaterial = UMaterialInstanceDynamic::Create(SphereMesh->GetMaterial(0), this);
+		SphereMesh->SetMaterial(0, TargetColorChangeMaterial);
+	}
 
 	/* Start to Peak Target Color */
 	OnStartToPeak.BindDynamic(this, &ATarget::InterpStartToPeak);
@@ -174,7 +211,7 @@ void ATarget::BeginPlay()
 		SetUseSeparateOutlineColor(true);
 	}
 
-	if (Config.TargetDeactivationResponses.Contains(ETargetDeactivationResponse::ShrinkQuickGrowSlow))
+	if (ResponseFlags.DeactivationResponses.Contains(ETargetDeactivationResponse::ShrinkQuickGrowSlow))
 	{
 		/* Fade the target from ColorWhenDamageTaken to BeatGridInactiveColor */
 		OnShrinkQuickAndGrowSlow.BindDynamic(this, &ATarget::InterpShrinkQuickAndGrowSlow);
@@ -186,14 +223,21 @@ void ATarget::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	if (UAbilitySystemComponent* ASC = GetAbilitySystemComponent())
+	if (bUseLightweightDamage)
+	{
+		LightweightMaxHealth = Config.MaxHealth <= 0.f ? Constants::UnlimitedTargetHealth : Config.MaxHealth;
+		LightweightHealth = LightweightMaxHealth;
+		CurrentDeactivationHealthThreshold = Config.MaxHealth - Config.DeactivationHealthLostThreshold;
+		AbilitySystemComponent->SetComponentTickEnabled(false);
+	}
+	else if (UAbilitySystemComponent* ASC = GetAbilitySystemComponent())
 	{
 		GetAbilitySystemComponent()->InitAbilityActorInfo(this, this);
 		if (const UBSAttributeSetBase* Set = GetAbilitySystemComponent()->GetSet<UBSAttributeSetBase>())
 		{
 			if (Config.MaxHealth <= 0.f)
 			{
-				ASC->SetNumericAttributeBase(Set->GetMaxHealthAttribute(), 10000);
+				ASC->SetNumericAttributeBase(Set->GetMaxHealthAttribute(), Constants::UnlimitedTargetHealth);
 			}
 			else
 			{
@@ -230,7 +274,7 @@ void ATarget::PostInitializeComponents()
 	TargetScale_Spawn = GetActorScale();
 	TargetLocation_Spawn = GetActorLocation();
 
-	if (Config.TargetActivationResponses.Contains(ETargetActivationResponse::ApplyLifetimeTargetScaling))
+	if (ResponseFlags.ActivationResponses.Contains(ETargetActivationResponse::ApplyLifetimeTargetScaling))
 	{
 		bApplyLifetimeTargetScaling = true;
 	}
@@ -247,7 +291,16 @@ void ATarget::PostInitializeComponents()
 		}
 		else
 		{
-			ProjectileMovementComponent->OnProjectileBounce.AddDynamic(this, &ATarget::OnProjectileBounce);
+			bUseAnalyticMovement = CVarTargetAnalyticMovement.GetValueOnGameThread() != 0;
+			if (bUseAnalyticMovement)
+			{
+				// The component only holds the speed and velocity, UpdateAnalyticMovement moves the target
+				ProjectileMovementComponent->SetComponentTickEnabled(false);
+			}
+			else
+			{
+				ProjectileMovementComponent->OnProjectileBounce.AddDynamic(this, &ATarget::OnProjectileBounce);
+			}
 			if (Config.MovingTargetDirectionMode == EMovingTargetDirectionMode::HorizontalOnly || Config.
 				MovingTargetDirectionMode == EMovingTargetDirectionMode::VerticalOnly || Config.
 				MovingTargetDirectionMode == EMovingTargetDirectionMode::AlternateHorizontalVertical)
@@ -262,6 +315,26 @@ void ATarget::PostInitializeComponents()
 void ATarget::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
+	if (bUseAnalyticMovement)
+	{
+		// The trajectory is exact at any time, so movement is evaluated at the frame time even with fixed steps
+		UpdateAnalyticMovement();
+	}
+	if (SimulationTimestep.IsEnabled())
+	{
+		for (int32 NumSteps = SimulationTimestep.Advance(DeltaSeconds); NumSteps > 0; NumSteps--)
+		{
+			TickTimelines(SimulationTimestep.GetStepSeconds());
+		}
+	}
+	else
+	{
+		TickTimelines(DeltaSeconds);
+	}
+}
+
+void ATarget::TickTimelines(const float DeltaSeconds)
+{
 	StartToPeakTimeline.TickTimeline(DeltaSeconds);
 	PeakToEndTimeline.TickTimeline(DeltaSeconds);
 	ShrinkQuickAndGrowSlowTimeline.TickTimeline(DeltaSeconds);
@@ -270,7 +343,28 @@ void ATarget::Tick(float DeltaSeconds)
 void ATarget::Init(const FBS_TargetConfig& InTargetConfig)
 {
 	Config = InTargetConfig;
+	ResponseFlags = FBS_TargetResponseFlags(Config);
 	Guid = FGuid::NewGuid();
+	bUseLightweightDamage = CVarTargetLightweightDamage.GetValueOnGameThread() && CanUseLightweightDamage(Config);
+	SimulationTimestep = FBSFixedTimestep::FromConsoleVariables();
+}
+
+bool ATarget::CanUseLightweightDamage(const FBS_TargetConfig& InTargetConfig)
+{
+	if (InTargetConfig.TargetDamageType != ETargetDamageType::Hit || InTargetConfig.MaxHealth <= 0.f ||
+		InTargetConfig.BasePlayerHitDamage < InTargetConfig.MaxHealth)
+	{
+		return false;
+	}
+
+	const FBS_TargetResponseFlags Flags(InTargetConfig);
+	return !InTargetConfig.TargetSpawnResponses.Contains(ETargetSpawnResponse::AddImmunity) &&
+		!Flags.ActivationResponses.Contains(ETargetActivationResponse::AddImmunity) &&
+		!Flags.ActivationResponses.Contains(ETargetActivationResponse::RemoveImmunity) &&
+		!Flags.ActivationResponses.Contains(ETargetActivationResponse::ToggleImmunity) &&
+		!Flags.DeactivationResponses.Contains(ETargetDeactivationResponse::AddImmunity) &&
+		!Flags.DeactivationResponses.Contains(ETargetDeactivationResponse::RemoveImmunity) &&
+		!Flags.DeactivationResponses.Contains(ETargetDeactivationResponse::ToggleImmunity);
 }
 
 void ATarget::OnProjectileBounce(const FHitResult& ImpactResult, const FVector& ImpactVelocity)
@@ -338,6 +432,70 @@ void ATarget::OnProjectileBounce(const FHitResult& ImpactResult, const FVector&
 	ProjectileMovementComponent->Velocity = NewVelocity;
 }
 
+void ATarget::SetMovementBounds(const FBox& InBounds)
+{
+	MovementBounds = InBounds;
+	bTrajectoryDirty = true;
+}
+
+FVector ATarget::GetLocationAtTime(const double Time) const
+{
+	if (!bUseAnalyticMovement || bTrajectoryDirty)
+	{
+		return GetActorLocation();
+	}
+	return Trajectory.Evaluate(Time);
+}
+
+void ATarget::UpdateAnalyticMovement()
+{
+	if (!MovementBounds.IsValid || !ProjectileMovementComponent->IsActive())
+	{
+		return;
+	}
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	const FVector& Velocity = ProjectileMovementComponent->Velocity;
+	if (!GetActorLocation().Equals(LastTrajectoryLocation))
+	{
+		// Moved by something else, e.g. the TargetManager on activation
+		Trajectory = FTargetTrajectory(Time, GetActorLocation(), ProjectileMovementComponent->
+			ConstrainDirectionToPlane(Velocity), MovementBounds.ExpandBy(-GetRadius()));
+	}
+	else if (bTrajectoryDirty || !Velocity.Equals(LastTrajectoryVelocity) || GetRadius() != LastTrajectoryRadius)
+	{
+		// Direction, speed, or scale changed since the last update, which is when the target was at
+		// LastTrajectoryLocation. A new scale changes how far the target can move before touching the bounds
+		Trajectory = FTargetTrajectory(LastTrajectoryTime, LastTrajectoryLocation, ProjectileMovementComponent->
+			ConstrainDirectionToPlane(Velocity), MovementBounds.ExpandBy(-GetRadius()));
+	}
+	bTrajectoryDirty = false;
+
+	// Targets moving in any direction leave a wall along its normal, the same as OnProjectileBounce, instead of
+	// reflecting off of it. Each bounce starts a new trajectory
+	if (Config.MovingTargetDirectionMode == EMovingTargetDirectionMode::Any)
+	{
+		FVector WallNormal;
+		double BounceTime = Trajectory.GetNextReflectionTime(FMath::Max(LastTrajectoryTime,
+			Trajectory.GetStartTime()), WallNormal);
+		for (int32 NumBounces = 0; BounceTime <= Time && NumBounces < MaxBouncesPerUpdate; NumBounces++)
+		{
+			Trajectory = FTargetTrajectory(BounceTime, Trajectory.Evaluate(BounceTime),
+				WallNormal * Trajectory.GetStartVelocity().Length(), Trajectory.GetBounds());
+			BounceTime = Trajectory.GetNextReflectionTime(BounceTime, WallNormal);
+		}
+	}
+
+	FVector NewVelocity;
+	SetActorLocation(Trajectory.Evaluate(Time, &NewVelocity));
+	ProjectileMovementComponent->Velocity = NewVelocity;
+
+	LastTrajectoryLocation = GetActorLocation();
+	LastTrajectoryVelocity = NewVelocity;
+	LastTrajectoryTime = Time;
+	LastTrajectoryRadius = GetRadius();
+}
+
 void ATarget::UpdatePlayerSettings(const FPlayerSettings_Game& InPlayerSettings)
 {
 	SetUseSeparateOutlineColor(InPlayerSettings.bUseSeparateOutlineColor);
@@ -349,7 +507,8 @@ void ATarget::UpdatePlayerSettings(const FPlayerSettings_Game& InPlayerSettings)
 
 UAbilitySystemComponent* ATarget::GetAbilitySystemComponent() const
 {
-	return AbilitySystemComponent;
+	// Gameplay effects applied to lightweight targets, e.g. by weapon abilities, have nothing to apply to
+	return bUseLightweightDamage ? nullptr : AbilitySystemComponent;
 }
 
 void ATarget::ApplyImmunityEffect()
@@ -387,6 +546,11 @@ void ATarget::OnImmunityBlockGameplayEffect(const FGameplayEffectSpec& Spec, con
 
 void ATarget::GetOwnedGameplayTags(FGameplayTagContainer& TagContainer) const
 {
+	if (bUseLightweightDamage)
+	{
+		TagContainer.AddTag(BSGameplayTags::Target_State_Immune_TrackingDamage);
+		return;
+	}
 	GetAbilitySystemComponent()->GetOwnedGameplayTags(TagContainer);
 }
 
@@ -411,16 +575,34 @@ void ATarget::OnIncomingDamageTaken(const FDamageEventData& InData)
 	}
 
 	// Save current color for use during deactivation responses
-	if (TargetColorChangeMaterial)
-	{
-		TargetColorChangeMaterial->GetVectorParameterValue(MaterialParameterColorName, ColorWhenDamageTaken);
-	}
+	ColorWhenDamageTaken = CurrentTargetColor;
 
 	FTargetDamageEvent Event(InData, ElapsedTime, this);
 	Event.SetTargetData(CurrentDeactivationHealthThreshold, {ETargetDamageType::Self, GetTargetDamageType()});
 	OnTargetDamageEvent.Broadcast(Event);
 }
 
+void ATarget::ApplyLightweightDamage(const float Damage, const ETargetDamageType DamageType,
+	AActor* EffectInstigator, AActor* EffectCauser, const bool bTreatAsExternalDamage)
+{
+	if (!ensure(bUseLightweightDamage) || Damage <= 0.f)
+	{
+		return;
+	}
+
+	const float OldHealth = LightweightHealth;
+	LightweightHealth = FMath::Clamp(LightweightHealth - Damage, 0.f, LightweightMaxHealth);
+	if (LightweightHealth == OldHealth)
+	{
+		return;
+	}
+
+	FDamageEventData DamageEvent(EffectInstigator, EffectCauser, nullptr, Damage, OldHealth, LightweightHealth,
+		DamageType);
+	DamageEvent.bTreatAsExternalDamage = bTreatAsExternalDamage;
+	OnIncomingDamageTaken(DamageEvent);
+}
+
 void ATarget::OnLifeSpanExpired()
 {
 	DamageSelf();
@@ -428,6 +610,12 @@ void ATarget::OnLifeSpanExpired()
 
 void ATarget::DamageSelf(const bool bTreatAsExternalDamage)
 {
+	if (bUseLightweightDamage)
+	{
+		ApplyLightweightDamage(Config.ExpirationHealthPenalty, ETargetDamageType::Self, this, this,
+			bTreatAsExternalDamage);
+		return;
+	}
 	if (UAbilitySystemComponent* Comp = GetAbilitySystemComponent())
 	{
 		FGameplayEffectContextHandle EffectContextHandle = Comp->MakeEffectContext();
@@ -445,6 +633,11 @@ void ATarget::DamageSelf(const bool bTreatAsExternalDamage)
 
 void ATarget::ResetHealth()
 {
+	if (bUseLightweightDamage)
+	{
+		LightweightHealth = LightweightMaxHealth;
+		return;
+	}
 	if (UAbilitySystemComponent* Comp = GetAbilitySystemComponent())
 	{
 		FGameplayEffectContextHandle EffectContextHandle = Comp->MakeEffectContext();
@@ -490,6 +683,11 @@ bool ATarget::ActivateTarget(const float Lifespan)
 
 	// This value is only changed here and DeactivateTarget
 	bIsCurrentlyActivated = true;
+	SetMaterialParameter(HighlightParameter, 1.f);
+	if (UTargetQuerySubsystem* TargetQuerySubsystem = GetWorld()->GetSubsystem<UTargetQuerySubsystem>())
+	{
+		TargetQuerySubsystem->UpdateTarget(this);
+	}
 
 	return true;
 }
@@ -500,6 +698,11 @@ void ATarget::DeactivateTarget()
 	TargetScale_Deactivation = GetActorScale();
 	CurrentDeactivationHealthThreshold -= Config.DeactivationHealthLostThreshold;
 	bIsCurrentlyActivated = false;
+	SetMaterialParameter(HighlightParameter, 0.f);
+	if (UTargetQuerySubsystem* TargetQuerySubsystem = GetWorld()->GetSubsystem<UTargetQuerySubsystem>())
+	{
+		TargetQuerySubsystem->UpdateTarget(this);
+	}
 }
 
 void ATarget::CheckForHealthReset(const bool bOutOfHealth)
@@ -555,24 +758,27 @@ void ATarget::StopAllTimelines()
 
 void ATarget::InterpStartToPeak(const float Alpha)
 {
+	const float LifetimeFraction = StartToPeakTimeline.GetPlaybackPosition() * Config.SpawnBeatDelay / Config.
+		TargetMaxLifeSpan;
 	SetTargetColor(UKismetMathLibrary::LinearColorLerp(Config.StartColor, Config.PeakColor, Alpha));
+	SetMaterialParameter(LifetimeFractionParameter, LifetimeFraction);
 	if (bApplyLifetimeTargetScaling)
 	{
 		SetTargetScale(FVector(UKismetMathLibrary::Lerp(GetTargetScale_Deactivation().X,
-			GetTargetScale_Deactivation().X * Config.LifetimeTargetScaleMultiplier,
-			StartToPeakTimeline.GetPlaybackPosition() * Config.SpawnBeatDelay / Config.TargetMaxLifeSpan)));
+			GetTargetScale_Deactivation().X * Config.LifetimeTargetScaleMultiplier, LifetimeFraction)));
 	}
 }
 
 void ATarget::InterpPeakToEnd(const float Alpha)
 {
+	const float LifetimeFraction = (PeakToEndTimeline.GetPlaybackPosition() * (Config.TargetMaxLifeSpan - Config.
+		SpawnBeatDelay) + Config.SpawnBeatDelay) / Config.TargetMaxLifeSpan;
 	SetTargetColor(UKismetMathLibrary::LinearColorLerp(Config.PeakColor, Config.EndColor, Alpha));
+	SetMaterialParameter(LifetimeFractionParameter, LifetimeFraction);
 	if (bApplyLifetimeTargetScaling)
 	{
 		SetTargetScale(FVector(UKismetMathLibrary::Lerp(GetTargetScale_Deactivation().X,
-			GetTargetScale_Deactivation().X * Config.LifetimeTargetScaleMultiplier,
-			(PeakToEndTimeline.GetPlaybackPosition() * (Config.TargetMaxLifeSpan - Config.SpawnBeatDelay) + Config.
-				SpawnBeatDelay) / Config.TargetMaxLifeSpan)));
+			GetTargetScale_Deactivation().X * Config.LifetimeTargetScaleMultiplier, LifetimeFraction)));
 	}
 }
 
@@ -589,15 +795,90 @@ void ATarget::InterpShrinkQuickAndGrowSlow(const float Alpha)
 /* -- Setter functions -- */
 /* ---------------------- */
 
+bool ATarget::InitMaterialParameters()
+{
+	BaseColorParameter.Name = MaterialParameterColorName;
+	OutlineColorParameter.Name = MaterialParameterOutlineColorName;
+	UseSeparateOutlineColorParameter.Name = MaterialParameterUseSeparateOutlineColorName;
+
+	if (!CVarTargetCustomPrimitiveData.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	BaseColorParameter.PrimitiveDataIndex = SphereMesh->GetCustomPrimitiveDataIndexForVectorParameter(
+		BaseColorParameter.Name);
+	if (BaseColorParameter.PrimitiveDataIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutlineColorParameter.PrimitiveDataIndex = SphereMesh->GetCustomPrimitiveDataIndexForVectorParameter(
+		OutlineColorParameter.Name);
+	UseSeparateOutlineColorParameter.PrimitiveDataIndex = SphereMesh->GetCustomPrimitiveDataIndexForScalarParameter(
+		UseSeparateOutlineColorParameter.Name);
+
+	// Only materials that read target state from custom primitive data have these parameters
+	LifetimeFractionParameter.PrimitiveDataIndex = SphereMesh->GetCustomPrimitiveDataIndexForScalarParameter(
+		MaterialParameterLifetimeFractionName);
+	HighlightParameter.PrimitiveDataIndex = SphereMesh->GetCustomPrimitiveDataIndexForScalarParameter(
+		MaterialParameterHighlightName);
+
+	// The parameters missing from custom primitive data are set on a Dynamic Material Instance instead
+	if (OutlineColorParameter.PrimitiveDataIndex == INDEX_NONE ||
+		UseSeparateOutlineColorParameter.PrimitiveDataIndex == INDEX_NONE)
+	{
+		// Every target spawned with the same material would report the same thing
+		static TSet<FString> ReportedMaterials;
+		const UMaterialInterface* Material = SphereMesh->GetMaterial(0);
+		bool bAlreadyReported = false;
+		ReportedMaterials.Add(GetPathNameSafe(Material), &bAlreadyReported);
+		if (!bAlreadyReported)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s reads %s from custom primitive data, but not both %s and %s. ")
+				TEXT("Using a Dynamic Material Instance for the rest."), *GetNameSafe(Material),
+				*BaseColorParameter.Name.ToString(), *OutlineColorParameter.Name.ToString(),
+				*UseSeparateOutlineColorParameter.Name.ToString());
+		}
+		return false;
+	}
+	return true;
+}
+
+void ATarget::SetMaterialParameter(const FTargetMaterialParameter& Parameter, const FLinearColor& Value)
+{
+	if (Parameter.PrimitiveDataIndex != INDEX_NONE)
+	{
+		SphereMesh->SetCustomPrimitiveDataVector4(Parameter.PrimitiveDataIndex, FVector4(Value));
+	}
+	else if (TargetColorChangeMaterial && !Parameter.Name.IsNone())
+	{
+		TargetColorChangeMaterial->SetVectorParameterValue(Parameter.Name, Value);
+	}
+}
+
+void ATarget::SetMaterialParameter(const FTargetMaterialParameter& Parameter, const float Value)
+{
+	if (Parameter.PrimitiveDataIndex != INDEX_NONE)
+	{
+		SphereMesh->SetCustomPrimitiveDataFloat(Parameter.PrimitiveDataIndex, Value);
+	}
+	else if (TargetColorChangeMaterial && !Parameter.Name.IsNone())
+	{
+		TargetColorChangeMaterial->SetScalarParameterValue(Parameter.Name, Value);
+	}
+}
+
 void ATarget::SetTargetColor(const FLinearColor& Color)
 {
+	CurrentTargetColor = Color;
 #if !UE_BUILD_SHIPPING
 	if (GIsAutomationTesting)
 	{
 		return;
 	}
 #endif
-	TargetColorChangeMaterial->SetVectorParameterValue(TEXT("BaseColor"), Color);
+	SetMaterialParameter(BaseColorParameter, Color);
 }
 
 void ATarget::SetTargetOutlineColor(const FLinearColor& Color)
@@ -608,7 +889,7 @@ void ATarget::SetTargetOutlineColor(const FLinearColor& Color)
 		return;
 	}
 #endif
-	TargetColorChangeMaterial->SetVectorParameterValue(TEXT("OutlineColor"), Color);
+	SetMaterialParameter(OutlineColorParameter, Color);
 }
 
 void ATarget::SetUseSeparateOutlineColor(const bool bUseSeparateOutlineColor)
@@ -622,10 +903,10 @@ void ATarget::SetUseSeparateOutlineColor(const bool bUseSeparateOutlineColor)
 	if (bUseSeparateOutlineColor)
 	{
 		SetTargetOutlineColor(Config.OutlineColor);
-		TargetColorChangeMaterial->SetScalarParameterValue("bUseSeparateOutlineColor", 1.f);
+		SetMaterialParameter(UseSeparateOutlineColorParameter, 1.f);
 		return;
 	}
-	TargetColorChangeMaterial->SetScalarParameterValue("bUseSeparateOutlineColor", 0.f);
+	SetMaterialParameter(UseSeparateOutlineColorParameter, 0.f);
 }
 
 void ATarget::SetTargetColorToInactiveColor()
@@ -744,7 +1025,8 @@ bool ATarget::IsImmuneToHitDamage() const
 
 bool ATarget::IsImmuneToTrackingDamage() const
 {
-	return ActiveGE_TargetImmunity.IsValid() || ActiveGE_TrackingImmunity.IsValid();
+	// Lightweight targets only take hit damage
+	return bUseLightweightDamage || ActiveGE_TargetImmunity.IsValid() || ActiveGE_TrackingImmunity.IsValid();
 }
 
 ETargetDamageType ATarget::GetTargetDamageType() const
@@ -10,9 +10,9 @@
 #include "Target/ReinforcementLearningComponent.h"
 #include "Target/SpawnAreaManagerComponent.h"
 #include "Target/Target.h"
+#include "Target/TargetQuerySubsystem.h"
 #include "Utilities/BSCommon.h"
 
-FVector (&RandBoxPoint)(const FVector Center, const FVector Extents) = UKismetMathLibrary::RandomPointInBoundingBox;
 DEFINE_LOG_CATEGORY(LogTargetManager);
 
 using namespace Constants;
@@ -91,10 +91,12 @@ void ATargetManager::Tick(float DeltaTime)
 }
 
 void ATargetManager::Init(const TSharedPtr<FBSConfig>& InConfig, const FCommonScoreInfo& InCommonScoreInfo,
-	const FPlayerSettings_Game& InPlayerSettings)
+	const FPlayerSettings_Game& InPlayerSettings, const int32 InRandomSeed)
 {
 	Clear();
 	BSConfig = InConfig;
+	RandomStream.Initialize(InRandomSeed);
+	CompileTargetResponses();
 
 	// Initialize target colors
 	BSConfig->InitColors(InPlayerSettings.bUseSeparateOutlineColor, InPlayerSettings.InactiveTargetColor,
@@ -113,9 +115,11 @@ void ATargetManager::Init(const TSharedPtr<FBSConfig>& InConfig, const FCommonSc
 	Init_Tables();
 
 	// Initialize the SpawnAreaManager
-	SpawnAreaDimensions = SpawnAreaManager->Init(BSConfig, GetSpawnBoxOrigin(), StaticExtents, StaticExtrema);
+	SpawnAreaDimensions = SpawnAreaManager->Init(BSConfig, GetSpawnBoxOrigin(), StaticExtents, StaticExtrema,
+		RandomStream.RandHelper(MAX_int32));
 
 	// Initialize SpawnBox extents and the SpawnVolume extents & location
+	MovingTargetDirectionStream.Initialize(RandomStream.RandHelper(MAX_int32));
 	const bool bDynamic = BSConfig->TargetConfig.BoundsScalingPolicy == EBoundsScalingPolicy::Dynamic;
 	const float Factor = bDynamic ? GetCurveTableValue(true, DynamicLookUpValue_SpawnAreaScale) : 1.f;
 	UpdateSpawnBoxExtents(Factor);
@@ -133,7 +137,7 @@ void ATargetManager::Init(const TSharedPtr<FBSConfig>& InConfig, const FCommonSc
 	if (BSConfig->IsCompatibleWithReinforcementLearning())
 	{
 		const FRLAgentParams Params(BSConfig->AIConfig, InCommonScoreInfo, SpawnAreaManager->GetSpawnAreaSize());
-		RLComponent->Init(Params);
+		RLComponent->Init(Params, RandomStream.RandHelper(MAX_int32));
 
 		// Bind the SpawnAreaManager to the RLComponent if it should request activation locations
 		const EReinforcementLearningMode Mode = RLComponent->GetRLMode();
@@ -158,7 +162,7 @@ void ATargetManager::Init(const TSharedPtr<FBSConfig>& InConfig, const FCommonSc
 #endif
 	}
 
-	RandomNumToActivateStream.Initialize(FMath::Rand());
+	RandomNumToActivateStream.Initialize(RandomStream.RandHelper(MAX_int32));
 
 	// Spawn any targets if needed
 	if (BSConfig->TargetConfig.TargetSpawningPolicy == ETargetSpawningPolicy::UpfrontOnly)
@@ -199,6 +203,9 @@ void ATargetManager::Clear()
 	CurrentStreak = 0;
 	BSConfig.Reset();
 	BSConfig = nullptr;
+	ResponseFlags = FBS_TargetResponseFlags();
+	DeactivationResponseHandlers.Reset();
+	MovingTargetDirectionTable = FMovingTargetDirectionTable();
 	LastTargetDamageType = ETargetDamageType::Tracking;
 	CurrentTargetScale = FVector(1.f);
 	StaticExtrema = FExtrema();
@@ -219,7 +226,7 @@ void ATargetManager::SetShouldSpawn(const bool bShouldSpawn)
 {
 	if (bShouldSpawn)
 	{
-		if (BSConfig->TargetConfig.TargetDeactivationResponses.Contains(ETargetDeactivationResponse::HideTarget))
+		if (ResponseFlags.DeactivationResponses.Contains(ETargetDeactivationResponse::HideTarget))
 		{
 			for (const TTuple<FGuid, ATarget*>& Pair : ManagedTargets)
 			{
@@ -274,6 +281,7 @@ ATarget* ATargetManager::SpawnTarget(const FTargetSpawnParams& Params)
 #endif
 
 	Target->SetTargetDamageType(FindNextTargetDamageType());
+	Target->SetMovementBounds(GetMovingTargetBounds());
 	Target->OnTargetDamageEvent.AddUObject(this, &ATargetManager::OnTargetDamageEvent);
 	AddToManagedTargets(Target, Params.SpawnAreaIndex);
 
@@ -289,7 +297,7 @@ ATarget* ATargetManager::SpawnTarget(const FTargetSpawnParams& Params)
 	}
 	if (BSConfig->TargetConfig.TargetSpawnResponses.Contains(ETargetSpawnResponse::ChangeVelocity))
 	{
-		const float SpawnVelocity = FMath::FRandRange(BSConfig->TargetConfig.MinSpawnedTargetSpeed,
+		const float SpawnVelocity = RandomStream.FRandRange(BSConfig->TargetConfig.MinSpawnedTargetSpeed,
 			BSConfig->TargetConfig.MaxSpawnedTargetSpeed);
 		Target->SetTargetSpeed(SpawnVelocity);
 
@@ -310,6 +318,10 @@ ATarget* ATargetManager::SpawnTarget(const FTargetSpawnParams& Params)
 void ATargetManager::AddToManagedTargets(ATarget* SpawnTarget, const int32 SpawnAreaIndex)
 {
 	ManagedTargets.Add(SpawnTarget->GetGuid(), SpawnTarget);
+	if (UTargetQuerySubsystem* TargetQuerySubsystem = GetWorld()->GetSubsystem<UTargetQuerySubsystem>())
+	{
+		TargetQuerySubsystem->RegisterTarget(SpawnTarget);
+	}
 	SpawnAreaManager->FlagSpawnAreaAsManaged(SpawnAreaIndex, SpawnTarget->GetGuid());
 }
 
@@ -320,7 +332,7 @@ bool ATargetManager::ActivateTarget(ATarget* InTarget) const
 		return false;
 	}
 
-	const TArray<ETargetActivationResponse>& Responses = BSConfig->TargetConfig.TargetActivationResponses;
+	const TBSEnumFlags<ETargetActivationResponse>& Responses = ResponseFlags.ActivationResponses;
 
 	// Only perform some Activation Responses if already activated
 	const bool bAlreadyActivated = InTarget->IsActivated();
@@ -344,7 +356,7 @@ bool ATargetManager::ActivateTarget(ATarget* InTarget) const
 	}
 	if (Responses.Contains(ETargetActivationResponse::ChangeVelocity))
 	{
-		InTarget->SetTargetSpeed(FMath::FRandRange(BSConfig->TargetConfig.MinActivatedTargetSpeed,
+		InTarget->SetTargetSpeed(RandomStream.FRandRange(BSConfig->TargetConfig.MinActivatedTargetSpeed,
 			BSConfig->TargetConfig.MaxActivatedTargetSpeed));
 		if (!Responses.Contains(ETargetActivationResponse::ChangeDirection) && BSConfig->TargetConfig.
 			MovingTargetDirectionMode != EMovingTargetDirectionMode::None)
@@ -406,94 +418,16 @@ bool ATargetManager::ActivateTarget(ATarget* InTarget) const
 
 void ATargetManager::DeactivateTarget(ATarget* InTarget, const bool bExpired, const bool bOutOfHealth) const
 {
-	const FBS_TargetConfig& Config = BSConfig->TargetConfig;
-	const TArray<ETargetDeactivationResponse>& Responses = BSConfig->TargetConfig.TargetDeactivationResponses;
-
-	// Immunity
-	if (Responses.Contains(ETargetDeactivationResponse::RemoveImmunity))
-	{
-		InTarget->RemoveImmunityEffect();
-	}
-	if (Responses.Contains(ETargetDeactivationResponse::AddImmunity))
-	{
-		InTarget->ApplyImmunityEffect();
-	}
-	if (Responses.Contains(ETargetDeactivationResponse::ToggleImmunity))
-	{
-		InTarget->IsImmuneToDamage() ? InTarget->RemoveImmunityEffect() : InTarget->ApplyImmunityEffect();
-	}
-
-	// Scale
-	if (Responses.Contains(ETargetDeactivationResponse::ResetScaleToSpawnedScale))
-	{
-		InTarget->SetTargetScale(InTarget->GetTargetScale_Spawn());
-	}
-	if (Responses.Contains(ETargetDeactivationResponse::ResetScaleToActivatedScale))
-	{
-		InTarget->SetTargetScale(InTarget->GetTargetScale_Activation());
-	}
-	if (Responses.Contains(ETargetDeactivationResponse::ApplyDeactivatedTargetScaleMultiplier))
-	{
-		InTarget->SetTargetScale(InTarget->GetActorScale() * Config.ConsecutiveChargeScaleMultiplier);
-	}
-
-	// Position
-	if (Responses.Contains(ETargetDeactivationResponse::ResetPositionToSpawnedPosition))
-	{
-		InTarget->SetActorLocation(InTarget->GetTargetLocation_Spawn());
-	}
-	if (Responses.Contains(ETargetDeactivationResponse::ResetPositionToActivatedPosition))
+	for (const FDeactivationResponseHandler Handler : DeactivationResponseHandlers)
 	{
-		InTarget->SetActorLocation(InTarget->GetTargetLocation_Activation());
-	}
-
-	// Velocity
-	if (Responses.Contains(ETargetDeactivationResponse::ChangeVelocity))
-	{
-		InTarget->SetTargetSpeed(FMath::FRandRange(Config.MinDeactivatedTargetSpeed, Config.MaxDeactivatedTargetSpeed));
-
-		if (!Responses.Contains(ETargetDeactivationResponse::ChangeDirection) && Config.MovingTargetDirectionMode !=
-			EMovingTargetDirectionMode::None)
-		{
-			ChangeTargetDirection(InTarget, 2);
-		}
-	}
-
-	// Direction
-	if (Responses.Contains(ETargetDeactivationResponse::ChangeDirection))
-	{
-		ChangeTargetDirection(InTarget, 2);
-	}
-
-	// Effects
-	if (Responses.Contains(ETargetDeactivationResponse::PlayExplosionEffect) && !bExpired)
-	{
-		const FVector Loc = InTarget->SphereMesh->GetComponentLocation();
-		const float SphereRadius = SphereTargetRadius * InTarget->GetActorScale().X;
-		InTarget->PlayExplosionEffect(Loc, SphereRadius, InTarget->ColorWhenDamageTaken);
-	}
-	if (Responses.Contains(ETargetDeactivationResponse::ShrinkQuickGrowSlow) && !bExpired)
-	{
-		InTarget->PlayShrinkQuickAndGrowSlowTimeline();
-	}
-
-	// Hide target
-	if (Responses.Contains(ETargetDeactivationResponse::HideTarget))
-	{
-		InTarget->SetActorHiddenInGame(true);
-	}
-
-	// Colors
-	if (Responses.Contains(ETargetDeactivationResponse::ResetColorToInactiveColor))
-	{
-		InTarget->SetTargetColor(Config.InactiveTargetColor);
+		Handler(*this, InTarget, bExpired);
 	}
 
 	InTarget->DeactivateTarget();
 	InTarget->CheckForHealthReset(bOutOfHealth);
 
 	// Handle reactivation
-	if (Responses.Contains(ETargetDeactivationResponse::Reactivate))
+	if (ResponseFlags.DeactivationResponses.Contains(ETargetDeactivationResponse::Reactivate))
 	{
 		ActivateTarget(InTarget);
 	}
@@ -502,54 +436,156 @@ void ATargetManager::DeactivateTarget(ATarget* InTarget, const bool bExpired, co
 bool ATargetManager::ShouldDeactivateTarget(const bool bExpired, const float CurrentHealth,
 	const float DeactivationThreshold) const
 {
-	const bool bOutOfHealth = CurrentHealth <= 0.f;
-	const bool ThresholdPassed = CurrentHealth <= DeactivationThreshold;
-	const TArray<ETargetDeactivationCondition>& Conditions = BSConfig->TargetConfig.TargetDeactivationConditions;
-
-	if (bExpired && Conditions.Contains(ETargetDeactivationCondition::OnExpiration))
-	{
-		return true;
-	}
-	if (bOutOfHealth && Conditions.Contains(ETargetDeactivationCondition::OnHealthReachedZero))
-	{
-		return true;
-	}
-	if (ThresholdPassed && Conditions.Contains(ETargetDeactivationCondition::OnSpecificHealthLost))
-	{
-		return true;
-	}
-	if (!bExpired && Conditions.Contains(ETargetDeactivationCondition::OnAnyExternalDamageTaken))
-	{
-		return true;
-	}
-	return false;
+	return ResponseFlags.ShouldDeactivate(bExpired, CurrentHealth, DeactivationThreshold);
 }
 
 bool ATargetManager::ShouldDestroyTarget(const bool bExpired, const bool bOutOfHealth) const
 {
-	const TArray<ETargetDestructionCondition>& Conditions = BSConfig->TargetConfig.TargetDestructionConditions;
+	return ResponseFlags.ShouldDestroy(bExpired, bOutOfHealth);
+}
 
-	if (BSConfig->TargetConfig.TargetDeactivationResponses.Contains(ETargetDeactivationResponse::Destroy))
-	{
-		return true;
-	}
-	if (Conditions.Contains(ETargetDestructionCondition::OnDeactivation))
-	{
-		return true;
-	}
-	if (Conditions.Contains(ETargetDestructionCondition::OnExpiration) && bExpired)
-	{
-		return true;
-	}
-	if (Conditions.Contains(ETargetDestructionCondition::OnHealthReachedZero) && bOutOfHealth)
+void ATargetManager::CompileTargetResponses()
+{
+	ResponseFlags = FBS_TargetResponseFlags(BSConfig->TargetConfig);
+
+	struct FHandlerEntry
 	{
-		return true;
-	}
-	if (Conditions.Contains(ETargetDestructionCondition::OnAnyExternalDamageTaken) && !bExpired)
+		ETargetDeactivationResponse Response;
+		FDeactivationResponseHandler Handler;
+	};
+
+	// Deactivation responses in the order they are executed
+	static const FHandlerEntry Handlers[] = {
+		// Immunity
+		{
+			ETargetDeactivationResponse::RemoveImmunity, [](const ATargetManager&, ATarget* InTarget, const bool)
+			{
+				InTarget->RemoveImmunityEffect();
+			}
+		},
+		{
+			ETargetDeactivationResponse::AddImmunity, [](const ATargetManager&, ATarget* InTarget, const bool)
+			{
+				InTarget->ApplyImmunityEffect();
+			}
+		},
+		{
+			ETargetDeactivationResponse::ToggleImmunity, [](const ATargetManager&, ATarget* InTarget, const bool)
+			{
+				InTarget->IsImmuneToDamage() ? InTarget->RemoveImmunityEffect() : InTarget->ApplyImmunityEffect();
+			}
+		},
+		// Scale
+		{
+			ETargetDeactivationResponse::ResetScaleToSpawnedScale,
+			[](const ATargetManager&, ATarget* InTarget, const bool)
+			{
+				InTarget->SetTargetScale(InTarget->GetTargetScale_Spawn());
+			}
+		},
+		{
+			ETargetDeactivationResponse::ResetScaleToActivatedScale,
+			[](const ATargetManager&, ATarget* InTarget, const bool)
+			{
+				InTarget->SetTargetScale(InTarget->GetTargetScale_Activation());
+			}
+		},
+		{
+			ETargetDeactivationResponse::ApplyDeactivatedTargetScaleMultiplier,
+			[](const ATargetManager& TargetManager, ATarget* InTarget, const bool)
+			{
+				InTarget->SetTargetScale(InTarget->GetActorScale() * TargetManager.BSConfig->TargetConfig.
+					ConsecutiveChargeScaleMultiplier);
+			}
+		},
+		// Position
+		{
+			ETargetDeactivationResponse::ResetPositionToSpawnedPosition,
+			[](const ATargetManager&, ATarget* InTarget, const bool)
+			{
+				InTarget->SetActorLocation(InTarget->GetTargetLocation_Spawn());
+			}
+		},
+		{
+			ETargetDeactivationResponse::ResetPositionToActivatedPosition,
+			[](const ATargetManager&, ATarget* InTarget, const bool)
+			{
+				InTarget->SetActorLocation(InTarget->GetTargetLocation_Activation());
+			}
+		},
+		// Velocity
+		{
+			ETargetDeactivationResponse::ChangeVelocity,
+			[](const ATargetManager& TargetManager, ATarget* InTarget, const bool)
+			{
+				const FBS_TargetConfig& Config = TargetManager.BSConfig->TargetConfig;
+				InTarget->SetTargetSpeed(TargetManager.RandomStream.FRandRange(Config.MinDeactivatedTargetSpeed,
+					Config.MaxDeactivatedTargetSpeed));
+
+				if (!TargetManager.ResponseFlags.DeactivationResponses.Contains(
+					ETargetDeactivationResponse::ChangeDirection) && Config.MovingTargetDirectionMode !=
+					EMovingTargetDirectionMode::None)
+				{
+					TargetManager.ChangeTargetDirection(InTarget, 2);
+				}
+			}
+		},
+		// Direction
+		{
+			ETargetDeactivationResponse::ChangeDirection,
+			[](const ATargetManager& TargetManager, ATarget* InTarget, const bool)
+			{
+				TargetManager.ChangeTargetDirection(InTarget, 2);
+			}
+		},
+		// Effects
+		{
+			ETargetDeactivationResponse::PlayExplosionEffect,
+			[](const ATargetManager&, ATarget* InTarget, const bool bExpired)
+			{
+				if (!bExpired)
+				{
+					const FVector Loc = InTarget->SphereMesh->GetComponentLocation();
+					const float SphereRadius = SphereTargetRadius * InTarget->GetActorScale().X;
+					InTarget->PlayExplosionEffect(Loc, SphereRadius, InTarget->ColorWhenDamageTaken);
+				}
+			}
+		},
+		{
+			ETargetDeactivationResponse::ShrinkQuickGrowSlow,
+			[](const ATargetManager&, ATarget* InTarget, const bool bExpired)
+			{
+				if (!bExpired)
+				{
+					InTarget->PlayShrinkQuickAndGrowSlowTimeline();
+				}
+			}
+		},
+		// Hide target
+		{
+			ETargetDeactivationResponse::HideTarget, [](const ATargetManager&, ATarget* InTarget, const bool)
+			{
+				InTarget->SetActorHiddenInGame(true);
+			}
+		},
+		// Colors
+		{
+			ETargetDeactivationResponse::ResetColorToInactiveColor,
+			[](const ATargetManager& TargetManager, ATarget* InTarget, const bool)
+			{
+				InTarget->SetTargetColor(TargetManager.BSConfig->TargetConfig.InactiveTargetColor);
+			}
+		},
+	};
+
+	DeactivationResponseHandlers.Reset();
+	for (const FHandlerEntry& Entry : Handlers)
 	{
-		return true;
+		if (ResponseFlags.DeactivationResponses.Contains(Entry.Response))
+		{
+			DeactivationResponseHandlers.Add(Entry.Handler);
+		}
 	}
-	return false;
 }
 
 int32 ATargetManager::HandleUpfrontSpawning()
@@ -783,7 +819,7 @@ FVector ATargetManager::FindNextSpawnedTargetScale() const
 		const float NewFactor = GetCurveTableValue(false, DynamicLookUpValue_TargetScale);
 		return FVector(UKismetMathLibrary::Lerp(Cfg.MaxSpawnedTargetScale, Cfg.MinSpawnedTargetScale, NewFactor));
 	}
-	return FVector(FMath::FRandRange(Cfg.MinSpawnedTargetScale, Cfg.MaxSpawnedTargetScale));
+	return FVector(RandomStream.FRandRange(Cfg.MinSpawnedTargetScale, Cfg.MaxSpawnedTargetScale));
 }
 
 TSet<FTargetSpawnParams> ATargetManager::GetTargetSpawnParams(const int32 NumToSpawn) const
@@ -924,7 +960,14 @@ void ATargetManager::UpdateDynamicLookUpValues(const FTargetDamageEvent& Event)
 
 void ATargetManager::RemoveFromManagedTargets(const FGuid GuidToRemove)
 {
-	ManagedTargets.Remove(GuidToRemove);
+	ATarget* Target = nullptr;
+	if (ManagedTargets.RemoveAndCopyValue(GuidToRemove, Target))
+	{
+		if (UTargetQuerySubsystem* TargetQuerySubsystem = GetWorld()->GetSubsystem<UTargetQuerySubsystem>())
+		{
+			TargetQuerySubsystem->UnregisterTarget(Target);
+		}
+	}
 }
 
 /* -------------------------------------------------- */
@@ -1201,6 +1244,28 @@ void ATargetManager::UpdateSpawnVolume(const float Factor) const
 	RightBox->SetBoxExtent(FVector(VolumeExtents.X, 0, VolumeExtents.Z));
 	ForwardBox->SetBoxExtent(FVector(0, VolumeExtents.Y, VolumeExtents.Z));
 	BackwardBox->SetBoxExtent(FVector(0, VolumeExtents.Y, VolumeExtents.Z));
+
+	if (BSConfig && BSConfig->TargetConfig.MovingTargetDirectionMode == EMovingTargetDirectionMode::Any)
+	{
+		MovingTargetDirectionTable.Update(GetSpawnBoxOrigin(), GetSpawnBoxExtents(), BSConfig->TargetConfig.BoxBounds.X,
+			MovingTargetDirectionStream);
+	}
+
+	const FBox MovingTargetBounds = GetMovingTargetBounds();
+	for (const TTuple<FGuid, ATarget*>& Pair : ManagedTargets)
+	{
+		if (Pair.Value)
+		{
+			Pair.Value->SetMovementBounds(MovingTargetBounds);
+		}
+	}
+}
+
+FBox ATargetManager::GetMovingTargetBounds() const
+{
+	return FBox(FVector(BackwardBox->GetComponentLocation().X, LeftBox->GetComponentLocation().Y,
+		BottomBox->GetComponentLocation().Z), FVector(ForwardBox->GetComponentLocation().X,
+		RightBox->GetComponentLocation().Y, TopBox->GetComponentLocation().Z));
 }
 
 /* ------------------------------ */
@@ -1235,57 +1300,48 @@ void ATargetManager::ChangeTargetDirection(ATarget* InTarget, const uint8 InSpaw
 FVector ATargetManager::GetNewTargetDirection(const FVector& LocationBeforeChange,
 	const bool bLastDirectionChangeHorizontal) const
 {
+	const FRandomStream& Stream = MovingTargetDirectionStream;
 	switch (BSConfig->TargetConfig.MovingTargetDirectionMode)
 	{
 	case EMovingTargetDirectionMode::HorizontalOnly:
 		{
-			return FMath::RandBool() ? FVector(0, 1, 0) : FVector(0, -1, 0);
+			return Stream.GetFraction() < 0.5f ? FVector(0, 1, 0) : FVector(0, -1, 0);
 		}
 	case EMovingTargetDirectionMode::VerticalOnly:
 		{
-			return FMath::RandBool() ? FVector(0, 0, 1) : FVector(0, 0, -1);
+			return Stream.GetFraction() < 0.5f ? FVector(0, 0, 1) : FVector(0, 0, -1);
 		}
 	case EMovingTargetDirectionMode::AlternateHorizontalVertical:
 		{
 			if (bLastDirectionChangeHorizontal)
 			{
-				return FMath::RandBool() ? FVector(0, 0, 1) : FVector(0, 0, -1);
+				return Stream.GetFraction() < 0.5f ? FVector(0, 0, 1) : FVector(0, 0, -1);
 			}
-			return FMath::RandBool() ? FVector(0, 1, 0) : FVector(0, -1, 0);
+			return Stream.GetFraction() < 0.5f ? FVector(0, 1, 0) : FVector(0, -1, 0);
 		}
 	case EMovingTargetDirectionMode::Any:
 		{
-			FVector Origin = GetSpawnBoxOrigin();
-			const FVector SBExtents = GetSpawnBoxExtents();
-
-			// Randomize the X location
-			Origin.X = FMath::FRandRange(Origin.X, Origin.X - BSConfig->TargetConfig.BoxBounds.X);
-
-			// 1/4 of the total Spawn Volume
-			const FVector Extent = FVector(SBExtents.X * 0.5f, SBExtents.Y * 0.5f, SBExtents.Z * 0.5f);
-			const FVector Offset = FVector(0, Extent.Y, Extent.Z);
-			TArray<FVector> PossibleLocations;
-
 #if !UE_BUILD_SHIPPING
-			LastAnyTargetDirectionModeSectors.Sectors.Empty();
-#endif
+			FVector NewLocation;
+			const FVector Direction = MovingTargetDirectionTable.SampleDirection(LocationBeforeChange, Stream,
+				&NewLocation);
 
-			for (const FVector& Direction : GetAnyDirectionMultipliers(LocationBeforeChange, Origin))
+			const int32 CurrentSectorIndex = MovingTargetDirectionTable.GetSectorIndex(LocationBeforeChange);
+			LastAnyTargetDirectionModeSectors.Sectors.Empty();
+			for (int32 i = 0; i < FMovingTargetDirectionTable::NumSectors; i++)
 			{
-				PossibleLocations.Add(RandBoxPoint(Origin + Direction * Offset, Extent));
-#if !UE_BUILD_SHIPPING
-				LastAnyTargetDirectionModeSectors.Sectors.Add({Origin + Direction * Offset, Extent});
-#endif
+				if (i != CurrentSectorIndex)
+				{
+					LastAnyTargetDirectionModeSectors.Sectors.Add({MovingTargetDirectionTable.GetSectorCenter(i),
+						MovingTargetDirectionTable.GetSectorExtents()});
+				}
 			}
-
-			const FVector NewLocation = PossibleLocations[FMath::RandRange(0, PossibleLocations.Num() - 1)];
-
-#if !UE_BUILD_SHIPPING
 			LastAnyTargetDirectionModeSectors.LineStart = LocationBeforeChange;
 			LastAnyTargetDirectionModeSectors.LineEnd = NewLocation;
+			return Direction;
+#else
+			return MovingTargetDirectionTable.SampleDirection(LocationBeforeChange, Stream);
 #endif
-
-			return UKismetMathLibrary::GetDirectionUnitVector(LocationBeforeChange, NewLocation);
 		}
 	case EMovingTargetDirectionMode::ForwardOnly:
 		{
@@ -1297,34 +1353,6 @@ FVector ATargetManager::GetNewTargetDirection(const FVector& LocationBeforeChang
 	return FVector::ZeroVector;
 }
 
-TArray<FVector> ATargetManager::GetAnyDirectionMultipliers(const FVector& LocationBeforeChange, const FVector& Origin)
-{
-	TArray<FVector> Multipliers = AnyDirectionModeMultipliers;
-	if (LocationBeforeChange.Y < 0)
-	{
-		if (LocationBeforeChange.Z < Origin.Z)
-		{
-			Multipliers.Remove(FVector(0, -1, -1));
-		}
-		else
-		{
-			Multipliers.Remove(FVector(0, -1, 1));
-		}
-	}
-	else
-	{
-		if (LocationBeforeChange.Z < Origin.Z)
-		{
-			Multipliers.Remove(FVector(0, 1, -1));
-		}
-		else
-		{
-			Multipliers.Remove(FVector(0, 1, 1));
-		}
-	}
-	return Multipliers;
-}
-
 void ATargetManager::UpdateTotalPossibleDamage()
 {
 	TotalPossibleDamage++;
@@ -1404,10 +1432,15 @@ void ATargetManager::DestroyTargets()
 		}
 	}
 	ManagedTargets.Empty();
+	if (UTargetQuerySubsystem* TargetQuerySubsystem = GetWorld()->GetSubsystem<UTargetQuerySubsystem>())
+	{
+		TargetQuerySubsystem->UnregisterAllTargets();
+	}
 }
 
 void ATargetManager::GetMovingTargetLocations(FMovingTargetLocations& MovingTargetLocations) const
 {
+	MovingTargetLocations.Map.Reserve(ManagedTargets.Num());
 	for (const TPair<FGuid, ATarget*>& Pair : ManagedTargets)
 	{
 		if (!FMath::IsNearlyZero(Pair.Value->GetTargetVelocity().Length(), UE_KINDA_SMALL_NUMBER))
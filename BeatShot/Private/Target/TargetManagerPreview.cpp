@@ -127,8 +127,7 @@ void ATargetManagerPreview::DeactivateTarget(ATarget* InTarget, const bool bExpi
 	Super::DeactivateTarget(InTarget, bExpired, bOutOfHealth);
 
 	// Hide target
-	if (InTarget && BSConfig->TargetConfig.TargetDeactivationResponses.
-	                          Contains(ETargetDeactivationResponse::HideTarget))
+	if (InTarget && ResponseFlags.DeactivationResponses.Contains(ETargetDeactivationResponse::HideTarget))
 	{
 		if (const ATargetPreview* TargetPreview = Cast<ATargetPreview>(InTarget))
 		{
@@ -0,0 +1,308 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "Target/TargetQuerySubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Physics/BSCollisionChannels.h"
+#include "Physics/BSSceneQuerySubsystem.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Target/Target.h"
+
+namespace
+{
+	TAutoConsoleVariable CVarAnalyticWeaponTrace(TEXT("bs_weapontrace.analytic"), 1,
+		TEXT("Intersect weapon traces with target bounding spheres before tracing the physics scene.\n")
+		TEXT("0: Disabled, 1: Enabled"));
+
+	/** How far in front of a target the occluder trace stops, so that it can't hit the target itself. */
+	constexpr double OccluderTraceTolerance = 0.1;
+}
+
+void FTargetSphereSet::Reset()
+{
+	CenterX.Reset();
+	CenterY.Reset();
+	CenterZ.Reset();
+	RadiusSquared.Reset();
+	NumSpheres = 0;
+}
+
+int32 FTargetSphereSet::Add(const FVector& Center, const float Radius)
+{
+	if (NumSpheres == CenterX.Num())
+	{
+		CenterX.AddZeroed(4);
+		CenterY.AddZeroed(4);
+		CenterZ.AddZeroed(4);
+		RadiusSquared.Add(-1.f, 4);
+	}
+	Set(NumSpheres, Center, Radius);
+	return NumSpheres++;
+}
+
+void FTargetSphereSet::Set(const int32 Index, const FVector& Center, const float Radius)
+{
+	CenterX[Index] = Center.X;
+	CenterY[Index] = Center.Y;
+	CenterZ[Index] = Center.Z;
+	RadiusSquared[Index] = Radius < 0.f ? -1.f : Radius * Radius;
+}
+
+void FTargetSphereSet::RemoveAtSwap(const int32 Index)
+{
+	check(Index >= 0 && Index < NumSpheres);
+	const int32 LastIndex = --NumSpheres;
+	CenterX[Index] = CenterX[LastIndex];
+	CenterY[Index] = CenterY[LastIndex];
+	CenterZ[Index] = CenterZ[LastIndex];
+	RadiusSquared[Index] = RadiusSquared[LastIndex];
+	RadiusSquared[LastIndex] = -1.f;
+}
+
+int32 FTargetSphereSet::Raycast(const FVector& Origin, const FVector& Direction, const double MaxDistance,
+	double& OutDistance, const TSet<int32>& IgnoredSpheres) const
+{
+	const VectorRegister4Float OriginX = VectorSetFloat1(Origin.X);
+	const VectorRegister4Float OriginY = VectorSetFloat1(Origin.Y);
+	const VectorRegister4Float OriginZ = VectorSetFloat1(Origin.Z);
+	const VectorRegister4Float DirectionX = VectorSetFloat1(Direction.X);
+	const VectorRegister4Float DirectionY = VectorSetFloat1(Direction.Y);
+	const VectorRegister4Float DirectionZ = VectorSetFloat1(Direction.Z);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+
+	int32 NearestIndex = INDEX_NONE;
+	float NearestDistance = MaxDistance;
+	VectorRegister4Float Nearest = VectorSetFloat1(NearestDistance);
+
+	for (int32 i = 0; i < CenterX.Num(); i += 4)
+	{
+		const VectorRegister4Float ToCenterX = VectorSubtract(VectorLoadAligned(&CenterX[i]), OriginX);
+		const VectorRegister4Float ToCenterY = VectorSubtract(VectorLoadAligned(&CenterY[i]), OriginY);
+		const VectorRegister4Float ToCenterZ = VectorSubtract(VectorLoadAligned(&CenterZ[i]), OriginZ);
+
+		// Distance along the ray to the point closest to the center
+		const VectorRegister4Float Closest = VectorMultiplyAdd(ToCenterZ, DirectionZ,
+			VectorMultiplyAdd(ToCenterY, DirectionY, VectorMultiply(ToCenterX, DirectionX)));
+		const VectorRegister4Float ToCenterSquared = VectorMultiplyAdd(ToCenterZ, ToCenterZ,
+			VectorMultiplyAdd(ToCenterY, ToCenterY, VectorMultiply(ToCenterX, ToCenterX)));
+
+		// Squared half length of the chord through the sphere, negative if the ray misses
+		const VectorRegister4Float HalfChordSquared = VectorSubtract(VectorMultiplyAdd(Closest, Closest,
+			VectorLoadAligned(&RadiusSquared[i])), ToCenterSquared);
+		const VectorRegister4Float HalfChord = VectorSqrt(VectorMax(HalfChordSquared, Zero));
+
+		// A ray that starts inside the sphere hits it at zero, a ray that starts past it doesn't hit it at all
+		const VectorRegister4Float Exit = VectorAdd(Closest, HalfChord);
+		const VectorRegister4Float Distance = VectorMax(VectorSubtract(Closest, HalfChord), Zero);
+
+		const VectorRegister4Float Hit = VectorBitwiseAnd(VectorCompareGE(HalfChordSquared, Zero),
+			VectorBitwiseAnd(VectorCompareGE(Exit, Zero), VectorCompareLE(Distance, Nearest)));
+		if (const int32 HitMask = VectorMaskBits(Hit))
+		{
+			alignas(16) float Distances[4];
+			VectorStoreAligned(Distance, Distances);
+			for (int32 Lane = 0; Lane < 4; Lane++)
+			{
+				if (HitMask & 1 << Lane && Distances[Lane] <= NearestDistance && !IgnoredSpheres.Contains(i + Lane))
+				{
+					NearestIndex = i + Lane;
+					NearestDistance = Distances[Lane];
+				}
+			}
+			Nearest = VectorSetFloat1(NearestDistance);
+		}
+	}
+
+	OutDistance = NearestDistance;
+	return NearestIndex;
+}
+
+void UTargetQuerySubsystem::RegisterTarget(ATarget* Target)
+{
+	if (!Target)
+	{
+		return;
+	}
+	if (const int32* ExistingIndex = EntryIndices.Find(Target->GetUniqueID()))
+	{
+		if (Entries[*ExistingIndex].Target == Target)
+		{
+			return;
+		}
+		// A destroyed target that was never unregistered had the same unique ID
+		RemoveTargetAt(*ExistingIndex);
+	}
+
+	const int32 Index = Entries.Add({Target, Target->GetUniqueID(), false});
+	Spheres.Add(FVector::ZeroVector, -1.f);
+	EntryIndices.Add(Target->GetUniqueID(), Index);
+	if (Target->CapsuleComponent)
+	{
+		Target->CapsuleComponent->TransformUpdated.AddUObject(this, &ThisClass::OnTargetTransformUpdated);
+	}
+	UpdateSphere(Index);
+}
+
+void UTargetQuerySubsystem::UnregisterTarget(ATarget* Target)
+{
+	const int32* Index = Target ? EntryIndices.Find(Target->GetUniqueID()) : nullptr;
+	if (!Index)
+	{
+		return;
+	}
+	if (Target->CapsuleComponent)
+	{
+		Target->CapsuleComponent->TransformUpdated.RemoveAll(this);
+	}
+	RemoveTargetAt(*Index);
+}
+
+void UTargetQuerySubsystem::UnregisterAllTargets()
+{
+	for (const FTargetQueryEntry& Entry : Entries)
+	{
+		if (const ATarget* Target = Entry.Target.Get(); Target && Target->CapsuleComponent)
+		{
+			Target->CapsuleComponent->TransformUpdated.RemoveAll(this);
+		}
+	}
+	Entries.Empty();
+	EntryIndices.Empty();
+	NumNonSphereTargets = 0;
+	Spheres.Reset();
+}
+
+void UTargetQuerySubsystem::UpdateTarget(const ATarget* Target)
+{
+	if (const int32* Index = Target ? EntryIndices.Find(Target->GetUniqueID()) : nullptr)
+	{
+		UpdateSphere(*Index);
+	}
+}
+
+bool UTargetQuerySubsystem::WeaponTrace(FHitResult& OutHit, const FVector& Start, const FVector& End,
+	const FCollisionQueryParams& Params)
+{
+	// Physics traces count against the per frame scene query budget
+	UBSSceneQuerySubsystem* SceneQuery = GetWorld()->GetSubsystem<UBSSceneQuerySubsystem>();
+	FVector Direction;
+	double Length;
+	(End - Start).ToDirectionAndLength(Direction, Length);
+	if (!CVarAnalyticWeaponTrace.GetValueOnGameThread() || Length <= OccluderTraceTolerance ||
+		NumNonSphereTargets > 0)
+	{
+		return SceneQuery->LineTrace(OutHit, Start, End, BS_TraceChannel_Weapon, Params);
+	}
+
+	// Usually only the weapon owner is ignored, so look up the ignored targets instead of checking every target
+	TSet<int32> IgnoredSpheres;
+	for (const uint32 ActorID : Params.GetIgnoredActors())
+	{
+		if (const int32* Index = EntryIndices.Find(ActorID))
+		{
+			IgnoredSpheres.Add(*Index);
+		}
+	}
+
+	double Distance;
+	int32 SphereIndex = Spheres.Raycast(Start, Direction, Length, Distance, IgnoredSpheres);
+	while (SphereIndex != INDEX_NONE && !Entries[SphereIndex].Target.IsValid())
+	{
+		// The target was destroyed without being unregistered
+		const int32 LastIndex = Entries.Num() - 1;
+		RemoveTargetAt(SphereIndex);
+		if (IgnoredSpheres.Remove(LastIndex))
+		{
+			IgnoredSpheres.Add(SphereIndex);
+		}
+		SphereIndex = Spheres.Raycast(Start, Direction, Length, Distance, IgnoredSpheres);
+	}
+	if (SphereIndex == INDEX_NONE)
+	{
+		// No target in the way, so only level geometry can be hit
+		return SceneQuery->LineTrace(OutHit, Start, End, BS_TraceChannel_Weapon, Params);
+	}
+
+	// Nothing can be in front of a target the trace starts inside of
+	if (Distance > OccluderTraceTolerance)
+	{
+		const FVector OccluderEnd = Start + Direction * (Distance - OccluderTraceTolerance);
+		if (SceneQuery->LineTrace(OutHit, Start, OccluderEnd, BS_TraceChannel_Weapon, Params))
+		{
+			OutHit.TraceEnd = End;
+			OutHit.Time = OutHit.Distance / Length;
+			return true;
+		}
+	}
+
+	MakeTargetHit(OutHit, SphereIndex, Start, End, Distance);
+	return true;
+}
+
+void UTargetQuerySubsystem::UpdateSphere(const int32 Index)
+{
+	FTargetQueryEntry& Entry = Entries[Index];
+	const ATarget* Target = Entry.Target.Get();
+	const UCapsuleComponent* Capsule = Target ? Target->CapsuleComponent : nullptr;
+	NumNonSphereTargets -= Entry.bNotSphere;
+	Entry.bNotSphere = false;
+	if (!Capsule || !Capsule->IsQueryCollisionEnabled() || Capsule->GetCollisionResponseToChannel(
+		BS_TraceChannel_Weapon) != ECR_Block)
+	{
+		Spheres.Set(Index, FVector::ZeroVector, -1.f);
+		return;
+	}
+
+	const float Radius = Capsule->GetScaledCapsuleRadius();
+	Entry.bNotSphere = !FMath::IsNearlyEqual(Capsule->GetScaledCapsuleHalfHeight(), Radius);
+	NumNonSphereTargets += Entry.bNotSphere;
+	Spheres.Set(Index, Capsule->GetComponentLocation(), Radius);
+}
+
+void UTargetQuerySubsystem::RemoveTargetAt(const int32 Index)
+{
+	NumNonSphereTargets -= Entries[Index].bNotSphere;
+	EntryIndices.Remove(Entries[Index].UniqueID);
+	const int32 LastIndex = Entries.Num() - 1;
+	if (Index != LastIndex)
+	{
+		EntryIndices.Add(Entries[LastIndex].UniqueID, Index);
+	}
+	Entries.RemoveAtSwap(Index);
+	Spheres.RemoveAtSwap(Index);
+}
+
+void UTargetQuerySubsystem::OnTargetTransformUpdated(USceneComponent* UpdatedComponent,
+	EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (const AActor* Owner = UpdatedComponent->GetOwner())
+	{
+		if (const int32* Index = EntryIndices.Find(Owner->GetUniqueID()))
+		{
+			UpdateSphere(*Index);
+		}
+	}
+}
+
+void UTargetQuerySubsystem::MakeTargetHit(FHitResult& OutHit, const int32 SphereIndex, const FVector& Start,
+	const FVector& End, const double Distance) const
+{
+	ATarget* Target = Entries[SphereIndex].Target.Get();
+	UCapsuleComponent* Capsule = Target->CapsuleComponent;
+	const FVector Direction = (End - Start).GetSafeNormal();
+	const FVector Location = Start + Direction * Distance;
+
+	// Line traces that start inside a shape report the opposite of the trace direction as the normal
+	const bool bStartPenetrating = Distance <= 0.0;
+	const FVector Normal = bStartPenetrating
+		? -Direction
+		: (Location - Capsule->GetComponentLocation()).GetSafeNormal();
+
+	OutHit = FHitResult(Target, Capsule, Location, Normal);
+	OutHit.bBlockingHit = true;
+	OutHit.bStartPenetrating = bStartPenetrating;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	OutHit.Distance = Distance;
+	OutHit.Time = Distance / FVector::Dist(Start, End);
+	OutHit.PhysMaterial = Capsule->BodyInstance.GetSimplePhysicalMaterial();
+}
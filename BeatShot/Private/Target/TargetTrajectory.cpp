@@ -0,0 +1,76 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "Target/TargetTrajectory.h"
+
+FTargetTrajectory::FTargetTrajectory(const double InStartTime, const FVector& InStartLocation,
+	const FVector& InVelocity, const FBox& InBounds) : StartTime(InStartTime), Velocity(InVelocity)
+{
+	// A box smaller than the target collapses to its center
+	const FVector Center = InBounds.GetCenter();
+	Bounds = FBox(InBounds.Min.ComponentMin(Center), InBounds.Max.ComponentMax(Center));
+	StartLocation = InStartLocation.BoundToBox(Bounds.Min, Bounds.Max);
+}
+
+FVector FTargetTrajectory::Evaluate(const double Time, FVector* OutVelocity) const
+{
+	const double ElapsedTime = Time - StartTime;
+	FVector Location;
+	FVector CurrentVelocity;
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		const double Length = Bounds.Max[Axis] - Bounds.Min[Axis];
+		// Axes without room to move keep their velocity, like a target pressed against a wall
+		if (Length <= UE_DOUBLE_KINDA_SMALL_NUMBER || Velocity[Axis] == 0.0)
+		{
+			Location[Axis] = StartLocation[Axis];
+			CurrentVelocity[Axis] = Velocity[Axis];
+			continue;
+		}
+
+		// Unfold the reflections into a line with period 2 * Length, then fold the position back into the box
+		const double Unfolded = StartLocation[Axis] - Bounds.Min[Axis] + Velocity[Axis] * ElapsedTime;
+		double Folded = FMath::Fmod(Unfolded, 2.0 * Length);
+		if (Folded < 0.0)
+		{
+			Folded += 2.0 * Length;
+		}
+		const bool bReflected = Folded > Length;
+		Location[Axis] = Bounds.Min[Axis] + (bReflected ? 2.0 * Length - Folded : Folded);
+		CurrentVelocity[Axis] = bReflected ? -Velocity[Axis] : Velocity[Axis];
+	}
+
+	if (OutVelocity)
+	{
+		*OutVelocity = CurrentVelocity;
+	}
+	return Location;
+}
+
+double FTargetTrajectory::GetNextReflectionTime(const double AfterTime, FVector& OutNormal) const
+{
+	double NextTime = MAX_dbl;
+	OutNormal = FVector::ZeroVector;
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		const double Length = Bounds.Max[Axis] - Bounds.Min[Axis];
+		if (Length <= UE_DOUBLE_KINDA_SMALL_NUMBER || Velocity[Axis] == 0.0)
+		{
+			continue;
+		}
+
+		// Reflections happen where the unfolded line crosses a multiple of Length, odd multiples being the max face
+		const double StartUnfolded = StartLocation[Axis] - Bounds.Min[Axis];
+		const double Unfolded = StartUnfolded + Velocity[Axis] * (AfterTime - StartTime);
+		const double Face = Velocity[Axis] > 0.0
+			? FMath::FloorToDouble(Unfolded / Length) + 1.0
+			: FMath::CeilToDouble(Unfolded / Length) - 1.0;
+		const double Time = StartTime + (Face * Length - StartUnfolded) / Velocity[Axis];
+		if (Time < NextTime)
+		{
+			NextTime = Time;
+			OutNormal = FVector::ZeroVector;
+			OutNormal[Axis] = FMath::Fmod(FMath::Abs(Face), 2.0) == 1.0 ? -1.0 : 1.0;
+		}
+	}
+	return NextTime;
+}
@@ -173,6 +173,18 @@ void ABeamVisualizer::UpdateVisualizer(const int32 Index, const float SpectrumAl
 	}
 }
 
+bool ABeamVisualizer::IsVisualizerVisible() const
+{
+	for (const TObjectPtr<ASimpleBeamLight>& Light : BeamLights)
+	{
+		if (Light && Light->WasRecentlyRendered())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 void ABeamVisualizer::DeactivateVisualizers()
 {
 	for (const TObjectPtr<ASimpleBeamLight>& Light : GetSimpleBeamLights())
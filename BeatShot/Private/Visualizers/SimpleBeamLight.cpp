@@ -9,6 +9,8 @@
 #include "Components/SceneComponent.h"
 #include "Components/SpotLightComponent.h"
 #include "Components/TimelineComponent.h"
+#include "Curves/CurveVector.h"
+#include "Engine/World.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Materials/MaterialInterface.h"
 
@@ -54,6 +56,20 @@ void ASimpleBeamLight::BeginPlay()
 	Super::BeginPlay();
 }
 
+void ASimpleBeamLight::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (RootTransformUpdatedHandle.IsValid())
+	{
+		SpotlightBase->TransformUpdated.Remove(RootTransformUpdatedHandle);
+		RootTransformUpdatedHandle.Reset();
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	LevelAddedHandle.Reset();
+	LevelRemovedHandle.Reset();
+	Super::EndPlay(EndPlayReason);
+}
+
 void ASimpleBeamLight::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -104,6 +120,19 @@ void ASimpleBeamLight::InitSimpleBeamLight(const FSimpleBeamLightConfig& InConfi
 		EmissiveLightBulb->SetVectorParameterValue(TEXT("Color"), SimpleBeamLightConfig.LightColor);
 	}
 
+	InvalidateTraceCache();
+	if (!RootTransformUpdatedHandle.IsValid())
+	{
+		RootTransformUpdatedHandle = SpotlightBase->TransformUpdated.AddUObject(this,
+			&ASimpleBeamLight::OnRootTransformUpdated);
+	}
+	if (!LevelAddedHandle.IsValid())
+	{
+		LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ASimpleBeamLight::OnLevelsChanged);
+		LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this,
+			&ASimpleBeamLight::OnLevelsChanged);
+	}
+
 	FHitResult Hit;
 	LineTraceFromSpotlightHead(SpotlightHead->GetForwardVector(), Hit);
 	LightPositionComponent->SetWorldLocation(Hit.Location);
@@ -119,6 +148,14 @@ void ASimpleBeamLight::InitSimpleBeamLight(const FSimpleBeamLightConfig& InConfi
 	{
 		TimelineVectorDelegate.BindUFunction(this, FName("LightMovementCurveCallback"));
 		LightPositionTimeline.AddInterpVector(SimpleBeamLightConfig.LightMovementCurve, TimelineVectorDelegate);
+		if (SimpleBeamLightConfig.LightMovementCurve)
+		{
+			SimpleBeamLightConfig.LightMovementCurve->GetTimeRange(TraceCacheMinTime, TraceCacheMaxTime);
+		}
+		if (SimpleBeamLightConfig.bCacheLineTraces && SimpleBeamLightConfig.bPrecomputeTraceCache)
+		{
+			PrecomputeTraceCache();
+		}
 	}
 }
 
@@ -163,6 +200,9 @@ void ASimpleBeamLight::DeactivateLightComponents()
 		LightPositionTimeline.Stop();
 	}
 
+	// Discard any traces that are still in flight so they don't turn the light back on
+	MinBeamTraceSerial = BeamTraceSerial;
+
 	if (EmissiveLightBulb)
 	{
 		EmissiveLightBulb->SetScalarParameterValue(TEXT("Intensity"), 0.f);
@@ -207,6 +247,163 @@ void ASimpleBeamLight::LineTraceFromSpotlightHead(const FVector& EndLocation, FH
 		EndLocation * FVector(999999999), ECC_Camera, FCollisionQueryParams::DefaultQueryParam);
 }
 
+void ASimpleBeamLight::SubmitTraceFromSpotlightHead(const FVector& EndLocation, const int32 LatencyTolerance,
+	FBSSceneQueryDelegate&& Delegate)
+{
+	FBSSceneQuery Query;
+	Query.Start = SpotlightHead->GetComponentLocation();
+	Query.End = EndLocation * FVector(999999999);
+	Query.Channel = ECC_Camera;
+	Query.Params = FCollisionQueryParams::DefaultQueryParam;
+	Query.LatencyTolerance = LatencyTolerance;
+
+	const FBeamLightTraceKey Key = GetTraceCacheKey(Query.Start, Query.End);
+	GetWorld()->GetSubsystem<UBSSceneQuerySubsystem>()->Submit(Query, FBSSceneQueryDelegate::CreateWeakLambda(this,
+		[this, Key, Generation = TraceCacheGeneration, Delegate = MoveTemp(Delegate)](const FHitResult& Hit)
+		{
+			if (Generation == TraceCacheGeneration)
+			{
+				CacheTrace(Key, Hit);
+			}
+			Delegate.ExecuteIfBound(Hit);
+		}));
+}
+
+bool ASimpleBeamLight::FindCachedTrace(const FVector& EndLocation, FHitResult& OutHitResult) const
+{
+	if (!SimpleBeamLightConfig.bCacheLineTraces)
+	{
+		return false;
+	}
+
+	const FVector Start = SpotlightHead->GetComponentLocation();
+	const FVector End = EndLocation * FVector(999999999);
+	const FBeamLightTraceCacheEntry* Found = TraceCache.Find(GetTraceCacheKey(Start, End));
+	if (!Found || IsTraceExpired(Found->Frame))
+	{
+		return false;
+	}
+
+	OutHitResult = Found->HitResult;
+	if (!OutHitResult.bBlockingHit)
+	{
+		return true;
+	}
+
+	// Intersect the exact beam with the cached hit plane so the quantization of the key isn't visible
+	const FVector Direction = (End - Start).GetSafeNormal();
+	const double Denominator = Direction.Dot(OutHitResult.ImpactNormal);
+	if (FMath::IsNearlyZero(Denominator))
+	{
+		return true;
+	}
+	const double Distance = (OutHitResult.ImpactPoint - Start).Dot(OutHitResult.ImpactNormal) / Denominator;
+	if (Distance > 0.0)
+	{
+		OutHitResult.TraceStart = Start;
+		OutHitResult.TraceEnd = End;
+		OutHitResult.Location = Start + Direction * Distance;
+		OutHitResult.ImpactPoint = OutHitResult.Location;
+		OutHitResult.Distance = static_cast<float>(Distance);
+	}
+	return true;
+}
+
+void ASimpleBeamLight::CacheTrace(const FBeamLightTraceKey& Key, const FHitResult& HitResult)
+{
+	if (!SimpleBeamLightConfig.bCacheLineTraces)
+	{
+		return;
+	}
+
+	// Only static geometry can be safely cached
+	const UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+	if (HitComponent && HitComponent->Mobility != EComponentMobility::Static)
+	{
+		TraceCache.Remove(Key);
+		return;
+	}
+
+	const int32 MaxNumTraces = FMath::Clamp(SimpleBeamLightConfig.NumCachedTraces, 2, MaxNumCachedBeamLightTraces);
+	if (TraceCache.Num() >= MaxNumTraces && !TraceCache.Contains(Key))
+	{
+		RemoveExpiredTraces();
+		if (TraceCache.Num() >= MaxNumTraces)
+		{
+			return;
+		}
+	}
+	TraceCache.Add(Key, FBeamLightTraceCacheEntry{HitResult, GFrameCounter});
+}
+
+void ASimpleBeamLight::RemoveExpiredTraces()
+{
+	for (auto It = TraceCache.CreateIterator(); It; ++It)
+	{
+		if (IsTraceExpired(It.Value().Frame))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void ASimpleBeamLight::PrecomputeTraceCache()
+{
+	if (!SimpleBeamLightConfig.LightMovementCurve)
+	{
+		return;
+	}
+
+	const FVector Start = SpotlightHead->GetComponentLocation();
+	const int32 NumTraces = FMath::Clamp(SimpleBeamLightConfig.NumCachedTraces, 2, MaxNumCachedBeamLightTraces);
+	for (int i = 0; i < NumTraces; i++)
+	{
+		const float Time = FMath::Lerp(TraceCacheMinTime, TraceCacheMaxTime,
+			static_cast<float>(i) / static_cast<float>(NumTraces - 1));
+		const FVector EndLocation = SimpleBeamLightConfig.LightMovementCurve->GetVectorValue(Time);
+		const FBeamLightTraceCacheEntry* Found = TraceCache.Find(GetTraceCacheKey(Start,
+			EndLocation * FVector(999999999)));
+		if (!Found || IsTraceExpired(Found->Frame))
+		{
+			SubmitTraceFromSpotlightHead(EndLocation, -1, FBSSceneQueryDelegate());
+		}
+	}
+}
+
+FBeamLightTraceKey ASimpleBeamLight::GetTraceCacheKey(const FVector& Start, const FVector& End)
+{
+	const FVector Direction = (End - Start).GetSafeNormal() / BeamLightTraceCacheDirectionTolerance;
+	return FBeamLightTraceKey{
+		FIntVector(FMath::RoundToInt(Start.X), FMath::RoundToInt(Start.Y), FMath::RoundToInt(Start.Z)),
+		FIntVector(FMath::RoundToInt(Direction.X), FMath::RoundToInt(Direction.Y), FMath::RoundToInt(Direction.Z))
+	};
+}
+
+bool ASimpleBeamLight::IsTraceExpired(const uint64 Frame)
+{
+	return GFrameCounter - Frame > static_cast<uint64>(BeamLightTraceCacheLifetimeFrames);
+}
+
+void ASimpleBeamLight::InvalidateTraceCache()
+{
+	TraceCache.Empty();
+	TraceCacheGeneration++;
+}
+
+void ASimpleBeamLight::OnRootTransformUpdated(USceneComponent* UpdatedComponent,
+	EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	InvalidateTraceCache();
+}
+
+void ASimpleBeamLight::OnLevelsChanged(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		InvalidateTraceCache();
+	}
+}
+
 void ASimpleBeamLight::UpdateBeamEndLightTransform(const FHitResult& HitResult) const
 {
 	BeamEndLight->SetWorldLocation(HitResult.Location + SpotlightHead->GetComponentRotation().Vector() * 5);
@@ -249,7 +446,6 @@ void ASimpleBeamLight::UpdateNiagaraBeamLength(const float HitResultDistance)
 
 void ASimpleBeamLight::LightMovementCurveCallback(const FVector& Position)
 {
-	FHitResult Hit;
 	float PlaybackPosition;
 
 	if (LightPositionTimeline.IsReversing())
@@ -261,7 +457,28 @@ void ASimpleBeamLight::LightMovementCurveCallback(const FVector& Position)
 		PlaybackPosition = 1 - LightPositionTimeline.GetPlaybackPosition();
 	}
 
-	LineTraceFromSpotlightHead(Position, Hit);
+	FHitResult Hit;
+	if (FindCachedTrace(Position, Hit))
+	{
+		UpdateMovingBeam(Hit, PlaybackPosition);
+		return;
+	}
+
+	// The beam catches up with the trace once it completes in a later frame
+	const uint32 Serial = BeamTraceSerial++;
+	SubmitTraceFromSpotlightHead(Position, BeamLightTraceLatencyTolerance,
+		FBSSceneQueryDelegate::CreateWeakLambda(this, [this, Serial, PlaybackPosition](const FHitResult& TraceHit)
+		{
+			if (Serial >= MinBeamTraceSerial)
+			{
+				MinBeamTraceSerial = Serial + 1;
+				UpdateMovingBeam(TraceHit, PlaybackPosition);
+			}
+		}));
+}
+
+void ASimpleBeamLight::UpdateMovingBeam(const FHitResult& Hit, const float PlaybackPosition)
+{
 	LightPositionComponent->SetWorldLocation(Hit.Location);
 	UpdateSpotlightHeadAndLimbRotation(Hit.Location, SpotlightHead->GetComponentLocation());
 
@@ -5,7 +5,7 @@
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 
-AStaticCubeVisualizer::AStaticCubeVisualizer()
+AStaticCubeVisualizer::AStaticCubeVisualizer(): DirtyStartIndex(INDEX_NONE), DirtyEndIndex(INDEX_NONE)
 {
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = false;
@@ -18,7 +18,6 @@ AStaticCubeVisualizer::AStaticCubeVisualizer()
 	InstancedBaseMesh->SetupAttachment(RootSceneComponent);
 	InstancedVerticalOutlineMesh->SetupAttachment(RootSceneComponent);
 	InstancedTopMesh->SetupAttachment(RootSceneComponent);
-	IndexTransformMap = TMap<int32, FTransform>();
 }
 
 void AStaticCubeVisualizer::InitializeVisualizer(const FPlayerSettings_AudioAnalyzer& InAASettings)
@@ -31,9 +30,7 @@ void AStaticCubeVisualizer::CreateCubeInstances()
 {
 	CubeVisualizerDefinition = GetVisualizerDefinition();
 
-	InstancedBaseMesh->ClearInstances();
-	InstancedVerticalOutlineMesh->ClearInstances();
-	InstancedTopMesh->ClearInstances();
+	ClearCubeInstances();
 
 	TArray<FTransform> SpawnTransforms;
 
@@ -78,10 +75,13 @@ void AStaticCubeVisualizer::CreateCubeInstances()
 	case EVisualizerLightSpawningMethod::AddExistingLightsFromLevel:
 		return;
 	}
-	IndexTransformMap.Empty();
+	InstanceSpawnTransforms = SpawnTransforms;
+	PendingSideAndBaseTransforms = SpawnTransforms;
+	PendingTopTransforms = SpawnTransforms;
+	PendingCustomData.Init(0.f, SpawnTransforms.Num());
+	LastSpectrumAlpha.Init(-1.f, SpawnTransforms.Num());
 	for (int i = 0; i < SpawnTransforms.Num(); i++)
 	{
-		IndexTransformMap.Add(i, SpawnTransforms[i]);
 		AddInstancedCubeMesh(SpawnTransforms[i]);
 	}
 }
@@ -92,27 +92,103 @@ void AStaticCubeVisualizer::UpdateVisualizer(const int32 Index, const float Spec
 	{
 		return;
 	}
+	const float ScaledHeight = GetScaledHeight(SpectrumAlpha);
+	const float CustomDataValue = (ScaledHeight - GetFastDef().MinCubeVisualizerHeightScale) / (GetFastDef().
+		MaxCubeVisualizerHeightScale - GetFastDef().MinCubeVisualizerHeightScale);
+
 	for (const int32 LightIndex : GetLightIndices(Index))
 	{
-		const float CustomDataValue = (GetScaledHeight(SpectrumAlpha) - GetFastDef().MinCubeVisualizerHeightScale) / (
-			GetFastDef().MaxCubeVisualizerHeightScale - GetFastDef().MinCubeVisualizerHeightScale);
+		if (!LastSpectrumAlpha.IsValidIndex(LightIndex) || FMath::IsNearlyEqual(LastSpectrumAlpha[LightIndex],
+			SpectrumAlpha, Constants::CubeVisualizerUpdateTolerance))
+		{
+			continue;
+		}
+		LastSpectrumAlpha[LightIndex] = SpectrumAlpha;
+		PendingSideAndBaseTransforms[LightIndex] = GetSideAndBaseTransform(LightIndex, ScaledHeight);
+		PendingTopTransforms[LightIndex] = GetTopMeshTransform(LightIndex, ScaledHeight);
+		PendingCustomData[LightIndex] = CustomDataValue;
+		MarkInstanceDirty(LightIndex);
+	}
+}
+
+void AStaticCubeVisualizer::SubmitPendingUpdates()
+{
+	if (DirtyStartIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const TArray<FTransform>& DirtySideAndBaseTransforms = GetDirtyTransforms(PendingSideAndBaseTransforms);
+	SubmitInstanceRange(InstancedBaseMesh, DirtySideAndBaseTransforms);
+	SubmitInstanceRange(InstancedVerticalOutlineMesh, DirtySideAndBaseTransforms);
+	SubmitInstanceRange(InstancedTopMesh, GetDirtyTransforms(PendingTopTransforms));
+
+	DirtyStartIndex = INDEX_NONE;
+	DirtyEndIndex = INDEX_NONE;
+}
+
+void AStaticCubeVisualizer::SubmitInstanceRange(UInstancedStaticMeshComponent* InstancedMesh,
+	const TArray<FTransform>& DirtyTransforms) const
+{
+	if (!ensureMsgf(InstancedMesh->GetInstanceCount() > DirtyEndIndex,
+		TEXT("%s has %d instances, but instance %d was updated"), *InstancedMesh->GetName(),
+		InstancedMesh->GetInstanceCount(), DirtyEndIndex))
+	{
+		return;
+	}
 
-		InstancedBaseMesh->UpdateInstanceTransform(LightIndex, GetSideAndBaseTransform(LightIndex, SpectrumAlpha));
-		InstancedVerticalOutlineMesh->UpdateInstanceTransform(LightIndex,
-			GetSideAndBaseTransform(LightIndex, SpectrumAlpha));
-		InstancedTopMesh->UpdateInstanceTransform(LightIndex, GetTopMeshTransform(LightIndex, SpectrumAlpha));
+	// Neither update marks the render state dirty, so it is only marked dirty once per submit
+	InstancedMesh->BatchUpdateInstancesTransforms(DirtyStartIndex, DirtyTransforms, false, false, false);
+	if (InstancedMesh->NumCustomDataFloats > 0)
+	{
+		for (int i = DirtyStartIndex; i <= DirtyEndIndex; i++)
+		{
+			InstancedMesh->SetCustomDataValue(i, 0, PendingCustomData[i], false);
+		}
+	}
+	InstancedMesh->MarkRenderStateDirty();
+}
 
-		InstancedBaseMesh->SetCustomDataValue(LightIndex, 0, CustomDataValue, false);
-		InstancedVerticalOutlineMesh->SetCustomDataValue(LightIndex, 0, CustomDataValue, false);
-		InstancedTopMesh->SetCustomDataValue(LightIndex, 0, CustomDataValue, false);
+const TArray<FTransform>& AStaticCubeVisualizer::GetDirtyTransforms(const TArray<FTransform>& Transforms)
+{
+	// The whole array is dirty most frames, so it can be submitted without a copy
+	const int32 NumDirty = DirtyEndIndex - DirtyStartIndex + 1;
+	if (NumDirty == Transforms.Num())
+	{
+		return Transforms;
 	}
+
+	// BatchUpdateInstancesTransforms takes an array, so partial ranges go through a buffer that keeps its allocation
+	DirtyTransformsBuffer.Reset(NumDirty);
+	DirtyTransformsBuffer.Append(Transforms.GetData() + DirtyStartIndex, NumDirty);
+	return DirtyTransformsBuffer;
 }
 
-void AStaticCubeVisualizer::MarkRenderStateDirty()
+void AStaticCubeVisualizer::MarkInstanceDirty(const int32 Index)
 {
-	InstancedBaseMesh->MarkRenderStateDirty();
-	InstancedVerticalOutlineMesh->MarkRenderStateDirty();
-	InstancedTopMesh->MarkRenderStateDirty();
+	if (DirtyStartIndex == INDEX_NONE)
+	{
+		DirtyStartIndex = Index;
+		DirtyEndIndex = Index;
+		return;
+	}
+	DirtyStartIndex = FMath::Min(DirtyStartIndex, Index);
+	DirtyEndIndex = FMath::Max(DirtyEndIndex, Index);
+}
+
+void AStaticCubeVisualizer::ClearCubeInstances()
+{
+	InstancedBaseMesh->ClearInstances();
+	InstancedVerticalOutlineMesh->ClearInstances();
+	InstancedTopMesh->ClearInstances();
+	InstanceSpawnTransforms.Empty();
+	PendingSideAndBaseTransforms.Empty();
+	PendingTopTransforms.Empty();
+	PendingCustomData.Empty();
+	DirtyTransformsBuffer.Empty();
+	LastSpectrumAlpha.Empty();
+	DirtyStartIndex = INDEX_NONE;
+	DirtyEndIndex = INDEX_NONE;
 }
 
 void AStaticCubeVisualizer::SetActivationState(const bool bActivate)
@@ -120,17 +196,14 @@ void AStaticCubeVisualizer::SetActivationState(const bool bActivate)
 	Super::SetActivationState(bActivate);
 	if (bActivate)
 	{
-		if (IndexTransformMap.IsEmpty())
+		if (InstanceSpawnTransforms.IsEmpty())
 		{
 			CreateCubeInstances();
 		}
 	}
 	else
 	{
-		InstancedBaseMesh->ClearInstances();
-		InstancedVerticalOutlineMesh->ClearInstances();
-		InstancedTopMesh->ClearInstances();
-		IndexTransformMap.Empty();
+		ClearCubeInstances();
 	}
 }
 
@@ -147,18 +220,17 @@ FVector AStaticCubeVisualizer::GetScale3D(const float ScaledHeight)
 		GetFastDef().MeshScale.Z * GetFastDef().OffsetScale.Z * ScaledHeight);
 }
 
-FTransform AStaticCubeVisualizer::GetTopMeshTransform(const int32 Index, const float SpectrumValue)
+FTransform AStaticCubeVisualizer::GetTopMeshTransform(const int32 Index, const float ScaledHeight)
 {
-	const FTransform* Found = IndexTransformMap.Find(Index);
-	return FTransform(Found->GetRotation(),
-		Found->GetLocation() + FVector(0, 0, GetFastDef().CubeHeight * (GetScaledHeight(SpectrumValue) - 1)),
-		GetScale3D(1.f));
+	const FTransform& SpawnTransform = InstanceSpawnTransforms[Index];
+	return FTransform(SpawnTransform.GetRotation(),
+		SpawnTransform.GetLocation() + FVector(0, 0, GetFastDef().CubeHeight * (ScaledHeight - 1)), GetScale3D(1.f));
 }
 
-FTransform AStaticCubeVisualizer::GetSideAndBaseTransform(const int32 Index, const float SpectrumValue)
+FTransform AStaticCubeVisualizer::GetSideAndBaseTransform(const int32 Index, const float ScaledHeight)
 {
-	const FTransform* Found = IndexTransformMap.Find(Index);
-	return FTransform(Found->GetRotation(), Found->GetLocation(), GetScale3D(GetScaledHeight(SpectrumValue)));
+	const FTransform& SpawnTransform = InstanceSpawnTransforms[Index];
+	return FTransform(SpawnTransform.GetRotation(), SpawnTransform.GetLocation(), GetScale3D(ScaledHeight));
 }
 
 void AStaticCubeVisualizer::AddInstancedCubeMesh(const FTransform& RelativeTransform)
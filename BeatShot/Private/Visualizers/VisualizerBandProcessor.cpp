@@ -0,0 +1,101 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "Visualizers/VisualizerBandProcessor.h"
+
+namespace
+{
+	/** Vectorized equivalent of UKismetMathLibrary::MapRangeClamped(Value, 0, Range, 0, 1), including its handling
+	 *  of a nearly zero range. */
+	FORCEINLINE VectorRegister4Float NormalizeClamped(const VectorRegister4Float& Value,
+		const VectorRegister4Float& Range)
+	{
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float NearlyZeroRange = VectorCompareLE(VectorAbs(Range),
+			VectorSetFloat1(UE_SMALL_NUMBER));
+		const VectorRegister4Float DegenerateValue = VectorSelect(VectorCompareGE(Value, Range), One, Zero);
+		const VectorRegister4Float Pct = VectorSelect(NearlyZeroRange, DegenerateValue, VectorDivide(Value, Range));
+		return VectorMin(VectorMax(Pct, Zero), One);
+	}
+}
+
+FVisualizerBandProcessor::FVisualizerBandProcessor()
+{
+	Init(0);
+}
+
+void FVisualizerBandProcessor::Init(const int32 InNumBands)
+{
+	NumBands = FMath::Clamp(InNumBands, 0, MaxNumBands);
+	NumVectors = FMath::DivideAndRoundUp(NumBands, 4);
+	BeamTriggeredMask = 0;
+
+	for (int i = 0; i < MaxNumBands; i++)
+	{
+		InputValues[i] = 0.f;
+		AvgValues[i] = 0.f;
+		CurrentSpectrumValues[i] = 0.f;
+		CurrentCubeSpectrumValues[i] = 0.f;
+		MaxSpectrumValues[i] = 1.f;
+		BeamAlpha[i] = 0.f;
+		CubeAlpha[i] = 0.f;
+	}
+}
+
+void FVisualizerBandProcessor::Process(const TArray<float>& SpectrumValues, const TArray<float>& AvgSpectrumValues)
+{
+	CopyToAligned(SpectrumValues, InputValues);
+	CopyToAligned(AvgSpectrumValues, AvgValues);
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float CurrentDivide = VectorSetFloat1(Constants::CurrentSpectrumValueDecrementDivide);
+	const VectorRegister4Float CubeDecrement = VectorSetFloat1(Constants::CurrentCubeSpectrumValueDecrement);
+	const VectorRegister4Float MaxDivide = VectorSetFloat1(Constants::MaxSpectrumValueDecrementDivide);
+
+	uint32 NewBeamTriggeredMask = 0;
+
+	for (int i = 0; i < NumVectors; i++)
+	{
+		const int32 Offset = i * 4;
+		const VectorRegister4Float Input = VectorLoadAligned(InputValues + Offset);
+		const VectorRegister4Float Avg = VectorLoadAligned(AvgValues + Offset);
+		VectorRegister4Float Current = VectorLoadAligned(CurrentSpectrumValues + Offset);
+		VectorRegister4Float Cube = VectorLoadAligned(CurrentCubeSpectrumValues + Offset);
+		VectorRegister4Float Max = VectorLoadAligned(MaxSpectrumValues + Offset);
+
+		// Peak hold
+		Max = VectorMax(Max, Input);
+		Cube = VectorMax(Cube, Input);
+
+		// A beam is only started once the previous one has fully decayed
+		const VectorRegister4Float Triggered = VectorBitwiseAnd(VectorCompareGT(Input, Zero),
+			VectorCompareLT(Current, Zero));
+		Current = VectorSelect(Triggered, Input, Current);
+
+		// Normalization
+		VectorStoreAligned(NormalizeClamped(Current, Max), BeamAlpha + Offset);
+		VectorStoreAligned(NormalizeClamped(VectorSubtract(Cube, Avg), Max), CubeAlpha + Offset);
+
+		// Decay
+		Current = VectorSelect(VectorCompareGE(Current, Zero),
+			VectorSubtract(Current, VectorDivide(Avg, CurrentDivide)), Current);
+		Cube = VectorSelect(VectorCompareGE(Cube, Zero), VectorSubtract(Cube, CubeDecrement), Cube);
+		Max = VectorSelect(VectorCompareGE(Max, Zero), VectorSubtract(Max, VectorDivide(Avg, MaxDivide)), Max);
+
+		VectorStoreAligned(Current, CurrentSpectrumValues + Offset);
+		VectorStoreAligned(Cube, CurrentCubeSpectrumValues + Offset);
+		VectorStoreAligned(Max, MaxSpectrumValues + Offset);
+
+		NewBeamTriggeredMask |= static_cast<uint32>(VectorMaskBits(Triggered)) << Offset;
+	}
+
+	BeamTriggeredMask = NumBands < 32 ? NewBeamTriggeredMask & ((1u << NumBands) - 1) : NewBeamTriggeredMask;
+}
+
+void FVisualizerBandProcessor::CopyToAligned(const TArray<float>& Source, float* Dest) const
+{
+	const int32 NumToCopy = FMath::Min(Source.Num(), NumBands);
+	FMemory::Memcpy(Dest, Source.GetData(), NumToCopy * sizeof(float));
+	FMemory::Memzero(Dest + NumToCopy, (MaxNumBands - NumToCopy) * sizeof(float));
+}
@@ -39,6 +39,20 @@ void AVisualizerBase::SetActivationState(const bool bActivate)
 	bIsActivated = bActivate;
 }
 
+bool AVisualizerBase::IsVisualizerVisible() const
+{
+	return WasRecentlyRendered();
+}
+
+float AVisualizerBase::GetUpdateCost() const
+{
+	if (const UBSVisualizerDefinition* Definition = GetVisualizerDefinition())
+	{
+		return Definition->UpdateCost;
+	}
+	return DefaultVisualizerUpdateCost;
+}
+
 void AVisualizerBase::UpdateAASettings(const FPlayerSettings_AudioAnalyzer& InAASettings)
 {
 	InitializeVisualizer(InAASettings);
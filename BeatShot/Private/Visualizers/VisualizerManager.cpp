@@ -2,13 +2,16 @@
 
 
 #include "Visualizers/VisualizerManager.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
 #include "SaveGames/SaveGamePlayerSettings.h"
 #include "Visualizers/BeamVisualizer.h"
 #include "Visualizers/StaticCubeVisualizer.h"
 #include "Visualizers/VisualizerBase.h"
 
-AVisualizerManager::AVisualizerManager(): bUpdateBeamVisualizers(false), bUpdateCubeVisualizers(false)
+AVisualizerManager::AVisualizerManager(): bUpdateBeamVisualizers(false), bUpdateCubeVisualizers(false),
+	UpdateBudget(DefaultVisualizerUpdateBudget), MaxFramesBetweenUpdates(DefaultMaxFramesBetweenVisualizerUpdates),
+	LODDistance(DefaultVisualizerLODDistance)
 {
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = false;
@@ -18,9 +21,7 @@ void AVisualizerManager::InitializeVisualizers(const FPlayerSettings_Game& Playe
 	const FPlayerSettings_AudioAnalyzer& InAASettings)
 {
 	AvgSpectrumValues.Init(0, InAASettings.NumBandChannels);
-	CurrentSpectrumValues.Init(0, InAASettings.NumBandChannels);
-	MaxSpectrumValues.Init(1.f, InAASettings.NumBandChannels);
-	CurrentCubeSpectrumValues.Init(0, InAASettings.NumBandChannels);
+	BandProcessor.Init(InAASettings.NumBandChannels);
 
 	/* Initialize visualizers already placed in level that may or not have spawned lights already */
 	for (const TSoftObjectPtr<AVisualizerBase>& Visualizer : LevelVisualizers)
@@ -74,77 +75,211 @@ void AVisualizerManager::InitializeVisualizers(const FPlayerSettings_Game& Playe
 	UpdateVisualizerSettings(PlayerSettings);
 }
 
-float AVisualizerManager::GetNormalizedSpectrumValue(const int32 Index, const bool bIsBeam)
+void AVisualizerManager::UpdateVisualizers(const TArray<float>& SpectrumValues)
 {
-	if (bIsBeam)
+	if (!bUpdateCubeVisualizers && !bUpdateBeamVisualizers)
 	{
-		return UKismetMathLibrary::MapRangeClamped(CurrentSpectrumValues[Index], 0, MaxSpectrumValues[Index], 0, 1);
+		return;
+	}
+
+	BandProcessor.Process(SpectrumValues, AvgSpectrumValues);
+
+	const int32 NumBands = FMath::Min(SpectrumValues.Num(), BandProcessor.GetNumBands());
+	for (FVisualizerUpdateState& State : UpdateStates)
+	{
+		AccumulatePendingBandValues(State, NumBands);
+	}
+
+	ScheduleVisualizerUpdates();
+
+	for (FVisualizerUpdateState& State : UpdateStates)
+	{
+		if (State.bScheduled)
+		{
+			UpdateVisualizer(State, NumBands);
+		}
+		else if (HasPendingUpdate(State))
+		{
+			State.FramesSinceUpdate++;
+		}
 	}
-	return UKismetMathLibrary::MapRangeClamped(CurrentCubeSpectrumValues[Index] - AvgSpectrumValues[Index], 0,
-		MaxSpectrumValues[Index], 0, 1);
 }
 
-void AVisualizerManager::UpdateVisualizers(const TArray<float>& SpectrumValues)
+void AVisualizerManager::ResetUpdateStates(const int32 NumBands)
 {
-	if (!bUpdateCubeVisualizers && !bUpdateBeamVisualizers)
+	for (FVisualizerUpdateState& State : UpdateStates)
 	{
+		State.bScheduled = false;
+		State.bHasPendingCubeAlpha = false;
+		State.FramesSinceUpdate = 0;
+		State.PendingBeamTriggeredMask = 0;
+		State.PendingBeamAlpha.Init(0.f, NumBands);
+		State.PendingCubeAlpha.Init(0.f, NumBands);
+	}
+}
+
+bool AVisualizerManager::HasPendingUpdate(const FVisualizerUpdateState& State) const
+{
+	const AVisualizerBase* Visualizer = State.Visualizer.Get();
+	if (!Visualizer || !Visualizer->IsActivated())
+	{
+		return false;
+	}
+	if (State.bIsBeam)
+	{
+		return bUpdateBeamVisualizers && State.PendingBeamTriggeredMask != 0;
+	}
+	return bUpdateCubeVisualizers && State.bHasPendingCubeAlpha;
+}
+
+void AVisualizerManager::AccumulatePendingBandValues(FVisualizerUpdateState& State, const int32 NumBands) const
+{
+	const AVisualizerBase* Visualizer = State.Visualizer.Get();
+	if (!Visualizer || !Visualizer->IsActivated())
+	{
+		State.PendingBeamTriggeredMask = 0;
+		State.bHasPendingCubeAlpha = false;
+		State.FramesSinceUpdate = 0;
 		return;
 	}
 
-	for (int i = 0; i < SpectrumValues.Num(); i++)
+	if (State.bIsBeam)
 	{
-		if (SpectrumValues[i] > MaxSpectrumValues[i])
-		{
-			MaxSpectrumValues[i] = SpectrumValues[i];
-		}
-		if (SpectrumValues[i] > CurrentCubeSpectrumValues[i])
+		const uint32 TriggeredMask = BandProcessor.GetBeamTriggeredMask();
+		for (int i = 0; i < NumBands; i++)
 		{
-			CurrentCubeSpectrumValues[i] = SpectrumValues[i];
+			if (TriggeredMask & (1u << i))
+			{
+				State.PendingBeamAlpha[i] = BandProcessor.GetBeamAlpha(i);
+			}
 		}
+		State.PendingBeamTriggeredMask |= TriggeredMask;
+		return;
+	}
+
+	for (int i = 0; i < NumBands; i++)
+	{
+		const float CubeAlpha = BandProcessor.GetCubeAlpha(i);
+		State.PendingCubeAlpha[i] = State.bHasPendingCubeAlpha
+			? FMath::Max(State.PendingCubeAlpha[i], CubeAlpha)
+			: CubeAlpha;
+	}
+	State.bHasPendingCubeAlpha = true;
+}
+
+void AVisualizerManager::ScheduleVisualizerUpdates()
+{
+	const bool bUseBudget = UpdateBudget > 0.f;
 
-		if (SpectrumValues[i] > 0 && CurrentSpectrumValues[i] < 0)
+	FVector CameraLocation = FVector::ZeroVector;
+	bool bHasCamera = false;
+	if (bUseBudget && LODDistance > 0.f)
+	{
+		if (const APlayerController* Controller = GetWorld()->GetFirstPlayerController())
 		{
-			CurrentSpectrumValues[i] = SpectrumValues[i];
-			if (bUpdateBeamVisualizers)
+			if (Controller->PlayerCameraManager)
 			{
-				UpdateBeamVisualizers(i, GetNormalizedSpectrumValue(i, true));
+				CameraLocation = Controller->PlayerCameraManager->GetCameraLocation();
+				bHasCamera = true;
 			}
 		}
-		if (bUpdateCubeVisualizers)
+	}
+
+	TArray<FVisualizerUpdateState*, TInlineAllocator<16>> Candidates;
+	for (FVisualizerUpdateState& State : UpdateStates)
+	{
+		State.bScheduled = false;
+		if (!HasPendingUpdate(State))
 		{
-			UpdateCubeVisualizers(i, GetNormalizedSpectrumValue(i, false));
+			continue;
 		}
-		if (CurrentSpectrumValues[i] >= 0)
+		if (!bUseBudget)
 		{
-			CurrentSpectrumValues[i] -= AvgSpectrumValues[i] / CurrentSpectrumValueDecrementDivide;
+			State.bScheduled = true;
+			continue;
 		}
-		if (CurrentCubeSpectrumValues[i] >= 0)
+
+		// HasPendingUpdate already checked that the visualizer is valid
+		const AVisualizerBase* Visualizer = State.Visualizer.Get();
+		State.Priority = State.FramesSinceUpdate + 1;
+		if (!Visualizer->IsVisualizerVisible())
 		{
-			CurrentCubeSpectrumValues[i] -= CurrentCubeSpectrumValueDecrement;
+			State.Priority *= HiddenVisualizerPriorityScale;
 		}
-		if (MaxSpectrumValues[i] >= 0)
+		if (bHasCamera)
 		{
-			MaxSpectrumValues[i] -= AvgSpectrumValues[i] / MaxSpectrumValueDecrementDivide;
+			const float Distance = FVector::Dist(CameraLocation, Visualizer->GetActorLocation());
+			State.Priority /= 1.f + Distance / LODDistance;
 		}
+		Candidates.Add(&State);
 	}
 
-	MarkVisualizerRenderStateDirty();
-}
+	if (Candidates.IsEmpty())
+	{
+		return;
+	}
 
-void AVisualizerManager::UpdateBeamVisualizers(const int32 Index, const float SpectrumValue)
-{
-	for (const TObjectPtr<ABeamVisualizer>& BeamVisualizer : GetBeamVisualizers())
+	// Overdue visualizers are updated before the budget is checked, so that none are starved. Their cost still
+	// counts against the budget, which is a hard cap for all other visualizers
+	const int32 MaxFrames = FMath::Max(1, MaxFramesBetweenUpdates);
+	float SpentBudget = 0.f;
+	for (FVisualizerUpdateState* State : Candidates)
 	{
-		BeamVisualizer->UpdateVisualizer(Index, SpectrumValue);
+		if (State->FramesSinceUpdate >= MaxFrames)
+		{
+			State->bScheduled = true;
+			SpentBudget += State->EstimatedCost;
+		}
+	}
+
+	Candidates.Sort([](const FVisualizerUpdateState& A, const FVisualizerUpdateState& B)
+	{
+		return A.Priority > B.Priority;
+	});
+	for (FVisualizerUpdateState* State : Candidates)
+	{
+		if (!State->bScheduled && SpentBudget + State->EstimatedCost <= UpdateBudget)
+		{
+			State->bScheduled = true;
+			SpentBudget += State->EstimatedCost;
+		}
 	}
 }
 
-void AVisualizerManager::UpdateCubeVisualizers(const int32 Index, const float SpectrumValue)
+void AVisualizerManager::UpdateVisualizer(FVisualizerUpdateState& State, const int32 NumBands)
 {
-	for (const TObjectPtr<AStaticCubeVisualizer>& CubeVisualizer : GetCubeVisualizers())
+	AVisualizerBase* Visualizer = State.Visualizer.Get();
+	if (!Visualizer)
+	{
+		return;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	if (State.bIsBeam)
+	{
+		for (int i = 0; i < NumBands; i++)
+		{
+			if (State.PendingBeamTriggeredMask & (1u << i))
+			{
+				Visualizer->UpdateVisualizer(i, State.PendingBeamAlpha[i]);
+			}
+		}
+		State.PendingBeamTriggeredMask = 0;
+	}
+	else
 	{
-		CubeVisualizer->UpdateVisualizer(Index, SpectrumValue);
+		for (int i = 0; i < NumBands; i++)
+		{
+			Visualizer->UpdateVisualizer(i, State.PendingCubeAlpha[i]);
+		}
+		State.bHasPendingCubeAlpha = false;
 	}
+	Visualizer->SubmitPendingUpdates();
+
+	const float MeasuredCost = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	State.EstimatedCost = FMath::Lerp(State.EstimatedCost, MeasuredCost, VisualizerCostSmoothingAlpha);
+	State.FramesSinceUpdate = 0;
 }
 
 void AVisualizerManager::DeactivateVisualizers()
@@ -191,9 +326,8 @@ void AVisualizerManager::UpdateVisualizerSettings(const FPlayerSettings_Game& Pl
 void AVisualizerManager::UpdateAASettings(const FPlayerSettings_AudioAnalyzer& NewAASettings)
 {
 	AvgSpectrumValues.Init(0, NewAASettings.NumBandChannels);
-	CurrentSpectrumValues.Init(0, NewAASettings.NumBandChannels);
-	MaxSpectrumValues.Init(1.f, NewAASettings.NumBandChannels);
-	CurrentCubeSpectrumValues.Init(0, NewAASettings.NumBandChannels);
+	BandProcessor.Init(NewAASettings.NumBandChannels);
+	ResetUpdateStates(NewAASettings.NumBandChannels);
 	for (const TObjectPtr<AVisualizerBase> Visualizer : GetVisualizers())
 	{
 		if (Visualizer)
@@ -203,16 +337,9 @@ void AVisualizerManager::UpdateAASettings(const FPlayerSettings_AudioAnalyzer& N
 	}
 }
 
-void AVisualizerManager::MarkVisualizerRenderStateDirty()
-{
-	for (const TObjectPtr<AStaticCubeVisualizer>& CubeVisualizer : GetCubeVisualizers())
-	{
-		CubeVisualizer->MarkRenderStateDirty();
-	}
-}
-
 void AVisualizerManager::SplitVisualizers()
 {
+	UpdateStates.Empty();
 	for (const TObjectPtr<AVisualizerBase>& Visualizer : GetVisualizers())
 	{
 		if (Cast<ABeamVisualizer>(Visualizer.Get()))
@@ -223,5 +350,15 @@ void AVisualizerManager::SplitVisualizers()
 		{
 			CubeVisualizers.AddUnique(Cast<AStaticCubeVisualizer>(Visualizer.Get()));
 		}
+		else
+		{
+			continue;
+		}
+
+		FVisualizerUpdateState& State = UpdateStates.AddDefaulted_GetRef();
+		State.Visualizer = Visualizer.Get();
+		State.bIsBeam = Cast<ABeamVisualizer>(Visualizer.Get()) != nullptr;
+		State.EstimatedCost = Visualizer->GetUpdateCost();
 	}
+	ResetUpdateStates(BandProcessor.GetNumBands());
 }
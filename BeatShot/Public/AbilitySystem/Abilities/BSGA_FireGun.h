@@ -37,6 +37,10 @@ protected:
 	/** Calls OnTargetDataReady. */
 	void OnTargetDataReadyCallback(const FGameplayAbilityTargetDataHandle& InData, FGameplayTag ApplicationTag);
 
+	/** Applies hit damage directly to any targets in TargetData that use lightweight damage, since they don't have
+	 *  an ability system for OnTargetDataReady to apply effects to. */
+	void ApplyLightweightDamage(const FGameplayAbilityTargetDataHandle& TargetData) const;
+
 	/** Performs a WeaponTrace and calls OnTargetDataReadyCallback. */
 	UFUNCTION(BlueprintCallable)
 	void StartTargeting();
@@ -26,6 +26,10 @@ struct FDamageEventData
 	float NewValue;
 	ETargetDamageType DamageType;
 
+	/** Whether to treat self damage as external damage. Only used when there is no EffectSpec, otherwise the
+	 *  Target_TreatAsExternalDamage tag of the EffectSpec is used. */
+	bool bTreatAsExternalDamage = false;
+
 	FDamageEventData()
 	{
 		EffectInstigator = nullptr;
@@ -42,7 +42,7 @@ public:
 	static UBSAT_PerformWeaponTraceSingle* PerformWeaponTraceSingle(UBSGameplayAbility* OwningAbility,
 		const FName TaskInstanceName, const float TraceDistance);
 
-	/** Performs actual LineTraceSingleByChannel, returning true on success. */
+	/** Performs the weapon trace through UTargetQuerySubsystem, returning true on success. */
 	bool LineTraceSingle(FHitResult& HitResult) const;
 
 private:
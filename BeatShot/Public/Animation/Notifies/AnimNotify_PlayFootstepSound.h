@@ -100,4 +100,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BeatShot|AnimNotify",
 		meta = (ExposeOnSpawn = true, EditCondition = "bPerformTrace"))
 	FBSAnimNotifyTraceSettings TraceProperties;
+
+private:
+	/** Executes PlayMovementSound on the owning actor and each of its components that implement
+	 *  IBSMovementSoundInterface. */
+	void PlayMovementSound(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
+		const FHitResult& HitResult) const;
 };
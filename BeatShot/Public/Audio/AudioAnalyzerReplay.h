@@ -0,0 +1,95 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBSConfig;
+
+/** The AudioAnalyzer output for a single game mode tick. */
+struct BEATSHOT_API FAudioAnalyzerReplayFrame
+{
+	/** The DeltaSeconds of the tick the frame was recorded on. */
+	float DeltaSeconds = 0.f;
+
+	/** Beats returned by the AATracker. */
+	TArray<bool> Beats;
+
+	/** Spectrum values sent to the VisualizerManager. */
+	TArray<float> SpectrumValues;
+
+	/** Average spectrum values sent to the VisualizerManager. */
+	TArray<float> AvgSpectrumValues;
+};
+
+/** A compact, compressed recording of the per-tick AudioAnalyzer output of a game mode, along with the random seed and
+ *  game mode config used. Used to replace the live AudioAnalyzer so that a game mode can be replayed without any audio
+ *  hardware and receive the exact same beat stream every time.
+ *
+ *  Beats are stored as packed bits, and spectrum values as flat float arrays, with a fixed number of channels per
+ *  frame. The whole recording is zlib compressed when saved. */
+class BEATSHOT_API FAudioAnalyzerReplay
+{
+public:
+	FAudioAnalyzerReplay();
+
+	/** Clears any existing frames and stores the metadata for a new recording. */
+	void BeginRecording(const int32 InRandomSeed, const FBSConfig& InConfig);
+
+	/** Appends a frame to the recording. The number of channels is taken from the first frame recorded, and later
+	 *  frames are padded or truncated to match. */
+	void RecordFrame(const float DeltaSeconds, const TArray<bool>& Beats, const TArray<float>& SpectrumValues,
+		const TArray<float>& AvgSpectrumValues);
+
+	/** Copies the next frame into OutFrame and advances the playback position. Returns false if there are no more
+	 *  frames. */
+	bool ReadNextFrame(FAudioAnalyzerReplayFrame& OutFrame);
+
+	/** Returns the DeltaSeconds of the frame the next ReadNextFrame returns, or zero if there are no more frames. */
+	float GetNextFrameDeltaSeconds() const;
+
+	/** Resets the playback position to the first frame. */
+	void RewindPlayback() { PlaybackFrame = 0; }
+
+	/** Serializes, compresses, and writes the recording to FilePath. Returns true on success. */
+	bool SaveToFile(const FString& FilePath) const;
+
+	/** Reads, decompresses, and deserializes a recording from FilePath. Returns true on success. */
+	bool LoadFromFile(const FString& FilePath);
+
+	/** Returns the random seed the recording was made with. */
+	int32 GetRandomSeed() const { return RandomSeed; }
+
+	/** Returns the fixed delta time the engine was running at when recording, or zero if it was not fixed. */
+	float GetFixedDeltaTime() const { return FixedDeltaTime; }
+
+	/** Deserializes the game mode config the recording was made with into OutConfig. Returns true on success. */
+	bool GetConfig(FBSConfig& OutConfig) const;
+
+	/** Returns the number of recorded frames. */
+	int32 GetNumFrames() const { return NumFrames; }
+
+	/** Returns FilePath if absolute, otherwise FilePath relative to the Saved/AudioAnalyzerReplays directory. */
+	static FString GetReplayFilePath(const FString& FilePath);
+
+	friend FArchive& operator<<(FArchive& Ar, FAudioAnalyzerReplay& Replay);
+
+private:
+	int32 RandomSeed;
+	float FixedDeltaTime;
+
+	/** The game mode config as a JSON string. */
+	FString ConfigString;
+
+	int32 NumFrames;
+	int32 NumBeatChannels;
+	int32 NumSpectrumChannels;
+
+	TArray<float> DeltaSeconds;
+	TBitArray<> BeatBits;
+	TArray<float> SpectrumData;
+	TArray<float> AvgSpectrumData;
+
+	/** Index of the next frame returned by ReadNextFrame. */
+	int32 PlaybackFrame;
+};
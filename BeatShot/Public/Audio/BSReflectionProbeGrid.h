@@ -0,0 +1,142 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "BSReflectionProbeGrid.generated.h"
+
+/** Traces a line through the level, the same as LineTraceSingleByChannel. */
+using FBSReflectionProbeTraceFunction = TFunctionRef<bool(const FVector& Start, const FVector& End,
+	FHitResult& OutHit)>;
+
+/** Compares the probe grid against live traces from random locations inside the grid. */
+struct FBSReflectionProbeValidation
+{
+	/** The number of rays compared. */
+	int32 NumSamples = 0;
+
+	/** The number of rays that either the grid couldn't answer or that started inside geometry. */
+	int32 NumSkipped = 0;
+
+	/** The number of rays where one of the grid or the live trace hit something and the other didn't. */
+	int32 NumHitMismatches = 0;
+
+	/** Distance errors of the rays that hit something in both the grid and the live trace. */
+	double MeanDistanceError = 0.0;
+	double MedianDistanceError = 0.0;
+	double MaxDistanceError = 0.0;
+};
+
+/** Early reflection distances baked on a regular grid of probes over a static level, so that weapon audio can estimate
+ *  reflections without tracing the scene. Each probe stores the distance to and normal of the first static surface in
+ *  each of a fixed set of directions. Baked with bs_reflectionprobes.bake and checked with
+ *  bs_reflectionprobes.validate. */
+UCLASS(BlueprintType)
+class BEATSHOT_API UBSReflectionProbeGrid : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** The number of directions each probe stores a reflection for. */
+	static constexpr int32 NumDirections = 64;
+
+	/** The object type traced when baking and validating the grid. */
+	static constexpr ECollisionChannel BakedObjectType = ECC_WorldStatic;
+
+	/** The trace channel the grid stands in for. Lookups answer it as if only the baked static geometry blocked it,
+	 *  and live traces on it are the fallback. */
+	static constexpr ECollisionChannel AnsweredChannel = ECC_Visibility;
+
+	/** Returns the probe grid of the world's level, if it has one that is baked. */
+	static const UBSReflectionProbeGrid* Get(const UWorld* World);
+
+	/** Returns the directions each probe stores a reflection for, evenly distributed over the unit sphere. */
+	static const TArray<FVector>& GetDirections();
+
+	/** Returns true if the grid can stand in for a trace on Channel with Params: only AnsweredChannel, without
+	 *  ignoring any components or any actors that are part of the baked geometry. */
+	static bool CanAnswer(const ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	/** Looks up a line trace from the grid by trilinearly interpolating the eight probes surrounding Start in the
+	 *  direction nearest to the ray.
+	 *  @param Start the start of the trace
+	 *  @param End the end of the trace
+	 *  @param OutHit filled the same way as a line trace, but only with a location, normal, and distance
+	 *  @param SurfaceNormal the normal of the surface the trace starts on, or zero if it doesn't start on a surface.
+	 *  Probes behind the surface see the other side of it and are left out of the interpolation
+	 *  @return false if the grid can't answer the query, e.g. Start is outside the grid or all surrounding probes
+	 *  are inside geometry or behind the surface
+	 */
+	bool Trace(const FVector& Start, const FVector& End, FHitResult& OutHit,
+		const FVector& SurfaceNormal = FVector::ZeroVector) const;
+
+	/** Bakes every probe inside Bounds using TraceFunction. */
+	void Bake(const FBSReflectionProbeTraceFunction& TraceFunction);
+
+	/** Bakes every probe inside Bounds by tracing the static geometry of the world. */
+	void Bake(const UWorld* World);
+
+	/** Compares the grid against TraceFunction for rays in random directions from random locations inside Bounds. */
+	FBSReflectionProbeValidation Validate(const FBSReflectionProbeTraceFunction& TraceFunction, const int32 NumSamples,
+		const int32 RandomSeed) const;
+
+	/** Compares the grid against traces of the static geometry of the world. */
+	FBSReflectionProbeValidation Validate(const UWorld* World, const int32 NumSamples, const int32 RandomSeed) const;
+
+	/** Returns true if the grid has been baked with the current settings. */
+	bool IsBaked() const;
+
+	/** The volume to place probes in, which should cover everywhere the player can shoot. */
+	UPROPERTY(EditAnywhere, Category = "Reflection Probes")
+	FBox Bounds = FBox(FVector(-2000.0, -2000.0, 0.0), FVector(2000.0, 2000.0, 1000.0));
+
+	/** The distance between neighboring probes. */
+	UPROPERTY(EditAnywhere, Category = "Reflection Probes", meta=(ClampMin=10))
+	float ProbeSpacing = 250.f;
+
+	/** The maximum reflection distance stored by a probe. */
+	UPROPERTY(EditAnywhere, Category = "Reflection Probes", meta=(ClampMin=100))
+	float MaxDistance = 4000.f;
+
+private:
+	/** Returns the number of probes along each axis of Bounds. */
+	FIntVector GetDesiredDimensions() const;
+
+	/** Returns the index of the probe at the grid coordinates. */
+	int32 GetProbeIndex(const int32 X, const int32 Y, const int32 Z) const;
+
+	/** Returns the index of the direction closest to Direction. */
+	static int32 FindNearestDirection(const FVector& Direction);
+
+	/** Packs a reflection into 16 bits of distance and an octahedral encoded normal. */
+	uint32 EncodeSample(const FHitResult& Hit) const;
+
+	/** Unpacks a reflection. @return false if there was no reflection within MaxDistance */
+	bool DecodeSample(const uint32 Sample, float& OutDistance, FVector& OutNormal) const;
+
+	/** The number of probes along each axis when the grid was baked. */
+	UPROPERTY(VisibleAnywhere, Category = "Reflection Probes|Baked")
+	FIntVector Dimensions = FIntVector::ZeroValue;
+
+	/** The bounds, spacing, and max distance when the grid was baked. */
+	UPROPERTY()
+	FBox BakedBounds = FBox(ForceInit);
+
+	UPROPERTY()
+	float BakedProbeSpacing = 0.f;
+
+	UPROPERTY()
+	float BakedMaxDistance = 0.f;
+
+	UPROPERTY()
+	int32 BakedNumDirections = 0;
+
+	/** NumDirections packed reflections for each probe, see EncodeSample. */
+	UPROPERTY()
+	TArray<uint32> Samples;
+
+	/** One bit for each probe, set if the probe is not inside geometry. */
+	UPROPERTY()
+	TArray<uint32> ValidProbes;
+};
@@ -20,6 +20,7 @@ class USoundControlBusMix;
 class ABSPlayerController;
 class SLoadingScreenWidget;
 class ATimeOfDayManager;
+class FScoreUploadOutbox;
 class USteamManager;
 
 /** Base GameInstance for this game. */
@@ -83,7 +84,7 @@ public:
 
 	/** Handles saving scores to database, called by BSGameMode. */
 	void SavePlayerScoresToDatabase(ABSPlayerController* PlayerController, bool bWasValidToSave,
-		bool bQuitToDesktopAfterSave) const;
+		bool bQuitToDesktopAfterSave);
 
 	/** Sets the loading screen state to fading out and updates the loading screen audio component state. */
 	void RemoveLoadingScreen();
@@ -138,6 +139,9 @@ protected:
 	/** The defining game mode options that are populated from a menu widget, and accessed by the GameMode. */
 	TSharedPtr<FBSConfig> BSConfig;
 
+	/** Uploads scores not saved to the database for the current account. */
+	TSharedPtr<FScoreUploadOutbox, ESPMode::ThreadSafe> ScoreUploadOutbox;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "BeatShot|Sound")
 	USoundBase* LoadingScreenSound;
 
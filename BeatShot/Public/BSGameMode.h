@@ -5,13 +5,16 @@
 #include "CoreMinimal.h"
 #include "BSPlayerSettingsInterface.h"
 #include "RuntimeAudioImporterTypes.h"
+#include "Audio/AudioAnalyzerReplay.h"
 #include "AbilitySystem/Globals/BSAbilitySet.h"
 #include "GameFramework/GameMode.h"
 #include "SaveGames/SaveGamePlayerScore.h"
 #include "SaveGames/SaveGamePlayerSettings.h"
+#include "System/BSFixedTimestep.h"
 #include "BSGameMode.generated.h"
 
 struct FBSConfig;
+struct FBS_TargetConfig;
 enum class ETransitionState : uint8;
 class UCapturableSoundWave;
 class UImportedSoundWave;
@@ -46,6 +49,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
 	virtual void PostLogin(APlayerController* NewPlayer) override;
 	virtual void PostLoad() override;
@@ -132,6 +136,16 @@ public:
 	 *  PlayerHUD binds to it, while DefaultGameMode (this) executes it. */
 	FOnAAManagerSecondPassed OnSecondPassed;
 
+	/** Returns the score for a perfect shot on one target, based on how many targets could spawn during the song. */
+	static float GetMaxScorePerTarget(const FBSConfig& InConfig);
+
+	/** Returns the score based on the time the target was alive for, given the score for a perfect shot. */
+	static float GetScoreFromTimeAlive(const FBS_TargetConfig& InTargetConfig, const float InMaxScorePerTarget,
+		const float InTimeAlive);
+
+	/** Calculates the accuracy, completion, and average time offset of a score and updates the time. */
+	static void FinalizePlayerScore(const FBSConfig& InConfig, FPlayerScore& InScore);
+
 protected:
 	virtual void OnPlayerSettingsChanged(const FPlayerSettings_Game& NewGameSettings) override;
 	virtual void OnPlayerSettingsChanged(const FPlayerSettings_AudioAnalyzer& NewAudioAnalyzerSettings) override;
@@ -146,8 +160,35 @@ private:
 	/** Does all the AudioAnalyzer initialization, called during InitializeGameMode. */
 	bool InitializeAudioManagers();
 
-	/** Retrieves all AudioAnalyzer data on tick. */
-	void OnTick_AudioAnalyzers(const float DeltaSeconds);
+	/** Retrieves all AudioAnalyzer data on tick.
+	 *  @param DeltaSeconds the frame time, which is recorded with the frame
+	 *  @param SimulatedSeconds the time simulated this frame, which is DeltaSeconds rounded down to whole fixed steps
+	 *  if SimulationTimestep is enabled. Only used to advance the target spawn cooldown
+	 */
+	void OnTick_AudioAnalyzers(const float DeltaSeconds, const float SimulatedSeconds);
+
+	/** Starts recording the AudioAnalyzer output if launched with -BSRecordAudioAnalyzer=<File>, or loads a recording
+	 *  to replace the AudioAnalyzer if launched with -BSReplayAudioAnalyzer=<File>. Chooses RandomSeed, using the
+	 *  recorded seed and replacing BSConfig with the recorded config when replaying. */
+	void InitializeAudioAnalyzerReplay();
+
+	/** Feeds the next recorded AudioAnalyzer frame to the TargetManager and VisualizerManager. Ends the game mode
+	 *  without saving scores once all frames have been played. */
+	void OnTick_AudioAnalyzerReplay(const float SimulatedSeconds);
+
+	/** Steps the engine by the DeltaSeconds of the next recorded frame, so that timers and timelines advance exactly
+	 *  as they did while recording. */
+	void UpdateReplayFixedTimeStep();
+
+	/** Enables FApp's fixed timestep with the given DeltaSeconds, remembering the previous setting the first time. */
+	void OverrideFixedTimeStep(const double DeltaSeconds);
+
+	/** Restores FApp's fixed timestep setting from before OverrideFixedTimeStep was first called. */
+	void RestoreFixedTimeStep();
+
+	/** Runs the engine at the fixed frame time requested with -BSFastForward=, unless an AudioAnalyzer recording is
+	 *  being replayed at its own frame times. */
+	void InitializeFastForward();
 
 	void GoToMainMenu();
 
@@ -216,6 +257,10 @@ private:
 	/** The time elapsed since last target spawn. */
 	float Elapsed;
 
+	/** Steps Elapsed in whole fixed steps if bs_sim.fixedtimestep is set, so that spawn cooldowns don't depend on the
+	 *  frame rate. */
+	FBSFixedTimestep SimulationTimestep;
+
 	/** Max score per target based on total amount of targets that could spawn. */
 	float MaxScorePerTarget;
 
@@ -250,6 +295,32 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "BeatShot|General")
 	int32 StreakThreshold = 50;
 
+	/** Records the AudioAnalyzer output each tick, saved to AudioAnalyzerRecordingPath when the game mode ends. */
+	TUniquePtr<FAudioAnalyzerReplay> AudioAnalyzerRecording;
+
+	/** File to save AudioAnalyzerRecording to. */
+	FString AudioAnalyzerRecordingPath;
+
+	/** A recording that replaces the live AudioAnalyzer output. */
+	TUniquePtr<FAudioAnalyzerReplay> AudioAnalyzerPlayback;
+
+	/** The frame most recently read from AudioAnalyzerPlayback. */
+	FAudioAnalyzerReplayFrame AudioAnalyzerPlaybackFrame;
+
+	/** Seed passed to the TargetManager, which seeds every random stream used to spawn and activate targets. */
+	int32 RandomSeed = 0;
+
+	/** The beats targets were spawned from on the last tick, copied before AAPlayer overwrites Beats. Only used while
+	 *  recording. */
+	TArray<bool> RecordedBeats;
+
+	/** Whether this game mode has overridden FApp's fixed timestep, which is restored when the game mode ends. */
+	bool bOverridingFixedTimeStep = false;
+
+	/** FApp's fixed timestep setting before this game mode overrode it. */
+	bool bUseFixedTimeStepBeforeOverride = false;
+	double FixedDeltaTimeBeforeOverride = 0.0;
+
 	TArray<bool> Beats;
 	TArray<float> SpectrumValues;
 	TArray<float> SpectrumVariance;
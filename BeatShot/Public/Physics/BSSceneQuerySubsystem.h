@@ -0,0 +1,154 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "BSSceneQuerySubsystem.generated.h"
+
+/** How urgently the result of a scene query is needed. */
+enum class EBSSceneQueryPriority : uint8
+{
+	/** Traced immediately on the game thread. For gameplay that can't continue without the result. */
+	Critical,
+	/** Traced asynchronously and delivered in a later frame, as long as the query can be issued within its latency
+	 *  tolerance. For cosmetic traces like audio reflections, beam lights, and footsteps. */
+	Deferred
+};
+
+/** Receives the result of a scene query. The hit is not a blocking hit if nothing was hit. */
+DECLARE_DELEGATE_OneParam(FBSSceneQueryDelegate, const FHitResult&);
+
+/** A single line trace submitted to UBSSceneQuerySubsystem. */
+struct FBSSceneQuery
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	ECollisionChannel Channel = ECC_Visibility;
+	FCollisionQueryParams Params;
+	EBSSceneQueryPriority Priority = EBSSceneQueryPriority::Deferred;
+
+	/** The number of frames a deferred query may wait to be issued before its result is no longer useful and the
+	 *  query is dropped. Negative to never drop the query. */
+	int32 LatencyTolerance = 2;
+};
+
+/** A deferred query waiting to be issued, along with everyone waiting for its result. */
+struct FBSPendingSceneQuery
+{
+	FBSSceneQuery Query;
+	TArray<FBSSceneQueryDelegate, TInlineAllocator<1>> Delegates;
+
+	/** The last frame the query can be issued on. */
+	uint64 LastFrame = 0;
+
+	/** The frame the query should be issued by, which orders the queries in Take. The same as LastFrame for queries
+	 *  that can be dropped, and a fixed number of frames after the query was added for queries that can't, so that
+	 *  they are not starved by newer queries. */
+	uint64 PriorityFrame = 0;
+
+	uint32 Hash = 0;
+};
+
+/** Deferred queries waiting to be issued. Queries that trace the same ray with the same parameters are merged. */
+struct BEATSHOT_API FBSSceneQueryBatch
+{
+	/** The number of frames a query that is never dropped waits before it is issued ahead of queries added after it. */
+	static constexpr int32 NeverDropPriorityLatency = 8;
+
+	/** Adds a query, or merges it with a pending query that traces the same ray.
+	 *  @param Query the query to add
+	 *  @param Delegate called with the result of the query
+	 *  @param FrameNumber the current frame
+	 *  @param MergeTolerance how close the start and end of two rays must be to merge them
+	 *  @return true if the query was merged with a pending query
+	 */
+	bool Add(const FBSSceneQuery& Query, FBSSceneQueryDelegate&& Delegate, const uint64 FrameNumber,
+		const double MergeTolerance);
+
+	/** Removes the queries closest to exceeding their latency tolerance, or waiting the longest if they are never
+	 *  dropped, after dropping any that have exceeded it.
+	 *  @param MaxQueries the maximum number of queries to remove
+	 *  @param FrameNumber the current frame
+	 *  @param OutQueries the removed queries
+	 *  @return the number of queries that were dropped
+	 */
+	int32 Take(const int32 MaxQueries, const uint64 FrameNumber, TArray<FBSPendingSceneQuery>& OutQueries);
+
+	void Reset();
+
+	int32 Num() const { return Pending.Num(); }
+
+private:
+	/** Returns whether two queries trace the same ray with the same channel, parameters, and object filters. */
+	static bool CanMerge(const FBSSceneQuery& A, const FBSSceneQuery& B, const double MergeTolerance);
+
+	/** Returns a hash of the quantized ray, channel, and parameters of the query. */
+	static uint32 GetQueryHash(const FBSSceneQuery& Query, const double MergeTolerance);
+
+	TArray<FBSPendingSceneQuery> Pending;
+
+	/** The indices in Pending of each query hash. */
+	TMultiMap<uint32, int32> PendingIndices;
+};
+
+/** The number of queries handled during the last frame. */
+struct FBSSceneQueryStats
+{
+	int32 NumCritical = 0;
+	int32 NumDeferred = 0;
+	int32 NumMerged = 0;
+	int32 NumDropped = 0;
+	int32 NumWaiting = 0;
+};
+
+/** Coalesces the line traces issued by gameplay, audio, and visualizers. Critical queries are traced immediately, while
+ *  deferred queries are batched, merged with duplicates, and issued as async scene queries once per frame. The total
+ *  number of queries issued per frame is limited by bs_scenequery.budget, with critical queries counting against the
+ *  budget first. */
+UCLASS()
+class BEATSHOT_API UBSSceneQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Traces a critical query immediately, the same as LineTraceSingleByChannel.
+	 *  @return true if there was a blocking hit
+	 */
+	bool LineTrace(FHitResult& OutHit, const FVector& Start, const FVector& End, const ECollisionChannel Channel,
+		const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam);
+
+	/** Submits a query. Critical queries and queries submitted outside of a game world call Delegate before
+	 *  returning, while deferred queries call it in a later frame, or never if the query is dropped. */
+	void Submit(const FBSSceneQuery& Query, FBSSceneQueryDelegate&& Delegate);
+
+	/** Returns the number of queries handled during the last frame. */
+	const FBSSceneQueryStats& GetLastFrameStats() const { return LastFrameStats; }
+
+private:
+	/** Issues the pending queries that fit in the budget for this frame. */
+	void IssuePendingQueries();
+
+	/** Delivers the result of an async trace to the delegates waiting for it. */
+	void OnAsyncTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** Calls every delegate with the hit. */
+	static void Deliver(const FHitResult& Hit, TConstArrayView<FBSSceneQueryDelegate> Delegates);
+
+	FBSSceneQueryBatch Batch;
+
+	/** Delegates waiting for an async trace, keyed by the user data passed to the trace. */
+	TMap<uint32, TArray<FBSSceneQueryDelegate, TInlineAllocator<1>>> InFlight;
+
+	FTraceDelegate AsyncTraceDelegate;
+	uint32 NextAsyncTraceID = 0;
+
+	FBSSceneQueryStats CurrentFrameStats;
+	FBSSceneQueryStats LastFrameStats;
+};
@@ -8,6 +8,7 @@
 
 class UBSGameUserSettings;
 class APostProcessVolume;
+class UBSReflectionProbeGrid;
 
 /** The base level used for this game. */
 UCLASS()
@@ -15,6 +16,10 @@ class BEATSHOT_API ARangeLevelScriptActor : public ALevelScriptActor
 {
 	GENERATED_BODY()
 
+public:
+	/** Returns the early reflection probe grid baked for this level, if any. */
+	UBSReflectionProbeGrid* GetReflectionProbeGrid() const { return ReflectionProbeGrid; }
+
 protected:
 	ARangeLevelScriptActor();
 
@@ -25,4 +30,8 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = "BeatShot|References")
 	TSoftObjectPtr<APostProcessVolume> PostProcessVolume;
+
+	/** Early reflections for weapon audio, baked from the static geometry of this level. */
+	UPROPERTY(EditDefaultsOnly, Category = "BeatShot|References")
+	TObjectPtr<UBSReflectionProbeGrid> ReflectionProbeGrid;
 };
@@ -0,0 +1,56 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Splits variable frame times into fixed simulation steps. Systems that own one call Advance once per frame and
+ *  simulate the returned number of steps, so their results only depend on the sum of frame times and not on how that
+ *  time was split into frames. */
+struct BEATSHOT_API FBSFixedTimestep
+{
+	FBSFixedTimestep() = default;
+
+	/** @param InStepSeconds the length of a step, or 0 to disable fixed steps
+	 *  @param InMaxStepsPerFrame the most steps Advance will return, to keep a long hitch from stalling the game
+	 */
+	FBSFixedTimestep(const double InStepSeconds, const int32 InMaxStepsPerFrame);
+
+	/** Returns a timestep using the rate in bs_sim.fixedtimestep and the limit in bs_sim.maxstepsperframe, or a
+	 *  disabled timestep if the rate is 0. */
+	static FBSFixedTimestep FromConsoleVariables();
+
+	/** Returns the fixed frame time of NumSteps steps using the rate in bs_sim.fixedtimestep, which headless
+	 *  simulations set on the engine to run NumSteps steps per frame as fast as possible instead of in real time.
+	 *  Returns 0 if fixed steps are disabled. */
+	static double GetFastForwardDeltaSeconds(const int32 NumSteps);
+
+	/** Returns the number of steps to fast forward from the -BSFastForward= command line argument, or 0. */
+	static int32 GetFastForwardSteps();
+
+	/** Adds DeltaSeconds to the accumulated time and returns the number of whole steps to simulate. Time beyond
+	 *  MaxStepsPerFrame steps is dropped. */
+	int32 Advance(const double DeltaSeconds);
+
+	/** Returns true if steps have a length. */
+	bool IsEnabled() const { return StepSeconds > 0.0; }
+
+	/** Returns the length of a step. */
+	double GetStepSeconds() const { return StepSeconds; }
+
+	/** Returns the fraction of a step that has been accumulated but not simulated, for interpolating between the last
+	 *  two simulated states when rendering. */
+	double GetAlpha() const { return IsEnabled() ? Accumulator / StepSeconds : 0.0; }
+
+	/** Returns the total time simulated in steps. */
+	double GetSimulationTime() const { return NumStepsSimulated * StepSeconds; }
+
+	/** Returns the total number of steps simulated. */
+	int64 GetNumStepsSimulated() const { return NumStepsSimulated; }
+
+private:
+	double StepSeconds = 0.0;
+	int32 MaxStepsPerFrame = 1;
+	double Accumulator = 0.0;
+	int64 NumStepsSimulated = 0;
+};
@@ -0,0 +1,49 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Candidate locations for new directions of moving targets in the Any direction mode. The spawn box is split into
+ *  four sectors (-Y -Z, +Y -Z, -Y +Z, +Y +Z), each with a fixed number of random locations, so that choosing a new
+ *  direction is two lookups instead of building and sampling boxes. */
+struct BEATSHOT_API FMovingTargetDirectionTable
+{
+	static constexpr int32 NumSectors = 4;
+	static constexpr int32 NumLocationsPerSector = 64;
+
+	/** Rebuilds the table if the spawn box or the depth targets can move in changed.
+	 *  @param InOrigin the origin of the spawn box
+	 *  @param InExtents the extents of the spawn box
+	 *  @param InDepth how far behind the spawn box locations can be
+	 *  @param Stream the stream used to generate locations
+	 *  @return true if the table was rebuilt
+	 */
+	bool Update(const FVector& InOrigin, const FVector& InExtents, const float InDepth, const FRandomStream& Stream);
+
+	/** Returns a unit direction from LocationBeforeChange to a random location in one of the three sectors that
+	 *  LocationBeforeChange is not in, and optionally that location. */
+	FVector SampleDirection(const FVector& LocationBeforeChange, const FRandomStream& Stream,
+		FVector* OutLocation = nullptr) const;
+
+	/** Returns the index of the sector that Location is in. */
+	int32 GetSectorIndex(const FVector& Location) const;
+
+	/** Returns the center of the box that a sector's locations are generated in. */
+	FVector GetSectorCenter(const int32 SectorIndex) const;
+
+	/** Returns the extents of the box that each sector's locations are generated in. */
+	FVector GetSectorExtents() const;
+
+	/** Returns true if the table has not been built. */
+	bool IsEmpty() const { return Locations.IsEmpty(); }
+
+private:
+	/** The spawn box and depth the table was built for. */
+	FVector Origin = FVector::ZeroVector;
+	FVector Extents = FVector::ZeroVector;
+	float Depth = 0.f;
+
+	/** NumLocationsPerSector locations for each sector, stored sector by sector. */
+	TArray<FVector> Locations;
+};
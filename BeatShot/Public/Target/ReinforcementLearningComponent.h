@@ -159,8 +159,8 @@ protected:
 public:
 	virtual void DestroyComponent(bool bPromoteChildren) override;
 
-	/** Initializes the QTable, called by TargetManager. */
-	void Init(const FRLAgentParams& AgentParams);
+	/** Initializes the QTable and seeds the random stream used to choose actions, called by TargetManager. */
+	void Init(const FRLAgentParams& AgentParams, const int32 InRandomSeed);
 
 	/** Resets the state of the component, aside from debug variables. */
 	void Clear();
@@ -180,7 +180,7 @@ public:
 
 private:
 	/** Returns a random SpawnArea index from the provided SpawnAreaIndices. */
-	static int32 ChooseRandomActionIndex(const TArray<int32>& SpawnAreaIndices);
+	int32 ChooseRandomActionIndex(const TArray<int32>& SpawnAreaIndices) const;
 
 	/** Returns the SpawnArea index that leads to the greatest reward. Calls GetIndices_MaximizeFirst or
 	 *  GetIndices_MaximizeSecond depending on the input previous index and iterates through the indices
@@ -289,6 +289,9 @@ private:
 	/** The number of samples collected starting from when the component was activated. */
 	int64 TotalTrainingSamples;
 
+	/** Random number stream for exploration and for choosing between equally rewarding actions. */
+	FRandomStream RandomStream;
+
 #if !UE_BUILD_SHIPPING
 
 public:
@@ -127,8 +127,8 @@ public:
 	/** Sets the total spawn area minimum and maximum values. */
 	static void SetTotalSpawnAreaExtrema(const FExtrema& InExtrema);
 
-	/** Returns a random offset between (0, 0, 0) and (0, Width, Height). */
-	static FVector GenerateRandomOffset();
+	/** Returns a random offset between (0, 0, 0) and (0, Width, Height), sampled from Stream. */
+	static FVector GenerateRandomOffset(const FRandomStream& Stream);
 
 	/** Returns the width of a Spawn Area. */
 	static int32 GetWidth() { return Width; }
@@ -386,10 +386,11 @@ public:
 	 *  @param InOrigin Origin of the total spawn area
 	 *  @param InStaticExtents Static extents of the total spawn area
 	 *  @param InStaticExtrema Static extrema of the total spawn area
+	 *  @param InRandomSeed Seed for the random stream used to choose Spawn Areas
 	 *  @return the size of
 	 */
 	FIntVector3 Init(const TSharedPtr<FBSConfig>& InConfig, const FVector& InOrigin, const FVector& InStaticExtents,
-		const FExtrema& InStaticExtrema);
+		const FExtrema& InStaticExtrema, const int32 InRandomSeed);
 
 	/** Resets all variables. */
 	void Clear();
@@ -765,29 +766,33 @@ protected:
 	 * 	@param Rectangles a set of valid Spawn Areas to modify
 	 *  @param bBordering whether to find the first rectangle where StartIndex candidates is not empty
 	 *  @param BlockSize Number of targets to spawn
+	 *  @param Stream the random stream to choose sub rectangles from
 	 *  @return the chosen rectangle candidate
 	 */
 	static FRectCandidate ChooseRectangleCandidate(const FRectangleSet& Rectangles, const bool bBordering,
-		const int32 BlockSize);
+		const int32 BlockSize, const FRandomStream& Stream);
 
 	/** Chooses the orientation of the rectangle based on the factors.
 	 * 
 	 *  @param Rect the rectangle to choose the orientation for
 	 *  @param Factor the factor to pull the rectangle dimensions from
+	 *  @param Stream the random stream to choose the orientation from if all factors fit
 	 *  @return a pair of start, end indices
 	 */
-	static FIndexPair ChooseRectangleOrientation(const FRectCandidate& Rect, const FFactor& Factor);
+	static FIndexPair ChooseRectangleOrientation(const FRectCandidate& Rect, const FFactor& Factor,
+		const FRandomStream& Stream);
 
 	/** Chooses the position of the rectangle inside the larger rectangle that was chosen.
 	 * 
 	 *  @param ChosenRectangle the rectangle to choose the position for
 	 *  @param Orientation the IndexPair return from ChooseRectangleOrientation
 	 *  @param bBordering whether to prefer bordering indices
+	 *  @param Stream the random stream to choose the position from
 	 *  @return A pair of bool values where the first indicates if i corresponds to rows and the second indicates
 	 *  if incrementing or decrementing
 	 */
 	static std::pair<bool, bool> ChooseRectanglePosition(FRectCandidate& ChosenRectangle, const FIndexPair& Orientation,
-		const bool bBordering);
+		const bool bBordering, const FRandomStream& Stream);
 
 	/** Returns a set of factors with the minimum distance between Factor1 and Factor2. */
 	static TSet<FFactor> GetPreferredRectangleDimensions(const int32 BlockSize, const int32 NumRows,
@@ -997,6 +1002,9 @@ private:
 	/** BoxBounds origin. */
 	FVector Origin;
 
+	/** Random number stream for choosing Spawn Areas and offsets within them, seeded in Init. */
+	FRandomStream RandomStream;
+
 	/** The largest the BoxExtents will be. */
 	FVector StaticExtents;
 
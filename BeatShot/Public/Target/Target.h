@@ -6,8 +6,11 @@
 #include "AbilitySystemInterface.h"
 #include "AbilitySystem/BSAbilitySystemComponent.h"
 #include "AbilitySystem/Globals/BSAttributeSetBase.h"
+#include "BSGameModeConfig/TargetResponseFlags.h"
 #include "Components/TimelineComponent.h"
 #include "GameFramework/Actor.h"
+#include "System/BSFixedTimestep.h"
+#include "Target/TargetTrajectory.h"
 #include "Target.generated.h"
 
 struct FPlayerSettings_Game;
@@ -20,6 +23,16 @@ class UNiagaraSystem;
 class UCurveFloat;
 class ATarget;
 
+/** A parameter of the target material, and where the material reads it from. */
+struct FTargetMaterialParameter
+{
+	FName Name;
+
+	/** The custom primitive data index of the parameter, or INDEX_NONE if the parameter is set on a Dynamic Material
+	 *  Instance instead. */
+	int32 PrimitiveDataIndex = INDEX_NONE;
+};
+
 /** Struct containing info about a target that is broadcast when a target takes damage or the ExpirationTimer timer
  *  expires. */
 USTRUCT()
@@ -135,6 +148,7 @@ class BEATSHOT_API ATarget : public AActor, public IAbilitySystemInterface, publ
 	friend class ATargetManager;
 	friend class ABeatShotGameModeFunctionalTest;
 	friend class FTargetCollisionTest;
+	friend class UTargetQuerySubsystem;
 
 protected:
 	UPROPERTY()
@@ -176,6 +190,20 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "BeatShot|Constants")
 	FName MaterialParameterColorName = "BaseColor";
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "BeatShot|Constants")
+	FName MaterialParameterOutlineColorName = "OutlineColor";
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "BeatShot|Constants")
+	FName MaterialParameterUseSeparateOutlineColorName = "bUseSeparateOutlineColor";
+
+	/** Fraction of TargetMaxLifeSpan that has passed since the target was activated. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "BeatShot|Constants")
+	FName MaterialParameterLifetimeFractionName = "LifetimeFraction";
+
+	/** 1 while the target is activated, 0 otherwise. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "BeatShot|Constants")
+	FName MaterialParameterHighlightName = "Highlight";
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "BeatShot|Constants")
 	FName TargetExplosionSphereRadiusParameterName = "SphereRadius";
 
@@ -191,6 +219,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "BeatShot|Curves")
 	UCurveFloat* ShrinkQuickAndGrowSlowCurve;
 
+	/** Only created if the sphere material doesn't read the base color from custom primitive data. */
 	UPROPERTY()
 	UMaterialInstanceDynamic* TargetColorChangeMaterial;
 
@@ -207,9 +236,30 @@ public:
 	/** Called in TargetManager to initialize the target. */
 	virtual void Init(const FBS_TargetConfig& InTargetConfig);
 
+	/** Returns true if targets of the config can skip the ability system and take damage through
+	 *  ApplyLightweightDamage. This is true for one-hit targets that only take hit damage and never change
+	 *  immunity. */
+	static bool CanUseLightweightDamage(const FBS_TargetConfig& InTargetConfig);
+
+	/** Returns true if the target takes damage through ApplyLightweightDamage instead of gameplay effects. */
+	bool UsesLightweightDamage() const { return bUseLightweightDamage; }
+
+	/** Subtracts damage from the target's health without the ability system and broadcasts the same damage event as
+	 *  a gameplay effect would. Only valid if UsesLightweightDamage. */
+	void ApplyLightweightDamage(const float Damage, const ETargetDamageType DamageType, AActor* EffectInstigator,
+		AActor* EffectCauser, const bool bTreatAsExternalDamage = false);
+
 	UFUNCTION()
 	void OnProjectileBounce(const FHitResult& ImpactResult, const FVector& ImpactVelocity);
 
+	/** Sets the box a moving target bounces inside of. Called by TargetManager when the target is spawned and when
+	 *  the spawn volume changes. */
+	void SetMovementBounds(const FBox& InBounds);
+
+	/** Returns the location of the target at Time (world time seconds). Exact for targets using analytic movement,
+	 *  up to the next bounce for targets moving in any direction, otherwise the current location. */
+	FVector GetLocationAtTime(const double Time) const;
+
 	/** Called by TargetManager if settings were changed that could affect the target. */
 	void UpdatePlayerSettings(const FPlayerSettings_Game& InPlayerSettings);
 
@@ -238,7 +288,8 @@ protected:
 	UFUNCTION()
 	virtual void OnLifeSpanExpired();
 
-	/** Apply damage to self using a GE, for example when the ExpirationTimer timer expires. */
+	/** Apply damage to self using a GE, or directly if using lightweight damage, for example when the
+	 *  ExpirationTimer timer expires. */
 	void DamageSelf(const bool bTreatAsExternalDamage = false);
 
 	/** Reset the health of the target using a GE. */
@@ -286,6 +337,16 @@ protected:
 	UFUNCTION()
 	void InterpShrinkQuickAndGrowSlow(const float Alpha);
 
+	/** Finds the custom primitive data indices of the material parameters.
+	 *  @return true if the sphere material reads the base color, outline color, and whether to use the separate
+	 *  outline color from custom primitive data, false if any of them need a Dynamic Material Instance */
+	bool InitMaterialParameters();
+
+	/** Sets a material parameter in custom primitive data, or on TargetColorChangeMaterial if the material doesn't
+	 *  read it from custom primitive data. Parameters without a name are only set in custom primitive data. */
+	void SetMaterialParameter(const FTargetMaterialParameter& Parameter, const FLinearColor& Value);
+	void SetMaterialParameter(const FTargetMaterialParameter& Parameter, const float Value);
+
 public:
 	/** Sets the color of the Base Target. */
 	UFUNCTION(BlueprintCallable)
@@ -412,6 +473,9 @@ protected:
 	UPROPERTY()
 	FBS_TargetConfig Config;
 
+	/** The response and condition arrays of Config as bitmasks. */
+	FBS_TargetResponseFlags ResponseFlags;
+
 	/** Timer to track the length of time the target has been damageable for. */
 	UPROPERTY()
 	FTimerHandle ExpirationTimer;
@@ -444,6 +508,16 @@ protected:
 	/** The color of the target when it was destroyed. */
 	FLinearColor ColorWhenDamageTaken;
 
+	/** The last color passed to SetTargetColor. */
+	FLinearColor CurrentTargetColor;
+
+	/** Sphere material parameters set by the target. */
+	FTargetMaterialParameter BaseColorParameter;
+	FTargetMaterialParameter OutlineColorParameter;
+	FTargetMaterialParameter UseSeparateOutlineColorParameter;
+	FTargetMaterialParameter LifetimeFractionParameter;
+	FTargetMaterialParameter HighlightParameter;
+
 	/** The type of damage this target is vulnerable to. */
 	ETargetDamageType TargetDamageType;
 
@@ -468,6 +542,44 @@ protected:
 	/** whether the target is currently activated. */
 	bool bIsCurrentlyActivated;
 
+	/** Whether the target takes damage through ApplyLightweightDamage. Set in Init, the ability system component
+	 *  is not initialized if true. */
+	bool bUseLightweightDamage;
+
+	/** Health and max health of the target if using lightweight damage. */
+	float LightweightHealth;
+	float LightweightMaxHealth;
+
+	/** Moves the target along Trajectory, rebuilding it if the velocity, location, or bounds were changed outside of
+	 *  the trajectory. */
+	void UpdateAnalyticMovement();
+
+	/** Whether the target moves along Trajectory instead of being simulated by the ProjectileMovementComponent,
+	 *  which then only stores the speed and velocity. */
+	bool bUseAnalyticMovement;
+
+	/** The closed form path of a moving target, rebuilt whenever its velocity or bounds change. */
+	FTargetTrajectory Trajectory;
+
+	/** The box a moving target bounces inside of. */
+	FBox MovementBounds;
+
+	/** The location, velocity, time, and radius of the last UpdateAnalyticMovement, used to detect outside
+	 *  changes. */
+	FVector LastTrajectoryLocation;
+	FVector LastTrajectoryVelocity;
+	double LastTrajectoryTime;
+	float LastTrajectoryRadius;
+
+	/** Whether Trajectory needs to be rebuilt, e.g. because MovementBounds changed. */
+	bool bTrajectoryDirty;
+
+	/** Advances the StartToPeak, PeakToEnd, and ShrinkQuickAndGrowSlow timelines. */
+	void TickTimelines(const float DeltaSeconds);
+
+	/** Splits frames into fixed steps for the timelines if bs_sim.fixedtimestep is set. Set in Init. */
+	FBSFixedTimestep SimulationTimestep;
+
 	FActiveGameplayEffectHandle ActiveGE_TargetImmunity;
 	FActiveGameplayEffectHandle ActiveGE_HitImmunity;
 	FActiveGameplayEffectHandle ActiveGE_TrackingImmunity;
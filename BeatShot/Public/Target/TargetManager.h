@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "TargetCommon.h"
+#include "MovingTargetDirectionTable.h"
+#include "BSGameModeConfig/TargetResponseFlags.h"
 #include "GameFramework/Actor.h"
 #include "TargetManager.generated.h"
 
@@ -24,10 +26,6 @@ static constexpr int32 DefaultNumTargetsToActivate = 100;
 static constexpr int32 DefaultMinToActivate_MinClamp = 1;
 static constexpr int32 MaxToActivate_MinClamp = 1;
 
-static const TArray AnyDirectionModeMultipliers = {
-	FVector(0, -1, -1), FVector(0, 1, -1), FVector(0, -1, 1), FVector(0, 1, 1)
-};
-
 /** Class responsible for spawning and managing targets for all game modes. */
 UCLASS()
 class BEATSHOT_API ATargetManager : public AActor
@@ -38,6 +36,7 @@ class BEATSHOT_API ATargetManager : public AActor
 	friend class ABeatShotGameModeFunctionalTest;
 	friend class FTargetManagerTestBase;
 	friend class FTargetManagerTestWithWorld;
+	friend class UBSGameModeSimulatorCommandlet;
 
 public:
 	ATargetManager();
@@ -117,9 +116,10 @@ protected:
 	FName CurveTableRowName_Linear_PreThreshold = FName("Linear_PreThreshold");
 
 public:
-	/** Initializes  */
+	/** Initializes the TargetManager and its components. Every random stream used to spawn, activate, and move
+	 *  targets is seeded from InRandomSeed, so the same seed and beats produce the same targets. */
 	void Init(const TSharedPtr<FBSConfig>& InConfig, const FCommonScoreInfo& InCommonScoreInfo,
-		const FPlayerSettings_Game& InPlayerSettings);
+		const FPlayerSettings_Game& InPlayerSettings, const int32 InRandomSeed = 0);
 
 	/** Resets all state and destroys all actors. Calls clear on Components who also manage state. */
 	void Clear();
@@ -164,6 +164,10 @@ protected:
 	/** Returns true if the target should be destroyed based on TargetDestructionConditions. */
 	bool ShouldDestroyTarget(const bool bExpired, const bool bOutOfHealth) const;
 
+	/** Compiles the response and condition arrays of the target config into ResponseFlags and
+	 *  DeactivationResponseHandlers. */
+	void CompileTargetResponses();
+
 	/** Spawns targets at the beginning of a game mode based on the TargetDistributionPolicy. */
 	int32 HandleUpfrontSpawning();
 
@@ -254,16 +258,17 @@ protected:
 	/** Updates the SpawnVolume and all directional boxes to match the current SpawnBox. */
 	virtual void UpdateSpawnVolume(const float Factor) const;
 
+	/** Returns the box enclosed by the directional boxes, which moving targets bounce inside of. */
+	FBox GetMovingTargetBounds() const;
+
 	/** Calls GetNewTargetDirection and sets the new direction of the target. Also bound to targets'
 	 *  OnDeactivationResponse_ChangeDirection delegate, which it calls with parameter 2. \n\n
 	 *  Spawn = 0, Activation  = 1, Deactivation = 2. */
 	void ChangeTargetDirection(ATarget* InTarget, const uint8 InSpawnActivationDeactivation) const;
 
-	/** Returns a new unit vector direction for a target. */
+	/** Returns a new unit vector direction for a target, sampled from MovingTargetDirectionStream. */
 	FVector GetNewTargetDirection(const FVector& LocationBeforeChange, const bool bLastDirectionChangeHorizontal) const;
 
-	static TArray<FVector> GetAnyDirectionMultipliers(const FVector& LocationBeforeChange, const FVector& Origin);
-
 	/** Updates the total amount of damage that can be done if a tracking target is damageable. */
 	void UpdateTotalPossibleDamage();
 
@@ -297,12 +302,33 @@ public:
 	void UpdateCommonScoreInfoQTable(FCommonScoreInfo& InCommonScoreInfo) const;
 
 protected:
+	/** Random number stream for target speeds and scales, and the seeds of the other streams. Seeded in Init. */
+	FRandomStream RandomStream;
+
 	/** Random number stream to keep randomization in sync between HandleRuntimeSpawning and HandleTargetActivation. */
 	FRandomStream RandomNumToActivateStream;
 
+	/** Random number stream for new moving target directions and the MovingTargetDirectionTable. */
+	FRandomStream MovingTargetDirectionStream;
+
+	/** Candidate locations for new directions in the Any direction mode, rebuilt by UpdateSpawnVolume when the
+	 *  spawn box changes. */
+	mutable FMovingTargetDirectionTable MovingTargetDirectionTable;
+
 	/** Initialized at start of game mode by DefaultGameMode. */
 	TSharedPtr<FBSConfig> BSConfig;
 
+	/** Executes one deactivation response on a target. */
+	using FDeactivationResponseHandler = void(*)(const ATargetManager& TargetManager, ATarget* InTarget,
+		const bool bExpired);
+
+	/** The target config's response and condition arrays as bitmasks, compiled during Init. */
+	FBS_TargetResponseFlags ResponseFlags;
+
+	/** Handlers for the deactivation responses in the target config, in the order they are executed. Doesn't include
+	 *  Reactivate, which is executed after the target is deactivated. */
+	TArray<FDeactivationResponseHandler, TInlineAllocator<8>> DeactivationResponseHandlers;
+
 	/** whether the TargetManager is allowed to spawn a target at a given time. */
 	bool ShouldSpawn;
 
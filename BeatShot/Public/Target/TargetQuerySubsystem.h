@@ -0,0 +1,118 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TargetQuerySubsystem.generated.h"
+
+class ATarget;
+
+/** Bounding spheres stored as a structure of arrays, padded to a multiple of four so that a ray can be tested against
+ *  four spheres at a time. Centers are stored as floats, which is more than precise enough inside a range level. */
+struct BEATSHOT_API FTargetSphereSet
+{
+	void Reset();
+
+	/** Adds a sphere. A negative radius adds a sphere that is never hit.
+	 *  @return the index of the sphere
+	 */
+	int32 Add(const FVector& Center, const float Radius);
+
+	/** Moves and resizes the sphere at Index. A negative radius keeps the sphere from being hit. */
+	void Set(const int32 Index, const FVector& Center, const float Radius);
+
+	/** Removes the sphere at Index, moving the last sphere into its place. */
+	void RemoveAtSwap(const int32 Index);
+
+	int32 Num() const { return NumSpheres; }
+
+	/** Finds the nearest sphere whose surface the ray enters within MaxDistance. Like a line trace that starts inside
+	 *  a shape, a sphere that contains the origin is hit at a distance of zero.
+	 *  @param Origin the start of the ray
+	 *  @param Direction the unit direction of the ray
+	 *  @param MaxDistance the length of the ray
+	 *  @param OutDistance the distance along the ray to the surface of the nearest sphere, if any
+	 *  @param IgnoredSpheres the indices of spheres to skip
+	 *  @return the index of the nearest sphere, or INDEX_NONE if no sphere was hit
+	 */
+	int32 Raycast(const FVector& Origin, const FVector& Direction, const double MaxDistance, double& OutDistance,
+		const TSet<int32>& IgnoredSpheres = TSet<int32>()) const;
+
+private:
+	TArray<float, TAlignedHeapAllocator<16>> CenterX;
+	TArray<float, TAlignedHeapAllocator<16>> CenterY;
+	TArray<float, TAlignedHeapAllocator<16>> CenterZ;
+
+	/** Negative for padding, so that padding is never hit. */
+	TArray<float, TAlignedHeapAllocator<16>> RadiusSquared;
+
+	int32 NumSpheres = 0;
+};
+
+/** A target registered with UTargetQuerySubsystem, which owns the sphere at the same index. */
+struct FTargetQueryEntry
+{
+	TWeakObjectPtr<ATarget> Target;
+
+	/** The unique ID of Target, kept so the entry can be found after Target is destroyed. */
+	uint32 UniqueID;
+
+	/** Whether Target blocks weapon traces but can't be represented by a sphere. */
+	bool bNotSphere;
+};
+
+/** Answers weapon traces against targets analytically. ATargetManager registers every target it manages, and since
+ *  every target is a sphere, weapon traces first intersect the ray with the bounding spheres of all live targets, and
+ *  only use the physics scene to look for level geometry in front of the nearest target. Falls back to a full physics
+ *  trace if any target is not a sphere.
+ *
+ *  The spheres are kept up to date as targets move, scale, activate, and deactivate, so a trace never visits every
+ *  target on the game thread. */
+UCLASS()
+class BEATSHOT_API UTargetQuerySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterTarget(ATarget* Target);
+	void UnregisterTarget(ATarget* Target);
+	void UnregisterAllTargets();
+
+	/** Updates the sphere of a registered target, e.g. after its collision changed. Movement and scale changes are
+	 *  picked up automatically. */
+	void UpdateTarget(const ATarget* Target);
+
+	/** Finds the first blocking hit on BS_TraceChannel_Weapon between Start and End, giving the same result as
+	 *  LineTraceSingleByChannel.
+	 *  @return true if there was a blocking hit
+	 */
+	bool WeaponTrace(FHitResult& OutHit, const FVector& Start, const FVector& End,
+		const FCollisionQueryParams& Params);
+
+private:
+	/** Updates the sphere at Index from the current location, scale, and collision of its target. */
+	void UpdateSphere(const int32 Index);
+
+	/** Removes the entry and sphere at Index, moving the last ones into their place. */
+	void RemoveTargetAt(const int32 Index);
+
+	/** Bound to the TransformUpdated event of the capsule of each registered target. */
+	void OnTargetTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+		ETeleportType Teleport);
+
+	/** Fills OutHit with a hit on the target at SphereIndex. */
+	void MakeTargetHit(FHitResult& OutHit, const int32 SphereIndex, const FVector& Start, const FVector& End,
+		const double Distance) const;
+
+	TArray<FTargetQueryEntry> Entries;
+
+	/** The index in Entries of each registered target, by unique ID. */
+	TMap<uint32, int32> EntryIndices;
+
+	/** The number of entries where bNotSphere is true. */
+	int32 NumNonSphereTargets = 0;
+
+	FTargetSphereSet Spheres;
+};
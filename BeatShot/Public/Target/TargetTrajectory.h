@@ -0,0 +1,42 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Closed form trajectory of a moving target: linear motion that reflects off the faces of an axis-aligned box. Each
+ *  axis is a triangle wave, so the location at any time is exact and doesn't depend on frame rate. */
+struct BEATSHOT_API FTargetTrajectory
+{
+	FTargetTrajectory() = default;
+
+	/** @param InStartTime the time the target was at InStartLocation
+	 *  @param InStartLocation the location at InStartTime, which is clamped to InBounds
+	 *  @param InVelocity the velocity at InStartTime
+	 *  @param InBounds the box the location must stay inside of
+	 */
+	FTargetTrajectory(const double InStartTime, const FVector& InStartLocation, const FVector& InVelocity,
+		const FBox& InBounds);
+
+	/** Returns the location at Time, and optionally the velocity after any reflections. Times before StartTime
+	 *  extrapolate backwards along the same path. */
+	FVector Evaluate(const double Time, FVector* OutVelocity = nullptr) const;
+
+	/** Returns the first time after AfterTime that the path reflects off a face of the box, or MAX_dbl if it never
+	 *  does. Used to replace the reflection with a different bounce.
+	 *  @param AfterTime the time to search from
+	 *  @param OutNormal the normal of the face that is hit, pointing into the box
+	 */
+	double GetNextReflectionTime(const double AfterTime, FVector& OutNormal) const;
+
+	double GetStartTime() const { return StartTime; }
+	const FVector& GetStartLocation() const { return StartLocation; }
+	const FVector& GetStartVelocity() const { return Velocity; }
+	const FBox& GetBounds() const { return Bounds; }
+
+private:
+	double StartTime = 0.0;
+	FVector StartLocation = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	FBox Bounds = FBox(FVector::ZeroVector, FVector::ZeroVector);
+};
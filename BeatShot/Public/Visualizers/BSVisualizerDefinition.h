@@ -162,6 +162,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Analyzer ", meta=(DisplayPriority=-300))
 	ELightVisualizerGroupingMethod GroupingMethod;
 
+	/** Estimated time in milliseconds to update this visualizer once. Used by the VisualizerManager to schedule
+	 *  updates within its budget until the actual cost has been measured. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Performance", meta=(ClampMin=0, DisplayPriority=-200))
+	float UpdateCost;
+
 	/** Each index in this array represents an AudioAnalyzerChannel, where the element is an array of visualizer
 	 *  indices that should sync to this AudioAnalyzerChannel. */
 	TArray<FChannelToVisualizerMap> MappedIndices;
@@ -179,6 +184,7 @@ public:
 		NumVisualizerLightsToSpawn = DefaultNumVisualizerLightsToSpawn;
 		AssignmentMethod = ELightVisualizerAssignmentMethod::MultiLightPerChannelOnly;
 		GroupingMethod = ELightVisualizerGroupingMethod::CombineByProximity;
+		UpdateCost = DefaultVisualizerUpdateCost;
 		MappedIndices = TArray<FChannelToVisualizerMap>();
 	}
 
@@ -27,6 +27,9 @@ public:
 	/** Activates the matching visualizer from the given index if it isn't already. */
 	virtual void UpdateVisualizer(const int32 Index, const float SpectrumAlpha) override;
 
+	/** Returns true if any of the beam lights were recently rendered. */
+	virtual bool IsVisualizerVisible() const override;
+
 	/** Deactivates all Beam Light visualizers. */
 	void DeactivateVisualizers();
 
@@ -6,6 +6,7 @@
 #include "BSConstants.h"
 #include "Components/TimelineComponent.h"
 #include "GameFramework/Actor.h"
+#include "Physics/BSSceneQuerySubsystem.h"
 #include "SimpleBeamLight.generated.h"
 
 class USpotLightComponent;
@@ -18,6 +19,34 @@ class UMaterialInstanceDynamic;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnBeamLightLifetimeCompleted, const int32 OutIndex);
 
+/** A beam traced from a SimpleBeamLight's SpotlightHead, quantized so that nearly identical beams share a cached
+ *  trace. */
+struct FBeamLightTraceKey
+{
+	/** Start of the beam, rounded to the nearest unit. */
+	FIntVector Start;
+
+	/** Direction of the beam, divided by BeamLightTraceCacheDirectionTolerance and rounded. */
+	FIntVector Direction;
+
+	bool operator==(const FBeamLightTraceKey& Other) const
+	{
+		return Start == Other.Start && Direction == Other.Direction;
+	}
+
+	friend uint32 GetTypeHash(const FBeamLightTraceKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.Start), GetTypeHash(Key.Direction));
+	}
+};
+
+/** A cached SimpleBeamLight trace and the frame it was traced on. */
+struct FBeamLightTraceCacheEntry
+{
+	FHitResult HitResult;
+	uint64 Frame = 0;
+};
+
 using namespace Constants;
 
 USTRUCT(BlueprintType, Category = "Simple Beam Light Config")
@@ -51,6 +80,26 @@ struct FSimpleBeamLightConfig
 		meta=(DisplayPriority=400, EditCondition="bIsMovingLight", EditConditionHides))
 	UCurveVector* LightMovementCurve;
 
+	/** Whether to cache line trace results of a moving light, keyed by the start and direction of the beam. Only hits
+	 *  against static geometry and misses are cached, and each is traced again after
+	 *  BeamLightTraceCacheLifetimeFrames. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Simple Beam Light Config | Movement",
+		meta=(DisplayPriority=410, EditCondition="bIsMovingLight", EditConditionHides))
+	bool bCacheLineTraces = true;
+
+	/** The most traces the cache holds, and the number of evenly spaced times along the LightMovementCurve that
+	 *  traces are precomputed for. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Simple Beam Light Config | Movement",
+		meta=(DisplayPriority=420, EditCondition="bIsMovingLight && bCacheLineTraces", EditConditionHides, ClampMin=2,
+			ClampMax=4096))
+	int32 NumCachedTraces = DefaultNumCachedBeamLightTraces;
+
+	/** Whether to trace NumCachedTraces evenly spaced times along the LightMovementCurve on initialization, so that
+	 *  the first pass of the light mostly reads from the cache. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Simple Beam Light Config | Movement",
+		meta=(DisplayPriority=430, EditCondition="bIsMovingLight && bCacheLineTraces", EditConditionHides))
+	bool bPrecomputeTraceCache = false;
+
 	/** whether to activate the Spotlight. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Simple Beam Light Config | Spotlight",
 		meta=(DisplayPriority=500))
@@ -112,6 +161,9 @@ struct FSimpleBeamLightConfig
 		Index = INDEX_NONE;
 		bIsMovingLight = false;
 		LightMovementCurve = nullptr;
+		bCacheLineTraces = true;
+		NumCachedTraces = DefaultNumCachedBeamLightTraces;
+		bPrecomputeTraceCache = false;
 		LightColor = FLinearColor::White;
 		bUseSpotlight = false;
 		MaxSpotlightIntensity = DefaultMaxSpotlightIntensity;
@@ -146,6 +198,8 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void Tick(float DeltaTime) override;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SimpleBeamLight | Components")
@@ -200,6 +254,10 @@ public:
 	UFUNCTION(CallInEditor)
 	void UpdateBeamEndLightLocation();
 
+	/** Empties the trace cache. Should be called if level geometry in front of the light changes. The cache is
+	 *  invalidated automatically when the light is moved or a level is added to or removed from its world. */
+	void InvalidateTraceCache();
+
 private:
 	/** Calls DeactivateLightComponents. */
 	UFUNCTION()
@@ -209,6 +267,39 @@ private:
 	UFUNCTION()
 	void LineTraceFromSpotlightHead(const FVector& EndLocation, FHitResult& OutHitResult) const;
 
+	/** Submits a deferred trace forward from SpotlightHead, and caches the result for the beam if it hit static
+	 *  geometry or nothing at all before calling Delegate. */
+	void SubmitTraceFromSpotlightHead(const FVector& EndLocation, const int32 LatencyTolerance,
+		FBSSceneQueryDelegate&& Delegate);
+
+	/** Returns true and fills OutHitResult with the beam towards EndLocation intersected with the cached hit of the
+	 *  same beam, if it hasn't expired. */
+	bool FindCachedTrace(const FVector& EndLocation, FHitResult& OutHitResult) const;
+
+	/** Caches the trace result for Key if it hit static geometry or nothing at all, or removes the cached trace for
+	 *  Key if it hit anything else. */
+	void CacheTrace(const FBeamLightTraceKey& Key, const FHitResult& HitResult);
+
+	/** Removes every cached trace older than BeamLightTraceCacheLifetimeFrames. */
+	void RemoveExpiredTraces();
+
+	/** Fills the trace cache by tracing at NumCachedTraces evenly spaced times along the LightMovementCurve. The
+	 *  traces are spread out over as many frames as the scene query budget requires. */
+	void PrecomputeTraceCache();
+
+	/** Returns the cache key for a beam traced from Start to End. */
+	static FBeamLightTraceKey GetTraceCacheKey(const FVector& Start, const FVector& End);
+
+	/** Returns whether a trace cached on Frame is too old to be reused. */
+	static bool IsTraceExpired(const uint64 Frame);
+
+	/** Invalidates the trace cache if the root component moves. */
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+		ETeleportType Teleport);
+
+	/** Invalidates the trace cache if a level is streamed into or out of this light's world. */
+	void OnLevelsChanged(ULevel* Level, UWorld* World);
+
 	/** Sets the position and rotation of LightPositionComponent, which is basically BeamEndLight. */
 	void UpdateBeamEndLightTransform(const FHitResult& HitResult) const;
 
@@ -231,12 +322,39 @@ private:
 	UFUNCTION()
 	void LightMovementCurveCallback(const FVector& Position);
 
+	/** Points the beam at the hit and updates the light intensities for the playback position. */
+	void UpdateMovingBeam(const FHitResult& Hit, const float PlaybackPosition);
+
 	/** The timeline to link to the LightMovementCurve. */
 	FTimeline LightPositionTimeline;
 
 	/** Delegate that binds the LightPositionTimeline to LightMovementCurveCallback(). */
 	FOnTimelineVector TimelineVectorDelegate;
 
+	/** Trace results from SpotlightHead, keyed by the beam they were traced along. */
+	TMap<FBeamLightTraceKey, FBeamLightTraceCacheEntry> TraceCache;
+
+	/** The time range of the LightMovementCurve that precomputed traces are spread over. */
+	float TraceCacheMinTime = 0.f;
+	float TraceCacheMaxTime = 0.f;
+
+	/** Incremented when the trace cache is invalidated, so that traces submitted before then aren't cached. */
+	uint32 TraceCacheGeneration = 0;
+
+	/** Incremented for each trace submitted by LightMovementCurveCallback. */
+	uint32 BeamTraceSerial = 0;
+
+	/** Traces submitted by LightMovementCurveCallback with a lower serial are discarded when they complete, because
+	 *  a newer trace has already moved the beam or the light was deactivated. */
+	uint32 MinBeamTraceSerial = 0;
+
+	/** Handle for the root component TransformUpdated delegate. */
+	FDelegateHandle RootTransformUpdatedHandle;
+
+	/** Handles for the FWorldDelegates level added and removed delegates. */
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+
 	float GimbalRotation;
 	float SpotlightHeadRotation;
 };
@@ -24,12 +24,14 @@ public:
 
 	virtual void InitializeVisualizer(const FPlayerSettings_AudioAnalyzer& InAASettings) override;
 
-	/** Updates the CubeHeightScale and the RedGreenAlpha for a cube at Index. */
+	/** Writes the new transforms and custom data for the cubes mapped to Index into the pending instance arrays. Cubes
+	 *  whose SpectrumAlpha has not changed by more than CubeVisualizerUpdateTolerance are skipped. */
 	virtual void UpdateVisualizer(const int32 Index, const float SpectrumAlpha) override;
 
-	/** Marks all instanced static meshes render states as dirty. Should be called by a VisualizerManager to limit the
-	 *  frequency of calls. */
-	virtual void MarkRenderStateDirty() override;
+	/** Submits the dirty instance range to each instanced static mesh with a single batched transform update and marks
+	 *  their render states dirty. Does nothing if no instance changed since the last call. Should be called by a
+	 *  VisualizerManager to limit the frequency of calls. */
+	virtual void SubmitPendingUpdates() override;
 
 	virtual void SetActivationState(const bool bActivate) override;
 
@@ -87,14 +89,51 @@ private:
 	FVector GetScale3D(const float ScaledHeight);
 
 	/** Returns the transform to be supplied to the InstancedTopMesh. */
-	FTransform GetTopMeshTransform(const int32 Index, const float SpectrumValue);
+	FTransform GetTopMeshTransform(const int32 Index, const float ScaledHeight);
 
 	/** Returns the transform to be supplied to the InstancedBaseMesh and InstancedVerticalOutlineMesh. */
-	FTransform GetSideAndBaseTransform(const int32 Index, const float SpectrumValue);
+	FTransform GetSideAndBaseTransform(const int32 Index, const float ScaledHeight);
 
 	/** Adds an instance for each mesh that is updated, i.e. InstancedBaseMesh, InstancedVerticalOutlineMesh, and
 	 *  InstancedTopMesh with the given RelativeTransform. */
 	void AddInstancedCubeMesh(const FTransform& RelativeTransform);
 
-	TMap<int32, FTransform> IndexTransformMap;
+	/** Clears all instances and the pending instance arrays. */
+	void ClearCubeInstances();
+
+	/** Expands the dirty instance range to include Index. */
+	void MarkInstanceDirty(const int32 Index);
+
+	/** Submits DirtyTransforms, which start at DirtyStartIndex, and the dirty range of PendingCustomData to
+	 *  InstancedMesh, marking its render state dirty once. Ensures that InstancedMesh has an instance for every dirty
+	 *  index. */
+	void SubmitInstanceRange(UInstancedStaticMeshComponent* InstancedMesh,
+		const TArray<FTransform>& DirtyTransforms) const;
+
+	/** Returns the dirty range of Transforms, either Transforms itself or a copy in DirtyTransformsBuffer. */
+	const TArray<FTransform>& GetDirtyTransforms(const TArray<FTransform>& Transforms);
+
+	/** The unscaled spawn transform of each cube, indexed by instance index. */
+	TArray<FTransform> InstanceSpawnTransforms;
+
+	/** Pending transforms for InstancedBaseMesh and InstancedVerticalOutlineMesh, indexed by instance index. */
+	TArray<FTransform> PendingSideAndBaseTransforms;
+
+	/** Pending transforms for InstancedTopMesh, indexed by instance index. */
+	TArray<FTransform> PendingTopTransforms;
+
+	/** Pending custom data value shared by all three meshes, indexed by instance index. */
+	TArray<float> PendingCustomData;
+
+	/** Reused storage for partially dirty transform ranges. */
+	TArray<FTransform> DirtyTransformsBuffer;
+
+	/** The SpectrumAlpha last written for each instance, used to skip updates within tolerance. */
+	TArray<float> LastSpectrumAlpha;
+
+	/** First instance index that has changed since the last SubmitPendingUpdates, or INDEX_NONE if clean. */
+	int32 DirtyStartIndex;
+
+	/** Last instance index that has changed since the last SubmitPendingUpdates, or INDEX_NONE if clean. */
+	int32 DirtyEndIndex;
 };
@@ -0,0 +1,72 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BSConstants.h"
+
+/** Processes the spectrum values of all band channels at once for the VisualizerManager. Keeps the running
+ *  max-tracking and decay state in aligned float arrays padded to DefaultMaxNumBandChannels, and processes four
+ *  channels per instruction. The results are stored in shared output buffers read by all visualizers. */
+struct BEATSHOT_API FVisualizerBandProcessor
+{
+	/** Maximum number of band channels that can be processed. */
+	static constexpr int32 MaxNumBands = Constants::DefaultMaxNumBandChannels;
+
+	static_assert(MaxNumBands % 4 == 0, "MaxNumBands must be a multiple of the vector width.");
+	static_assert(MaxNumBands <= 32, "MaxNumBands must fit inside BeamTriggeredMask.");
+
+	FVisualizerBandProcessor();
+
+	/** Resets all state and outputs for NumBands channels. */
+	void Init(const int32 InNumBands);
+
+	/** Applies max-tracking, normalization, and decay for all channels using the new SpectrumValues and the average
+	 *  spectrum values. Fills BeamAlpha, CubeAlpha, and BeamTriggeredMask. */
+	void Process(const TArray<float>& SpectrumValues, const TArray<float>& AvgSpectrumValues);
+
+	/** Returns the number of band channels being processed. */
+	int32 GetNumBands() const { return NumBands; }
+
+	/** Returns the normalized beam value for a channel. Only valid if IsBeamTriggered returns true. */
+	float GetBeamAlpha(const int32 Index) const { return BeamAlpha[Index]; }
+
+	/** Returns the normalized cube value for a channel. */
+	float GetCubeAlpha(const int32 Index) const { return CubeAlpha[Index]; }
+
+	/** Returns whether the channel started a new beam during the last call to Process. */
+	bool IsBeamTriggered(const int32 Index) const { return (BeamTriggeredMask & (1u << Index)) != 0; }
+
+	/** Returns the bitmask of channels that started a new beam during the last call to Process. */
+	uint32 GetBeamTriggeredMask() const { return BeamTriggeredMask; }
+
+	/** Returns the current decaying spectrum value of a channel, used by beam visualizers. */
+	float GetCurrentSpectrumValue(const int32 Index) const { return CurrentSpectrumValues[Index]; }
+
+	/** Returns the current decaying spectrum value of a channel, used by cube visualizers. */
+	float GetCurrentCubeSpectrumValue(const int32 Index) const { return CurrentCubeSpectrumValues[Index]; }
+
+	/** Returns the current decaying max spectrum value of a channel. */
+	float GetMaxSpectrumValue(const int32 Index) const { return MaxSpectrumValues[Index]; }
+
+private:
+	/** Copies up to NumBands values from Source into the aligned Dest array, zeroing any remaining padded lanes. */
+	void CopyToAligned(const TArray<float>& Source, float* Dest) const;
+
+	/** Number of channels being processed. */
+	int32 NumBands;
+
+	/** Number of vector registers needed to cover NumBands. */
+	int32 NumVectors;
+
+	/** Bit N is set if channel N started a new beam during the last call to Process. */
+	uint32 BeamTriggeredMask;
+
+	alignas(16) float InputValues[MaxNumBands];
+	alignas(16) float AvgValues[MaxNumBands];
+	alignas(16) float CurrentSpectrumValues[MaxNumBands];
+	alignas(16) float CurrentCubeSpectrumValues[MaxNumBands];
+	alignas(16) float MaxSpectrumValues[MaxNumBands];
+	alignas(16) float BeamAlpha[MaxNumBands];
+	alignas(16) float CubeAlpha[MaxNumBands];
+};
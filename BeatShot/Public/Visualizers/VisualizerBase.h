@@ -54,12 +54,19 @@ public:
 	/** Called by the VisualizerManager when AudioAnalyzer settings are changed. Calls InitializeVisualizer. */
 	virtual void UpdateAASettings(const FPlayerSettings_AudioAnalyzer& InAASettings);
 
-	/** If the visualizer is using an instanced static mesh, use this function to rerender the meshes. Should be called
-	 *  by VisualizerManager. */
-	virtual void MarkRenderStateDirty()
+	/** If the visualizer is using an instanced static mesh, use this function to submit any instance data changed by
+	 *  UpdateVisualizer since the last call. Should be called by VisualizerManager once per update. */
+	virtual void SubmitPendingUpdates()
 	{
 	}
 
+	/** Returns whether any part of the visualizer has been rendered recently. Used by the VisualizerManager to
+	 *  prioritize updates. */
+	virtual bool IsVisualizerVisible() const;
+
+	/** Returns the estimated cost in milliseconds of updating this visualizer once. */
+	float GetUpdateCost() const;
+
 	/** Returns the definition for this visualizer. */
 	virtual UBSVisualizerDefinition* GetVisualizerDefinition() const { return VisualizerDefinition; }
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "VisualizerBandProcessor.h"
 #include "GameFramework/Actor.h"
 #include "VisualizerManager.generated.h"
 
@@ -13,6 +14,41 @@ class AStaticCubeVisualizer;
 class ABeamVisualizer;
 class UAudioAnalyzerManager;
 
+/** Scheduling state for a single visualizer, used by the VisualizerManager to distribute its update budget. Band
+ *  values produced while a visualizer is skipped are coalesced so that no beats are lost. */
+struct FVisualizerUpdateState
+{
+	/** The visualizer this state belongs to. */
+	TWeakObjectPtr<AVisualizerBase> Visualizer;
+
+	/** Whether the visualizer only responds to beam triggers instead of continuous cube values. */
+	bool bIsBeam = false;
+
+	/** Whether the visualizer was selected to update this frame. */
+	bool bScheduled = false;
+
+	/** Whether PendingCubeAlpha contains values that have not been sent to the visualizer. */
+	bool bHasPendingCubeAlpha = false;
+
+	/** Estimated cost in milliseconds of updating the visualizer, smoothed from measured update times. */
+	float EstimatedCost = 0.f;
+
+	/** Update priority for the current frame. */
+	float Priority = 0.f;
+
+	/** Number of frames the visualizer has had a pending update but was skipped. */
+	int32 FramesSinceUpdate = 0;
+
+	/** Bitmask of channels that triggered a beam since the last update. */
+	uint32 PendingBeamTriggeredMask = 0;
+
+	/** The beam alpha of each channel when it was last triggered. */
+	TArray<float> PendingBeamAlpha;
+
+	/** The peak cube alpha of each channel since the last update. */
+	TArray<float> PendingCubeAlpha;
+};
+
 /** The class responsible for managing visualizers in a level. There is only one per level,
  *  and the GameMode spawns it. */
 UCLASS()
@@ -47,17 +83,11 @@ public:
 	/** Updates visualizers based on player AudioAnalyzer settings. */
 	void UpdateAASettings(const FPlayerSettings_AudioAnalyzer& NewAASettings);
 
-	UPROPERTY(VisibleAnywhere, Category = "BeatShot|Update")
-	TArray<float> AvgSpectrumValues;
-
-	UPROPERTY(VisibleAnywhere, Category = "BeatShot|Update")
-	TArray<float> CurrentSpectrumValues;
+	/** Returns the shared band processing output that all visualizers read from. */
+	const FVisualizerBandProcessor& GetBandProcessor() const { return BandProcessor; }
 
 	UPROPERTY(VisibleAnywhere, Category = "BeatShot|Update")
-	TArray<float> CurrentCubeSpectrumValues;
-
-	UPROPERTY(VisibleAnywhere, Category = "BeatShot|Update")
-	TArray<float> MaxSpectrumValues;
+	TArray<float> AvgSpectrumValues;
 
 protected:
 	/* The base StaticCubeVisualizer class to spawn through code. */
@@ -86,6 +116,21 @@ protected:
 	UPROPERTY()
 	bool bUpdateCubeVisualizers;
 
+	/** Most time in milliseconds to spend updating visualizers each frame. Visualizers that have gone
+	 *  MaxFramesBetweenUpdates frames without an update are always updated first, and the rest are updated in order
+	 *  of priority while their estimated cost fits in what remains of the budget. Zero or less updates every
+	 *  visualizer every frame. */
+	UPROPERTY(EditDefaultsOnly, Category = "BeatShot|Budget", meta=(Units="Milliseconds"))
+	float UpdateBudget;
+
+	/** Number of frames a visualizer can be skipped before it is updated regardless of the UpdateBudget. */
+	UPROPERTY(EditDefaultsOnly, Category = "BeatShot|Budget", meta=(ClampMin=1))
+	int32 MaxFramesBetweenUpdates;
+
+	/** Distance from the camera at which a visualizer's update priority is halved. Zero or less ignores distance. */
+	UPROPERTY(EditDefaultsOnly, Category = "BeatShot|Budget")
+	float LODDistance;
+
 private:
 	TArray<TObjectPtr<ABeamVisualizer>> BeamVisualizers;
 	TArray<TObjectPtr<AStaticCubeVisualizer>> CubeVisualizers;
@@ -97,15 +142,25 @@ private:
 	/** Splits Visualizers into smaller subclass groups. */
 	void SplitVisualizers();
 
-	/** Updates any Beam Visualizers in BeamVisualizers. */
-	void UpdateBeamVisualizers(const int32 Index, const float SpectrumValue);
+	/** Resets the scheduling state of every visualizer for NumBands channels. */
+	void ResetUpdateStates(const int32 NumBands);
+
+	/** Returns whether the visualizer is active and has band values that it has not received yet. */
+	bool HasPendingUpdate(const FVisualizerUpdateState& State) const;
+
+	/** Merges the latest BandProcessor output into the pending band values of a visualizer. */
+	void AccumulatePendingBandValues(FVisualizerUpdateState& State, const int32 NumBands) const;
+
+	/** Marks the visualizers to update this frame based on visibility, distance from the camera, time since their
+	 *  last update, and the UpdateBudget. */
+	void ScheduleVisualizerUpdates();
 
-	/** Updates any Cube Visualizers in CubeVisualizers. */
-	void UpdateCubeVisualizers(const int32 Index, const float SpectrumValue);
+	/** Sends the pending band values to a visualizer, submits its batched updates, and measures the time taken. */
+	void UpdateVisualizer(FVisualizerUpdateState& State, const int32 NumBands);
 
-	/** Returns a normalized spectrum value based on recent spectrum values. */
-	float GetNormalizedSpectrumValue(const int32 Index, const bool bIsBeam);
+	/** Normalizes, peak-holds, and decays the spectrum values of all band channels at once. */
+	FVisualizerBandProcessor BandProcessor;
 
-	/** Marks the render state dirty on any visualizers using instanced static meshes. */
-	void MarkVisualizerRenderStateDirty();
+	/** Scheduling state for each visualizer in Visualizers. */
+	TArray<FVisualizerUpdateState> UpdateStates;
 };
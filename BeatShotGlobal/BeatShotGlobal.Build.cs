@@ -19,6 +19,12 @@ public class BeatShotGlobal : ModuleRules
 			"DeveloperSettings", "AudioModulation"
 		});
 
+		// Only used by the mock backend, which is compiled out of shipping builds
+		if (Target.Configuration != UnrealTargetConfiguration.Shipping)
+		{
+			PublicDependencyModuleNames.Add("HTTPServer");
+		}
+
 		PublicIncludePaths.Add(Path.Combine(EngineDirectory, "Plugins/Marketplace/DLSS/Source/ThirdParty/NGX/Include"));
 		PublicIncludePaths.Add(Path.Combine(EngineDirectory,
 			"Plugins/Marketplace/Streamline/Source/ThirdParty/Streamline/include"));
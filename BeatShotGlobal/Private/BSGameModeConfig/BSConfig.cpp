@@ -1,8 +1,62 @@
 ﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
 
 #include "BSGameModeConfig/BSConfig.h"
-#include "JsonObjectConverter.h"
+#include "BSConstants.h"
+#include "Hash/CityHash.h"
+#include "Misc/Base64.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Utilities/BSJsonStream.h"
+#include "Utilities/BSStructDelta.h"
 
+namespace
+{
+	/** The same fields that are skipped when converting to JSON. */
+	constexpr int64 ConfigSkipFlags = CPF_Transient | CPF_SkipSerialization;
+
+	/** Default values of FBSConfig that changed in a share code version. */
+	struct FShareCodeDefaultsChange
+	{
+		/** The share code version the defaults changed in. */
+		uint8 Version;
+
+		/** Sets the changed values back to their defaults in the previous version. */
+		void (*RestorePreviousDefaults)(FBSConfig& Config);
+	};
+
+	/** Every change to the defaults of FBSConfig, in increasing version order. Add an entry whenever
+	 *  GameModeShareCodeVersion is incremented. */
+	const TArray<FShareCodeDefaultsChange>& GetShareCodeDefaultsChanges()
+	{
+		static const TArray<FShareCodeDefaultsChange> Changes;
+		return Changes;
+	}
+
+	/** Writes the share code version followed by the fields of Config that differ from the defaults of the version. */
+	void SerializeCompact(const FBSConfig& Config, const uint8 InVersion, TArray<uint8>& OutBytes)
+	{
+		static const FBSConfig CurrentDefaults;
+		TOptional<FBSConfig> VersionDefaults;
+		if (InVersion != Constants::GameModeShareCodeVersion)
+		{
+			VersionDefaults = FBSConfig::GetShareCodeDefaults(InVersion);
+		}
+		const FBSConfig& Defaults = VersionDefaults.IsSet() ? VersionDefaults.GetValue() : CurrentDefaults;
+		FMemoryWriter Writer(OutBytes, true);
+		uint8 Version = InVersion;
+		Writer << Version;
+		BSStructDelta::WriteStruct(Writer, FBSConfig::StaticStruct(), &Config, &Defaults, ConfigSkipFlags);
+	}
+
+	void SetFailReason(FText* OutFailReason, const FString& Reason)
+	{
+		if (OutFailReason)
+		{
+			*OutFailReason = FText::FromString(Reason);
+		}
+	}
+}
 
 FBSConfig::FBSConfig()
 {
@@ -120,13 +174,9 @@ void FBSConfig::InitColors(const bool bUseSeparateOutlineColor, const FLinearCol
 
 FString FBSConfig::ToString() const
 {
-	const TSharedPtr<FJsonObject> JsonObject = FJsonObjectConverter::UStructToJsonObject<FBSConfig>(*this, 0,
-		CPF_Transient | CPF_SkipSerialization, nullptr);
-	if (JsonObject.IsValid())
+	FString JsonString;
+	if (BSJsonStream::UStructToJsonString(*this, JsonString, 0, ConfigSkipFlags))
 	{
-		FString JsonString;
-		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
 		return JsonString;
 	}
 	return FString();
@@ -144,14 +194,7 @@ FString FBSConfig::EncodeToString() const
 
 bool FBSConfig::FromString(const FString& JsonString, FBSConfig& OutConfig, FText* OutFailReason)
 {
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
-	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-	{
-		return FJsonObjectConverter::JsonObjectToUStruct<FBSConfig>(JsonObject.ToSharedRef(), &OutConfig, 0,
-			CPF_Transient | CPF_SkipSerialization, false, OutFailReason);
-	}
-	return false;
+	return BSJsonStream::JsonStringToUStruct(JsonString, &OutConfig, 0, ConfigSkipFlags, OutFailReason);
 }
 
 bool FBSConfig::DecodeFromString(const FString& EncodedString, FBSConfig& OutConfig, FText* OutFailReason)
@@ -166,3 +209,102 @@ bool FBSConfig::DecodeFromString(const FString& EncodedString, FBSConfig& OutCon
 	}
 	return false;
 }
+
+FString FBSConfig::EncodeToShareCode() const
+{
+	return EncodeToShareCode(Constants::GameModeShareCodeVersion);
+}
+
+FString FBSConfig::EncodeToShareCode(const uint8 Version) const
+{
+	TArray<uint8> Uncompressed;
+	SerializeCompact(*this, Version, Uncompressed);
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Uncompressed.Num());
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Uncompressed.GetData(),
+		Uncompressed.Num()))
+	{
+		return FString();
+	}
+
+	TArray<uint8> ShareCodeBytes;
+	FMemoryWriter Writer(ShareCodeBytes);
+	int32 UncompressedSize = Uncompressed.Num();
+	Writer << UncompressedSize;
+	Writer.Serialize(Compressed.GetData(), CompressedSize);
+	return Constants::GameModeShareCodePrefix + FBase64::Encode(ShareCodeBytes);
+}
+
+FBSConfig FBSConfig::GetShareCodeDefaults(const uint8 Version)
+{
+	FBSConfig Defaults;
+	const TArray<FShareCodeDefaultsChange>& Changes = GetShareCodeDefaultsChanges();
+	for (int32 i = Changes.Num() - 1; i >= 0 && Changes[i].Version > Version; i--)
+	{
+		Changes[i].RestorePreviousDefaults(Defaults);
+	}
+	return Defaults;
+}
+
+bool FBSConfig::DecodeFromShareCode(const FString& ShareCode, FBSConfig& OutConfig, FText* OutFailReason)
+{
+	const FString TrimmedShareCode = ShareCode.TrimStartAndEnd();
+	if (!TrimmedShareCode.StartsWith(Constants::GameModeShareCodePrefix, ESearchCase::CaseSensitive))
+	{
+		return DecodeFromString(TrimmedShareCode, OutConfig, OutFailReason);
+	}
+
+	TArray<uint8> ShareCodeBytes;
+	if (!FBase64::Decode(TrimmedShareCode.RightChop(FCString::Strlen(Constants::GameModeShareCodePrefix)),
+		ShareCodeBytes))
+	{
+		SetFailReason(OutFailReason, TEXT("Share code is not valid Base64"));
+		return false;
+	}
+
+	FMemoryReader Reader(ShareCodeBytes);
+	int32 UncompressedSize = 0;
+	Reader << UncompressedSize;
+	if (Reader.IsError() || UncompressedSize <= 0 || UncompressedSize > Constants::GameModeShareCodeMaxSize)
+	{
+		SetFailReason(OutFailReason, TEXT("Share code has an invalid size"));
+		return false;
+	}
+
+	const int64 CompressedOffset = Reader.Tell();
+	TArray<uint8> Uncompressed;
+	Uncompressed.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Zlib, Uncompressed.GetData(), UncompressedSize,
+		ShareCodeBytes.GetData() + CompressedOffset, ShareCodeBytes.Num() - CompressedOffset))
+	{
+		SetFailReason(OutFailReason, TEXT("Share code could not be decompressed"));
+		return false;
+	}
+
+	FMemoryReader UncompressedReader(Uncompressed, true);
+	uint8 Version = 0;
+	UncompressedReader << Version;
+	if (Version < Constants::MinGameModeShareCodeVersion || Version > Constants::GameModeShareCodeVersion)
+	{
+		SetFailReason(OutFailReason, FString::Printf(TEXT("Unsupported share code version %d"), Version));
+		return false;
+	}
+
+	FBSConfig Config = GetShareCodeDefaults(Version);
+	if (!BSStructDelta::ReadStruct(UncompressedReader, StaticStruct(), &Config, ConfigSkipFlags))
+	{
+		SetFailReason(OutFailReason, TEXT("Share code contains invalid game mode data"));
+		return false;
+	}
+	OutConfig = MoveTemp(Config);
+	return true;
+}
+
+uint64 FBSConfig::GetContentHash() const
+{
+	TArray<uint8> Bytes;
+	SerializeCompact(*this, Constants::GameModeShareCodeVersion, Bytes);
+	return CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), Bytes.Num());
+}
@@ -8,6 +8,24 @@
 #include "SaveGames/SaveGamePlayerScore.h"
 #include "Utilities/SaveLoadCommon.h"
 
+namespace
+{
+	/** Returns the display name of each preset base game mode mapped to the base game mode, ignoring case. */
+	const TMap<FString, EBaseGameMode>& GetPresetGameModeNames()
+	{
+		static const TMap<FString, EBaseGameMode> PresetGameModeNames = []()
+		{
+			TMap<FString, EBaseGameMode> Names;
+			for (const EBaseGameMode& Preset : TEnumRange<EBaseGameMode>())
+			{
+				Names.FindOrAdd(UEnum::GetDisplayValueAsText(Preset).ToString(), Preset);
+			}
+			return Names;
+		}();
+		return PresetGameModeNames;
+	}
+}
+
 /* --------------------------- */
 /* ---- Custom Game Modes ---- */
 /* --------------------------- */
@@ -22,6 +40,12 @@ TArray<FBSConfig> IBSGameModeInterface::LoadCustomGameModes()
 	return TArray<FBSConfig>();
 }
 
+void IBSGameModeInterface::PreloadCustomGameModes()
+{
+	SaveLoadCommon::LoadFromSlotAsync<USaveGameCustomGameMode>(TEXT("CustomGameModesSlot"), 3,
+		[](const USaveGameCustomGameMode*) {});
+}
+
 bool IBSGameModeInterface::FindCustomGameMode(const FString& CustomGameModeName, FBSConfig& OutConfig)
 {
 	if (const USaveGameCustomGameMode* SaveGameCustomGameMode = SaveLoadCommon::LoadFromSlot<USaveGameCustomGameMode>(
@@ -34,52 +58,52 @@ bool IBSGameModeInterface::FindCustomGameMode(const FString& CustomGameModeName,
 
 void IBSGameModeInterface::SaveCustomGameMode(const FBSConfig& ConfigToSave)
 {
-	if (USaveGameCustomGameMode* SaveGameCustomGameMode = SaveLoadCommon::LoadFromSlot<USaveGameCustomGameMode>(
-		TEXT("CustomGameModesSlot"), 3))
-	{
-		SaveGameCustomGameMode->SaveCustomGameMode(ConfigToSave);
-		SaveLoadCommon::SaveToSlot(SaveGameCustomGameMode, TEXT("CustomGameModesSlot"), 3);
-	}
+	SaveLoadCommon::ModifySlot<USaveGameCustomGameMode>(TEXT("CustomGameModesSlot"), 3,
+		[&ConfigToSave](USaveGameCustomGameMode& SaveGameCustomGameMode)
+		{
+			SaveGameCustomGameMode.SaveCustomGameMode(ConfigToSave);
+			return true;
+		});
 }
 
 int32 IBSGameModeInterface::RemoveCustomGameMode(const FBSConfig& ConfigToRemove)
 {
 	int32 NumCustomGameModesRemoved = 0;
-	if (USaveGameCustomGameMode* SaveGameCustomGameMode = SaveLoadCommon::LoadFromSlot<USaveGameCustomGameMode>(
-		TEXT("CustomGameModesSlot"), 3))
-	{
-		NumCustomGameModesRemoved = SaveGameCustomGameMode->RemoveCustomGameMode(ConfigToRemove);
-		SaveLoadCommon::SaveToSlot(SaveGameCustomGameMode, TEXT("CustomGameModesSlot"), 3);
-	}
-	if (USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
-	{
-		const int32 NumCommonScoreInfosRemoved = SaveGamePlayerScore->RemoveCommonScoreInfo(
-			ConfigToRemove.DefiningConfig);
-		UE_LOG(LogTemp, Display, TEXT("%d Common Score Infos removed when removing a custom game mode."),
-			NumCommonScoreInfosRemoved);
-		SaveLoadCommon::SaveToSlot(SaveGamePlayerScore, TEXT("ScoreSlot"), 1);
-	}
+	SaveLoadCommon::ModifySlot<USaveGameCustomGameMode>(TEXT("CustomGameModesSlot"), 3,
+		[&ConfigToRemove, &NumCustomGameModesRemoved](USaveGameCustomGameMode& SaveGameCustomGameMode)
+		{
+			NumCustomGameModesRemoved = SaveGameCustomGameMode.RemoveCustomGameMode(ConfigToRemove);
+			return true;
+		});
+	SaveLoadCommon::ModifySlot<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+		[&ConfigToRemove](USaveGamePlayerScore& SaveGamePlayerScore)
+		{
+			const int32 NumCommonScoreInfosRemoved = SaveGamePlayerScore.RemoveCommonScoreInfo(
+				ConfigToRemove.DefiningConfig);
+			UE_LOG(LogTemp, Display, TEXT("%d Common Score Infos removed when removing a custom game mode."),
+				NumCommonScoreInfosRemoved);
+			return true;
+		});
 	return NumCustomGameModesRemoved;
 }
 
 int32 IBSGameModeInterface::RemoveAllCustomGameModes()
 {
 	int32 NumCustomGameModesRemoved = 0;
-	if (USaveGameCustomGameMode* SaveGameCustomGameMode = SaveLoadCommon::LoadFromSlot<USaveGameCustomGameMode>(
-		TEXT("CustomGameModesSlot"), 3))
-	{
-		NumCustomGameModesRemoved = SaveGameCustomGameMode->RemoveAll();
-		SaveLoadCommon::SaveToSlot(SaveGameCustomGameMode, TEXT("CustomGameModesSlot"), 3);
-	}
-	if (USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
-	{
-		const int32 NumCommonScoreInfosRemoved = SaveGamePlayerScore->RemoveAllCustomGameModeCommonScoreInfo();
-		UE_LOG(LogTemp, Display, TEXT("%d Common Score Infos removed when removing all custom game modes."),
-			NumCommonScoreInfosRemoved);
-		SaveLoadCommon::SaveToSlot(SaveGamePlayerScore, TEXT("ScoreSlot"), 1);
-	}
+	SaveLoadCommon::ModifySlot<USaveGameCustomGameMode>(TEXT("CustomGameModesSlot"), 3,
+		[&NumCustomGameModesRemoved](USaveGameCustomGameMode& SaveGameCustomGameMode)
+		{
+			NumCustomGameModesRemoved = SaveGameCustomGameMode.RemoveAll();
+			return true;
+		});
+	SaveLoadCommon::ModifySlot<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+		[](USaveGamePlayerScore& SaveGamePlayerScore)
+		{
+			const int32 NumCommonScoreInfosRemoved = SaveGamePlayerScore.RemoveAllCustomGameModeCommonScoreInfo();
+			UE_LOG(LogTemp, Display, TEXT("%d Common Score Infos removed when removing all custom game modes."),
+				NumCommonScoreInfosRemoved);
+			return true;
+		});
 	return NumCustomGameModesRemoved;
 }
 
@@ -116,7 +140,7 @@ bool IBSGameModeInterface::DoesCustomGameModeMatchConfig(const FString& CustomGa
 ECustomGameModeImportResult IBSGameModeInterface::ImportCustomGameMode(const FString& InSerializedJsonString,
 	FBSConfig& OutConfig, FText& OutDecodeFailureReason)
 {
-	if (!FBSConfig::DecodeFromString(InSerializedJsonString, OutConfig, &OutDecodeFailureReason))
+	if (!FBSConfig::DecodeFromShareCode(InSerializedJsonString, OutConfig, &OutDecodeFailureReason))
 	{
 		return ECustomGameModeImportResult::InvalidImportString;
 	}
@@ -141,7 +165,7 @@ ECustomGameModeImportResult IBSGameModeInterface::ImportCustomGameMode(const FSt
 
 FString IBSGameModeInterface::ExportCustomGameMode(const FBSConfig& InConfig)
 {
-	return InConfig.EncodeToString();
+	return InConfig.EncodeToShareCode();
 }
 
 /* --------------------------- */
@@ -151,23 +175,13 @@ FString IBSGameModeInterface::ExportCustomGameMode(const FBSConfig& InConfig)
 bool IBSGameModeInterface::FindPresetGameMode(const FString& GameModeName, const EGameModeDifficulty& Difficulty,
 	const UBSGameModeDataAsset* PresetGameModeDataAsset, FBSConfig& OutConfig)
 {
-	EBaseGameMode BaseGameMode = EBaseGameMode::None;
-
-	for (const EBaseGameMode& Preset : TEnumRange<EBaseGameMode>())
-	{
-		if (GameModeName.Equals(UEnum::GetDisplayValueAsText(Preset).ToString(), ESearchCase::IgnoreCase))
-		{
-			BaseGameMode = Preset;
-			break;
-		}
-	}
-
-	if (BaseGameMode == EBaseGameMode::None)
+	const EBaseGameMode* BaseGameMode = GetPresetGameModeNames().Find(GameModeName);
+	if (!BaseGameMode)
 	{
 		return false;
 	}
 
-	return FindPresetGameMode(BaseGameMode, Difficulty, PresetGameModeDataAsset, OutConfig);
+	return FindPresetGameMode(*BaseGameMode, Difficulty, PresetGameModeDataAsset, OutConfig);
 }
 
 bool IBSGameModeInterface::FindPresetGameMode(const EBaseGameMode& BaseGameMode, const EGameModeDifficulty& Difficulty,
@@ -176,7 +190,7 @@ bool IBSGameModeInterface::FindPresetGameMode(const EBaseGameMode& BaseGameMode,
 	if (BaseGameMode != EBaseGameMode::None)
 	{
 		const FBS_DefiningConfig DefiningConfig = FBSConfig::GetConfigForPreset(BaseGameMode, Difficulty);
-		const TMap<FBS_DefiningConfig, FBSConfig> Map = PresetGameModeDataAsset->GetGameModesMap();
+		const TMap<FBS_DefiningConfig, FBSConfig>& Map = PresetGameModeDataAsset->GetGameModesMap();
 		if (const FBSConfig* Found = Map.Find(DefiningConfig))
 		{
 			OutConfig = *Found;
@@ -189,12 +203,5 @@ bool IBSGameModeInterface::FindPresetGameMode(const EBaseGameMode& BaseGameMode,
 
 bool IBSGameModeInterface::IsPresetGameMode(const FString& GameModeName)
 {
-	for (const EBaseGameMode& Preset : TEnumRange<EBaseGameMode>())
-	{
-		if (GameModeName.Equals(UEnum::GetDisplayValueAsText(Preset).ToString(), ESearchCase::IgnoreCase))
-		{
-			return true;
-		}
-	}
-	return false;
+	return GetPresetGameModeNames().Contains(GameModeName);
 }
@@ -0,0 +1,414 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+// ReSharper disable StringLiteralTypo
+#include "BSMockBackend.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "HttpRequestInterface.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Containers/Ticker.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Compression.h"
+#include "Utilities/BSJsonStream.h"
+
+DEFINE_LOG_CATEGORY(LogBSMockBackend);
+
+const TCHAR* FBSMockBackend::AccessToken = TEXT("mock-access-token");
+const TCHAR* FBSMockBackend::RefreshToken = TEXT("mock-refresh-token");
+const TCHAR* FBSMockBackend::SteamID = TEXT("76561197960287930");
+
+namespace
+{
+	TSharedPtr<FBSMockBackend> RunningMockBackend;
+
+	/** Whether Get has already tried to start the mock backend from FBSMockBackendSettings. */
+	bool bTriedStartFromSettings = false;
+
+	FString GetVerbString(const EHttpServerRequestVerbs Verb)
+	{
+		switch (Verb)
+		{
+		case EHttpServerRequestVerbs::VERB_GET:
+			return TEXT("GET");
+		case EHttpServerRequestVerbs::VERB_POST:
+			return TEXT("POST");
+		case EHttpServerRequestVerbs::VERB_PUT:
+			return TEXT("PUT");
+		case EHttpServerRequestVerbs::VERB_PATCH:
+			return TEXT("PATCH");
+		case EHttpServerRequestVerbs::VERB_DELETE:
+			return TEXT("DELETE");
+		case EHttpServerRequestVerbs::VERB_OPTIONS:
+			return TEXT("OPTIONS");
+		default:
+			return TEXT("NONE");
+		}
+	}
+
+	FString GetHeader(const FHttpServerRequest& Request, const FString& Name)
+	{
+		const TArray<FString>* Values = Request.Headers.Find(Name);
+		return Values && !Values->IsEmpty() ? FString::Join(*Values, TEXT(",")) : FString();
+	}
+
+	/** Converts the body to a string, decompressing it first if it was gzip compressed by FScoreUploadOutbox. */
+	FString GetBodyAsString(const FHttpServerRequest& Request)
+	{
+		TArray<uint8> Decompressed;
+		const TArray<uint8>* Body = &Request.Body;
+		if (GetHeader(Request, TEXT("Content-Encoding")).Equals(TEXT("gzip")) && Request.Body.Num() > 4)
+		{
+			// The gzip trailer ends with the size of the uncompressed data
+			const uint8* SizeBytes = Request.Body.GetData() + Request.Body.Num() - 4;
+			const int32 UncompressedSize = SizeBytes[0] | SizeBytes[1] << 8 | SizeBytes[2] << 16 | SizeBytes[3] << 24;
+			Decompressed.SetNumUninitialized(UncompressedSize);
+			if (!FCompression::UncompressMemory(NAME_Gzip, Decompressed.GetData(), UncompressedSize,
+				Request.Body.GetData(), Request.Body.Num()))
+			{
+				return FString();
+			}
+			Body = &Decompressed;
+		}
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body->GetData()), Body->Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+FBSMockBackendSettings FBSMockBackendSettings::Load()
+{
+	FBSMockBackendSettings Settings;
+	if (!GConfig)
+	{
+		return Settings;
+	}
+	const TCHAR* Section = TEXT("/Script/BeatShotGlobal.BSMockBackendSettings");
+	GConfig->GetBool(Section, TEXT("bEnabled"), Settings.bEnabled, GGameIni);
+	GConfig->GetInt(Section, TEXT("Port"), Settings.Port, GGameIni);
+	GConfig->GetFloat(Section, TEXT("Latency"), Settings.Options.Latency, GGameIni);
+	GConfig->GetFloat(Section, TEXT("FailureRate"), Settings.Options.FailureRate, GGameIni);
+	GConfig->GetInt(Section, TEXT("FailureStatus"), Settings.Options.FailureStatus, GGameIni);
+	GConfig->GetInt(Section, TEXT("RandomSeed"), Settings.Options.RandomSeed, GGameIni);
+	GConfig->GetBool(Section, TEXT("bCaptureRequests"), Settings.Options.bCaptureRequests, GGameIni);
+	Settings.Port = FMath::Clamp(Settings.Port, 1, 65535);
+	Settings.Options.Latency = FMath::Max(Settings.Options.Latency, 0.f);
+	Settings.Options.FailureRate = FMath::Clamp(Settings.Options.FailureRate, 0.f, 1.f);
+	return Settings;
+}
+
+TSharedPtr<FBSMockBackend> FBSMockBackend::Start(const uint32 Port, const FBSMockBackendOptions& Options)
+{
+	check(IsInGameThread());
+	Stop();
+
+	const TSharedRef<FBSMockBackend> MockBackend = MakeShareable(new FBSMockBackend(Port, Options));
+	if (!MockBackend->BindRoutes(Port))
+	{
+		UE_LOG(LogBSMockBackend, Error, TEXT("Failed to start the mock backend on port %u."), Port);
+		return nullptr;
+	}
+	FHttpServerModule::Get().StartAllListeners();
+	UE_LOG(LogBSMockBackend, Display, TEXT("Mock backend listening on %s."), *MockBackend->OriginURL);
+
+	RunningMockBackend = MockBackend;
+	return RunningMockBackend;
+}
+
+TSharedPtr<FBSMockBackend> FBSMockBackend::Get()
+{
+	if (!RunningMockBackend && !bTriedStartFromSettings && IsInGameThread())
+	{
+		bTriedStartFromSettings = true;
+		const FBSMockBackendSettings Settings = FBSMockBackendSettings::Load();
+		if (Settings.bEnabled || FParse::Param(FCommandLine::Get(), TEXT("BSMockBackend")))
+		{
+			Start(Settings.Port, Settings.Options);
+		}
+	}
+	return RunningMockBackend;
+}
+
+void FBSMockBackend::Stop()
+{
+	RunningMockBackend.Reset();
+}
+
+FBSMockBackend::FBSMockBackend(const uint32 Port, const FBSMockBackendOptions& InOptions):
+	OriginURL(FString::Printf(TEXT("http://127.0.0.1:%u"), Port)), Options(InOptions),
+	FailureStream(InOptions.RandomSeed)
+{
+}
+
+FBSMockBackend::~FBSMockBackend()
+{
+	if (Router)
+	{
+		for (const FHttpRouteHandle& Handle : RouteHandles)
+		{
+			Router->UnbindRoute(Handle);
+		}
+	}
+}
+
+void FBSMockBackend::SetOptions(const FBSMockBackendOptions& InOptions)
+{
+	Options = InOptions;
+	FailureStream.Initialize(Options.RandomSeed);
+}
+
+void FBSMockBackend::FailNextRequests(const int32 InNumRequests, const int32 Status)
+{
+	NumForcedFailures = InNumRequests;
+	ForcedFailureStatus = Status;
+}
+
+TArray<FPlayerScore> FBSMockBackend::GetScores(const FString& UserID) const
+{
+	const TArray<FPlayerScore>* Found = Scores.Find(UserID);
+	return Found ? *Found : TArray<FPlayerScore>();
+}
+
+FString FBSMockBackend::GetUserID(const FString& Username)
+{
+	return TEXT("mock-") + Username.ToLower();
+}
+
+bool FBSMockBackend::BindRoutes(const uint32 Port)
+{
+	Router = FHttpServerModule::Get().GetHttpRouter(Port, true);
+	if (!Router)
+	{
+		return false;
+	}
+
+	const auto Bind = [this](const TCHAR* Path, const EHttpServerRequestVerbs Verb, const FRouteHandler Handler)
+	{
+		const FHttpRouteHandle Handle = Router->BindRoute(FHttpPath(Path), Verb, FHttpRequestHandler::CreateLambda(
+			[WeakThis = AsWeak(), Handler](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+			{
+				const TSharedPtr<FBSMockBackend> MockBackend = WeakThis.Pin();
+				return MockBackend && MockBackend->HandleRequest(Request, OnComplete, Handler);
+			}));
+		if (Handle)
+		{
+			RouteHandles.Add(Handle);
+		}
+		return Handle.IsValid();
+	};
+
+	return Bind(TEXT("/api/login"), EHttpServerRequestVerbs::VERB_POST, &FBSMockBackend::HandleLogin) &&
+		Bind(TEXT("/api/refresh"), EHttpServerRequestVerbs::VERB_GET, &FBSMockBackend::HandleRefresh) &&
+		Bind(TEXT("/api/profile/:userid/savescores"), EHttpServerRequestVerbs::VERB_POST,
+			&FBSMockBackend::HandleSaveScores) &&
+		Bind(TEXT("/api/profile/:userid/deletescores"), EHttpServerRequestVerbs::VERB_DELETE,
+			&FBSMockBackend::HandleDeleteScores) &&
+		Bind(TEXT("/api/sendfeedback"), EHttpServerRequestVerbs::VERB_POST, &FBSMockBackend::HandleSendFeedback) &&
+		Bind(TEXT("/login/steam/authenticate/noredirect/:ticket"), EHttpServerRequestVerbs::VERB_GET,
+			&FBSMockBackend::HandleAuthenticateSteamUser);
+}
+
+bool FBSMockBackend::HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete,
+	const FRouteHandler Handler)
+{
+	NumRequests++;
+	const FString Body = GetBodyAsString(Request);
+
+	FMockResponse Response;
+	if (NumForcedFailures > 0)
+	{
+		NumForcedFailures--;
+		Response = MakeMessageResponse(ForcedFailureStatus, TEXT("Injected failure"));
+	}
+	else if (Options.FailureRate > 0.f && FailureStream.FRand() < Options.FailureRate)
+	{
+		Response = MakeMessageResponse(Options.FailureStatus, TEXT("Injected failure"));
+	}
+	else
+	{
+		Response = (this->*Handler)(Request, Body);
+	}
+
+	if (Options.bCaptureRequests)
+	{
+		FBSMockBackendRequest& Captured = CapturedRequests.AddDefaulted_GetRef();
+		Captured.Verb = GetVerbString(Request.Verb);
+		Captured.Path = Request.RelativePath.GetPath();
+		for (const TPair<FString, TArray<FString>>& Header : Request.Headers)
+		{
+			Captured.Headers.Add(Header.Key, FString::Join(Header.Value, TEXT(",")));
+		}
+		Captured.Body = Body;
+		Captured.ResponseCode = Response.Code;
+	}
+
+	Respond(OnComplete, Response);
+	return true;
+}
+
+FBSMockBackend::FMockResponse FBSMockBackend::HandleLogin(const FHttpServerRequest& Request, const FString& Body)
+{
+	FLoginPayload LoginPayload;
+	if (!BSJsonStream::JsonStringToUStruct(Body, &LoginPayload))
+	{
+		return MakeMessageResponse(400, TEXT("Invalid login payload"));
+	}
+	const FString& Username = LoginPayload.Username.IsEmpty() ? LoginPayload.Email : LoginPayload.Username;
+	if (Username.IsEmpty() || LoginPayload.Password.IsEmpty())
+	{
+		return MakeMessageResponse(401, TEXT("Invalid username or password"));
+	}
+
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetStringField(TEXT("userID"), GetUserID(Username));
+	JsonObject->SetStringField(TEXT("displayName"), Username);
+	JsonObject->SetStringField(TEXT("accessToken"), AccessToken);
+
+	FMockResponse Response;
+	FJsonSerializer::Serialize(JsonObject, TJsonWriterFactory<>::Create(&Response.Body));
+	Response.Headers.Add(TEXT("set-cookie"), MakeRefreshCookie());
+	return Response;
+}
+
+FBSMockBackend::FMockResponse FBSMockBackend::HandleRefresh(const FHttpServerRequest& Request, const FString& Body)
+{
+	if (!GetHeader(Request, TEXT("Cookie")).Contains(RefreshToken))
+	{
+		return MakeMessageResponse(401, TEXT("Invalid refresh token"));
+	}
+
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetStringField(TEXT("accessToken"), AccessToken);
+
+	FMockResponse Response;
+	FJsonSerializer::Serialize(JsonObject, TJsonWriterFactory<>::Create(&Response.Body));
+	return Response;
+}
+
+FBSMockBackend::FMockResponse FBSMockBackend::HandleSaveScores(const FHttpServerRequest& Request, const FString& Body)
+{
+	if (!IsAuthorized(Request))
+	{
+		return MakeMessageResponse(401, TEXT("Invalid access token"));
+	}
+	FJsonScore JsonScores;
+	if (!BSJsonStream::JsonStringToUStruct(Body, &JsonScores))
+	{
+		return MakeMessageResponse(400, TEXT("Invalid scores"));
+	}
+	Scores.FindOrAdd(Request.PathParams.FindRef(TEXT("userid"))).Append(MoveTemp(JsonScores.Scores));
+	return MakeMessageResponse(200, TEXT("Scores saved"));
+}
+
+FBSMockBackend::FMockResponse FBSMockBackend::HandleDeleteScores(const FHttpServerRequest& Request,
+	const FString& Body)
+{
+	if (!IsAuthorized(Request))
+	{
+		return MakeMessageResponse(401, TEXT("Invalid access token"));
+	}
+	FJsonDeleteScores JsonDelete;
+	if (!BSJsonStream::JsonStringToUStruct(Body, &JsonDelete))
+	{
+		return MakeMessageResponse(400, TEXT("Invalid custom game mode name"));
+	}
+
+	int32 NumRemoved = 0;
+	if (TArray<FPlayerScore>* UserScores = Scores.Find(Request.PathParams.FindRef(TEXT("userid"))))
+	{
+		NumRemoved = UserScores->RemoveAll([&JsonDelete](const FPlayerScore& Score)
+		{
+			return Score.DefiningConfig.CustomGameModeName.Equals(JsonDelete.CustomGameModeName);
+		});
+	}
+
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetNumberField(TEXT("Number Removed"), NumRemoved);
+
+	FMockResponse Response;
+	FJsonSerializer::Serialize(JsonObject, TJsonWriterFactory<>::Create(&Response.Body));
+	return Response;
+}
+
+FBSMockBackend::FMockResponse FBSMockBackend::HandleSendFeedback(const FHttpServerRequest& Request,
+	const FString& Body)
+{
+	FJsonFeedback Feedback;
+	if (!BSJsonStream::JsonStringToUStruct(Body, &Feedback) || Feedback.Content.IsEmpty())
+	{
+		return MakeMessageResponse(400, TEXT("Invalid feedback"));
+	}
+	return MakeMessageResponse(200, TEXT("Feedback sent"));
+}
+
+FBSMockBackend::FMockResponse FBSMockBackend::HandleAuthenticateSteamUser(const FHttpServerRequest& Request,
+	const FString& Body)
+{
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetStringField(TEXT("result"), TEXT("OK"));
+	JsonObject->SetStringField(TEXT("steamid"), SteamID);
+	JsonObject->SetStringField(TEXT("ownersteamid"), SteamID);
+	JsonObject->SetBoolField(TEXT("vacbanned"), false);
+	JsonObject->SetBoolField(TEXT("publisherbanned"), false);
+	JsonObject->SetStringField(TEXT("displayname"), TEXT("Mock Steam User"));
+
+	FMockResponse Response;
+	FJsonSerializer::Serialize(JsonObject, TJsonWriterFactory<>::Create(&Response.Body));
+	Response.Headers.Add(TEXT("set-cookie"), MakeRefreshCookie());
+	return Response;
+}
+
+bool FBSMockBackend::IsAuthorized(const FHttpServerRequest& Request)
+{
+	return GetHeader(Request, TEXT("Authorization")).Equals(FString(TEXT("Bearer ")) + AccessToken,
+		ESearchCase::CaseSensitive);
+}
+
+FString FBSMockBackend::MakeRefreshCookie()
+{
+	return FString::Printf(TEXT("jwt=%s; Path=/; Expires=%s; HttpOnly"), RefreshToken,
+		*(FDateTime::UtcNow() + FTimespan::FromDays(30)).ToHttpDate());
+}
+
+FBSMockBackend::FMockResponse FBSMockBackend::MakeMessageResponse(const int32 Code, const FString& Message)
+{
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetStringField(TEXT("message"), Message);
+
+	FMockResponse Response;
+	Response.Code = Code;
+	FJsonSerializer::Serialize(JsonObject, TJsonWriterFactory<>::Create(&Response.Body));
+	return Response;
+}
+
+void FBSMockBackend::Respond(const FHttpResultCallback& OnComplete, const FMockResponse& Response) const
+{
+	const auto Send = [OnComplete, Response]()
+	{
+		TUniquePtr<FHttpServerResponse> ServerResponse = FHttpServerResponse::Create(Response.Body,
+			TEXT("application/json"));
+		ServerResponse->Code = static_cast<EHttpServerResponseCodes>(Response.Code);
+		for (const TPair<FString, FString>& Header : Response.Headers)
+		{
+			ServerResponse->Headers.Add(Header.Key, {Header.Value});
+		}
+		OnComplete(MoveTemp(ServerResponse));
+	};
+
+	if (Options.Latency <= 0.f)
+	{
+		Send();
+		return;
+	}
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Send](float)
+	{
+		Send();
+		return false;
+	}), Options.Latency);
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -3,58 +3,130 @@
 
 #include "BSPlayerScoreInterface.h"
 #include "SaveGames/SaveGamePlayerScore.h"
+#include "SaveGames/SaveGameSubsystem.h"
 #include "Utilities/SaveLoadCommon.h"
 
+namespace
+{
+	/** Calls Use with the score slot once its player score store is loaded, then saves the slot if Use returns true
+	 *  or scores were moved out of it.
+	 *  @return false if the slot could not be loaded or saved
+	 */
+	bool UseScoreSlot(TFunctionRef<bool(USaveGamePlayerScore&)> Use)
+	{
+		return SaveLoadCommon::ModifySlot<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+			[&Use](USaveGamePlayerScore& SaveGamePlayerScore)
+			{
+				const bool bMigrated = SaveGamePlayerScore.InitializeScoreStore();
+				return Use(SaveGamePlayerScore) || bMigrated;
+			});
+	}
+}
+
 TArray<FPlayerScore> IBSPlayerScoreInterface::LoadPlayerScores()
 {
-	if (const USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
+	TArray<FPlayerScore> PlayerScores;
+	UseScoreSlot([&PlayerScores](const USaveGamePlayerScore& SaveGamePlayerScore)
+	{
+		PlayerScores = SaveGamePlayerScore.GetPlayerScores();
+		return false;
+	});
+	return PlayerScores;
+}
+
+void IBSPlayerScoreInterface::LoadPlayerScoresAsync(TFunction<void(const TArray<FPlayerScore>&)> OnLoaded)
+{
+	// Nothing keeps the save game alive without the subsystem
+	if (!USaveGameSubsystem::Get())
 	{
-		return SaveGamePlayerScore->GetPlayerScores();
+		OnLoaded(LoadPlayerScores());
+		return;
 	}
-	return TArray<FPlayerScore>();
+
+	SaveLoadCommon::LoadFromSlotAsync<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+		[OnLoaded = MoveTemp(OnLoaded)](const USaveGamePlayerScore* Loaded)
+		{
+			const bool bLoaded = Loaded && SaveLoadCommon::ModifySlot<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+				[&OnLoaded](USaveGamePlayerScore& SaveGamePlayerScore)
+				{
+					SaveGamePlayerScore.InitializeScoreStoreAsync(
+						[WeakSaveGame = TWeakObjectPtr<USaveGamePlayerScore>(&SaveGamePlayerScore), OnLoaded](
+						const bool bMigrated)
+						{
+							if (bMigrated && WeakSaveGame.IsValid())
+							{
+								SaveLoadCommon::SaveToSlot(WeakSaveGame.Get(), TEXT("ScoreSlot"), 1);
+							}
+							OnLoaded(WeakSaveGame.IsValid() ? WeakSaveGame->GetPlayerScores() : TArray<FPlayerScore>());
+						});
+					return false;
+				});
+			if (!bLoaded)
+			{
+				OnLoaded(TArray<FPlayerScore>());
+			}
+		});
 }
 
 TArray<FPlayerScore> IBSPlayerScoreInterface::LoadPlayerScores_UnsavedToDatabase()
 {
-	if (const USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
+	TArray<FPlayerScore> PlayerScores;
+	UseScoreSlot([&PlayerScores](const USaveGamePlayerScore& SaveGamePlayerScore)
 	{
-		return SaveGamePlayerScore->GetPlayerScores_UnsavedToDatabase();
-	}
-	return TArray<FPlayerScore>();
+		PlayerScores = SaveGamePlayerScore.GetPlayerScores_UnsavedToDatabase();
+		return false;
+	});
+	return PlayerScores;
 }
 
 void IBSPlayerScoreInterface::SetAllPlayerScoresSavedToDatabase()
 {
-	if (USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
+	UseScoreSlot([](USaveGamePlayerScore& SaveGamePlayerScore)
 	{
-		SaveGamePlayerScore->SetAllScoresSavedToDatabase();
-		SaveLoadCommon::SaveToSlot(SaveGamePlayerScore, TEXT("ScoreSlot"), 1);
-	}
+		return SaveGamePlayerScore.SetAllScoresSavedToDatabase();
+	});
+}
+
+void IBSPlayerScoreInterface::SetPlayerScoresSavedToDatabase(const TArray<FString>& Times)
+{
+	UseScoreSlot([&Times](USaveGamePlayerScore& SaveGamePlayerScore)
+	{
+		return SaveGamePlayerScore.SetScoresSavedToDatabase(Times);
+	});
 }
 
 TArray<FPlayerScore> IBSPlayerScoreInterface::GetMatchingPlayerScores(const FPlayerScore& PlayerScore)
 {
-	return LoadPlayerScores().FilterByPredicate([&PlayerScore](const FPlayerScore& ComparePlayerScore)
+	TArray<FPlayerScore> PlayerScores;
+	UseScoreSlot([&PlayerScores, &PlayerScore](const USaveGamePlayerScore& SaveGamePlayerScore)
 	{
-		if (ComparePlayerScore == PlayerScore)
+		PlayerScores = SaveGamePlayerScore.GetMatchingPlayerScores(PlayerScore);
+		return false;
+	});
+	return PlayerScores;
+}
+
+bool IBSPlayerScoreInterface::GetMostRecentPlayerScore(FPlayerScore& OutPlayerScore)
+{
+	bool bFound = false;
+	UseScoreSlot([&bFound, &OutPlayerScore](const USaveGamePlayerScore& SaveGamePlayerScore)
+	{
+		if (const FPlayerScore* MostRecent = SaveGamePlayerScore.GetMostRecentPlayerScore())
 		{
-			return true;
+			OutPlayerScore = *MostRecent;
+			bFound = true;
 		}
 		return false;
 	});
+	return bFound;
 }
 
 void IBSPlayerScoreInterface::SavePlayerScoreInstance(const FPlayerScore& PlayerScoreToSave)
 {
-	if (USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
+	UseScoreSlot([&PlayerScoreToSave](USaveGamePlayerScore& SaveGamePlayerScore)
 	{
-		SaveGamePlayerScore->AddPlayerScoreInstance(PlayerScoreToSave);
-		SaveLoadCommon::SaveToSlot(SaveGamePlayerScore, TEXT("ScoreSlot"), 1);
-	}
+		return SaveGamePlayerScore.AddPlayerScoreInstance(PlayerScoreToSave);
+	});
 }
 
 /* --------------------------- */
@@ -64,49 +136,52 @@ void IBSPlayerScoreInterface::SavePlayerScoreInstance(const FPlayerScore& Player
 FCommonScoreInfo IBSPlayerScoreInterface::FindOrAddCommonScoreInfo(const FBS_DefiningConfig& DefiningConfig)
 {
 	FCommonScoreInfo CommonScoreInfo;
-	if (USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
-	{
-		SaveGamePlayerScore->FindOrAddCommonScoreInfo(DefiningConfig, CommonScoreInfo);
-	}
+	SaveLoadCommon::ModifySlot<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+		[&DefiningConfig, &CommonScoreInfo](USaveGamePlayerScore& SaveGamePlayerScore)
+		{
+			SaveGamePlayerScore.FindOrAddCommonScoreInfo(DefiningConfig, CommonScoreInfo);
+			return false;
+		});
 	return CommonScoreInfo;
 }
 
 void IBSPlayerScoreInterface::SaveCommonScoreInfo(const FBS_DefiningConfig& DefiningConfig,
 	const FCommonScoreInfo& CommonScoreInfoToSave)
 {
-	if (USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
-	{
-		SaveGamePlayerScore->SaveCommonScoreInfo(DefiningConfig, CommonScoreInfoToSave);
-		SaveLoadCommon::SaveToSlot(SaveGamePlayerScore, TEXT("ScoreSlot"), 1);
-	}
+	SaveLoadCommon::ModifySlot<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+		[&DefiningConfig, &CommonScoreInfoToSave](USaveGamePlayerScore& SaveGamePlayerScore)
+		{
+			SaveGamePlayerScore.SaveCommonScoreInfo(DefiningConfig, CommonScoreInfoToSave);
+			return true;
+		});
 }
 
 int32 IBSPlayerScoreInterface::RemoveCommonScoreInfo(const FBS_DefiningConfig& DefiningConfig)
 {
-	if (USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
-	{
-		const int32 NumRemoved = SaveGamePlayerScore->RemoveCommonScoreInfo(DefiningConfig);
-		if (SaveLoadCommon::SaveToSlot(SaveGamePlayerScore, TEXT("ScoreSlot"), 1))
+	int32 NumRemoved = 0;
+	if (SaveLoadCommon::ModifySlot<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+		[&DefiningConfig, &NumRemoved](USaveGamePlayerScore& SaveGamePlayerScore)
 		{
-			return NumRemoved;
-		}
+			NumRemoved = SaveGamePlayerScore.RemoveCommonScoreInfo(DefiningConfig);
+			return true;
+		}))
+	{
+		return NumRemoved;
 	}
 	return 0;
 }
 
 int32 IBSPlayerScoreInterface::ResetQTable(const FBS_DefiningConfig& DefiningConfig)
 {
-	if (USaveGamePlayerScore* SaveGamePlayerScore = SaveLoadCommon::LoadFromSlot<USaveGamePlayerScore>(
-		TEXT("ScoreSlot"), 1))
-	{
-		const int32 NumCleared = SaveGamePlayerScore->ResetQTable(DefiningConfig);
-		if (SaveLoadCommon::SaveToSlot(SaveGamePlayerScore, TEXT("ScoreSlot"), 1))
+	int32 NumCleared = 0;
+	if (SaveLoadCommon::ModifySlot<USaveGamePlayerScore>(TEXT("ScoreSlot"), 1,
+		[&DefiningConfig, &NumCleared](USaveGamePlayerScore& SaveGamePlayerScore)
 		{
-			return NumCleared;
-		}
+			NumCleared = SaveGamePlayerScore.ResetQTable(DefiningConfig);
+			return true;
+		}))
+	{
+		return NumCleared;
 	}
 	return 0;
 }
@@ -17,44 +17,52 @@ FPlayerSettings IBSPlayerSettingsInterface::LoadPlayerSettings()
 
 void IBSPlayerSettingsInterface::SavePlayerSettings(const FPlayerSettings_AudioAnalyzer& InSettingsStruct)
 {
-	if (USaveGamePlayerSettings* Settings = SaveLoadCommon::LoadFromSlot<USaveGamePlayerSettings>(TEXT("SettingsSlot"),
-		0))
+	if (SaveLoadCommon::ModifySlot<USaveGamePlayerSettings>(TEXT("SettingsSlot"), 0,
+		[&InSettingsStruct](USaveGamePlayerSettings& Settings)
+		{
+			Settings.SavePlayerSettings(InSettingsStruct);
+			return true;
+		}))
 	{
-		Settings->SavePlayerSettings(InSettingsStruct);
-		SaveLoadCommon::SaveToSlot(Settings, TEXT("SettingsSlot"), 0);
 		OnPlayerSettingsChangedDelegate_AudioAnalyzer.Broadcast(InSettingsStruct);
 	}
 }
 
 void IBSPlayerSettingsInterface::SavePlayerSettings(const FPlayerSettings_CrossHair& InSettingsStruct)
 {
-	if (USaveGamePlayerSettings* Settings = SaveLoadCommon::LoadFromSlot<USaveGamePlayerSettings>(TEXT("SettingsSlot"),
-		0))
+	if (SaveLoadCommon::ModifySlot<USaveGamePlayerSettings>(TEXT("SettingsSlot"), 0,
+		[&InSettingsStruct](USaveGamePlayerSettings& Settings)
+		{
+			Settings.SavePlayerSettings(InSettingsStruct);
+			return true;
+		}))
 	{
-		Settings->SavePlayerSettings(InSettingsStruct);
-		SaveLoadCommon::SaveToSlot(Settings, TEXT("SettingsSlot"), 0);
 		OnPlayerSettingsChangedDelegate_CrossHair.Broadcast(InSettingsStruct);
 	}
 }
 
 void IBSPlayerSettingsInterface::SavePlayerSettings(const FPlayerSettings_Game& InSettingsStruct)
 {
-	if (USaveGamePlayerSettings* Settings = SaveLoadCommon::LoadFromSlot<USaveGamePlayerSettings>(TEXT("SettingsSlot"),
-		0))
+	if (SaveLoadCommon::ModifySlot<USaveGamePlayerSettings>(TEXT("SettingsSlot"), 0,
+		[&InSettingsStruct](USaveGamePlayerSettings& Settings)
+		{
+			Settings.SavePlayerSettings(InSettingsStruct);
+			return true;
+		}))
 	{
-		Settings->SavePlayerSettings(InSettingsStruct);
-		SaveLoadCommon::SaveToSlot(Settings, TEXT("SettingsSlot"), 0);
 		OnPlayerSettingsChangedDelegate_Game.Broadcast(InSettingsStruct);
 	}
 }
 
 void IBSPlayerSettingsInterface::SavePlayerSettings(const FPlayerSettings_User& InSettingsStruct)
 {
-	if (USaveGamePlayerSettings* Settings = SaveLoadCommon::LoadFromSlot<USaveGamePlayerSettings>(TEXT("SettingsSlot"),
-		0))
+	if (SaveLoadCommon::ModifySlot<USaveGamePlayerSettings>(TEXT("SettingsSlot"), 0,
+		[&InSettingsStruct](USaveGamePlayerSettings& Settings)
+		{
+			Settings.SavePlayerSettings(InSettingsStruct);
+			return true;
+		}))
 	{
-		Settings->SavePlayerSettings(InSettingsStruct);
-		SaveLoadCommon::SaveToSlot(Settings, TEXT("SettingsSlot"), 0);
 		OnPlayerSettingsChangedDelegate_User.Broadcast(InSettingsStruct);
 	}
 }
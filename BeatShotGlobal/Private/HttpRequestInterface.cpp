@@ -3,10 +3,12 @@
 
 // ReSharper disable StringLiteralTypo
 #include "HttpRequestInterface.h"
+#include "BSMockBackend.h"
 #include "HttpModule.h"
 #include "JsonObjectConverter.h"
 #include "Interfaces/IHttpResponse.h"
 #include "SaveGames/SaveGamePlayerScore.h"
+#include "Utilities/BSJsonStream.h"
 
 bool IHttpRequestInterface::IsRefreshTokenValid(const FString RefreshToken)
 {
@@ -28,11 +30,25 @@ bool IHttpRequestInterface::IsRefreshTokenValid(const FString RefreshToken)
 	return false;
 }
 
+FString IHttpRequestInterface::ResolveURL(const FString& URL)
+{
+#if !UE_BUILD_SHIPPING
+	if (URL.StartsWith(Constants::OriginURL))
+	{
+		if (const TSharedPtr<FBSMockBackend> MockBackend = FBSMockBackend::Get())
+		{
+			return MockBackend->GetOriginURL() + URL.RightChop(Constants::OriginURL.Len());
+		}
+	}
+#endif // !UE_BUILD_SHIPPING
+	return URL;
+}
+
 void IHttpRequestInterface::RequestAccessToken(const FString RefreshToken,
 	TSharedPtr<FAccessTokenResponse, ESPMode::ThreadSafe> AccessTokenResponse)
 {
 	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(Constants::Endpoint_Refresh);
+	HttpRequest->SetURL(ResolveURL(Constants::Endpoint_Refresh));
 	HttpRequest->SetVerb("GET");
 	HttpRequest->SetTimeout(5.f);
 	HttpRequest->SetHeader("Cookie", RefreshToken);
@@ -82,7 +98,7 @@ void IHttpRequestInterface::LoginUser(const FLoginPayload LoginPayload,
 	FJsonSerializer::Serialize(JsonObject, JsonWriter);
 
 	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(Constants::Endpoint_Login);
+	HttpRequest->SetURL(ResolveURL(Constants::Endpoint_Login));
 	HttpRequest->SetVerb("POST");
 	HttpRequest->SetTimeout(5.f);
 	HttpRequest->SetHeader("Content-Type", "application/json");
@@ -141,14 +157,11 @@ void IHttpRequestInterface::PostPlayerScores(const TArray<FPlayerScore> ScoresTo
 	}
 
 	FString ContentString;
-	const TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
-	FJsonObjectConverter::UStructToJsonObject(FJsonScore::StaticStruct(), &JsonScores, JsonObject);
-	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ContentString);
-	FJsonSerializer::Serialize(JsonObject, JsonWriter);
+	BSJsonStream::UStructToJsonString(JsonScores, ContentString);
 	UE_LOG(LogTemp, Display, TEXT("FJsonScore: %s"), *ContentString);
 
 	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(Constants::Segment_ApiProfile + UserID + "/savescores");
+	HttpRequest->SetURL(ResolveURL(Constants::Segment_ApiProfile) + UserID + Constants::Segment_SaveScores);
 	HttpRequest->SetVerb("POST");
 	HttpRequest->SetTimeout(5.f);
 	HttpRequest->SetHeader("Content-Type", "application/json");
@@ -196,7 +209,7 @@ void IHttpRequestInterface::PostFeedback(const FJsonFeedback InFeedback,
 	FJsonSerializer::Serialize(JsonObject, JsonWriter);
 
 	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(Constants::Endpoint_SendFeedback);
+	HttpRequest->SetURL(ResolveURL(Constants::Endpoint_SendFeedback));
 	HttpRequest->SetTimeout(5.f);
 	HttpRequest->SetVerb("POST");
 	HttpRequest->SetHeader("Content-Type", "application/json");
@@ -244,7 +257,7 @@ void IHttpRequestInterface::DeleteScores(const FString CustomGameModeName, const
 	FJsonSerializer::Serialize(JsonObject, JsonWriter);
 
 	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(Constants::Segment_ApiProfile + UserID + "/deletescores");
+	HttpRequest->SetURL(ResolveURL(Constants::Segment_ApiProfile) + UserID + "/deletescores");
 	HttpRequest->SetTimeout(5.f);
 	HttpRequest->SetVerb("DELETE");
 	HttpRequest->SetHeader("Content-Type", "application/json");
@@ -294,7 +307,7 @@ void IHttpRequestInterface::AuthenticateSteamUser(const FString AuthTicket,
 	TSharedPtr<FSteamAuthTicketResponse, ESPMode::ThreadSafe> SteamAuthTicketResponse)
 {
 	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(Constants::Endpoint_AuthenticateUserTicketNoRedirect + AuthTicket);
+	HttpRequest->SetURL(ResolveURL(Constants::Endpoint_AuthenticateUserTicketNoRedirect) + AuthTicket);
 	HttpRequest->SetTimeout(5.f);
 	HttpRequest->SetVerb("GET");
 	HttpRequest->OnProcessRequestComplete().BindLambda(
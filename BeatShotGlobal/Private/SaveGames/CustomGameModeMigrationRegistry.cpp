@@ -0,0 +1,40 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "SaveGames/CustomGameModeMigrationRegistry.h"
+#include "BSGameModeConfig/BSConfig.h"
+#include "SaveGames/SaveGameCustomGameMode.h"
+
+FCustomGameModeMigrationRegistry::FCustomGameModeMigrationRegistry()
+{
+	RegisterMigration(0, &USaveGameCustomGameMode::UpgradeCustomGameModeToVersion1);
+}
+
+FCustomGameModeMigrationRegistry& FCustomGameModeMigrationRegistry::Get()
+{
+	static FCustomGameModeMigrationRegistry Registry;
+	return Registry;
+}
+
+void FCustomGameModeMigrationRegistry::RegisterMigration(const int32 FromVersion, FCustomGameModeMigration Migration)
+{
+	Migrations.Add(FromVersion, MoveTemp(Migration));
+}
+
+void FCustomGameModeMigrationRegistry::Migrate(TArray<FBSConfig>& Configs, const int32 FromVersion,
+	const int32 ToVersion) const
+{
+	for (int32 Version = FromVersion; Version < ToVersion; Version++)
+	{
+		const FCustomGameModeMigration* Migration = Migrations.Find(Version);
+		if (!Migration)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No custom game mode migration registered from Version %d"), Version);
+			continue;
+		}
+		for (FBSConfig& Config : Configs)
+		{
+			(*Migration)(Config);
+		}
+	}
+}
@@ -0,0 +1,390 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "SaveGames/PlayerScoreStore.h"
+#include "BSConstants.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+DEFINE_LOG_CATEGORY(LogPlayerScoreStore);
+
+namespace
+{
+	/** "BSPS" */
+	constexpr uint32 PlayerScoreStoreMagic = 0x53505342;
+
+	/** Incremented whenever a record type is added or the record layout changes. */
+	constexpr int32 PlayerScoreStoreVersion = 2;
+
+	/** The first version that can contain MarkSavedToDatabase records. */
+	constexpr int32 PlayerScoreStoreVersion_MarkSavedToDatabase = 2;
+
+	/** Serializes all reads and writes of store files, since a store may be loaded on a background thread while the
+	 *  game thread appends to or compacts the same file. */
+	FCriticalSection FileCriticalSection;
+}
+
+FPlayerScoreStore::FPlayerScoreStore(const FString& InFilePath): FilePath(InFilePath), MostRecentScore(INDEX_NONE),
+                                                                 NumRecords(0), FileVersion(PlayerScoreStoreVersion),
+                                                                 bNeedsCompaction(false)
+{
+}
+
+bool FPlayerScoreStore::Load()
+{
+	Reset();
+
+	TArray<uint8> FileData;
+	{
+		FScopeLock Lock(&FileCriticalSection);
+		if (!IFileManager::Get().FileExists(*FilePath))
+		{
+			return true;
+		}
+		if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+		{
+			return false;
+		}
+	}
+
+	FMemoryReader Reader(FileData);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic << Version;
+	if (Reader.IsError() || Magic != PlayerScoreStoreMagic || Version > PlayerScoreStoreVersion)
+	{
+		UE_LOG(LogPlayerScoreStore, Error, TEXT("%s is not a valid player score log"), *FilePath);
+		return false;
+	}
+	FileVersion = Version;
+
+	bool bTruncated = false;
+	while (!Reader.AtEnd())
+	{
+		uint8 Type = 0;
+		int32 PayloadSize = 0;
+		uint32 PayloadCrc = 0;
+		Reader << Type << PayloadSize << PayloadCrc;
+		if (Reader.IsError() || PayloadSize < 0 || PayloadSize > Reader.TotalSize() - Reader.Tell())
+		{
+			bTruncated = true;
+			break;
+		}
+
+		const uint8* Payload = FileData.GetData() + Reader.Tell();
+		if (FCrc::MemCrc32(Payload, PayloadSize) != PayloadCrc)
+		{
+			bTruncated = true;
+			break;
+		}
+		Reader.Seek(Reader.Tell() + PayloadSize);
+
+		switch (static_cast<ERecordType>(Type))
+		{
+		case ERecordType::AddScore:
+			{
+				FMemoryReaderView PayloadReader(MakeArrayView(Payload, PayloadSize));
+				FPlayerScore Score;
+				SerializeScore(PayloadReader, Score);
+				if (!PayloadReader.IsError() && !ScoresByTime.Contains(Score.Time))
+				{
+					IndexScore(Scores.Add(MoveTemp(Score)));
+				}
+			}
+			break;
+		case ERecordType::MarkAllSavedToDatabase:
+			ApplyMarkAllSavedToDatabase();
+			break;
+		case ERecordType::MarkSavedToDatabase:
+			{
+				FMemoryReaderView PayloadReader(MakeArrayView(Payload, PayloadSize));
+				TArray<FString> Times;
+				PayloadReader << Times;
+				if (!PayloadReader.IsError())
+				{
+					ApplyMarkSavedToDatabase(Times);
+				}
+			}
+			break;
+		default:
+			UE_LOG(LogPlayerScoreStore, Warning, TEXT("Skipping unknown record type %d"), Type);
+			break;
+		}
+		NumRecords++;
+	}
+
+	// The partially written record must be dropped before appending, so that later appends are readable. Not done here
+	// since Load may run on a background thread
+	if (bTruncated)
+	{
+		UE_LOG(LogPlayerScoreStore, Warning, TEXT("Found a partially written record in %s"), *FilePath);
+		bNeedsCompaction = true;
+	}
+	return true;
+}
+
+int32 FPlayerScoreStore::Import(const TArray<FPlayerScore>& InScores)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	int32 NumImported = 0;
+	for (const FPlayerScore& Score : InScores)
+	{
+		if (ScoresByTime.Contains(Score.Time))
+		{
+			continue;
+		}
+
+		const int32 Index = Scores.Add(Score);
+		IndexScore(Index);
+
+		TArray<uint8> Payload;
+		FMemoryWriter PayloadWriter(Payload);
+		SerializeScore(PayloadWriter, Scores[Index]);
+		WriteRecord(Writer, ERecordType::AddScore, Payload);
+		NumImported++;
+	}
+
+	if (NumImported > 0 && AppendToFile(Data))
+	{
+		NumRecords += NumImported;
+	}
+	return NumImported;
+}
+
+bool FPlayerScoreStore::Add(const FPlayerScore& InScore)
+{
+	if (ScoresByTime.Contains(InScore.Time))
+	{
+		return false;
+	}
+
+	const int32 Index = Scores.Add(InScore);
+	IndexScore(Index);
+
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	SerializeScore(PayloadWriter, Scores[Index]);
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	WriteRecord(Writer, ERecordType::AddScore, Payload);
+	if (!AppendToFile(Data))
+	{
+		return false;
+	}
+	NumRecords++;
+	return true;
+}
+
+void FPlayerScoreStore::MarkAllSavedToDatabase()
+{
+	if (UnsavedScores.IsEmpty())
+	{
+		return;
+	}
+	ApplyMarkAllSavedToDatabase();
+	AppendNonScoreRecord(ERecordType::MarkAllSavedToDatabase, TArray<uint8>());
+}
+
+void FPlayerScoreStore::MarkSavedToDatabase(const TArray<FString>& Times)
+{
+	if (ApplyMarkSavedToDatabase(Times) == 0)
+	{
+		return;
+	}
+
+	// Rewrite logs from older versions with the current header, so older builds reject the file instead of skipping
+	// the record
+	if (FileVersion < PlayerScoreStoreVersion_MarkSavedToDatabase)
+	{
+		Compact();
+		return;
+	}
+
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	PayloadWriter << const_cast<TArray<FString>&>(Times);
+	AppendNonScoreRecord(ERecordType::MarkSavedToDatabase, Payload);
+}
+
+bool FPlayerScoreStore::Compact()
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	uint32 Magic = PlayerScoreStoreMagic;
+	int32 Version = PlayerScoreStoreVersion;
+	Writer << Magic << Version;
+
+	for (FPlayerScore& Score : Scores)
+	{
+		TArray<uint8> Payload;
+		FMemoryWriter PayloadWriter(Payload);
+		SerializeScore(PayloadWriter, Score);
+		WriteRecord(Writer, ERecordType::AddScore, Payload);
+	}
+
+	check(IsInGameThread());
+	FScopeLock Lock(&FileCriticalSection);
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Data, *TempFilePath) || !IFileManager::Get().Move(*FilePath, *TempFilePath,
+		true, true))
+	{
+		UE_LOG(LogPlayerScoreStore, Error, TEXT("Failed to compact %s"), *FilePath);
+		return false;
+	}
+	NumRecords = Scores.Num();
+	FileVersion = PlayerScoreStoreVersion;
+	bNeedsCompaction = false;
+	return true;
+}
+
+TArray<FPlayerScore> FPlayerScoreStore::GetScores_UnsavedToDatabase() const
+{
+	TArray<FPlayerScore> UnsavedToDatabase;
+	UnsavedToDatabase.Reserve(UnsavedScores.Num());
+	for (const int32 Index : UnsavedScores)
+	{
+		UnsavedToDatabase.Add(Scores[Index]);
+	}
+	return UnsavedToDatabase;
+}
+
+TArray<FPlayerScore> FPlayerScoreStore::GetMatchingScores(const FPlayerScore& InScore) const
+{
+	TArray<FPlayerScore> Matching;
+	if (const TArray<int32>* Found = ScoresByDefiningConfig.Find(InScore.DefiningConfig))
+	{
+		for (const int32 Index : *Found)
+		{
+			if (Scores[Index] == InScore)
+			{
+				Matching.Add(Scores[Index]);
+			}
+		}
+	}
+	return Matching;
+}
+
+const FPlayerScore* FPlayerScoreStore::GetMostRecentScore() const
+{
+	return Scores.IsValidIndex(MostRecentScore) ? &Scores[MostRecentScore] : nullptr;
+}
+
+FString FPlayerScoreStore::GetDefaultFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), TEXT("PlayerScores.log"));
+}
+
+void FPlayerScoreStore::IndexScore(const int32 Index)
+{
+	const FPlayerScore& Score = Scores[Index];
+	ScoresByDefiningConfig.FindOrAdd(Score.DefiningConfig).Add(Index);
+	ScoresByTime.Add(Score.Time, Index);
+	if (!Score.bSavedToDatabase)
+	{
+		UnsavedScores.Add(Index);
+	}
+
+	// Iso8601 times compare the same as strings as they do as dates
+	if (!Scores.IsValidIndex(MostRecentScore) || Score.Time > Scores[MostRecentScore].Time)
+	{
+		MostRecentScore = Index;
+	}
+}
+
+void FPlayerScoreStore::Reset()
+{
+	Scores.Empty();
+	ScoresByDefiningConfig.Empty();
+	ScoresByTime.Empty();
+	UnsavedScores.Empty();
+	MostRecentScore = INDEX_NONE;
+	NumRecords = 0;
+	FileVersion = PlayerScoreStoreVersion;
+	bNeedsCompaction = false;
+}
+
+void FPlayerScoreStore::ApplyMarkAllSavedToDatabase()
+{
+	for (const int32 Index : UnsavedScores)
+	{
+		Scores[Index].bSavedToDatabase = true;
+	}
+	UnsavedScores.Empty();
+}
+
+int32 FPlayerScoreStore::ApplyMarkSavedToDatabase(const TArray<FString>& Times)
+{
+	int32 NumMarked = 0;
+	for (const FString& Time : Times)
+	{
+		const int32* Index = ScoresByTime.Find(Time);
+		if (Index && !Scores[*Index].bSavedToDatabase)
+		{
+			Scores[*Index].bSavedToDatabase = true;
+			UnsavedScores.Remove(*Index);
+			NumMarked++;
+		}
+	}
+	return NumMarked;
+}
+
+void FPlayerScoreStore::AppendNonScoreRecord(const ERecordType Type, const TArray<uint8>& Payload)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	WriteRecord(Writer, Type, Payload);
+	if (AppendToFile(Data))
+	{
+		NumRecords++;
+	}
+
+	if (NumRecords - Scores.Num() >= Constants::PlayerScoreStoreCompactionThreshold)
+	{
+		Compact();
+	}
+}
+
+void FPlayerScoreStore::WriteRecord(FArchive& Ar, const ERecordType Type, const TArray<uint8>& Payload)
+{
+	uint8 TypeValue = static_cast<uint8>(Type);
+	int32 PayloadSize = Payload.Num();
+	uint32 PayloadCrc = FCrc::MemCrc32(Payload.GetData(), PayloadSize);
+	Ar << TypeValue << PayloadSize << PayloadCrc;
+	Ar.Serialize(const_cast<uint8*>(Payload.GetData()), PayloadSize);
+}
+
+void FPlayerScoreStore::SerializeScore(FArchive& Ar, FPlayerScore& Score)
+{
+	FObjectAndNameAsStringProxyArchive ProxyAr(Ar, false);
+	FPlayerScore::StaticStruct()->SerializeItem(ProxyAr, &Score, nullptr);
+}
+
+bool FPlayerScoreStore::AppendToFile(const TArray<uint8>& Data)
+{
+	check(IsInGameThread());
+	FScopeLock Lock(&FileCriticalSection);
+	const bool bWriteHeader = IFileManager::Get().FileSize(*FilePath) <= 0;
+	const TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath,
+		bWriteHeader ? 0 : FILEWRITE_Append));
+	if (!FileWriter)
+	{
+		UE_LOG(LogPlayerScoreStore, Error, TEXT("Failed to open %s"), *FilePath);
+		return false;
+	}
+
+	if (bWriteHeader)
+	{
+		uint32 Magic = PlayerScoreStoreMagic;
+		int32 Version = PlayerScoreStoreVersion;
+		*FileWriter << Magic << Version;
+		FileVersion = PlayerScoreStoreVersion;
+	}
+	FileWriter->Serialize(const_cast<uint8*>(Data.GetData()), Data.Num());
+	return FileWriter->Close();
+}
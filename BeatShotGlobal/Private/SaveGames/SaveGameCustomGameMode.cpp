@@ -3,6 +3,9 @@
 
 #include "SaveGames/SaveGameCustomGameMode.h"
 #include "BSGameModeConfig/BSConfig.h"
+#include "Async/Async.h"
+#include "SaveGames/CustomGameModeMigrationRegistry.h"
+#include "SaveGames/SaveGameSubsystem.h"
 
 USaveGameCustomGameMode::USaveGameCustomGameMode()
 {
@@ -11,7 +14,13 @@ USaveGameCustomGameMode::USaveGameCustomGameMode()
 void USaveGameCustomGameMode::Serialize(FStructuredArchive::FRecord Record)
 {
 	Super::Serialize(Record);
-	LastLoadedVersion = Version;
+
+	// Saving may happen on a background thread, see USaveGameSubsystem
+	if (Record.GetUnderlyingArchive().IsLoading())
+	{
+		LastLoadedVersion = Version;
+		bIndexesDirty = true;
+	}
 }
 
 TArray<FBSConfig> USaveGameCustomGameMode::GetCustomGameModes() const
@@ -21,6 +30,19 @@ TArray<FBSConfig> USaveGameCustomGameMode::GetCustomGameModes() const
 
 bool USaveGameCustomGameMode::FindCustomGameMode(const FString& GameModeName, FBSConfig& OutConfig) const
 {
+	BuildIndexes();
+	const int32* Index = NameIndex.Find(GameModeName);
+	if (!Index)
+	{
+		return false;
+	}
+
+	// The index ignores case, but this lookup does not
+	if (CustomGameModes[*Index].DefiningConfig.CustomGameModeName.Equals(GameModeName))
+	{
+		OutConfig = CustomGameModes[*Index];
+		return true;
+	}
 	for (const FBSConfig& Mode : CustomGameModes)
 	{
 		if (Mode.DefiningConfig.CustomGameModeName.Equals(GameModeName))
@@ -34,14 +56,22 @@ bool USaveGameCustomGameMode::FindCustomGameMode(const FString& GameModeName, FB
 
 void USaveGameCustomGameMode::SaveCustomGameMode(const FBSConfig& InCustomGameMode)
 {
-	const int32 Index = CustomGameModes.Find(InCustomGameMode);
-	if (CustomGameModes.IsValidIndex(Index))
+	BuildIndexes();
+	if (const int32* Index = DefiningConfigIndex.Find(InCustomGameMode.DefiningConfig))
 	{
-		CustomGameModes[Index] = InCustomGameMode;
+		// Custom game modes only match if their names are equal, but other game modes may be renamed
+		if (!CustomGameModes[*Index].DefiningConfig.CustomGameModeName.Equals(
+			InCustomGameMode.DefiningConfig.CustomGameModeName, ESearchCase::IgnoreCase))
+		{
+			bIndexesDirty = true;
+		}
+		CustomGameModes[*Index] = InCustomGameMode;
 	}
 	else
 	{
-		CustomGameModes.Add(InCustomGameMode);
+		const int32 NewIndex = CustomGameModes.Add(InCustomGameMode);
+		DefiningConfigIndex.Add(InCustomGameMode.DefiningConfig, NewIndex);
+		NameIndex.FindOrAdd(InCustomGameMode.DefiningConfig.CustomGameModeName, NewIndex);
 	}
 }
 
@@ -49,6 +79,12 @@ int32 USaveGameCustomGameMode::RemoveCustomGameMode(const FBSConfig& InCustomGam
 {
 	const int32 NumRemoved = CustomGameModes.Remove(InCustomGameMode);
 	CustomGameModes.Shrink();
+
+	// Every game mode after the removed ones has moved, so the indexes are rebuilt on the next lookup
+	if (NumRemoved > 0)
+	{
+		bIndexesDirty = true;
+	}
 	return NumRemoved;
 }
 
@@ -56,39 +92,109 @@ int32 USaveGameCustomGameMode::RemoveAll()
 {
 	const int32 NumRemoved = CustomGameModes.Num();
 	CustomGameModes.Empty();
+	NameIndex.Empty();
+	DefiningConfigIndex.Empty();
+	bIndexesDirty = false;
 	return NumRemoved - CustomGameModes.Num();
 }
 
 bool USaveGameCustomGameMode::IsCustomGameMode(const FString& GameModeName) const
 {
-	for (const FBSConfig& GameMode : CustomGameModes)
+	BuildIndexes();
+	return NameIndex.Contains(GameModeName);
+}
+
+void USaveGameCustomGameMode::BuildIndexes() const
+{
+	if (!bIndexesDirty)
 	{
-		if (GameMode.DefiningConfig.CustomGameModeName.Equals(GameModeName, ESearchCase::IgnoreCase))
-		{
-			return true;
-		}
+		return;
 	}
-	return false;
+
+	NameIndex.Reset();
+	DefiningConfigIndex.Reset();
+	NameIndex.Reserve(CustomGameModes.Num());
+	DefiningConfigIndex.Reserve(CustomGameModes.Num());
+	for (int32 i = 0; i < CustomGameModes.Num(); i++)
+	{
+		NameIndex.FindOrAdd(CustomGameModes[i].DefiningConfig.CustomGameModeName, i);
+		DefiningConfigIndex.FindOrAdd(CustomGameModes[i].DefiningConfig, i);
+	}
+	bIndexesDirty = false;
 }
 
 void USaveGameCustomGameMode::UpgradeCustomGameModes()
 {
-	while (Version < Constants::CustomGameModeVersion)
+	FinishPendingUpgrade();
+	if (!NeedsUpgrade())
 	{
-		switch (Version++)
+		return;
+	}
+	USaveGameSubsystem::WaitForPendingWrite(this);
+	FCustomGameModeMigrationRegistry::Get().Migrate(CustomGameModes, Version, Constants::CustomGameModeVersion);
+	Version = Constants::CustomGameModeVersion;
+	bIndexesDirty = true;
+}
+
+void USaveGameCustomGameMode::UpgradeCustomGameModesAsync(TFunction<void(bool)> OnUpgraded)
+{
+	if (!NeedsUpgrade() && !PendingUpgrade.IsValid())
+	{
+		OnUpgraded(false);
+		return;
+	}
+
+	PendingUpgradeCallbacks.Add(MoveTemp(OnUpgraded));
+	if (PendingUpgrade.IsValid())
+	{
+		return;
+	}
+
+	// Nothing to migrate, so just stamp the version
+	if (CustomGameModes.IsEmpty())
+	{
+		PendingUpgrade = MakeFulfilledPromise<TArray<FBSConfig>>().GetFuture();
+		FinishPendingUpgrade();
+		return;
+	}
+
+	PendingUpgrade = Async(EAsyncExecution::ThreadPool,
+		[WeakThis = TWeakObjectPtr<ThisClass>(this), Modes = CustomGameModes, FromVersion = Version]() mutable
 		{
-		case 0:
+			FCustomGameModeMigrationRegistry::Get().Migrate(Modes, FromVersion, Constants::CustomGameModeVersion);
+			AsyncTask(ENamedThreads::GameThread, [WeakThis]()
 			{
-				for (FBSConfig& Mode : CustomGameModes)
+				if (USaveGameCustomGameMode* SaveGameCustomGameMode = WeakThis.Get())
 				{
-					UpgradeCustomGameModeToVersion1(Mode);
+					SaveGameCustomGameMode->FinishPendingUpgrade();
 				}
-			}
-			break;
-		default:
-			break;
-		}
+			});
+			return Modes;
+		});
+}
+
+bool USaveGameCustomGameMode::FinishPendingUpgrade()
+{
+	if (!PendingUpgrade.IsValid())
+	{
+		return false;
+	}
+
+	const int32 Old = Version;
+	USaveGameSubsystem::WaitForPendingWrite(this);
+	CustomGameModes = PendingUpgrade.Get();
+	PendingUpgrade.Reset();
+	bIndexesDirty = true;
+	Version = Constants::CustomGameModeVersion;
+	UE_LOG(LogTemp, Display, TEXT("Upgraded USaveGameCustomGameMode from Version %d to %d"), Old, Version);
+
+	const TArray<TFunction<void(bool)>> Callbacks = MoveTemp(PendingUpgradeCallbacks);
+	PendingUpgradeCallbacks.Reset();
+	for (const TFunction<void(bool)>& Callback : Callbacks)
+	{
+		Callback(true);
 	}
+	return true;
 }
 
 void USaveGameCustomGameMode::UpgradeCustomGameModeToVersion1(FBSConfig& InConfig)
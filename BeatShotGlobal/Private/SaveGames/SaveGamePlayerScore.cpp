@@ -2,7 +2,171 @@
 
 
 #include "SaveGames/SaveGamePlayerScore.h"
+#include "SaveGames/PlayerScoreStore.h"
+#include "SaveGames/SaveGameSubsystem.h"
+#include "Async/Async.h"
+#include "Serialization/CustomVersion.h"
 
+const FGuid FCommonScoreInfoCustomVersion::GUID(0x6B3C2A51, 0x4E8D47F2, 0x9A1B3C7D, 0x5E2F8A14);
+
+static FCustomVersionRegistration GRegisterCommonScoreInfoCustomVersion(FCommonScoreInfoCustomVersion::GUID,
+	FCommonScoreInfoCustomVersion::LatestVersion, TEXT("CommonScoreInfoVer"));
+
+namespace
+{
+	/** Flags stored at the start of a compact FCommonScoreInfo. */
+	enum class ECommonScoreInfoFlags : uint8
+	{
+		None = 0,
+		QuantizedQTable = 1 << 0
+	};
+
+	/** Serializes a signed value as a zigzag encoded variable length integer, so small magnitudes take one byte. */
+	void SerializeZigZag(FArchive& Ar, int64& Value)
+	{
+		if (Ar.IsSaving())
+		{
+			uint64 Encoded = (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63);
+			do
+			{
+				uint8 Byte = Encoded & 0x7f;
+				Encoded >>= 7;
+				if (Encoded)
+				{
+					Byte |= 0x80;
+				}
+				Ar << Byte;
+			}
+			while (Encoded);
+		}
+		else
+		{
+			uint64 Encoded = 0;
+			for (int32 Shift = 0; Shift < 64; Shift += 7)
+			{
+				uint8 Byte = 0;
+				Ar << Byte;
+				Encoded |= static_cast<uint64>(Byte & 0x7f) << Shift;
+				if (!(Byte & 0x80) || Ar.IsError())
+				{
+					break;
+				}
+			}
+			Value = static_cast<int64>(Encoded >> 1) ^ -static_cast<int64>(Encoded & 1);
+		}
+	}
+
+	/** Serializes the number of elements in an array, resizing it when loading. */
+	template <typename T>
+	void SerializeNum(FArchive& Ar, TArray<T>& Array)
+	{
+		int64 Num = Array.Num();
+		SerializeZigZag(Ar, Num);
+		if (Ar.IsLoading())
+		{
+			Array.SetNum(Num >= 0 && Num <= Ar.TotalSize() ? static_cast<int32>(Num) : 0);
+		}
+	}
+
+	/** Serializes values as the difference from the previous value. */
+	void SerializeDeltaEncoded(FArchive& Ar, TArray<int64>& Values)
+	{
+		int64 Previous = 0;
+		for (int64& Value : Values)
+		{
+			int64 Delta = Value - Previous;
+			SerializeZigZag(Ar, Delta);
+			Value = Previous + Delta;
+			Previous = Value;
+		}
+	}
+
+	/** Serializes a float array as 16-bit values spread evenly between the min and max value. */
+	void SerializeQuantized(FArchive& Ar, TArray<float>& Values)
+	{
+		float Min = 0.f;
+		float Max = 0.f;
+		if (Ar.IsSaving() && !Values.IsEmpty())
+		{
+			Min = FMath::Min(Values);
+			Max = FMath::Max(Values);
+		}
+		Ar << Min << Max;
+
+		const float Range = Max - Min;
+		for (float& Value : Values)
+		{
+			uint16 Quantized = Range > 0.f
+				? static_cast<uint16>(FMath::RoundToInt((Value - Min) / Range * 65535.f))
+				: 0;
+			Ar << Quantized;
+			Value = Min + Quantized / 65535.f * Range;
+		}
+	}
+}
+
+bool FCommonScoreInfo::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FCommonScoreInfoCustomVersion::GUID);
+	if (Ar.IsLoading())
+	{
+		const FCustomVersion* Version = Ar.GetCustomVersions().GetVersion(FCommonScoreInfoCustomVersion::GUID);
+		if (!Version || Version->Version < FCommonScoreInfoCustomVersion::CompactBinarySerialization)
+		{
+			return false;
+		}
+	}
+	SerializeCompact(Ar, Constants::bQuantizeSavedQTables);
+	return true;
+}
+
+void FCommonScoreInfo::SerializeCompact(FArchive& Ar, const bool bQuantizeQTable)
+{
+	uint8 Flags = static_cast<uint8>(bQuantizeQTable ? ECommonScoreInfoFlags::QuantizedQTable :
+		ECommonScoreInfoFlags::None);
+	Ar << Flags;
+
+	// QTable
+	Ar << NumQTableRows << NumQTableColumns;
+	SerializeNum(Ar, QTable);
+	if (Flags & static_cast<uint8>(ECommonScoreInfoFlags::QuantizedQTable))
+	{
+		SerializeQuantized(Ar, QTable);
+	}
+	else
+	{
+		Ar.Serialize(QTable.GetData(), QTable.Num() * sizeof(float));
+	}
+
+	// Training samples
+	SerializeNum(Ar, TrainingSamples);
+	for (int32& Sample : TrainingSamples)
+	{
+		int64 Value = Sample;
+		SerializeZigZag(Ar, Value);
+		Sample = static_cast<int32>(Value);
+	}
+	SerializeZigZag(Ar, TotalTrainingSamples);
+
+	// Accuracy
+	Ar << AccuracyData.SpawnAreaSize;
+	SerializeNum(Ar, AccuracyData.AccuracyRows);
+	for (FAccuracyRow& Row : AccuracyData.AccuracyRows)
+	{
+		int64 Size = Row.Size;
+		SerializeZigZag(Ar, Size);
+		if (Ar.IsLoading())
+		{
+			Row = FAccuracyRow(Size >= 0 && Size <= Ar.TotalSize() ? static_cast<int32>(Size) : 0);
+		}
+		SerializeDeltaEncoded(Ar, Row.TotalSpawns);
+		SerializeDeltaEncoded(Ar, Row.TotalHits);
+	}
+	if (Ar.IsLoading())
+	{
+		AccuracyData.CalculateAccuracy();
+	}
+}
 
 USaveGamePlayerScore::USaveGamePlayerScore()
 {
@@ -21,51 +185,208 @@ USaveGamePlayerScore::USaveGamePlayerScore()
 	TrainingSamplesFormat.MinimumIntegralDigits = 1;
 }
 
+USaveGamePlayerScore::~USaveGamePlayerScore() = default;
+
+bool USaveGamePlayerScore::InitializeScoreStore()
+{
+	return InitializeScoreStore(FPlayerScoreStore::GetDefaultFilePath());
+}
+
+bool USaveGamePlayerScore::InitializeScoreStore(const FString& FilePath)
+{
+	if (ScoreStore || bScoreStoreLoadFailed)
+	{
+		return false;
+	}
+
+	TUniquePtr<FPlayerScoreStore> LoadedStore = MakeUnique<FPlayerScoreStore>(FilePath);
+	const bool bLoaded = LoadedStore->Load();
+	return AdoptScoreStore(MoveTemp(LoadedStore), bLoaded);
+}
+
+void USaveGamePlayerScore::InitializeScoreStoreAsync(TFunction<void(bool)> OnInitialized)
+{
+	if (ScoreStore || bScoreStoreLoadFailed)
+	{
+		OnInitialized(false);
+		return;
+	}
+
+	PendingScoreStoreCallbacks.Add(MoveTemp(OnInitialized));
+	if (PendingScoreStoreCallbacks.Num() > 1)
+	{
+		return;
+	}
+
+	Async(EAsyncExecution::ThreadPool, [WeakThis = TWeakObjectPtr<ThisClass>(this)]()
+	{
+		TUniquePtr<FPlayerScoreStore> LoadedStore = MakeUnique<FPlayerScoreStore>();
+		const bool bLoaded = LoadedStore->Load();
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, LoadedStore = MoveTemp(LoadedStore), bLoaded]() mutable
+		{
+			USaveGamePlayerScore* SaveGamePlayerScore = WeakThis.Get();
+			if (!SaveGamePlayerScore)
+			{
+				return;
+			}
+
+			// The store may have been loaded synchronously while loading in the background
+			const bool bMigrated = !SaveGamePlayerScore->ScoreStore && !SaveGamePlayerScore->bScoreStoreLoadFailed &&
+				SaveGamePlayerScore->AdoptScoreStore(MoveTemp(LoadedStore), bLoaded);
+
+			const TArray<TFunction<void(bool)>> Callbacks = MoveTemp(SaveGamePlayerScore->PendingScoreStoreCallbacks);
+			SaveGamePlayerScore->PendingScoreStoreCallbacks.Reset();
+			for (const TFunction<void(bool)>& Callback : Callbacks)
+			{
+				Callback(bMigrated);
+			}
+		});
+	});
+}
+
+bool USaveGamePlayerScore::AdoptScoreStore(TUniquePtr<FPlayerScoreStore>&& LoadedStore, const bool bLoaded)
+{
+	// Appending to a store that failed to load could make the rest of its records unreadable. A store loaded on a
+	// background thread leaves removing any partially written record to the game thread
+	if (!bLoaded || (LoadedStore->NeedsCompaction() && !LoadedStore->Compact()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load player scores, using the score save game slot instead"));
+		bScoreStoreLoadFailed = true;
+		return false;
+	}
+	ScoreStore = MoveTemp(LoadedStore);
+
+	if (PlayerScoreArray.IsEmpty())
+	{
+		return false;
+	}
+
+	// Adopting may happen after InitializeScoreStoreAsync, outside of SaveLoadCommon::ModifySlot
+	USaveGameSubsystem::WaitForPendingWrite(this);
+
+	const int32 NumImported = ScoreStore->Import(PlayerScoreArray);
+	if (!ScoreStore->Compact())
+	{
+		return false;
+	}
+	UE_LOG(LogTemp, Display, TEXT("Moved %d player scores to the player score store"), NumImported);
+	PlayerScoreArray.Empty();
+	return true;
+}
+
 TArray<FPlayerScore> USaveGamePlayerScore::GetPlayerScores() const
 {
-	return PlayerScoreArray;
+	return ScoreStore ? ScoreStore->GetScores() : PlayerScoreArray;
 }
 
 TArray<FPlayerScore> USaveGamePlayerScore::GetPlayerScores_UnsavedToDatabase() const
 {
-	TArray<FPlayerScore> UnsavedScores;
+	if (ScoreStore)
+	{
+		return ScoreStore->GetScores_UnsavedToDatabase();
+	}
+	return PlayerScoreArray.FilterByPredicate([](const FPlayerScore& Score)
+	{
+		return !Score.bSavedToDatabase;
+	});
+}
+
+TArray<FPlayerScore> USaveGamePlayerScore::GetMatchingPlayerScores(const FPlayerScore& InPlayerScore) const
+{
+	if (ScoreStore)
+	{
+		return ScoreStore->GetMatchingScores(InPlayerScore);
+	}
+	return PlayerScoreArray.FilterByPredicate([&InPlayerScore](const FPlayerScore& Score)
+	{
+		return Score == InPlayerScore;
+	});
+}
+
+const FPlayerScore* USaveGamePlayerScore::GetMostRecentPlayerScore() const
+{
+	if (ScoreStore)
+	{
+		return ScoreStore->GetMostRecentScore();
+	}
+
+	// Iso8601 times compare the same as strings as they do as dates
+	const FPlayerScore* MostRecent = nullptr;
 	for (const FPlayerScore& Score : PlayerScoreArray)
 	{
-		if (!Score.bSavedToDatabase)
+		if (!MostRecent || Score.Time > MostRecent->Time)
 		{
-			UnsavedScores.Add(Score);
+			MostRecent = &Score;
 		}
 	}
-	return UnsavedScores;
+	return MostRecent;
 }
 
-void USaveGamePlayerScore::AddPlayerScoreInstance(const FPlayerScore& InPlayerScore)
+bool USaveGamePlayerScore::AddPlayerScoreInstance(const FPlayerScore& InPlayerScore)
 {
-	if (!ContainsExistingTime(InPlayerScore))
+	if (ContainsExistingTime(InPlayerScore))
 	{
-		PlayerScoreArray.Add(InPlayerScore);
+		UE_LOG(LogTemp, Display, TEXT("Existing Score with the same Time found"));
+		return false;
 	}
-	else
+	if (ScoreStore)
 	{
-		UE_LOG(LogTemp, Display, TEXT("Existing Score with the same Time found"));
+		ScoreStore->Add(InPlayerScore);
+		return false;
 	}
+
+	// Moved to the store once it loads
+	PlayerScoreArray.Add(InPlayerScore);
+	return true;
 }
 
-void USaveGamePlayerScore::SetAllScoresSavedToDatabase()
+bool USaveGamePlayerScore::SetAllScoresSavedToDatabase()
 {
+	if (ScoreStore)
+	{
+		ScoreStore->MarkAllSavedToDatabase();
+		return false;
+	}
+
+	bool bMarked = false;
 	for (FPlayerScore& Score : PlayerScoreArray)
 	{
+		bMarked |= !Score.bSavedToDatabase;
 		Score.bSavedToDatabase = true;
 	}
+	return bMarked;
 }
 
-bool USaveGamePlayerScore::ContainsExistingTime(const FPlayerScore& InPlayerScore)
+bool USaveGamePlayerScore::SetScoresSavedToDatabase(const TArray<FString>& Times)
 {
-	const FPlayerScore* Found = PlayerScoreArray.FindByPredicate([&InPlayerScore](const FPlayerScore& CompareScore)
+	if (ScoreStore)
+	{
+		ScoreStore->MarkSavedToDatabase(Times);
+		return false;
+	}
+
+	bool bMarked = false;
+	for (FPlayerScore& Score : PlayerScoreArray)
+	{
+		if (!Score.bSavedToDatabase && Times.Contains(Score.Time))
+		{
+			Score.bSavedToDatabase = true;
+			bMarked = true;
+		}
+	}
+	return bMarked;
+}
+
+bool USaveGamePlayerScore::ContainsExistingTime(const FPlayerScore& InPlayerScore) const
+{
+	if (ScoreStore)
+	{
+		return ScoreStore->ContainsTime(InPlayerScore.Time);
+	}
+	return PlayerScoreArray.ContainsByPredicate([&InPlayerScore](const FPlayerScore& Score)
 	{
-		return InPlayerScore.Time.Equals(CompareScore.Time);
+		return Score.Time.Equals(InPlayerScore.Time);
 	});
-	return Found ? true : false;
 }
 
 TMap<FBS_DefiningConfig, FCommonScoreInfo> USaveGamePlayerScore::GetCommonScoreInfo() const
@@ -76,7 +397,9 @@ TMap<FBS_DefiningConfig, FCommonScoreInfo> USaveGamePlayerScore::GetCommonScoreI
 void USaveGamePlayerScore::FindOrAddCommonScoreInfo(const FBS_DefiningConfig& InDefiningConfig,
 	FCommonScoreInfo& OutCommonScoreInfo)
 {
-	OutCommonScoreInfo = CommonScoreInfo.FindOrAdd(InDefiningConfig);
+	// Not added to the map, since the save game stays resident and would otherwise persist empty entries
+	const FCommonScoreInfo* Found = CommonScoreInfo.Find(InDefiningConfig);
+	OutCommonScoreInfo = Found ? *Found : FCommonScoreInfo();
 }
 
 void USaveGamePlayerScore::SaveCommonScoreInfo(const FBS_DefiningConfig& InDefiningConfig,
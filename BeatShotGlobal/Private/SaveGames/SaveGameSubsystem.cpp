@@ -0,0 +1,215 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "SaveGames/SaveGameSubsystem.h"
+#include "BSConstants.h"
+#include "Async/Async.h"
+#include "GameFramework/SaveGame.h"
+#include "Kismet/GameplayStatics.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+
+DEFINE_LOG_CATEGORY(LogSaveGameSubsystem);
+
+USaveGameSubsystem* USaveGameSubsystem::Instance = nullptr;
+
+void USaveGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Instance = this;
+	FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &USaveGameSubsystem::OnFlushTick), Constants::SaveGameFlushInterval);
+}
+
+void USaveGameSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+	FlushSynchronous();
+	CachedSaveGames.Empty();
+	WritingSaveGames.Empty();
+	PreloadedData.Empty();
+	PendingPreloads.Empty();
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+	Super::Deinitialize();
+}
+
+USaveGameSubsystem* USaveGameSubsystem::Get()
+{
+	check(IsInGameThread());
+	return Instance;
+}
+
+USaveGame* USaveGameSubsystem::FindCachedSaveGame(const FString& SlotName, const int32 UserIndex) const
+{
+	if (const TObjectPtr<USaveGame>* Found = CachedSaveGames.Find(FSaveGameSlotKey(SlotName, UserIndex)))
+	{
+		return *Found;
+	}
+	return nullptr;
+}
+
+void USaveGameSubsystem::CacheSaveGame(const FString& SlotName, const int32 UserIndex, USaveGame* SaveGame)
+{
+	CachedSaveGames.Add(FSaveGameSlotKey(SlotName, UserIndex), SaveGame);
+}
+
+void USaveGameSubsystem::MarkSlotDirty(const FString& SlotName, const int32 UserIndex, USaveGame* SaveGame)
+{
+	const FSaveGameSlotKey Key(SlotName, UserIndex);
+	CachedSaveGames.Add(Key, SaveGame);
+	DirtySlots.Add(Key);
+}
+
+void USaveGameSubsystem::PreloadSlotAsync(const FString& SlotName, const int32 UserIndex,
+	TFunction<void()> OnPreloaded)
+{
+	const FSaveGameSlotKey Key(SlotName, UserIndex);
+	if (CachedSaveGames.Contains(Key) || PreloadedData.Contains(Key))
+	{
+		OnPreloaded();
+		return;
+	}
+
+	// Only one read per slot
+	if (TArray<TFunction<void()>>* Pending = PendingPreloads.Find(Key))
+	{
+		Pending->Add(MoveTemp(OnPreloaded));
+		return;
+	}
+	PendingPreloads.Add(Key).Add(MoveTemp(OnPreloaded));
+
+	// Slots are only written once they are resident, so nothing can be writing to this one
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	Async(EAsyncExecution::ThreadPool, [WeakThis = TWeakObjectPtr<ThisClass>(this), Key, SaveSystem]()
+	{
+		TArray<uint8> Data;
+		if (SaveSystem && SaveSystem->DoesSaveGameExist(*Key.SlotName, Key.UserIndex))
+		{
+			SaveSystem->LoadGame(false, *Key.SlotName, Key.UserIndex, Data);
+		}
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Key, Data = MoveTemp(Data)]() mutable
+		{
+			if (USaveGameSubsystem* SaveGameSubsystem = WeakThis.Get())
+			{
+				SaveGameSubsystem->OnSlotPreloaded(Key, MoveTemp(Data));
+			}
+		});
+	});
+}
+
+bool USaveGameSubsystem::ConsumePreloadedData(const FString& SlotName, const int32 UserIndex, TArray<uint8>& OutData)
+{
+	return PreloadedData.RemoveAndCopyValue(FSaveGameSlotKey(SlotName, UserIndex), OutData);
+}
+
+void USaveGameSubsystem::OnSlotPreloaded(const FSaveGameSlotKey& Key, TArray<uint8>&& Data)
+{
+	// The slot may have been loaded synchronously while reading
+	if (!Data.IsEmpty() && !CachedSaveGames.Contains(Key))
+	{
+		PreloadedData.Add(Key, MoveTemp(Data));
+	}
+
+	TArray<TFunction<void()>> Callbacks;
+	PendingPreloads.RemoveAndCopyValue(Key, Callbacks);
+	for (const TFunction<void()>& Callback : Callbacks)
+	{
+		Callback();
+	}
+}
+
+void USaveGameSubsystem::FlushSynchronous()
+{
+	for (TPair<FSaveGameSlotKey, TFuture<bool>>& Pair : PendingWrites)
+	{
+		Pair.Value.Wait();
+	}
+	CollectFinishedWrites();
+
+	for (const FSaveGameSlotKey& Key : DirtySlots)
+	{
+		if (!WriteSaveGame(CachedSaveGames.FindRef(Key), Key))
+		{
+			UE_LOG(LogSaveGameSubsystem, Error, TEXT("Failed to save %s"), *Key.ToString());
+		}
+	}
+	DirtySlots.Empty();
+}
+
+void USaveGameSubsystem::WaitForPendingWrite(const USaveGame* SaveGame)
+{
+	check(IsInGameThread());
+	if (!Instance || !SaveGame)
+	{
+		return;
+	}
+	for (const TPair<FSaveGameSlotKey, TObjectPtr<USaveGame>>& Pair : Instance->WritingSaveGames)
+	{
+		if (Pair.Value == SaveGame)
+		{
+			Instance->PendingWrites.FindChecked(Pair.Key).Wait();
+		}
+	}
+}
+
+bool USaveGameSubsystem::OnFlushTick(float DeltaTime)
+{
+	CollectFinishedWrites();
+
+	for (auto It = DirtySlots.CreateIterator(); It; ++It)
+	{
+		// Only one write per slot at a time, so that an older write can never replace a newer one
+		const FSaveGameSlotKey& Key = *It;
+		if (PendingWrites.Contains(Key))
+		{
+			continue;
+		}
+
+		// Anything that modifies the save game waits for this write to finish first, see WaitForPendingWrite
+		USaveGame* SaveGame = CachedSaveGames.FindRef(Key);
+		WritingSaveGames.Add(Key, SaveGame);
+		PendingWrites.Add(Key, Async(EAsyncExecution::ThreadPool, [SaveGame, Key]()
+		{
+			return WriteSaveGame(SaveGame, Key);
+		}));
+		It.RemoveCurrent();
+	}
+	return true;
+}
+
+void USaveGameSubsystem::CollectFinishedWrites()
+{
+	for (auto It = PendingWrites.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsReady())
+		{
+			continue;
+		}
+		if (It.Value().Get())
+		{
+			UE_LOG(LogSaveGameSubsystem, Verbose, TEXT("Saved %s"), *It.Key().ToString());
+		}
+		else
+		{
+			UE_LOG(LogSaveGameSubsystem, Warning, TEXT("Failed to write %s, retrying"), *It.Key().ToString());
+			DirtySlots.Add(It.Key());
+		}
+		WritingSaveGames.Remove(It.Key());
+		It.RemoveCurrent();
+	}
+}
+
+bool USaveGameSubsystem::WriteSaveGame(const USaveGame* SaveGame, const FSaveGameSlotKey& Key)
+{
+	// Saving only reads from the save game, even though SaveGameToMemory takes a mutable pointer
+	TArray<uint8> Data;
+	if (!SaveGame || !UGameplayStatics::SaveGameToMemory(const_cast<USaveGame*>(SaveGame), Data))
+	{
+		return false;
+	}
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	return SaveSystem && SaveSystem->SaveGame(false, *Key.SlotName, Key.UserIndex, Data);
+}
@@ -0,0 +1,297 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+
+#include "ScoreUploadOutbox.h"
+#include "HttpModule.h"
+#include "HttpRequestInterface.h"
+#include "Async/Async.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Compression.h"
+#include "Utilities/BSJsonStream.h"
+
+DEFINE_LOG_CATEGORY(LogScoreUploadOutbox);
+
+namespace
+{
+	/** Rough number of characters a single condensed FPlayerScore takes up, used to size the payload buffer. */
+	constexpr int32 EstimatedCharsPerScore = 768;
+}
+
+FScoreUploadOutbox::FScoreUploadOutbox(const FString& InUserID, FScoreUploadAccessTokenProvider InAccessTokenProvider,
+	const FString& InBaseURL, const bool bInCompress): UserID(InUserID), BaseURL(InBaseURL),
+	                                                  AccessTokenProvider(MoveTemp(InAccessTokenProvider)),
+	                                                  bCompress(bInCompress), bUploading(false),
+	                                                  NumFailedAttempts(0), RetryStream(FPlatformTime::Cycles())
+{
+}
+
+FScoreUploadOutbox::~FScoreUploadOutbox()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(RetryHandle);
+}
+
+int32 FScoreUploadOutbox::Enqueue(const TArray<FPlayerScore>& Scores)
+{
+	int32 NumAdded = 0;
+	for (const FPlayerScore& Score : Scores)
+	{
+		if (Score.bSavedToDatabase || PendingTimes.Contains(Score.Time))
+		{
+			continue;
+		}
+		PendingTimes.Add(Score.Time);
+		Pending.Add(Score);
+		NumAdded++;
+	}
+	return NumAdded;
+}
+
+void FScoreUploadOutbox::Flush(TFunction<void(bool)> OnFlushed)
+{
+	if (Pending.IsEmpty() && !bUploading)
+	{
+		OnFlushed(true);
+		return;
+	}
+
+	FlushCallbacks.Add(MoveTemp(OnFlushed));
+	if (bUploading)
+	{
+		// Send right away instead of waiting for a scheduled retry
+		if (RetryHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(RetryHandle);
+			RetryHandle.Reset();
+			SendNextBatch();
+		}
+		return;
+	}
+
+	bUploading = true;
+	NumFailedAttempts = 0;
+	SendNextBatch();
+}
+
+bool FScoreUploadOutbox::BuildPayload(const TArray<FPlayerScore>& Scores, const bool bCompress,
+	TArray<uint8>& OutPayload)
+{
+	FJsonScore JsonScores;
+	JsonScores.Scores = Scores;
+	FString ContentString;
+	if (!BSJsonStream::UStructToJsonString(JsonScores, ContentString, 0, 0, false, Scores.Num() *
+		EstimatedCharsPerScore))
+	{
+		return false;
+	}
+
+	const FTCHARToUTF8 Utf8(*ContentString);
+	if (!bCompress)
+	{
+		OutPayload.SetNumUninitialized(Utf8.Length());
+		FMemory::Memcpy(OutPayload.GetData(), Utf8.Get(), Utf8.Length());
+		return true;
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Utf8.Length());
+	OutPayload.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Gzip, OutPayload.GetData(), CompressedSize, Utf8.Get(), Utf8.Length()))
+	{
+		OutPayload.Empty();
+		return false;
+	}
+	OutPayload.SetNum(CompressedSize);
+	return true;
+}
+
+float FScoreUploadOutbox::GetRetryDelay(const int32 Attempt, FRandomStream& Stream)
+{
+	const float Delay = FMath::Min(Constants::ScoreUploadInitialRetryDelay * FMath::Pow(2.f, FMath::Max(Attempt - 1,
+		0)), Constants::ScoreUploadMaxRetryDelay);
+	return Delay * (1.f + Stream.FRandRange(-Constants::ScoreUploadRetryJitter, Constants::ScoreUploadRetryJitter));
+}
+
+void FScoreUploadOutbox::SendNextBatch()
+{
+	if (Pending.IsEmpty())
+	{
+		bUploading = false;
+		CompleteFlush(true);
+		return;
+	}
+
+	TArray<FPlayerScore> Batch(Pending.GetData(), FMath::Min(Pending.Num(), Constants::ScoreUploadBatchSize));
+	TArray<FString> Times;
+	Times.Reserve(Batch.Num());
+	for (const FPlayerScore& Score : Batch)
+	{
+		Times.Add(Score.Time);
+	}
+
+	Async(EAsyncExecution::ThreadPool,
+		[WeakThis = TWeakPtr<FScoreUploadOutbox, ESPMode::ThreadSafe>(AsShared()), Batch = MoveTemp(Batch),
+			Times = MoveTemp(Times), bCompressed = bCompress]() mutable
+		{
+			TArray<uint8> Payload;
+			bool bBuilt = BuildPayload(Batch, bCompressed, Payload);
+			if (!bBuilt && bCompressed)
+			{
+				UE_LOG(LogScoreUploadOutbox, Warning, TEXT("Failed to compress score upload, sending uncompressed"));
+				bCompressed = false;
+				bBuilt = BuildPayload(Batch, false, Payload);
+			}
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Times = MoveTemp(Times), Payload = MoveTemp(Payload),
+				bCompressed, bBuilt]() mutable
+			{
+				if (const TSharedPtr<FScoreUploadOutbox, ESPMode::ThreadSafe> Outbox = WeakThis.Pin())
+				{
+					if (bBuilt)
+					{
+						Outbox->SendBatch(Times, MoveTemp(Payload), bCompressed);
+					}
+					else
+					{
+						Outbox->AbortUpload();
+					}
+				}
+			});
+		});
+}
+
+void FScoreUploadOutbox::SendBatch(const TArray<FString>& Times, TArray<uint8>&& Payload, const bool bCompressed)
+{
+	if (AccessToken.IsEmpty())
+	{
+		if (!AccessTokenProvider)
+		{
+			OnBatchCompleted(Times, bCompressed, false, 401);
+			return;
+		}
+		AccessTokenProvider([WeakThis = TWeakPtr<FScoreUploadOutbox, ESPMode::ThreadSafe>(AsShared()), Times,
+			Payload = MoveTemp(Payload), bCompressed](const FString& NewAccessToken) mutable
+		{
+			if (const TSharedPtr<FScoreUploadOutbox, ESPMode::ThreadSafe> Outbox = WeakThis.Pin())
+			{
+				if (NewAccessToken.IsEmpty())
+				{
+					Outbox->OnBatchCompleted(Times, bCompressed, false, 401);
+					return;
+				}
+				Outbox->AccessToken = NewAccessToken;
+				Outbox->SendBatch(Times, MoveTemp(Payload), bCompressed);
+			}
+		});
+		return;
+	}
+
+	const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
+	// Resolved for every batch so that batches follow the mock backend starting or stopping
+	HttpRequest->SetURL(IHttpRequestInterface::ResolveURL(BaseURL) + UserID + Constants::Segment_SaveScores);
+	HttpRequest->SetVerb("POST");
+	HttpRequest->SetTimeout(Constants::ScoreUploadTimeout);
+	HttpRequest->SetHeader("Content-Type", "application/json");
+	if (bCompressed)
+	{
+		HttpRequest->SetHeader("Content-Encoding", "gzip");
+	}
+	HttpRequest->SetHeader("Authorization", "Bearer " + AccessToken);
+	HttpRequest->SetContent(MoveTemp(Payload));
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[WeakThis = TWeakPtr<FScoreUploadOutbox, ESPMode::ThreadSafe>(AsShared()), Times, bCompressed](
+		FHttpRequestPtr Request, const FHttpResponsePtr Response, bool bConnectedSuccessfully)
+		{
+			if (const TSharedPtr<FScoreUploadOutbox, ESPMode::ThreadSafe> Outbox = WeakThis.Pin())
+			{
+				const bool bHasResponse = bConnectedSuccessfully && Response.IsValid();
+				Outbox->OnBatchCompleted(Times, bCompressed, bHasResponse,
+					bHasResponse ? Response->GetResponseCode() : 502);
+			}
+		});
+	HttpRequest->ProcessRequest();
+}
+
+void FScoreUploadOutbox::OnBatchCompleted(const TArray<FString>& Times, const bool bCompressed,
+	const bool bConnectedSuccessfully, const int32 HttpStatus)
+{
+	if (bConnectedSuccessfully && HttpStatus >= 200 && HttpStatus <= 300)
+	{
+		for (const FString& Time : Times)
+		{
+			PendingTimes.Remove(Time);
+		}
+		const TSet<FString> Acknowledged(Times);
+		Pending.RemoveAll([&Acknowledged](const FPlayerScore& Score)
+		{
+			return Acknowledged.Contains(Score.Time);
+		});
+		UE_LOG(LogScoreUploadOutbox, Display, TEXT("Saved %d scores to database, %d remaining."), Times.Num(),
+			Pending.Num());
+
+		NumFailedAttempts = 0;
+		if (OnScoresAcknowledged)
+		{
+			OnScoresAcknowledged(Times);
+		}
+		SendNextBatch();
+		return;
+	}
+
+	if (bCompressed && bConnectedSuccessfully && (HttpStatus == 400 || HttpStatus == 415))
+	{
+		// Not a failed attempt, the same batch is sent again right away
+		UE_LOG(LogScoreUploadOutbox, Warning, TEXT("Compressed score upload rejected Http Status: %d, sending "
+			"uncompressed"), HttpStatus);
+		bCompress = false;
+		SendNextBatch();
+		return;
+	}
+
+	UE_LOG(LogScoreUploadOutbox, Warning, TEXT("Score upload failed Http Status: %d"), HttpStatus);
+	if (HttpStatus == 401 || HttpStatus == 403)
+	{
+		AccessToken.Empty();
+	}
+	CompleteFlush(false);
+	ScheduleRetry();
+}
+
+void FScoreUploadOutbox::ScheduleRetry()
+{
+	NumFailedAttempts++;
+	if (NumFailedAttempts >= Constants::ScoreUploadMaxAttempts)
+	{
+		UE_LOG(LogScoreUploadOutbox, Warning, TEXT("Giving up on score upload after %d attempts, %d scores pending."),
+			NumFailedAttempts, Pending.Num());
+		bUploading = false;
+		return;
+	}
+
+	const float Delay = GetRetryDelay(NumFailedAttempts, RetryStream);
+	RetryHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[WeakThis = TWeakPtr<FScoreUploadOutbox, ESPMode::ThreadSafe>(AsShared())](float)
+		{
+			if (const TSharedPtr<FScoreUploadOutbox, ESPMode::ThreadSafe> Outbox = WeakThis.Pin())
+			{
+				Outbox->RetryHandle.Reset();
+				Outbox->SendNextBatch();
+			}
+			return false;
+		}), Delay);
+}
+
+void FScoreUploadOutbox::AbortUpload()
+{
+	// Retrying would build the same payload, so the scores stay pending until the next flush
+	UE_LOG(LogScoreUploadOutbox, Error, TEXT("Failed to build score upload, %d scores pending."), Pending.Num());
+	bUploading = false;
+	CompleteFlush(false);
+}
+
+void FScoreUploadOutbox::CompleteFlush(const bool bSucceeded)
+{
+	const TArray<TFunction<void(bool)>> Callbacks = MoveTemp(FlushCallbacks);
+	FlushCallbacks.Reset();
+	for (const TFunction<void(bool)>& Callback : Callbacks)
+	{
+		Callback(bSucceeded);
+	}
+}
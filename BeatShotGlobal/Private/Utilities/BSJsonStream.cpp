@@ -0,0 +1,820 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "Utilities/BSJsonStream.h"
+#include "JsonObjectConverter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** The minimum number of characters reserved for the output of UStructToJsonString. */
+	constexpr int32 MinReserveSize = 1024;
+
+	/* ---------------- */
+	/* ---- Writer ---- */
+	/* ---------------- */
+
+	/** FJsonSerializer writes a value without an identifier whenever the identifier is empty. */
+	template <typename PrintPolicy, typename ValueType>
+	void WriteJsonValue(const TSharedRef<TJsonWriter<TCHAR, PrintPolicy>>& Writer, const FString& Identifier,
+		const ValueType& Value)
+	{
+		if (Identifier.IsEmpty())
+		{
+			Writer->WriteValue(Value);
+		}
+		else
+		{
+			Writer->WriteValue(Identifier, Value);
+		}
+	}
+
+	template <typename PrintPolicy>
+	void WriteJsonObjectStart(const TSharedRef<TJsonWriter<TCHAR, PrintPolicy>>& Writer, const FString& Identifier)
+	{
+		if (Identifier.IsEmpty())
+		{
+			Writer->WriteObjectStart();
+		}
+		else
+		{
+			Writer->WriteObjectStart(Identifier);
+		}
+	}
+
+	template <typename PrintPolicy>
+	void WriteJsonArrayStart(const TSharedRef<TJsonWriter<TCHAR, PrintPolicy>>& Writer, const FString& Identifier)
+	{
+		if (Identifier.IsEmpty())
+		{
+			Writer->WriteArrayStart();
+		}
+		else
+		{
+			Writer->WriteArrayStart(Identifier);
+		}
+	}
+
+	template <typename PrintPolicy>
+	bool WriteProperty(const TSharedRef<TJsonWriter<TCHAR, PrintPolicy>>& Writer, const FString& Identifier,
+		FProperty* Property, const void* Value, const int64 CheckFlags, const int64 SkipFlags);
+
+	/** Writes every property of a struct, matching FJsonObjectConverter::UStructToJsonAttributes. */
+	template <typename PrintPolicy>
+	bool WriteStructProperties(const TSharedRef<TJsonWriter<TCHAR, PrintPolicy>>& Writer,
+		const UStruct* StructDefinition, const void* Struct, const int64 CheckFlags, const int64 SkipFlags)
+	{
+		for (TFieldIterator<FProperty> It(StructDefinition); It; ++It)
+		{
+			FProperty* Property = *It;
+			if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
+			{
+				continue;
+			}
+			if (Property->HasAnyPropertyFlags(SkipFlags))
+			{
+				continue;
+			}
+
+			const FString Identifier = FJsonObjectConverter::StandardizeCase(Property->GetAuthoredName());
+			if (!WriteProperty(Writer, Identifier, Property, Property->ContainerPtrToValuePtr<uint8>(Struct),
+				CheckFlags, SkipFlags))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Returns the string used as the JSON key for a map key, matching FJsonObjectConverter. Map keys are rare, so
+	 *  they still go through the converter. */
+	FString GetMapKeyString(const FMapProperty* MapProperty, const void* KeyPtr, const int32 Index,
+		const int64 CheckFlags, const int64 SkipFlags)
+	{
+		FString KeyString;
+		const TSharedPtr<FJsonValue> KeyValue = FJsonObjectConverter::UPropertyToJsonValue(MapProperty->KeyProp,
+			KeyPtr, CheckFlags, SkipFlags);
+		if (!KeyValue.IsValid() || !KeyValue->TryGetString(KeyString))
+		{
+			MapProperty->KeyProp->ExportTextItem_Direct(KeyString, KeyPtr, nullptr, nullptr, 0);
+			if (KeyString.IsEmpty())
+			{
+				KeyString = FString::Printf(TEXT("Unparsed Key %d"), Index);
+			}
+		}
+		if (CastField<FEnumProperty>(MapProperty->KeyProp) || CastField<FNameProperty>(MapProperty->KeyProp))
+		{
+			KeyString = FJsonObjectConverter::StandardizeCase(KeyString);
+		}
+		return KeyString;
+	}
+
+	/** Writes a single value, matching FJsonObjectConverter's conversion of a scalar property to an FJsonValue. */
+	template <typename PrintPolicy>
+	bool WriteScalarProperty(const TSharedRef<TJsonWriter<TCHAR, PrintPolicy>>& Writer, const FString& Identifier,
+		FProperty* Property, const void* Value, const int64 CheckFlags, const int64 SkipFlags)
+	{
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			WriteJsonValue(Writer, Identifier, EnumProperty->GetEnum()->GetAuthoredNameStringByValue(
+				EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value)));
+			return true;
+		}
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (const UEnum* EnumDef = NumericProperty->GetIntPropertyEnum())
+			{
+				WriteJsonValue(Writer, Identifier, EnumDef->GetAuthoredNameStringByValue(
+					NumericProperty->GetSignedIntPropertyValue(Value)));
+				return true;
+			}
+			if (NumericProperty->IsFloatingPoint())
+			{
+				WriteJsonValue(Writer, Identifier, NumericProperty->GetFloatingPointPropertyValue(Value));
+				return true;
+			}
+			if (NumericProperty->IsInteger())
+			{
+				// FJsonValueNumber stores every number as a double
+				WriteJsonValue(Writer, Identifier,
+					static_cast<double>(NumericProperty->GetSignedIntPropertyValue(Value)));
+				return true;
+			}
+			return false;
+		}
+		if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			WriteJsonValue(Writer, Identifier, BoolProperty->GetPropertyValue(Value));
+			return true;
+		}
+		if (const FStrProperty* StringProperty = CastField<FStrProperty>(Property))
+		{
+			WriteJsonValue(Writer, Identifier, StringProperty->GetPropertyValue(Value));
+			return true;
+		}
+		if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+		{
+			WriteJsonValue(Writer, Identifier, TextProperty->GetPropertyValue(Value).ToString());
+			return true;
+		}
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			WriteJsonArrayStart(Writer, Identifier);
+			FScriptArrayHelper Helper(ArrayProperty, Value);
+			for (int32 i = 0; i < Helper.Num(); i++)
+			{
+				if (!WriteProperty(Writer, FString(), ArrayProperty->Inner, Helper.GetRawPtr(i),
+					CheckFlags & ~CPF_ParmFlags, SkipFlags))
+				{
+					return false;
+				}
+			}
+			Writer->WriteArrayEnd();
+			return true;
+		}
+		if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			WriteJsonArrayStart(Writer, Identifier);
+			FScriptSetHelper Helper(SetProperty, Value);
+			for (int32 i = 0; i < Helper.GetMaxIndex(); i++)
+			{
+				if (Helper.IsValidIndex(i) && !WriteProperty(Writer, FString(), SetProperty->ElementProp,
+					Helper.GetElementPtr(i), CheckFlags & ~CPF_ParmFlags, SkipFlags))
+				{
+					return false;
+				}
+			}
+			Writer->WriteArrayEnd();
+			return true;
+		}
+		if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			WriteJsonObjectStart(Writer, Identifier);
+			FScriptMapHelper Helper(MapProperty, Value);
+			for (int32 i = 0; i < Helper.GetMaxIndex(); i++)
+			{
+				if (!Helper.IsValidIndex(i))
+				{
+					continue;
+				}
+				const FString KeyString = GetMapKeyString(MapProperty, Helper.GetKeyPtr(i), i,
+					CheckFlags & ~CPF_ParmFlags, SkipFlags);
+				if (!WriteProperty(Writer, KeyString, MapProperty->ValueProp, Helper.GetValuePtr(i),
+					CheckFlags & ~CPF_ParmFlags, SkipFlags))
+				{
+					return false;
+				}
+			}
+			Writer->WriteObjectEnd();
+			return true;
+		}
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (StructProperty->Struct == FJsonObjectWrapper::StaticStruct())
+			{
+				// Exported as the wrapped JSON object, so let the converter handle it
+				const TSharedPtr<FJsonValue> JsonValue = FJsonObjectConverter::UPropertyToJsonValue(Property, Value,
+					CheckFlags, SkipFlags);
+				return JsonValue.IsValid() && FJsonSerializer::Serialize(JsonValue, Identifier, Writer, false);
+			}
+
+			UScriptStruct::ICppStructOps* CppStructOps = StructProperty->Struct->GetCppStructOps();
+			if (CppStructOps && CppStructOps->HasExportTextItem())
+			{
+				FString ExportedText;
+				CppStructOps->ExportTextItem(ExportedText, Value, nullptr, nullptr, PPF_None, nullptr);
+				WriteJsonValue(Writer, Identifier, ExportedText);
+				return true;
+			}
+
+			WriteJsonObjectStart(Writer, Identifier);
+			if (!WriteStructProperties(Writer, StructProperty->Struct, Value, CheckFlags & ~CPF_ParmFlags, SkipFlags))
+			{
+				return false;
+			}
+			Writer->WriteObjectEnd();
+			return true;
+		}
+		if (CastField<FObjectPropertyBase>(Property))
+		{
+			// Instanced objects are exported as nested objects, so let the converter handle them
+			const TSharedPtr<FJsonValue> JsonValue = FJsonObjectConverter::UPropertyToJsonValue(Property, Value,
+				CheckFlags, SkipFlags);
+			return JsonValue.IsValid() && FJsonSerializer::Serialize(JsonValue, Identifier, Writer, false);
+		}
+
+		// Everything else is exported as text
+		FString ExportedText;
+		Property->ExportTextItem_Direct(ExportedText, Value, nullptr, nullptr, PPF_None);
+		WriteJsonValue(Writer, Identifier, ExportedText);
+		return true;
+	}
+
+	/** Writes a property, as an array if it is a static array. */
+	template <typename PrintPolicy>
+	bool WriteProperty(const TSharedRef<TJsonWriter<TCHAR, PrintPolicy>>& Writer, const FString& Identifier,
+		FProperty* Property, const void* Value, const int64 CheckFlags, const int64 SkipFlags)
+	{
+		if (Property->ArrayDim == 1)
+		{
+			return WriteScalarProperty(Writer, Identifier, Property, Value, CheckFlags, SkipFlags);
+		}
+
+		WriteJsonArrayStart(Writer, Identifier);
+		for (int32 i = 0; i < Property->ArrayDim; i++)
+		{
+			if (!WriteScalarProperty(Writer, FString(), Property, static_cast<const uint8*>(Value) + i * Property->
+				ElementSize, CheckFlags, SkipFlags))
+			{
+				return false;
+			}
+		}
+		Writer->WriteArrayEnd();
+		return true;
+	}
+
+	template <typename PrintPolicy>
+	bool WriteRootStruct(FArchive& Archive, const UStruct* StructDefinition, const void* Struct,
+		const int64 CheckFlags, const int64 SkipFlags)
+	{
+		const TSharedRef<TJsonWriter<TCHAR, PrintPolicy>> Writer = TJsonWriterFactory<TCHAR, PrintPolicy>::Create(
+			&Archive);
+		Writer->WriteObjectStart();
+		if (!WriteStructProperties(Writer, StructDefinition, Struct, CheckFlags, SkipFlags))
+		{
+			return false;
+		}
+		Writer->WriteObjectEnd();
+		return Writer->Close();
+	}
+
+	/* ---------------- */
+	/* ---- Reader ---- */
+	/* ---------------- */
+
+	/** The current value token of the reader, with the same conversions between types as FJsonValue. String points
+	 *  into the reader, so the token is only valid until the next call to ReadNext. */
+	struct FJsonToken
+	{
+		EJsonNotation Notation = EJsonNotation::Null;
+		const FString* String = nullptr;
+		double Number = 0.0;
+		bool bBoolean = false;
+
+		FJsonToken(const TJsonReader<>& Reader, const EJsonNotation InNotation): Notation(InNotation)
+		{
+			switch (Notation)
+			{
+			case EJsonNotation::String:
+				String = &Reader.GetValueAsString();
+				break;
+			case EJsonNotation::Number:
+				Number = Reader.GetValueAsNumber();
+				break;
+			case EJsonNotation::Boolean:
+				bBoolean = Reader.GetValueAsBoolean();
+				break;
+			default:
+				break;
+			}
+		}
+
+		explicit FJsonToken(const FString& InString): Notation(EJsonNotation::String), String(&InString)
+		{
+		}
+
+		double AsNumber() const
+		{
+			double Value = 0.0;
+			if (Notation == EJsonNotation::Number)
+			{
+				Value = Number;
+			}
+			else if (Notation == EJsonNotation::String)
+			{
+				LexTryParseString(Value, **String);
+			}
+			else if (Notation == EJsonNotation::Boolean)
+			{
+				Value = bBoolean ? 1.0 : 0.0;
+			}
+			return Value;
+		}
+
+		FString AsString() const
+		{
+			if (Notation == EJsonNotation::String)
+			{
+				return *String;
+			}
+			if (Notation == EJsonNotation::Number)
+			{
+				return FString::SanitizeFloat(Number, 0);
+			}
+			if (Notation == EJsonNotation::Boolean)
+			{
+				return bBoolean ? TEXT("true") : TEXT("false");
+			}
+			return FString();
+		}
+
+		bool AsBool() const
+		{
+			if (Notation == EJsonNotation::Boolean)
+			{
+				return bBoolean;
+			}
+			if (Notation == EJsonNotation::Number)
+			{
+				return Number != 0.0;
+			}
+			if (Notation == EJsonNotation::String)
+			{
+				return String->ToBool();
+			}
+			return false;
+		}
+	};
+
+	void SetFailReason(FText* OutFailReason, const FString& Reason)
+	{
+		if (OutFailReason)
+		{
+			*OutFailReason = FText::FromString(Reason);
+		}
+	}
+
+	/** Consumes the rest of the value that started with Notation. */
+	bool SkipValue(TJsonReader<>& Reader, const EJsonNotation Notation)
+	{
+		if (Notation == EJsonNotation::Error)
+		{
+			return false;
+		}
+		if (Notation != EJsonNotation::ObjectStart && Notation != EJsonNotation::ArrayStart)
+		{
+			return true;
+		}
+
+		int32 Depth = 1;
+		EJsonNotation Next;
+		while (Depth > 0 && Reader.ReadNext(Next))
+		{
+			if (Next == EJsonNotation::Error)
+			{
+				return false;
+			}
+			if (Next == EJsonNotation::ObjectStart || Next == EJsonNotation::ArrayStart)
+			{
+				Depth++;
+			}
+			else if (Next == EJsonNotation::ObjectEnd || Next == EJsonNotation::ArrayEnd)
+			{
+				Depth--;
+			}
+		}
+		return Depth == 0;
+	}
+
+	bool ReadProperty(TJsonReader<>& Reader, const FJsonToken& Token, FProperty* Property, void* Value,
+		const int64 CheckFlags, const int64 SkipFlags, FText* OutFailReason);
+
+	/** Reads the members of an object into a struct, after its ObjectStart has been read. Matches
+	 *  FJsonObjectConverter::JsonAttributesToUStruct, which looks up properties by case-insensitive name and leaves
+	 *  properties with null values unchanged. */
+	bool ReadStructProperties(TJsonReader<>& Reader, const UStruct* StructDefinition, void* Struct,
+		const int64 CheckFlags, const int64 SkipFlags, FText* OutFailReason)
+	{
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation))
+		{
+			if (Notation == EJsonNotation::ObjectEnd)
+			{
+				return true;
+			}
+			if (Notation == EJsonNotation::Error)
+			{
+				SetFailReason(OutFailReason, Reader.GetErrorMessage());
+				return false;
+			}
+
+			if (Notation == EJsonNotation::Null)
+			{
+				continue;
+			}
+
+			const FName Name(*Reader.GetIdentifier(), FNAME_Find);
+			FProperty* Property = Name.IsNone() ? nullptr : StructDefinition->FindPropertyByName(Name);
+			if (!Property || (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags)) || Property->
+				HasAnyPropertyFlags(SkipFlags))
+			{
+				if (!SkipValue(Reader, Notation))
+				{
+					SetFailReason(OutFailReason, Reader.GetErrorMessage());
+					return false;
+				}
+				continue;
+			}
+
+			if (!ReadProperty(Reader, FJsonToken(Reader, Notation), Property, Property->ContainerPtrToValuePtr<void>(
+				Struct), CheckFlags, SkipFlags, OutFailReason))
+			{
+				return false;
+			}
+		}
+		SetFailReason(OutFailReason, Reader.GetErrorMessage());
+		return false;
+	}
+
+	/** Reads a single value into a property, matching FJsonObjectConverter's conversion of a scalar FJsonValue. */
+	bool ReadScalarProperty(TJsonReader<>& Reader, const FJsonToken& Token, FProperty* Property, void* Value,
+		const int64 CheckFlags, const int64 SkipFlags, FText* OutFailReason)
+	{
+		static const FName NAME_DateTime(TEXT("DateTime"));
+		static const FName NAME_Color(TEXT("Color"));
+		static const FName NAME_LinearColor(TEXT("LinearColor"));
+
+		const auto Fail = [&Property, OutFailReason]()
+		{
+			SetFailReason(OutFailReason, FString::Printf(TEXT("Unable to import %s from JSON"),
+				*Property->GetName()));
+			return false;
+		};
+
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			if (Token.Notation == EJsonNotation::String)
+			{
+				const int64 IntValue = EnumProperty->GetEnum()->GetValueByNameString(*Token.String,
+					EGetByNameFlags::CheckAuthoredName);
+				if (IntValue == INDEX_NONE)
+				{
+					return Fail();
+				}
+				EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Value, IntValue);
+			}
+			else
+			{
+				EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Value,
+					static_cast<int64>(Token.AsNumber()));
+			}
+			return true;
+		}
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			const UEnum* EnumDef = NumericProperty->GetIntPropertyEnum();
+			if (EnumDef && Token.Notation == EJsonNotation::String)
+			{
+				const int64 IntValue = EnumDef->GetValueByNameString(*Token.String, EGetByNameFlags::CheckAuthoredName);
+				if (IntValue == INDEX_NONE)
+				{
+					return Fail();
+				}
+				NumericProperty->SetIntPropertyValue(Value, IntValue);
+			}
+			else if (NumericProperty->IsFloatingPoint())
+			{
+				NumericProperty->SetFloatingPointPropertyValue(Value, Token.AsNumber());
+			}
+			else if (NumericProperty->IsInteger())
+			{
+				if (Token.Notation == EJsonNotation::String)
+				{
+					// Parsed directly so that large values do not lose precision going through a double
+					NumericProperty->SetIntPropertyValue(Value, FCString::Atoi64(**Token.String));
+				}
+				else
+				{
+					NumericProperty->SetIntPropertyValue(Value, static_cast<int64>(Token.AsNumber()));
+				}
+			}
+			else
+			{
+				return Fail();
+			}
+			return true;
+		}
+		if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			BoolProperty->SetPropertyValue(Value, Token.AsBool());
+			return true;
+		}
+		if (const FStrProperty* StringProperty = CastField<FStrProperty>(Property))
+		{
+			StringProperty->SetPropertyValue(Value, Token.AsString());
+			return true;
+		}
+		if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+		{
+			if (Token.Notation != EJsonNotation::String)
+			{
+				SkipValue(Reader, Token.Notation);
+				return Fail();
+			}
+			TextProperty->SetPropertyValue(Value, FText::FromString(*Token.String));
+			return true;
+		}
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			if (Token.Notation != EJsonNotation::ArrayStart)
+			{
+				SkipValue(Reader, Token.Notation);
+				return Fail();
+			}
+
+			// Existing elements are read into rather than replaced, the same as the converter
+			FScriptArrayHelper Helper(ArrayProperty, Value);
+			int32 Index = 0;
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd)
+			{
+				if (Notation == EJsonNotation::Error)
+				{
+					return Fail();
+				}
+				if (Index >= Helper.Num())
+				{
+					Helper.AddValue();
+				}
+				if (!ReadProperty(Reader, FJsonToken(Reader, Notation), ArrayProperty->Inner, Helper.GetRawPtr(Index),
+					CheckFlags & ~CPF_ParmFlags, SkipFlags, OutFailReason))
+				{
+					return false;
+				}
+				Index++;
+			}
+			Helper.Resize(Index);
+			return Notation == EJsonNotation::ArrayEnd || Fail();
+		}
+		if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			if (Token.Notation != EJsonNotation::ArrayStart)
+			{
+				SkipValue(Reader, Token.Notation);
+				return Fail();
+			}
+
+			FScriptSetHelper Helper(SetProperty, Value);
+			Helper.EmptyElements();
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd)
+			{
+				if (Notation == EJsonNotation::Error)
+				{
+					return Fail();
+				}
+				const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+				if (!ReadProperty(Reader, FJsonToken(Reader, Notation), SetProperty->ElementProp,
+					Helper.GetElementPtr(NewIndex), CheckFlags & ~CPF_ParmFlags, SkipFlags, OutFailReason))
+				{
+					Helper.Rehash();
+					return false;
+				}
+			}
+			Helper.Rehash();
+			return Notation == EJsonNotation::ArrayEnd || Fail();
+		}
+		if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			if (Token.Notation != EJsonNotation::ObjectStart)
+			{
+				SkipValue(Reader, Token.Notation);
+				return Fail();
+			}
+
+			FScriptMapHelper Helper(MapProperty, Value);
+			Helper.EmptyValues();
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation) && Notation != EJsonNotation::ObjectEnd)
+			{
+				if (Notation == EJsonNotation::Error)
+				{
+					return Fail();
+				}
+				if (Notation == EJsonNotation::Null)
+				{
+					continue;
+				}
+
+				// Keys are always read from a string, before the value moves the reader past the identifier
+				const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+				const bool bKeySuccess = ReadProperty(Reader, FJsonToken(Reader.GetIdentifier()), MapProperty->KeyProp,
+					Helper.GetKeyPtr(NewIndex), CheckFlags & ~CPF_ParmFlags, SkipFlags, OutFailReason);
+				if (!bKeySuccess || !ReadProperty(Reader, FJsonToken(Reader, Notation), MapProperty->ValueProp,
+					Helper.GetValuePtr(NewIndex), CheckFlags & ~CPF_ParmFlags, SkipFlags, OutFailReason))
+				{
+					Helper.Rehash();
+					return false;
+				}
+			}
+			Helper.Rehash();
+			return Notation == EJsonNotation::ObjectEnd || Fail();
+		}
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (Token.Notation == EJsonNotation::ObjectStart)
+			{
+				return ReadStructProperties(Reader, StructProperty->Struct, Value, CheckFlags & ~CPF_ParmFlags,
+					SkipFlags, OutFailReason);
+			}
+			if (Token.Notation != EJsonNotation::String)
+			{
+				SkipValue(Reader, Token.Notation);
+				return Fail();
+			}
+
+			const FName StructName = StructProperty->Struct->GetFName();
+			if (StructName == NAME_LinearColor)
+			{
+				*static_cast<FLinearColor*>(Value) = FColor::FromHex(*Token.String);
+				return true;
+			}
+			if (StructName == NAME_Color)
+			{
+				*static_cast<FColor*>(Value) = FColor::FromHex(*Token.String);
+				return true;
+			}
+			if (StructName == NAME_DateTime)
+			{
+				FDateTime& DateTime = *static_cast<FDateTime*>(Value);
+				if (*Token.String == TEXT("min"))
+				{
+					DateTime = FDateTime::MinValue();
+				}
+				else if (*Token.String == TEXT("max"))
+				{
+					DateTime = FDateTime::MaxValue();
+				}
+				else if (*Token.String == TEXT("now"))
+				{
+					DateTime = FDateTime::UtcNow();
+				}
+				else if (!FDateTime::ParseIso8601(**Token.String, DateTime) && !FDateTime::Parse(*Token.String,
+					DateTime))
+				{
+					return Fail();
+				}
+				return true;
+			}
+
+			const TCHAR* ImportTextPtr = **Token.String;
+			UScriptStruct::ICppStructOps* CppStructOps = StructProperty->Struct->GetCppStructOps();
+			if (!CppStructOps || !CppStructOps->HasImportTextItem() || !CppStructOps->ImportTextItem(ImportTextPtr,
+				Value, PPF_None, nullptr, GWarn))
+			{
+				Property->ImportText_Direct(**Token.String, Value, nullptr, PPF_None);
+			}
+			return true;
+		}
+
+		// Everything else is imported from text
+		if (Token.Notation == EJsonNotation::ObjectStart || Token.Notation == EJsonNotation::ArrayStart)
+		{
+			SkipValue(Reader, Token.Notation);
+			return Fail();
+		}
+		return Property->ImportText_Direct(*Token.AsString(), Value, nullptr, PPF_None) != nullptr || Fail();
+	}
+
+	/** Reads a property, from an array if it is a static array. */
+	bool ReadProperty(TJsonReader<>& Reader, const FJsonToken& Token, FProperty* Property, void* Value,
+		const int64 CheckFlags, const int64 SkipFlags, FText* OutFailReason)
+	{
+		if (Property->ArrayDim == 1)
+		{
+			return ReadScalarProperty(Reader, Token, Property, Value, CheckFlags, SkipFlags, OutFailReason);
+		}
+
+		if (Token.Notation != EJsonNotation::ArrayStart)
+		{
+			SkipValue(Reader, Token.Notation);
+			SetFailReason(OutFailReason, FString::Printf(TEXT("Unable to import static array %s from non-array JSON"),
+				*Property->GetName()));
+			return false;
+		}
+
+		int32 Index = 0;
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd)
+		{
+			if (Notation == EJsonNotation::Error)
+			{
+				SetFailReason(OutFailReason, Reader.GetErrorMessage());
+				return false;
+			}
+			if (Index >= Property->ArrayDim)
+			{
+				if (!SkipValue(Reader, Notation))
+				{
+					return false;
+				}
+				continue;
+			}
+			if (!ReadScalarProperty(Reader, FJsonToken(Reader, Notation), Property, static_cast<uint8*>(Value) + Index
+				* Property->ElementSize, CheckFlags, SkipFlags, OutFailReason))
+			{
+				return false;
+			}
+			Index++;
+		}
+		return Notation == EJsonNotation::ArrayEnd;
+	}
+}
+
+bool BSJsonStream::UStructToJsonString(const UStruct* StructDefinition, const void* Struct, FString& OutJsonString,
+	const int64 CheckFlags, const int64 SkipFlags, const bool bPrettyPrint, const int32 ReserveSize)
+{
+	// Same default as FJsonObjectConverter::UStructToJsonAttributes
+	const int64 WriteSkipFlags = SkipFlags == 0 ? CPF_Deprecated | CPF_Transient : SkipFlags;
+
+	TArray<uint8> Bytes;
+	Bytes.Reserve(FMath::Max(ReserveSize, MinReserveSize) * sizeof(TCHAR));
+	FMemoryWriter Archive(Bytes);
+	const bool bSuccess = bPrettyPrint
+		? WriteRootStruct<TPrettyJsonPrintPolicy<TCHAR>>(Archive, StructDefinition, Struct, CheckFlags, WriteSkipFlags)
+		: WriteRootStruct<TCondensedJsonPrintPolicy<TCHAR>>(Archive, StructDefinition, Struct, CheckFlags,
+			WriteSkipFlags);
+	if (!bSuccess)
+	{
+		return false;
+	}
+
+	const int32 NumChars = Bytes.Num() / sizeof(TCHAR);
+	TArray<TCHAR, FString::AllocatorType>& CharArray = OutJsonString.GetCharArray();
+	CharArray.SetNumUninitialized(NumChars + 1);
+	FMemory::Memcpy(CharArray.GetData(), Bytes.GetData(), NumChars * sizeof(TCHAR));
+	CharArray[NumChars] = TEXT('\0');
+	return true;
+}
+
+bool BSJsonStream::JsonStringToUStruct(const FString& JsonString, const UStruct* StructDefinition, void* OutStruct,
+	const int64 CheckFlags, const int64 SkipFlags, FText* OutFailReason)
+{
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		SetFailReason(OutFailReason, Reader->GetErrorMessage().IsEmpty()
+			? FString(TEXT("Expected a JSON object"))
+			: Reader->GetErrorMessage());
+		return false;
+	}
+	if (!ReadStructProperties(*Reader, StructDefinition, OutStruct, CheckFlags, SkipFlags, OutFailReason))
+	{
+		return false;
+	}
+
+	// Matches FJsonSerializer::Deserialize, which fails on anything after the root object
+	if (Reader->ReadNext(Notation) || !Reader->GetErrorMessage().IsEmpty())
+	{
+		SetFailReason(OutFailReason, Reader->GetErrorMessage().IsEmpty()
+			? FString(TEXT("Unexpected content after the root object"))
+			: Reader->GetErrorMessage());
+		return false;
+	}
+	return true;
+}
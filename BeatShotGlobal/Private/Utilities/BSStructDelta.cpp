@@ -0,0 +1,230 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "Utilities/BSStructDelta.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/StructuredArchive.h"
+
+namespace
+{
+	/** A written property, before the properties are sorted by Tag. */
+	struct FDeltaField
+	{
+		uint32 Tag;
+		TArray<uint8> Bytes;
+	};
+
+	/** Serializes an unsigned value as a variable length integer, so small values take one byte. */
+	void SerializeVarUInt(FArchive& Ar, uint32& Value)
+	{
+		if (Ar.IsSaving())
+		{
+			uint32 Remaining = Value;
+			do
+			{
+				uint8 Byte = Remaining & 0x7f;
+				Remaining >>= 7;
+				if (Remaining)
+				{
+					Byte |= 0x80;
+				}
+				Ar << Byte;
+			}
+			while (Remaining);
+		}
+		else
+		{
+			Value = 0;
+			for (int32 Shift = 0; Shift < 32; Shift += 7)
+			{
+				uint8 Byte = 0;
+				Ar << Byte;
+				Value |= static_cast<uint32>(Byte & 0x7f) << Shift;
+				if (!(Byte & 0x80) || Ar.IsError())
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	uint32 GetPropertyTag(const FProperty* Property)
+	{
+		return FCrc::StrCrc32(*Property->GetName());
+	}
+
+	/** Returns the struct of Property if it should be written field by field rather than as a single item. */
+	const UScriptStruct* GetNestedStruct(const FProperty* Property)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (!StructProperty || Property->ArrayDim != 1)
+		{
+			return nullptr;
+		}
+		if (StructProperty->Struct->StructFlags & (STRUCT_Immutable | STRUCT_SerializeNative))
+		{
+			return nullptr;
+		}
+		return StructProperty->Struct;
+	}
+
+	bool IsIdentical(const FProperty* Property, const void* Value, const void* DefaultValue)
+	{
+		for (int32 i = 0; i < Property->ArrayDim; i++)
+		{
+			const int32 Offset = i * Property->ElementSize;
+			if (!Property->Identical(static_cast<const uint8*>(Value) + Offset,
+				static_cast<const uint8*>(DefaultValue) + Offset))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Returns false if the element count at the current position of a loading archive is more than the remaining
+	 *  bytes could hold, so corrupt data fails before a dynamic array or string is allocated. */
+	bool HasValidElementCount(FArchive& Ar, const FProperty* Property)
+	{
+		const bool bIsString = Property->IsA<FStrProperty>();
+		if (!bIsString && !Property->IsA<FArrayProperty>())
+		{
+			return true;
+		}
+
+		const int64 Start = Ar.Tell();
+		int32 Num = 0;
+		Ar << Num;
+		Ar.Seek(Start);
+
+		// Each element takes at least one byte, and strings with a negative length are UTF-16
+		const int64 NumBytes = Num < 0 ? -static_cast<int64>(Num) * sizeof(UTF16CHAR) : Num;
+		if (Ar.IsError() || (Num < 0 && !bIsString) || NumBytes > Ar.TotalSize() - Start - sizeof(int32))
+		{
+			Ar.SetError();
+			return false;
+		}
+		return true;
+	}
+
+	bool SerializeItems(FArchive& Ar, FProperty* Property, void* Value)
+	{
+		for (int32 i = 0; i < Property->ArrayDim; i++)
+		{
+			if (Ar.IsLoading() && !HasValidElementCount(Ar, Property))
+			{
+				return false;
+			}
+			FStructuredArchiveFromArchive StructuredArchive(Ar);
+			Property->SerializeItem(StructuredArchive.GetSlot(), static_cast<uint8*>(Value) + i * Property->ElementSize,
+				nullptr);
+		}
+		return !Ar.IsError();
+	}
+
+	FProperty* FindPropertyByTag(const UStruct* StructDefinition, const uint32 Tag, const int64 SkipFlags)
+	{
+		for (TFieldIterator<FProperty> It(StructDefinition); It; ++It)
+		{
+			if (!It->HasAnyPropertyFlags(SkipFlags) && GetPropertyTag(*It) == Tag)
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+}
+
+void BSStructDelta::WriteStruct(FArchive& Ar, const UStruct* StructDefinition, const void* Struct,
+	const void* Defaults, const int64 SkipFlags)
+{
+	TArray<FDeltaField> Fields;
+	for (TFieldIterator<FProperty> It(StructDefinition); It; ++It)
+	{
+		FProperty* Property = *It;
+		if (Property->HasAnyPropertyFlags(SkipFlags))
+		{
+			continue;
+		}
+
+		const void* Value = Property->ContainerPtrToValuePtr<void>(Struct);
+		const void* DefaultValue = Property->ContainerPtrToValuePtr<void>(Defaults);
+		FDeltaField Field{GetPropertyTag(Property)};
+		FMemoryWriter Writer(Field.Bytes, true);
+		if (const UScriptStruct* NestedStruct = GetNestedStruct(Property))
+		{
+			WriteStruct(Writer, NestedStruct, Value, DefaultValue, SkipFlags);
+
+			// A nested struct without any changes is a single zero byte
+			if (Field.Bytes.Num() <= 1)
+			{
+				continue;
+			}
+		}
+		else
+		{
+			if (IsIdentical(Property, Value, DefaultValue))
+			{
+				continue;
+			}
+			SerializeItems(Writer, Property, const_cast<void*>(Value));
+		}
+		Fields.Add(MoveTemp(Field));
+	}
+
+	Fields.Sort([](const FDeltaField& A, const FDeltaField& B) { return A.Tag < B.Tag; });
+
+	uint32 NumFields = Fields.Num();
+	SerializeVarUInt(Ar, NumFields);
+	for (FDeltaField& Field : Fields)
+	{
+		uint32 Size = Field.Bytes.Num();
+		Ar << Field.Tag;
+		SerializeVarUInt(Ar, Size);
+		Ar.Serialize(Field.Bytes.GetData(), Size);
+	}
+}
+
+bool BSStructDelta::ReadStruct(FArchive& Ar, const UStruct* StructDefinition, void* OutStruct, const int64 SkipFlags)
+{
+	uint32 NumFields = 0;
+	SerializeVarUInt(Ar, NumFields);
+	TArray<uint8> Bytes;
+	for (uint32 i = 0; i < NumFields && !Ar.IsError(); i++)
+	{
+		uint32 Tag = 0;
+		uint32 Size = 0;
+		Ar << Tag;
+		SerializeVarUInt(Ar, Size);
+		if (Ar.IsError() || Size > Ar.TotalSize() - Ar.Tell())
+		{
+			return false;
+		}
+
+		FProperty* Property = FindPropertyByTag(StructDefinition, Tag, SkipFlags);
+		if (!Property)
+		{
+			Ar.Seek(Ar.Tell() + Size);
+			continue;
+		}
+
+		Bytes.SetNumUninitialized(Size, false);
+		Ar.Serialize(Bytes.GetData(), Size);
+		FMemoryReader Reader(Bytes, true);
+		// Strings and arrays nested inside the field can't be larger than the field itself
+		Reader.ArMaxSerializeSize = Size;
+		void* Value = Property->ContainerPtrToValuePtr<void>(OutStruct);
+		if (const UScriptStruct* NestedStruct = GetNestedStruct(Property))
+		{
+			if (!ReadStruct(Reader, NestedStruct, Value, SkipFlags))
+			{
+				return false;
+			}
+		}
+		else if (!SerializeItems(Reader, Property, Value))
+		{
+			return false;
+		}
+	}
+	return !Ar.IsError();
+}
@@ -5,30 +5,125 @@
 #include "SaveGames/SaveGameCustomGameMode.h"
 #include "SaveGames/SaveGamePlayerScore.h"
 #include "SaveGames/SaveGamePlayerSettings.h"
+#include "SaveGames/SaveGameSubsystem.h"
 
-template <typename T>
-T* SaveLoadCommon::LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex)
+namespace
 {
-	if (UGameplayStatics::DoesSaveGameExist(InSlotName, InSlotIndex))
+	/** Loads the save game from the platform save game system, or creates a new one if the slot does not exist or
+	 *  could not be loaded. */
+	template <typename T>
+	T* LoadOrCreateSaveGame(const FString& InSlotName, const int32 InSlotIndex)
 	{
-		if (T* SaveGameObject = Cast<T>(UGameplayStatics::LoadGameFromSlot(InSlotName, InSlotIndex)))
+		TArray<uint8> PreloadedData;
+		USaveGameSubsystem* SaveGameSubsystem = USaveGameSubsystem::Get();
+		if (SaveGameSubsystem && SaveGameSubsystem->ConsumePreloadedData(InSlotName, InSlotIndex, PreloadedData))
+		{
+			if (T* SaveGameObject = Cast<T>(UGameplayStatics::LoadGameFromMemory(PreloadedData)))
+			{
+				return SaveGameObject;
+			}
+		}
+
+		if (UGameplayStatics::DoesSaveGameExist(InSlotName, InSlotIndex))
 		{
-			return SaveGameObject;
+			if (T* SaveGameObject = Cast<T>(UGameplayStatics::LoadGameFromSlot(InSlotName, InSlotIndex)))
+			{
+				return SaveGameObject;
+			}
+			UE_LOG(LogTemp, Warning, TEXT("Failed to load %s, creating a new save game"), *InSlotName);
 		}
+		return Cast<T>(UGameplayStatics::CreateSaveGameObject(T::StaticClass()));
 	}
-	else
+
+	/** Returns the resident save game for the slot, or loads it and makes it resident. */
+	template <typename T>
+	T* FindOrLoadSaveGame(const FString& InSlotName, const int32 InSlotIndex)
 	{
-		if (T* SaveGameObject = Cast<T>(UGameplayStatics::CreateSaveGameObject(T::StaticClass())))
+		USaveGameSubsystem* SaveGameSubsystem = USaveGameSubsystem::Get();
+		if (SaveGameSubsystem)
 		{
-			return SaveGameObject;
+			if (T* CachedSaveGame = Cast<T>(SaveGameSubsystem->FindCachedSaveGame(InSlotName, InSlotIndex)))
+			{
+				return CachedSaveGame;
+			}
 		}
+
+		T* SaveGameObject = LoadOrCreateSaveGame<T>(InSlotName, InSlotIndex);
+		if (SaveGameObject && SaveGameSubsystem)
+		{
+			SaveGameSubsystem->CacheSaveGame(InSlotName, InSlotIndex, SaveGameObject);
+		}
+		return SaveGameObject;
+	}
+
+	/** Returns the resident save game for the slot after bringing it up to date. */
+	template <typename T>
+	T* LoadUpToDateSaveGame(const FString& InSlotName, const int32 InSlotIndex)
+	{
+		return FindOrLoadSaveGame<T>(InSlotName, InSlotIndex);
+	}
+
+	template <>
+	USaveGameCustomGameMode* LoadUpToDateSaveGame<USaveGameCustomGameMode>(const FString& InSlotName,
+		const int32 InSlotIndex)
+	{
+		USaveGameCustomGameMode* SaveGameObject = FindOrLoadSaveGame<USaveGameCustomGameMode>(InSlotName,
+			InSlotIndex);
+		if (!SaveGameObject)
+		{
+			return nullptr;
+		}
+
+		// Normally already upgraded by LoadFromSlotAsync at startup, so this only blocks if the background upgrade
+		// has not finished yet, or if the slot was loaded synchronously before it was ever upgraded
+		if (SaveGameObject->FinishPendingUpgrade())
+		{
+			SaveLoadCommon::SaveToSlot(SaveGameObject, InSlotName, InSlotIndex);
+		}
+		else if (SaveGameObject->NeedsUpgrade())
+		{
+			const int32 Old = SaveGameObject->GetVersion();
+			SaveGameObject->UpgradeCustomGameModes();
+			SaveLoadCommon::SaveToSlot(SaveGameObject, InSlotName, InSlotIndex);
+			const int32 New = SaveGameObject->GetVersion();
+			UE_LOG(LogTemp, Warning, TEXT("Upgraded USaveGameCustomGameMode from Version %d to %d"), Old, New);
+		}
+		return SaveGameObject;
+	}
+}
+
+template <typename T>
+const T* SaveLoadCommon::LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex)
+{
+	return LoadUpToDateSaveGame<T>(InSlotName, InSlotIndex);
+}
+
+template <typename T>
+bool SaveLoadCommon::ModifySlot(const FString& InSlotName, const int32 InSlotIndex, TFunctionRef<bool(T&)> Modify)
+{
+	T* SaveGameObject = LoadUpToDateSaveGame<T>(InSlotName, InSlotIndex);
+	if (!SaveGameObject)
+	{
+		return false;
 	}
-	return nullptr;
+	USaveGameSubsystem::WaitForPendingWrite(SaveGameObject);
+	return !Modify(*SaveGameObject) || SaveToSlot(SaveGameObject, InSlotName, InSlotIndex);
 }
 
 template <typename T>
 bool SaveLoadCommon::SaveToSlot(T* SaveGameClass, const FString& InSlotName, const int32 InSlotIndex)
 {
+	// Written to disk in the background by the subsystem
+	if (USaveGameSubsystem* SaveGameSubsystem = USaveGameSubsystem::Get())
+	{
+		if (!SaveGameClass)
+		{
+			return false;
+		}
+		SaveGameSubsystem->MarkSlotDirty(InSlotName, InSlotIndex, SaveGameClass);
+		return true;
+	}
+
 	if (UGameplayStatics::SaveGameToSlot(SaveGameClass, InSlotName, InSlotIndex))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Save Succeeded"));
@@ -37,32 +132,56 @@ bool SaveLoadCommon::SaveToSlot(T* SaveGameClass, const FString& InSlotName, con
 	return false;
 }
 
-template <>
-USaveGameCustomGameMode* SaveLoadCommon::LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex)
+template <typename T>
+void SaveLoadCommon::LoadFromSlotAsync(const FString& InSlotName, const int32 InSlotIndex,
+	TFunction<void(const T*)> OnLoaded)
 {
-	USaveGameCustomGameMode* SaveGameObject;
-	if (UGameplayStatics::DoesSaveGameExist(InSlotName, InSlotIndex))
+	USaveGameSubsystem* SaveGameSubsystem = USaveGameSubsystem::Get();
+	if (!SaveGameSubsystem)
 	{
-		SaveGameObject = Cast<USaveGameCustomGameMode>(UGameplayStatics::LoadGameFromSlot(InSlotName, InSlotIndex));
+		OnLoaded(LoadFromSlot<T>(InSlotName, InSlotIndex));
+		return;
 	}
-	else
+
+	SaveGameSubsystem->PreloadSlotAsync(InSlotName, InSlotIndex,
+		[InSlotName, InSlotIndex, OnLoaded = MoveTemp(OnLoaded)]()
 	{
-		SaveGameObject = Cast<USaveGameCustomGameMode>(
-			UGameplayStatics::CreateSaveGameObject(USaveGameCustomGameMode::StaticClass()));
-	}
+		OnLoaded(LoadFromSlot<T>(InSlotName, InSlotIndex));
+	});
+}
 
-	if (!SaveGameObject)
+template <>
+void SaveLoadCommon::LoadFromSlotAsync(const FString& InSlotName, const int32 InSlotIndex,
+	TFunction<void(const USaveGameCustomGameMode*)> OnLoaded)
+{
+	USaveGameSubsystem* SaveGameSubsystem = USaveGameSubsystem::Get();
+	if (!SaveGameSubsystem)
 	{
-		return nullptr;
+		OnLoaded(LoadFromSlot<USaveGameCustomGameMode>(InSlotName, InSlotIndex));
+		return;
 	}
 
-	if (SaveGameObject->GetLastLoadedVersion() < Constants::CustomGameModeVersion)
+	SaveGameSubsystem->PreloadSlotAsync(InSlotName, InSlotIndex,
+		[InSlotName, InSlotIndex, OnLoaded = MoveTemp(OnLoaded)]()
 	{
-		const int32 Old = SaveGameObject->GetLastLoadedVersion();
-		SaveGameObject->UpgradeCustomGameModes();
-		SaveToSlot(SaveGameObject, InSlotName, InSlotIndex);
-		const int32 New = SaveGameObject->GetVersion();
-		UE_LOG(LogTemp, Warning, TEXT("Upgraded USaveGameCustomGameMode from Version %d to %d"), Old, New);
-	}
-	return SaveGameObject;
+		USaveGameCustomGameMode* SaveGameObject = FindOrLoadSaveGame<USaveGameCustomGameMode>(InSlotName,
+			InSlotIndex);
+		if (!SaveGameObject)
+		{
+			OnLoaded(nullptr);
+			return;
+		}
+
+		// The upgraded modes are written back with the new version, so the migrations only ever run once per slot
+		SaveGameObject->UpgradeCustomGameModesAsync(
+			[WeakSaveGame = TWeakObjectPtr<USaveGameCustomGameMode>(SaveGameObject), InSlotName, InSlotIndex,
+				OnLoaded](const bool bUpgraded)
+			{
+				if (bUpgraded && WeakSaveGame.IsValid())
+				{
+					SaveToSlot(WeakSaveGame.Get(), InSlotName, InSlotIndex);
+				}
+				OnLoaded(WeakSaveGame.Get());
+			});
+	});
 }
@@ -7,9 +7,53 @@ namespace Constants
 	/** Version used for SaveGameCustomGameMode. */
 	inline constexpr int32 CustomGameModeVersion = 1;
 
+	/** Version of the binary game mode share code format. Must be incremented whenever a default value of FBSConfig
+	 *  changes, since share codes only contain values that differ from the defaults. The previous defaults must then be
+	 *  added to the share code defaults changes in BSConfig.cpp, so that share codes of older versions still decode. */
+	inline constexpr uint8 GameModeShareCodeVersion = 1;
+
+	/** The oldest binary game mode share code version that can still be decoded. */
+	inline constexpr uint8 MinGameModeShareCodeVersion = 1;
+
+	/** Prefix of binary game mode share codes. Contains characters outside the Base64 alphabet so that legacy Base64
+	 *  JSON share codes are never mistaken for one. */
+	inline constexpr TCHAR GameModeShareCodePrefix[] = TEXT("BS-");
+
+	/** The maximum size in bytes of a decompressed game mode share code. */
+	inline constexpr int32 GameModeShareCodeMaxSize = 64 * 1024;
+
 	/** Version used for BSGameUserSettings. */
 	inline constexpr int32 BSGameUserSettingsVersion = 1;
 
+	/** The interval in seconds that USaveGameSubsystem writes modified save games to disk. Saves made within the same
+	 *  interval are coalesced into a single write. */
+	inline constexpr float SaveGameFlushInterval = 0.5f;
+
+	/** The number of records in the player score log that do not add a new score (e.g. marking scores as saved to the
+	 *  database) before the log is compacted. */
+	inline constexpr int32 PlayerScoreStoreCompactionThreshold = 64;
+
+	/** The maximum number of scores sent in a single request by FScoreUploadOutbox. */
+	inline constexpr int32 ScoreUploadBatchSize = 100;
+
+	/** The timeout in seconds of a single score upload request. */
+	inline constexpr float ScoreUploadTimeout = 10.f;
+
+	/** The delay in seconds before the first retry of a failed score upload, doubled for each following retry. */
+	inline constexpr float ScoreUploadInitialRetryDelay = 2.f;
+
+	/** The maximum delay in seconds between retries of a failed score upload. */
+	inline constexpr float ScoreUploadMaxRetryDelay = 120.f;
+
+	/** The fraction of the retry delay that is randomized, so that clients do not retry in lockstep. */
+	inline constexpr float ScoreUploadRetryJitter = 0.25f;
+
+	/** The number of consecutive failed score uploads before FScoreUploadOutbox stops retrying until the next flush. */
+	inline constexpr int32 ScoreUploadMaxAttempts = 8;
+
+	/** Whether score upload payloads are gzip compressed. Off until the database accepts Content-Encoding: gzip. */
+	inline constexpr bool bCompressScoreUploads = false;
+
 	/** The length of the countdown timer. */
 	inline constexpr int32 CountdownTimerLength = 3;
 
@@ -22,6 +66,12 @@ namespace Constants
 	/** The distance to trace the line. */
 	inline constexpr float TraceDistance = 999999;
 
+	/** The number of frames an early reflection trace can wait for the scene query budget before it's dropped. */
+	inline constexpr int32 EarlyReflectionTraceLatencyTolerance = 2;
+
+	/** The number of frames a moving beam light trace can wait for the scene query budget before it's dropped. */
+	inline constexpr int32 BeamLightTraceLatencyTolerance = 1;
+
 	/** Length of time until video settings are reset. */
 	inline constexpr float VideoSettingsTimeoutLength = 10.f;
 
@@ -52,6 +102,10 @@ namespace Constants
 	/** Default size of a QTable. */
 	inline constexpr int32 DefaultQTableSize = 625;
 
+	/** Whether the QTable of FCommonScoreInfo is quantized to 16 bits per value when saved. Halves the size of the
+	 *  QTable, at the cost of a precision of (Max - Min) / 65535. */
+	inline constexpr bool bQuantizeSavedQTables = false;
+
 	/** Default number of rows in FAccuracyData. */
 	inline constexpr int32 DefaultNumberOfAccuracyDataRows = 5;
 
@@ -310,6 +364,9 @@ namespace Constants
 	/** Base health of a target if using tracking damage. */
 	inline constexpr float BaseTrackingTargetHealth = 1000000.f;
 
+	/** Max health of a target with unlimited health, which is reset whenever it runs out. */
+	inline constexpr float UnlimitedTargetHealth = 10000.f;
+
 #pragma endregion
 
 #pragma region MinMaxSnapSize
@@ -516,6 +573,27 @@ namespace Constants
 	/** Max scale to apply to the height of a single Cube in a StaticCubeVisualizer. */
 	inline constexpr float DefaultMaxCubeVisualizerHeightScale = 4;
 
+	/** Minimum change in spectrum alpha required before a cube instance is resubmitted to the renderer. */
+	inline constexpr float CubeVisualizerUpdateTolerance = 0.001f;
+
+	/** Default estimated cost in milliseconds of a single visualizer update, before it has been measured. */
+	inline constexpr float DefaultVisualizerUpdateCost = 0.05f;
+
+	/** Default time in milliseconds the VisualizerManager can spend updating visualizers each frame. */
+	inline constexpr float DefaultVisualizerUpdateBudget = 1.f;
+
+	/** Default number of frames a visualizer can be skipped before it is prioritized over all others. */
+	inline constexpr int32 DefaultMaxFramesBetweenVisualizerUpdates = 4;
+
+	/** Default distance from the camera at which a visualizer's update priority is halved. */
+	inline constexpr float DefaultVisualizerLODDistance = 4000.f;
+
+	/** Multiplier applied to the update priority of visualizers that were not recently rendered. */
+	inline constexpr float HiddenVisualizerPriorityScale = 0.25f;
+
+	/** Weight given to the most recent measured update time when estimating a visualizer's cost. */
+	inline constexpr float VisualizerCostSmoothingAlpha = 0.1f;
+
 	// Beam Visualizers
 
 	/** Location of the BeamVisualizer in middle of room. */
@@ -554,6 +632,19 @@ namespace Constants
 	/** The default value for the inner cone angle of the Spotlight. */
 	inline constexpr float DefaultSimpleBeamLightBeamLength = 10.f;
 
+	/** The most traces a SimpleBeamLight caches by default, and the number of evenly spaced times along its movement
+	 *  curve that traces are precomputed for. */
+	inline constexpr int32 DefaultNumCachedBeamLightTraces = 256;
+
+	/** The most traces a single SimpleBeamLight can cache. */
+	inline constexpr int32 MaxNumCachedBeamLightTraces = 4096;
+
+	/** The number of frames a cached SimpleBeamLight trace, hit or miss, is reused for before it is traced again. */
+	inline constexpr int32 BeamLightTraceCacheLifetimeFrames = 300;
+
+	/** SimpleBeamLight beams whose directions differ by less than this in each component share a cached trace. */
+	inline constexpr float BeamLightTraceCacheDirectionTolerance = 0.002f;
+
 	/** Relative offset of the Spotlight limb from the SpotlightBase. */
 	inline const FVector DefaultSpotlightLimbOffset(18, 0, 0);
 
@@ -86,4 +86,23 @@ struct BEATSHOTGLOBAL_API FBSConfig
 
 	/** Initializes the OutConfig from a serialized Json object, returns true if successful. */
 	static bool DecodeFromString(const FString& EncodedString, FBSConfig& OutConfig, FText* OutFailReason = nullptr);
+
+	/** Returns a short share code containing the compressed binary representation of the fields that differ from a
+	 *  default config. */
+	FString EncodeToShareCode() const;
+
+	/** Same as EncodeToShareCode, but relative to the defaults of an older share code version. */
+	FString EncodeToShareCode(const uint8 Version) const;
+
+	/** Returns the default config that share codes of the given version were written relative to. */
+	static FBSConfig GetShareCodeDefaults(const uint8 Version);
+
+	/** Initializes the OutConfig from a share code created by EncodeToShareCode or a legacy share code created by
+	 *  EncodeToString, returns true if successful. Share codes of any version from MinGameModeShareCodeVersion up to
+	 *  GameModeShareCodeVersion are supported. */
+	static bool DecodeFromShareCode(const FString& ShareCode, FBSConfig& OutConfig, FText* OutFailReason = nullptr);
+
+	/** Returns a 64-bit hash of every serialized field. Configs with equal fields always have the same hash, so it can
+	 *  be used as a cache key for data derived from the config. */
+	uint64 GetContentHash() const;
 };
@@ -112,9 +112,19 @@ struct BEATSHOTGLOBAL_API FBS_DefiningConfig
 		return false;
 	}
 
+	/** Only hashes the fields compared by operator==, so that custom game modes can be found in a TMap regardless of
+	 *  difficulty and name case. */
 	friend FORCEINLINE uint32 GetTypeHash(const FBS_DefiningConfig& Config)
 	{
-		return HashCombine(GetTypeHash(Config.GameModeType), HashCombine(GetTypeHash(Config.BaseGameMode),
-			HashCombine(GetTypeHash(Config.CustomGameModeName), GetTypeHash(Config.Difficulty))));
+		if (Config.GameModeType == EGameModeType::Custom)
+		{
+			return HashCombine(GetTypeHash(Config.GameModeType), GetTypeHash(Config.CustomGameModeName));
+		}
+		if (Config.GameModeType == EGameModeType::Preset)
+		{
+			return HashCombine(GetTypeHash(Config.GameModeType), HashCombine(GetTypeHash(Config.BaseGameMode),
+				GetTypeHash(Config.Difficulty)));
+		}
+		return GetTypeHash(Config.GameModeType);
 	}
 };
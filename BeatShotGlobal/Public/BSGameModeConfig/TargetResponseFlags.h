@@ -0,0 +1,100 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TargetConfig.h"
+
+/** A set of values of a uint8 enum packed into a bitmask, so that membership is a single bit test. */
+template <typename EnumType>
+struct TBSEnumFlags
+{
+	static_assert(sizeof(EnumType) == sizeof(uint8), "TBSEnumFlags only supports uint8 enums");
+
+	TBSEnumFlags() = default;
+
+	explicit TBSEnumFlags(const TArray<EnumType>& Values)
+	{
+		for (const EnumType Value : Values)
+		{
+			Add(Value);
+		}
+	}
+
+	void Add(const EnumType Value)
+	{
+		checkf(static_cast<uint8>(Value) < 64, TEXT("Enum value %d doesn't fit in TBSEnumFlags"),
+			static_cast<int32>(Value));
+		Bits |= 1ull << static_cast<uint8>(Value);
+	}
+
+	bool Contains(const EnumType Value) const
+	{
+		return (Bits & 1ull << static_cast<uint8>(Value)) != 0;
+	}
+
+	bool IsEmpty() const { return Bits == 0; }
+
+	bool operator==(const TBSEnumFlags& Other) const { return Bits == Other.Bits; }
+
+	uint64 Bits = 0;
+};
+
+/** The response and condition arrays of an FBS_TargetConfig compiled into bitmasks when the config is loaded, so that
+ *  activation, deactivation, and damage events don't search the arrays. */
+struct FBS_TargetResponseFlags
+{
+	FBS_TargetResponseFlags() = default;
+
+	explicit FBS_TargetResponseFlags(const FBS_TargetConfig& Config) :
+		ActivationResponses(Config.TargetActivationResponses),
+		DeactivationConditions(Config.TargetDeactivationConditions),
+		DeactivationResponses(Config.TargetDeactivationResponses),
+		DestructionConditions(Config.TargetDestructionConditions)
+	{
+	}
+
+	/** Returns true if a target should be deactivated based on the TargetDeactivationConditions. */
+	bool ShouldDeactivate(const bool bExpired, const float CurrentHealth, const float DeactivationThreshold) const
+	{
+		if (bExpired && DeactivationConditions.Contains(ETargetDeactivationCondition::OnExpiration))
+		{
+			return true;
+		}
+		if (CurrentHealth <= 0.f && DeactivationConditions.Contains(ETargetDeactivationCondition::OnHealthReachedZero))
+		{
+			return true;
+		}
+		if (CurrentHealth <= DeactivationThreshold && DeactivationConditions.Contains(
+			ETargetDeactivationCondition::OnSpecificHealthLost))
+		{
+			return true;
+		}
+		return !bExpired && DeactivationConditions.Contains(ETargetDeactivationCondition::OnAnyExternalDamageTaken);
+	}
+
+	/** Returns true if a target should be destroyed based on the TargetDestructionConditions and the Destroy
+	 *  deactivation response. */
+	bool ShouldDestroy(const bool bExpired, const bool bOutOfHealth) const
+	{
+		if (DeactivationResponses.Contains(ETargetDeactivationResponse::Destroy) || DestructionConditions.Contains(
+			ETargetDestructionCondition::OnDeactivation))
+		{
+			return true;
+		}
+		if (bExpired && DestructionConditions.Contains(ETargetDestructionCondition::OnExpiration))
+		{
+			return true;
+		}
+		if (bOutOfHealth && DestructionConditions.Contains(ETargetDestructionCondition::OnHealthReachedZero))
+		{
+			return true;
+		}
+		return !bExpired && DestructionConditions.Contains(ETargetDestructionCondition::OnAnyExternalDamageTaken);
+	}
+
+	TBSEnumFlags<ETargetActivationResponse> ActivationResponses;
+	TBSEnumFlags<ETargetDeactivationCondition> DeactivationConditions;
+	TBSEnumFlags<ETargetDeactivationResponse> DeactivationResponses;
+	TBSEnumFlags<ETargetDestructionCondition> DestructionConditions;
+};
@@ -37,6 +37,10 @@ public:
 	/** @return all saved Custom Game Modes. */
 	static TArray<FBSConfig> LoadCustomGameModes();
 
+	/** Loads the Custom Game Modes slot and runs any pending version migrations on a background thread, so that they
+	 *  are already upgraded by the time LoadCustomGameModes is first called. */
+	static void PreloadCustomGameModes();
+
 	/** Attempts to find a saved custom game mode.
 	 *  @param CustomGameModeName to search for
 	 *  @param OutConfig the Custom Game Mode if found, or a default if not
@@ -73,17 +77,17 @@ public:
 	 */
 	static bool DoesCustomGameModeMatchConfig(const FString& CustomGameModeName, const FBSConfig& InConfig);
 
-	/** Attempts to initialize a given config using the serialized json string. Returns true on success.
-	 *  @param InSerializedJsonString serialized json string
-	 *  @param OutConfig game mode configuration created from json string if successful
+	/** Attempts to initialize a given config using a share code, or a legacy serialized json string.
+	 *  @param InSerializedJsonString share code or serialized json string
+	 *  @param OutConfig game mode configuration created from the share code if successful
 	 *  @param OutDecodeFailureReason contains reason for decode failure if decode failure
 	 *  @return the import result as an enum
 	 */
 	static ECustomGameModeImportResult ImportCustomGameMode(const FString& InSerializedJsonString, FBSConfig& OutConfig,
 		FText& OutDecodeFailureReason);
 
-	/** Creates a serialized Json object export string from an FBSConfig
-	 *  @param InConfig game mode configuration to create serialized json string from
+	/** Creates a compact share code from an FBSConfig
+	 *  @param InConfig game mode configuration to create the share code from
 	 */
 	static FString ExportCustomGameMode(const FBSConfig& InConfig);
 
@@ -0,0 +1,145 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+#include "DeveloperSettings/BSMockBackendSettings.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBSMockBackend, Log, All);
+
+/** A request received by the mock backend. */
+struct FBSMockBackendRequest
+{
+	FString Verb;
+	FString Path;
+	TMap<FString, FString> Headers;
+
+	/** The body as a string, decompressed if it was sent with gzip Content-Encoding. */
+	FString Body;
+
+	/** The status code the request was answered with. */
+	int32 ResponseCode = 0;
+};
+
+/** An in-process loopback Http server implementing the routes of the BeatShot website used by
+ *  IHttpRequestInterface and FScoreUploadOutbox, so that the networking code can be tested and benchmarked without
+ *  network access. Scores are kept in memory for the lifetime of the server, and every issued token is accepted until
+ *  then. Latency and failures can be injected through FBSMockBackendOptions.
+ *
+ *  Requests are only routed to the mock backend while it is running, see IHttpRequestInterface::ResolveURL. All
+ *  functions must be called on the game thread. */
+class BEATSHOTGLOBAL_API FBSMockBackend : public TSharedFromThis<FBSMockBackend>
+{
+public:
+	/** The access token issued by the login and refresh routes. */
+	static const TCHAR* AccessToken;
+
+	/** The refresh token stored in the cookie issued by the login and Steam authentication routes. */
+	static const TCHAR* RefreshToken;
+
+	/** The Steam ID returned by the Steam authentication route. */
+	static const TCHAR* SteamID;
+
+	/** Starts listening on Port, stopping any mock backend that is already running.
+	 *  @return the running mock backend, or nullptr if the port could not be bound
+	 */
+	static TSharedPtr<FBSMockBackend> Start(const uint32 Port, const FBSMockBackendOptions& Options = {});
+
+	/** @return the running mock backend, starting it from FBSMockBackendSettings if it is enabled and has not been
+	 *  started yet */
+	static TSharedPtr<FBSMockBackend> Get();
+
+	/** Stops the running mock backend, if any. */
+	static void Stop();
+
+	~FBSMockBackend();
+
+	/** @return the URL that replaces Constants::OriginURL while this is running. */
+	const FString& GetOriginURL() const { return OriginURL; }
+
+	const FBSMockBackendOptions& GetOptions() const { return Options; }
+	void SetOptions(const FBSMockBackendOptions& InOptions);
+
+	/** Answers the next NumRequests requests with Status, regardless of FailureRate. */
+	void FailNextRequests(const int32 NumRequests, const int32 Status);
+
+	/** @return all requests received since the last call to ClearCapturedRequests, if bCaptureRequests is true. */
+	const TArray<FBSMockBackendRequest>& GetCapturedRequests() const { return CapturedRequests; }
+	void ClearCapturedRequests() { CapturedRequests.Empty(); }
+
+	/** @return the number of requests received, whether captured or not. */
+	int32 GetNumRequests() const { return NumRequests; }
+
+	/** @return the scores saved for UserID. */
+	TArray<FPlayerScore> GetScores(const FString& UserID) const;
+
+	/** @return the userID the login route issues for Username. */
+	static FString GetUserID(const FString& Username);
+
+private:
+	/** A response, created and sent once any latency has elapsed. */
+	struct FMockResponse
+	{
+		int32 Code = 200;
+		FString Body;
+		TMap<FString, FString> Headers;
+	};
+
+	/** A route handler, which is only called if the request was not chosen to fail. */
+	using FRouteHandler = FMockResponse(FBSMockBackend::*)(const FHttpServerRequest& Request, const FString& Body);
+
+	FBSMockBackend(const uint32 Port, const FBSMockBackendOptions& InOptions);
+
+	/** Binds all routes to the router for the port.
+	 *  @return false if the port could not be bound
+	 */
+	bool BindRoutes(const uint32 Port);
+
+	/** Captures the request, injects any failure, and otherwise responds with the result of Handler. */
+	bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete,
+		const FRouteHandler Handler);
+
+	FMockResponse HandleLogin(const FHttpServerRequest& Request, const FString& Body);
+	FMockResponse HandleRefresh(const FHttpServerRequest& Request, const FString& Body);
+	FMockResponse HandleSaveScores(const FHttpServerRequest& Request, const FString& Body);
+	FMockResponse HandleDeleteScores(const FHttpServerRequest& Request, const FString& Body);
+	FMockResponse HandleSendFeedback(const FHttpServerRequest& Request, const FString& Body);
+	FMockResponse HandleAuthenticateSteamUser(const FHttpServerRequest& Request, const FString& Body);
+
+	/** @return true if the request has the Bearer AccessToken Authorization header. */
+	static bool IsAuthorized(const FHttpServerRequest& Request);
+
+	/** @return a cookie containing RefreshToken that IHttpRequestInterface::IsRefreshTokenValid accepts. */
+	static FString MakeRefreshCookie();
+
+	/** @return a response with a JSON body containing a single message field. */
+	static FMockResponse MakeMessageResponse(const int32 Code, const FString& Message);
+
+	/** Sends Response now, or once Latency has elapsed. */
+	void Respond(const FHttpResultCallback& OnComplete, const FMockResponse& Response) const;
+
+	FString OriginURL;
+	FBSMockBackendOptions Options;
+	FRandomStream FailureStream;
+	TSharedPtr<IHttpRouter> Router;
+	TArray<FHttpRouteHandle> RouteHandles;
+
+	TArray<FBSMockBackendRequest> CapturedRequests;
+	int32 NumRequests = 0;
+	int32 NumForcedFailures = 0;
+	int32 ForcedFailureStatus = 0;
+
+	/** Scores saved through the save scores route, keyed by userID. */
+	TMap<FString, TArray<FPlayerScore>> Scores;
+};
+
+#endif // !UE_BUILD_SHIPPING
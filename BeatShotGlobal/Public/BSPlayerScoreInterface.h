@@ -26,18 +26,34 @@ public:
 	/** @return all player scores loaded from slot. */
 	static TArray<FPlayerScore> LoadPlayerScores();
 
+	/** Loads all player scores on a background thread, then calls OnLoaded on the game thread.
+	 *  @param OnLoaded called with all player scores once loaded
+	 */
+	static void LoadPlayerScoresAsync(TFunction<void(const TArray<FPlayerScore>&)> OnLoaded);
+
 	/** @return all player scores loaded from slot not saved to database. */
 	static TArray<FPlayerScore> LoadPlayerScores_UnsavedToDatabase();
 
 	/** Marks all player scores as saved to the database and saves to slot */
 	static void SetAllPlayerScoresSavedToDatabase();
 
+	/** Marks the player scores with the given times as saved to the database.
+	 *  @param Times the times of the player scores acknowledged by the database
+	 */
+	static void SetPlayerScoresSavedToDatabase(const TArray<FString>& Times);
+
 	/** Finds any PlayerScores that match the input PlayerScore.
 	 *  @param PlayerScore object to use to find matching scores
 	 *  @return matching player scores based on DefaultMode, CustomGameModeName, Difficulty, and SongTitle
 	 */
 	static TArray<FPlayerScore> GetMatchingPlayerScores(const FPlayerScore& PlayerScore);
 
+	/** Finds the player score with the latest time.
+	 *  @param OutPlayerScore the most recent player score, if found
+	 *  @return whether any player scores exist
+	 */
+	static bool GetMostRecentPlayerScore(FPlayerScore& OutPlayerScore);
+
 	/** Saves an instance of an FPlayerScore to slot.
 	 *  @param PlayerScoreToSave scores to save
 	 */
@@ -0,0 +1,47 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/** How the mock backend responds to requests. */
+struct FBSMockBackendOptions
+{
+	/** The delay in seconds before each response is sent. */
+	float Latency = 0.f;
+
+	/** The fraction of requests, between 0 and 1, that are answered with FailureStatus instead of being routed. */
+	float FailureRate = 0.f;
+
+	/** The Http status code returned for injected failures. */
+	int32 FailureStatus = 503;
+
+	/** Seeds failure injection so that runs are repeatable. */
+	int32 RandomSeed = 0;
+
+	/** Whether to keep a copy of every request received. */
+	bool bCaptureRequests = true;
+};
+
+/** Settings for the local mock backend, which replaces the BeatShot website for every request made through
+ *  IHttpRequestInterface and FScoreUploadOutbox. Read from the [/Script/BeatShotGlobal.BSMockBackendSettings]
+ *  section of DefaultGame.ini. These are plain structs rather than UDeveloperSettings so that, like the mock backend,
+ *  they are compiled out of shipping builds. */
+struct BEATSHOTGLOBAL_API FBSMockBackendSettings
+{
+	/** Whether to start the mock backend the first time a request is made. Can also be enabled with the
+	 *  -BSMockBackend command line switch. */
+	bool bEnabled = false;
+
+	/** The loopback port the mock backend listens on. */
+	int32 Port = 30300;
+
+	FBSMockBackendOptions Options;
+
+	/** Returns the settings from the game config, using the defaults above for any that are not set. */
+	static FBSMockBackendSettings Load();
+};
+
+#endif // !UE_BUILD_SHIPPING
@@ -213,6 +213,10 @@ public:
 	/** Checks to see if the user has a refresh token and if it has expired or not. */
 	static bool IsRefreshTokenValid(const FString RefreshToken);
 
+	/** @return URL with Constants::OriginURL replaced by the origin of the mock backend if it is running or enabled
+	 *  in FBSMockBackendSettings, otherwise URL unchanged. Always URL unchanged in shipping builds. */
+	static FString ResolveURL(const FString& URL);
+
 	/** Makes a GET request for a short lived access token given a valid refresh token. Executes supplied
 	 *  OnAccessTokenResponse with the access token.
 	 *  
@@ -0,0 +1,35 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBSConfig;
+
+/** Upgrades a single custom game mode from one USaveGameCustomGameMode version to the next. */
+using FCustomGameModeMigration = TFunction<void(FBSConfig&)>;
+
+/** Holds the migration from each USaveGameCustomGameMode version to the next. Migrations run on a background thread,
+ *  so they must only modify the config passed in. All migrations should be registered at startup, before any custom
+ *  game modes are loaded. */
+class BEATSHOTGLOBAL_API FCustomGameModeMigrationRegistry
+{
+public:
+	/** @return the registry, with all built-in migrations registered. */
+	static FCustomGameModeMigrationRegistry& Get();
+
+	/** Registers the migration from FromVersion to FromVersion + 1, replacing any existing migration. */
+	void RegisterMigration(const int32 FromVersion, FCustomGameModeMigration Migration);
+
+	/** @return whether a migration from FromVersion to FromVersion + 1 is registered. */
+	bool HasMigration(const int32 FromVersion) const { return Migrations.Contains(FromVersion); }
+
+	/** Applies every registered migration from FromVersion up to ToVersion to all configs, skipping any versions
+	 *  without a migration. */
+	void Migrate(TArray<FBSConfig>& Configs, const int32 FromVersion, const int32 ToVersion) const;
+
+private:
+	FCustomGameModeMigrationRegistry();
+
+	TMap<int32, FCustomGameModeMigration> Migrations;
+};
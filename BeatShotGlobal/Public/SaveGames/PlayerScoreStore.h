@@ -0,0 +1,124 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogPlayerScoreStore, Log, All);
+
+/** Stores player scores in an append-only log file instead of the score save game slot. Adding a score or marking all
+ *  scores as saved to the database appends a single record, so the cost of saving does not grow with the number of
+ *  scores. The log is rewritten as a single snapshot once it contains PlayerScoreStoreCompactionThreshold records that
+ *  do not add a score, or if a partially written record is found when loading.
+ *
+ *  All scores are kept in memory with indexes by defining config, by time, and by whether they have been saved to the
+ *  database.
+ *
+ *  Load only reads the log file, so it can run on any thread. Every other function that writes to the file must be
+ *  called on the game thread. All file access from any store is serialized behind a single lock, so a read never
+ *  sees a partially replaced file. */
+class BEATSHOTGLOBAL_API FPlayerScoreStore
+{
+public:
+	explicit FPlayerScoreStore(const FString& InFilePath = GetDefaultFilePath());
+
+	/** Reads all records from the log file, replacing any scores in memory. Never writes to the file; if a partially
+	 *  written record is found, NeedsCompaction returns true until Compact is called. Returns false if the file
+	 *  exists but could not be read. */
+	bool Load();
+
+	/** @return whether Load found a partially written record, which must be removed with Compact before appending. */
+	bool NeedsCompaction() const { return bNeedsCompaction; }
+
+	/** Adds scores in a single write, skipping any with the same time as an existing score. Used to migrate scores
+	 *  from the score save game slot. Returns the number of scores added. */
+	int32 Import(const TArray<FPlayerScore>& InScores);
+
+	/** Appends a score to the log. Returns false if a score with the same time already exists or the write failed. */
+	bool Add(const FPlayerScore& InScore);
+
+	/** Marks every score as saved to the database. */
+	void MarkAllSavedToDatabase();
+
+	/** Marks the scores with the given times as saved to the database, ignoring any unknown times. */
+	void MarkSavedToDatabase(const TArray<FString>& Times);
+
+	/** Rewrites the log as a single snapshot of all scores. Returns true on success. */
+	bool Compact();
+
+	/** @return all scores, in the order they were added. */
+	const TArray<FPlayerScore>& GetScores() const { return Scores; }
+
+	/** @return all scores not saved to the database. */
+	TArray<FPlayerScore> GetScores_UnsavedToDatabase() const;
+
+	/** @return all scores with the same DefiningConfig and SongTitle as InScore. */
+	TArray<FPlayerScore> GetMatchingScores(const FPlayerScore& InScore) const;
+
+	/** @return the score with the latest time, or nullptr if there are no scores. */
+	const FPlayerScore* GetMostRecentScore() const;
+
+	/** @return whether a score with the time exists. */
+	bool ContainsTime(const FString& Time) const { return ScoresByTime.Contains(Time); }
+
+	/** @return the log file in the SaveGames directory. */
+	static FString GetDefaultFilePath();
+
+private:
+	enum class ERecordType : uint8
+	{
+		AddScore,
+		MarkAllSavedToDatabase,
+		MarkSavedToDatabase
+	};
+
+	/** Adds the score at Index to all indexes. */
+	void IndexScore(const int32 Index);
+
+	/** Clears all scores and indexes. */
+	void Reset();
+
+	/** Applies MarkAllSavedToDatabase to the scores and indexes in memory. */
+	void ApplyMarkAllSavedToDatabase();
+
+	/** Applies MarkSavedToDatabase to the scores and indexes in memory. Returns the number of scores marked. */
+	int32 ApplyMarkSavedToDatabase(const TArray<FString>& Times);
+
+	/** Appends a record that does not add a score, compacting the log if there are too many. */
+	void AppendNonScoreRecord(const ERecordType Type, const TArray<uint8>& Payload);
+
+	/** Serializes a record into Ar. */
+	static void WriteRecord(FArchive& Ar, const ERecordType Type, const TArray<uint8>& Payload);
+
+	/** Serializes a score with tagged property serialization so that scores from older versions remain readable. */
+	static void SerializeScore(FArchive& Ar, FPlayerScore& Score);
+
+	/** Appends the records in Data to the log file, writing the file header first if the file is empty. */
+	bool AppendToFile(const TArray<uint8>& Data);
+
+	FString FilePath;
+
+	TArray<FPlayerScore> Scores;
+
+	/** Indices into Scores for each defining config. */
+	TMap<FBS_DefiningConfig, TArray<int32>> ScoresByDefiningConfig;
+
+	/** Index into Scores for each score time. */
+	TMap<FString, int32> ScoresByTime;
+
+	/** Indices into Scores not saved to the database. */
+	TArray<int32> UnsavedScores;
+
+	/** Index into Scores of the score with the latest time. */
+	int32 MostRecentScore;
+
+	/** The number of records in the log file. */
+	int32 NumRecords;
+
+	/** The version in the header of the log file, or the current version if the file has not been written. */
+	int32 FileVersion;
+
+	/** Whether Load found a partially written record. */
+	bool bNeedsCompaction;
+};
@@ -3,6 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "BSConstants.h"
+#include "Async/Future.h"
+#include "BSGameModeConfig/DefiningConfig.h"
 #include "GameFramework/SaveGame.h"
 #include "SaveGameCustomGameMode.generated.h"
 
@@ -46,15 +49,34 @@ public:
 	/** @return true if there is a CustomGameMode matching the GameModeName. */
 	bool IsCustomGameMode(const FString& GameModeName) const;
 
+	/** @return the number of CustomGameModes. */
+	int32 GetNumCustomGameModes() const { return CustomGameModes.Num(); }
+
 	/** @return the version of the SaveGame. */
 	int32 GetVersion() const { return Version; }
 
 	/** @return the last loaded version of the SaveGame. */
 	int32 GetLastLoadedVersion() const { return LastLoadedVersion; }
 
-	/** Upgrades all Custom Game Modes in CustomGameModes to the latest Version. */
+	/** @return true if CustomGameModes are older than Constants::CustomGameModeVersion. */
+	bool NeedsUpgrade() const { return Version < Constants::CustomGameModeVersion; }
+
+	/** Upgrades all Custom Game Modes in CustomGameModes to the latest Version using the migrations registered in
+	 *  FCustomGameModeMigrationRegistry. Applies any pending asynchronous upgrade first. */
 	void UpgradeCustomGameModes();
 
+	/** Upgrades a copy of CustomGameModes on a background thread, then replaces CustomGameModes with it on the game
+	 *  thread and calls OnUpgraded with whether an upgrade was applied. Calls OnUpgraded immediately if no upgrade is
+	 *  needed. CustomGameModes must not be modified until the upgrade has been applied.
+	 *  @param OnUpgraded called once the upgrade has been applied
+	 */
+	void UpgradeCustomGameModesAsync(TFunction<void(bool)> OnUpgraded);
+
+	/** Waits for an upgrade started by UpgradeCustomGameModesAsync to finish and applies it.
+	 *  @return true if an upgrade was applied
+	 */
+	bool FinishPendingUpgrade();
+
 	/** Upgrades an FBSConfig struct to Version 1 from Version 0.
 	 *  @param InConfig game mode configuration to upgrade
 	 */
@@ -69,4 +91,22 @@ private:
 
 	UPROPERTY(Transient)
 	int32 LastLoadedVersion = -1;
+
+	/** Rebuilds NameIndex and DefiningConfigIndex from CustomGameModes if they are out of date. */
+	void BuildIndexes() const;
+
+	/** Index in CustomGameModes of the first game mode with each CustomGameModeName, ignoring case. */
+	mutable TMap<FString, int32> NameIndex;
+
+	/** Index in CustomGameModes of the first game mode matching each FBS_DefiningConfig. */
+	mutable TMap<FBS_DefiningConfig, int32> DefiningConfigIndex;
+
+	/** Whether CustomGameModes has been replaced or reordered since the indexes were built. */
+	mutable bool bIndexesDirty = true;
+
+	/** The upgraded copy of CustomGameModes being created by UpgradeCustomGameModesAsync. */
+	TFuture<TArray<FBSConfig>> PendingUpgrade;
+
+	/** Callbacks waiting for the pending upgrade to be applied. */
+	TArray<TFunction<void(bool)>> PendingUpgradeCallbacks;
 };
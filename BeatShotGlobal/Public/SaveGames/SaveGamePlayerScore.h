@@ -8,6 +8,26 @@
 #include "GameFramework/SaveGame.h"
 #include "SaveGamePlayerScore.generated.h"
 
+class FPlayerScoreStore;
+
+/** Custom version for the binary serialization of FCommonScoreInfo. */
+struct BEATSHOTGLOBAL_API FCommonScoreInfoCustomVersion
+{
+	enum Type
+	{
+		/** FCommonScoreInfo used tagged property serialization. */
+		BeforeCustomVersionWasAdded = 0,
+
+		/** Compact binary serialization with an optionally quantized QTable and delta encoded accuracy counts. */
+		CompactBinarySerialization,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
+
 /** Struct only used to save accuracy to database. */
 USTRUCT()
 struct BEATSHOTGLOBAL_API FAccuracyRow
@@ -134,6 +154,7 @@ struct BEATSHOTGLOBAL_API FAccuracyData
 	FAccuracyData(const int32 InNumRows, const int32 InNumCols)
 	{
 		AccuracyRows.Init(FAccuracyRow(InNumCols), InNumRows);
+		SpawnAreaSize = FVector::ZeroVector;
 	}
 
 	/** Adds the InUpdate AccuracyRows to this structs Accuracy rows, and recalculates the accuracy. */
@@ -579,6 +600,23 @@ struct BEATSHOTGLOBAL_API FCommonScoreInfo
 		}
 		return Total / static_cast<double>(TrainingSamples.Num());
 	}
+
+	/** Serializes using SerializeCompact, or returns false to fall back to tagged property serialization when loading
+	 *  data saved before FCommonScoreInfoCustomVersion::CompactBinarySerialization. */
+	bool Serialize(FArchive& Ar);
+
+	/** Serializes all members in a compact binary format. Accuracy values are not stored, and are recalculated from
+	 *  the delta encoded TotalSpawns and TotalHits when loading.
+	 *  @param Ar the archive to serialize to or from
+	 *  @param bQuantizeQTable whether to store the QTable as 16-bit values when saving
+	 */
+	void SerializeCompact(FArchive& Ar, const bool bQuantizeQTable);
+};
+
+template <>
+struct TStructOpsTypeTraits<FCommonScoreInfo> : public TStructOpsTypeTraitsBase2<FCommonScoreInfo>
+{
+	enum { WithSerializer = true };
 };
 
 /** Used to load and save player scores. */
@@ -748,25 +786,55 @@ class BEATSHOTGLOBAL_API USaveGamePlayerScore : public USaveGame
 
 public:
 	USaveGamePlayerScore();
+	virtual ~USaveGamePlayerScore() override;
 
-	/** @return a copy of PlayerScoreArray. */
+	/** Loads the player score store if it hasn't been loaded yet, and moves any scores in PlayerScoreArray into it.
+	 *  If the store fails to load, scores keep being read from and added to PlayerScoreArray for the rest of the
+	 *  session, and the store file is left untouched.
+	 *  @return true if scores were moved out of PlayerScoreArray, meaning the slot should be saved.
+	 */
+	bool InitializeScoreStore();
+
+	/** Same as InitializeScoreStore, using a store file other than the default. */
+	bool InitializeScoreStore(const FString& FilePath);
+
+	/** Loads the player score store on a background thread if it hasn't been loaded yet, then calls OnInitialized on
+	 *  the game thread with whether scores were moved out of PlayerScoreArray. Scores added while loading go to
+	 *  PlayerScoreArray, and are moved into the store along with the rest once it is loaded. */
+	void InitializeScoreStoreAsync(TFunction<void(bool)> OnInitialized);
+
+	/** @return a copy of all player scores. */
 	TArray<FPlayerScore> GetPlayerScores() const;
 
 	/** @return a copy of player scores not saved to database. */
 	TArray<FPlayerScore> GetPlayerScores_UnsavedToDatabase() const;
 
-	/** Adds a new entry to PlayerScoreArray.
+	/** @return copies of the player scores that match the DefiningConfig and SongTitle of InPlayerScore. */
+	TArray<FPlayerScore> GetMatchingPlayerScores(const FPlayerScore& InPlayerScore) const;
+
+	/** @return the player score with the latest time, or nullptr if there are none. */
+	const FPlayerScore* GetMostRecentPlayerScore() const;
+
+	/** Appends a new entry to the player score store, or to PlayerScoreArray if the store is not loaded.
 	 *  @param InPlayerScore player score instance to add
+	 *  @return true if the score was added to PlayerScoreArray, meaning the slot should be saved.
+	 */
+	bool AddPlayerScoreInstance(const FPlayerScore& InPlayerScore);
+
+	/** Marks all player scores as saved to the database.
+	 *  @return true if scores in PlayerScoreArray were marked, meaning the slot should be saved.
 	 */
-	void AddPlayerScoreInstance(const FPlayerScore& InPlayerScore);
+	bool SetAllScoresSavedToDatabase();
 
-	/** Modifies score instances in PlayerScoreArray. */
-	void SetAllScoresSavedToDatabase();
+	/** Marks the player scores with the given times as saved to the database.
+	 *  @return true if scores in PlayerScoreArray were marked, meaning the slot should be saved.
+	 */
+	bool SetScoresSavedToDatabase(const TArray<FString>& Times);
 
 	/** @return a copy of CommonScoreInfo. */
 	TMap<FBS_DefiningConfig, FCommonScoreInfo> GetCommonScoreInfo() const;
 
-	/** Finds or Adds an entry to CommonScoreInfo map for the given Defining Config.
+	/** Finds the entry in the CommonScoreInfo map for the given Defining Config, or returns a new one if none found.
 	 *  @param InDefiningConfig key used to find the CommonScoreInfo
 	 *  @param OutCommonScoreInfo the found CommonScoreInfo
 	 */
@@ -821,16 +889,34 @@ public:
 		const FCommonScoreInfo& InCommonScoreInfo, const FNumberFormattingOptions& Options);
 
 private:
+	/** Takes ownership of a loaded player score store and moves any scores in PlayerScoreArray into it.
+	 *  @param LoadedStore the store to use
+	 *  @param bLoaded whether the store loaded successfully. A store that failed to load is discarded, and
+	 *  PlayerScoreArray is used instead
+	 *  @return true if scores were moved out of PlayerScoreArray
+	 */
+	bool AdoptScoreStore(TUniquePtr<FPlayerScoreStore>&& LoadedStore, const bool bLoaded);
+
 	/**
 	 * @param InPlayerScore the player score to compare to existing
 	 * @return whether there exists a score with the same time.
 	 */
-	bool ContainsExistingTime(const FPlayerScore& InPlayerScore);
+	bool ContainsExistingTime(const FPlayerScore& InPlayerScore) const;
 
-	/** Array containing all saved score instances. */
+	/** Array containing all score instances saved before the player score store was added, or added while the store
+	 *  could not be loaded. Emptied once they have been moved to the store. */
 	UPROPERTY()
 	TArray<FPlayerScore> PlayerScoreArray;
 
+	/** All player scores, stored in an append-only log outside the save game slot. */
+	TUniquePtr<FPlayerScoreStore> ScoreStore;
+
+	/** Whether the store failed to load this session, so that it is not loaded again until the next session. */
+	bool bScoreStoreLoadFailed = false;
+
+	/** Callbacks waiting for InitializeScoreStoreAsync to finish. */
+	TArray<TFunction<void(bool)>> PendingScoreStoreCallbacks;
+
 	/** Map containing common score info for each unique defining config. */
 	UPROPERTY()
 	TMap<FBS_DefiningConfig, FCommonScoreInfo> CommonScoreInfo;
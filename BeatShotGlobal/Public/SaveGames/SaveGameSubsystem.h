@@ -0,0 +1,132 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "SaveGameSubsystem.generated.h"
+
+class USaveGame;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSaveGameSubsystem, Log, All);
+
+/** Identifies a save game slot by its name and user index, the same as UGameplayStatics. */
+USTRUCT()
+struct FSaveGameSlotKey
+{
+	GENERATED_BODY()
+
+	FSaveGameSlotKey() = default;
+
+	FSaveGameSlotKey(const FString& InSlotName, const int32 InUserIndex) : SlotName(InSlotName),
+		UserIndex(InUserIndex)
+	{
+	}
+
+	UPROPERTY()
+	FString SlotName;
+
+	UPROPERTY()
+	int32 UserIndex = 0;
+
+	bool operator==(const FSaveGameSlotKey& Other) const
+	{
+		return UserIndex == Other.UserIndex && SlotName == Other.SlotName;
+	}
+
+	friend uint32 GetTypeHash(const FSaveGameSlotKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.SlotName), GetTypeHash(Key.UserIndex));
+	}
+
+	FString ToString() const { return FString::Printf(TEXT("%s (%d)"), *SlotName, UserIndex); }
+};
+
+/** Keeps every save game slot resident in memory after it is first loaded, so that SaveLoadCommon::LoadFromSlot only
+ *  reads from the platform save game system once per slot. SaveLoadCommon::SaveToSlot only marks a slot as modified;
+ *  every SaveGameFlushInterval, each modified slot is serialized and written through the platform save game system
+ *  on a background thread. Any remaining modified slots are written synchronously on shutdown. Slots can also be read
+ *  on a background thread with PreloadSlotAsync before they are first loaded.
+ *
+ *  The resident save game is read by the background thread while it is being written, so it must only be modified on
+ *  the game thread after WaitForPendingWrite, which SaveLoadCommon::ModifySlot does. Everything else only gets a const
+ *  view of it from SaveLoadCommon::LoadFromSlot. */
+UCLASS()
+class BEATSHOTGLOBAL_API USaveGameSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** @return the subsystem of the running game instance, or nullptr if there is none. */
+	static USaveGameSubsystem* Get();
+
+	/** @return the resident save game for the slot, or nullptr if the slot has not been loaded yet. Only
+	 *  SaveLoadCommon should modify it, after calling WaitForPendingWrite. */
+	USaveGame* FindCachedSaveGame(const FString& SlotName, const int32 UserIndex) const;
+
+	/** Makes a save game loaded from the platform save game system the resident save game for the slot. */
+	void CacheSaveGame(const FString& SlotName, const int32 UserIndex, USaveGame* SaveGame);
+
+	/** Marks the slot as modified so that it is written on the next flush, making SaveGame the resident save game for
+	 *  the slot if it is not already. */
+	void MarkSlotDirty(const FString& SlotName, const int32 UserIndex, USaveGame* SaveGame);
+
+	/** Reads the slot on a background thread, then calls OnPreloaded on the game thread. The data is kept until taken
+	 *  by ConsumePreloadedData, so that loading the slot does not read from disk on the game thread. Calls OnPreloaded
+	 *  immediately if the slot is already resident. */
+	void PreloadSlotAsync(const FString& SlotName, const int32 UserIndex, TFunction<void()> OnPreloaded);
+
+	/** Moves the preloaded data for the slot into OutData.
+	 *  @return false if the slot was not preloaded, or did not exist
+	 */
+	bool ConsumePreloadedData(const FString& SlotName, const int32 UserIndex, TArray<uint8>& OutData);
+
+	/** Writes all modified slots to disk and waits for every write to finish. */
+	void FlushSynchronous();
+
+	/** Blocks until SaveGame is no longer being serialized on a background thread, so that it can be modified. Does
+	 *  nothing if there is no running subsystem. Must be called on the game thread. */
+	static void WaitForPendingWrite(const USaveGame* SaveGame);
+
+private:
+	/** Ticker callback that starts a background write for each modified slot. */
+	bool OnFlushTick(float DeltaTime);
+
+	/** Stores the data read by PreloadSlotAsync and calls all callbacks waiting on the slot. */
+	void OnSlotPreloaded(const FSaveGameSlotKey& Key, TArray<uint8>&& Data);
+
+	/** Checks finished background writes, marking any failed slots as modified again. */
+	void CollectFinishedWrites();
+
+	/** Serializes SaveGame and writes it to the slot through the platform save game system. Safe to call from any
+	 *  thread, as long as SaveGame is not modified until it returns. */
+	static bool WriteSaveGame(const USaveGame* SaveGame, const FSaveGameSlotKey& Key);
+
+	/** All slots loaded this session. */
+	UPROPERTY()
+	TMap<FSaveGameSlotKey, TObjectPtr<USaveGame>> CachedSaveGames;
+
+	/** Slots modified since they were last written. */
+	TSet<FSaveGameSlotKey> DirtySlots;
+
+	/** Background writes that have not been collected yet, at most one per slot. */
+	TMap<FSaveGameSlotKey, TFuture<bool>> PendingWrites;
+
+	/** The save game being written by each pending write, kept alive even if the slot is given a new save game. */
+	UPROPERTY()
+	TMap<FSaveGameSlotKey, TObjectPtr<USaveGame>> WritingSaveGames;
+
+	/** Data read by PreloadSlotAsync that has not been deserialized yet. */
+	TMap<FSaveGameSlotKey, TArray<uint8>> PreloadedData;
+
+	/** Callbacks waiting for a background read to finish, for each slot being preloaded. */
+	TMap<FSaveGameSlotKey, TArray<TFunction<void()>>> PendingPreloads;
+
+	FTSTicker::FDelegateHandle FlushTickerHandle;
+
+	static USaveGameSubsystem* Instance;
+};
@@ -0,0 +1,116 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BSConstants.h"
+#include "Containers/Ticker.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogScoreUploadOutbox, Log, All);
+
+/** Called by FScoreUploadOutbox when it needs an access token. The callback must be called on the game thread with
+ *  a valid access token, or an empty string if one could not be acquired. */
+using FScoreUploadAccessTokenProvider = TFunction<void(TFunction<void(const FString& AccessToken)>)>;
+
+/** Uploads player scores that have not been saved to the database. Scores are sent in batches of at most
+ *  ScoreUploadBatchSize, with each JSON payload built and optionally compressed on a background thread. If the
+ *  database rejects a compressed batch, it and every later batch are sent uncompressed instead. The scores in a batch
+ *  are reported through OnScoresAcknowledged as soon as the database accepts the batch, so a failure part way through
+ *  never causes acknowledged scores to be sent again. Failed batches are retried with exponential backoff and jitter.
+ *
+ *  The outbox itself only holds the scores pending for this session; the player score log already persists which
+ *  scores have not been saved to the database, so they are enqueued again on the next launch. All functions must be
+ *  called on the game thread. */
+class BEATSHOTGLOBAL_API FScoreUploadOutbox : public TSharedFromThis<FScoreUploadOutbox, ESPMode::ThreadSafe>
+{
+public:
+	/** @param InUserID userID of the BeatShot account
+	 *  @param InAccessTokenProvider called whenever a new access token is needed
+	 *  @param InBaseURL the URL that the userID and Segment_SaveScores are appended to
+	 *  @param bInCompress whether to gzip compress payloads
+	 */
+	FScoreUploadOutbox(const FString& InUserID, FScoreUploadAccessTokenProvider InAccessTokenProvider,
+		const FString& InBaseURL = Constants::Segment_ApiProfile,
+		const bool bInCompress = Constants::bCompressScoreUploads);
+
+	~FScoreUploadOutbox();
+
+	/** Adds any scores not saved to the database and not already pending to the outbox.
+	 *  @return the number of scores added
+	 */
+	int32 Enqueue(const TArray<FPlayerScore>& Scores);
+
+	/** Starts uploading all pending scores if not already uploading. OnFlushed is called once with true when every
+	 *  pending score has been acknowledged, or with false after the first failed batch. Failed batches keep being
+	 *  retried in the background after OnFlushed has been called. */
+	void Flush(TFunction<void(bool)> OnFlushed);
+
+	/** @return userID of the BeatShot account scores are uploaded to. */
+	const FString& GetUserID() const { return UserID; }
+
+	/** @return the number of scores waiting to be acknowledged. */
+	int32 GetNumPending() const { return Pending.Num(); }
+
+	/** @return true if a batch is being sent or a retry is scheduled. */
+	bool IsUploading() const { return bUploading; }
+
+	/** Called with the times of the scores in each batch acknowledged by the database. */
+	TFunction<void(const TArray<FString>&)> OnScoresAcknowledged;
+
+	/** Converts Scores to the JSON body expected by the database, gzip compressing it if bCompress is true. Safe to
+	 *  call from any thread.
+	 *  @return false if the JSON could not be written or compression failed
+	 */
+	static bool BuildPayload(const TArray<FPlayerScore>& Scores, const bool bCompress, TArray<uint8>& OutPayload);
+
+	/** @return the delay in seconds before retrying after Attempt consecutive failures. */
+	static float GetRetryDelay(const int32 Attempt, FRandomStream& Stream);
+
+private:
+	/** Builds the payload for the next batch on a background thread, or completes the flush if nothing is pending. */
+	void SendNextBatch();
+
+	/** Sends a batch once its payload has been built, acquiring an access token first if needed. */
+	void SendBatch(const TArray<FString>& Times, TArray<uint8>&& Payload, const bool bCompressed);
+
+	/** Stops uploading after a payload could not be built, keeping every score pending. */
+	void AbortUpload();
+
+	/** Removes an acknowledged batch, resends it uncompressed if the compressed payload was rejected, or schedules a
+	 *  retry if it failed. */
+	void OnBatchCompleted(const TArray<FString>& Times, const bool bCompressed, const bool bConnectedSuccessfully,
+		const int32 HttpStatus);
+
+	/** Schedules SendNextBatch after GetRetryDelay, or gives up if ScoreUploadMaxAttempts has been reached. */
+	void ScheduleRetry();
+
+	/** Calls and clears all flush callbacks. */
+	void CompleteFlush(const bool bSucceeded);
+
+	FString UserID;
+
+	/** The URL that the userID and Segment_SaveScores are appended to, resolved when each batch is sent. */
+	FString BaseURL;
+	FScoreUploadAccessTokenProvider AccessTokenProvider;
+
+	/** The most recent access token, cleared whenever the database rejects it. */
+	FString AccessToken;
+
+	/** Scores waiting to be acknowledged, in the order they were enqueued. */
+	TArray<FPlayerScore> Pending;
+
+	/** The times of all scores in Pending. */
+	TSet<FString> PendingTimes;
+
+	/** Callbacks waiting for the current flush to complete. */
+	TArray<TFunction<void(bool)>> FlushCallbacks;
+
+	/** Whether payloads are gzip compressed, cleared once the database rejects a compressed payload. */
+	bool bCompress;
+
+	bool bUploading;
+	int32 NumFailedAttempts;
+	FRandomStream RetryStream;
+	FTSTicker::FDelegateHandle RetryHandle;
+};
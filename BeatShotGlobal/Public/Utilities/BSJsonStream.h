@@ -0,0 +1,59 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Converts UStructs to and from JSON without building an intermediate FJsonObject tree.
+ *
+ *  The writer walks the struct with reflection and writes each property straight into a TJsonWriter backed by a
+ *  pre-sized buffer. It follows the same conversion rules as FJsonObjectConverter::UStructToJsonObject, so the output
+ *  is identical to converting the struct to an FJsonObject and serializing it with FJsonSerializer.
+ *
+ *  The reader pulls tokens from a TJsonReader and writes each value straight into the matching property, following the
+ *  same rules as FJsonObjectConverter::JsonObjectToUStruct with bStrictMode disabled. Unlike the converter, the struct
+ *  may be partially written if the JSON turns out to be invalid part way through. */
+namespace BSJsonStream
+{
+	/** Writes Struct as a JSON object to OutJsonString.
+	 *  @param StructDefinition the type of Struct
+	 *  @param Struct the struct to write
+	 *  @param OutJsonString replaced with the JSON string
+	 *  @param CheckFlags only properties with any of these flags are written, or all properties if zero
+	 *  @param SkipFlags properties with any of these flags are not written
+	 *  @param bPrettyPrint whether to use TPrettyJsonPrintPolicy or TCondensedJsonPrintPolicy
+	 *  @param ReserveSize the expected number of characters, used to size the output buffer
+	 *  @return false if any property could not be converted
+	 */
+	BEATSHOTGLOBAL_API bool UStructToJsonString(const UStruct* StructDefinition, const void* Struct,
+		FString& OutJsonString, const int64 CheckFlags = 0, const int64 SkipFlags = 0, const bool bPrettyPrint = true,
+		const int32 ReserveSize = 0);
+
+	/** Reads a JSON object into OutStruct, leaving any properties not present in the JSON unchanged.
+	 *  @param JsonString the JSON object to read
+	 *  @param StructDefinition the type of OutStruct
+	 *  @param OutStruct the struct to write
+	 *  @param CheckFlags only properties with any of these flags are read, or all properties if zero
+	 *  @param SkipFlags properties with any of these flags are not read
+	 *  @param OutFailReason optional reason for failure
+	 *  @return false if the JSON was invalid or any property could not be converted
+	 */
+	BEATSHOTGLOBAL_API bool JsonStringToUStruct(const FString& JsonString, const UStruct* StructDefinition,
+		void* OutStruct, const int64 CheckFlags = 0, const int64 SkipFlags = 0, FText* OutFailReason = nullptr);
+
+	template <typename InStructType>
+	bool UStructToJsonString(const InStructType& InStruct, FString& OutJsonString, const int64 CheckFlags = 0,
+		const int64 SkipFlags = 0, const bool bPrettyPrint = true, const int32 ReserveSize = 0)
+	{
+		return UStructToJsonString(InStructType::StaticStruct(), &InStruct, OutJsonString, CheckFlags, SkipFlags,
+			bPrettyPrint, ReserveSize);
+	}
+
+	template <typename OutStructType>
+	bool JsonStringToUStruct(const FString& JsonString, OutStructType* OutStruct, const int64 CheckFlags = 0,
+		const int64 SkipFlags = 0, FText* OutFailReason = nullptr)
+	{
+		return JsonStringToUStruct(JsonString, OutStructType::StaticStruct(), OutStruct, CheckFlags, SkipFlags,
+			OutFailReason);
+	}
+}
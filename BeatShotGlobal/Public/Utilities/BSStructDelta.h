@@ -0,0 +1,38 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Compact binary serialization of the properties of a UStruct that differ from a default instance.
+ *
+ *  Each written property is tagged with a CRC of its name and the size of its data, and the tags are sorted, so the
+ *  output does not depend on declaration order and unknown or removed properties are skipped when reading. Nested
+ *  structs are written recursively, so a single changed field only writes that field. Other properties, including
+ *  containers and immutable structs such as FVector, are written with FProperty::SerializeItem.
+ *
+ *  Identical structs always produce identical bytes, which makes the output suitable for hashing. Since omitted
+ *  properties are read back as whatever the struct already contains, the reader must start from the same defaults
+ *  the writer used. */
+namespace BSStructDelta
+{
+	/** Writes the properties of Struct that differ from Defaults.
+	 *  @param Ar the archive to write to
+	 *  @param StructDefinition the type of Struct and Defaults
+	 *  @param Struct the struct to write
+	 *  @param Defaults the struct to compare against
+	 *  @param SkipFlags properties with any of these flags are not written
+	 */
+	BEATSHOTGLOBAL_API void WriteStruct(FArchive& Ar, const UStruct* StructDefinition, const void* Struct,
+		const void* Defaults, const int64 SkipFlags = CPF_Transient);
+
+	/** Reads properties written by WriteStruct into OutStruct, which should already contain the defaults.
+	 *  @param Ar the archive to read from
+	 *  @param StructDefinition the type of OutStruct
+	 *  @param OutStruct the struct to read into
+	 *  @param SkipFlags properties with any of these flags are not read
+	 *  @return false if the data was truncated or invalid
+	 */
+	BEATSHOTGLOBAL_API bool ReadStruct(FArchive& Ar, const UStruct* StructDefinition, void* OutStruct,
+		const int64 SkipFlags = CPF_Transient);
+}
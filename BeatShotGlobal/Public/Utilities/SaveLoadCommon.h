@@ -8,11 +8,27 @@ class USaveGameCustomGameMode;
 
 namespace SaveLoadCommon
 {
+	/** Loads the save game in the slot, or creates a new one if the slot does not exist. While a USaveGameSubsystem is
+	 *  running, this is the resident save game shared by every caller, which is only modified through ModifySlot. */
 	template <typename T>
-	T* LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex);
+	const T* LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex);
 
+	/** Loads the save game in the slot and calls Modify with it once it is not being written in the background, then
+	 *  saves it if Modify returns true.
+	 *  @return false if the slot could not be loaded, or Modify returned true and the slot could not be saved
+	 */
+	template <typename T>
+	bool ModifySlot(const FString& InSlotName, const int32 InSlotIndex, TFunctionRef<bool(T&)> Modify);
+
+	/** Saves the save game to the slot. While a USaveGameSubsystem is running, it becomes the resident save game for
+	 *  the slot and is written in the background. */
 	template <typename T>
 	bool SaveToSlot(T* SaveGameClass, const FString& InSlotName, const int32 InSlotIndex);
+
+	/** Reads the slot on a background thread, then calls OnLoaded on the game thread with the result of LoadFromSlot.
+	 *  Calls OnLoaded immediately if the slot is already loaded or there is no USaveGameSubsystem. */
+	template <typename T>
+	void LoadFromSlotAsync(const FString& InSlotName, const int32 InSlotIndex, TFunction<void(const T*)> OnLoaded);
 }
 
 template bool SaveLoadCommon::SaveToSlot(USaveGameCustomGameMode* SaveGameClass, const FString& InSlotName,
@@ -22,9 +38,29 @@ template bool SaveLoadCommon::SaveToSlot(USaveGamePlayerSettings* SaveGameClass,
 template bool SaveLoadCommon::SaveToSlot(USaveGamePlayerScore* SaveGameClass, const FString& InSlotName,
 	const int32 InSlotIndex);
 
+template const USaveGameCustomGameMode* SaveLoadCommon::LoadFromSlot(const FString& InSlotName,
+	const int32 InSlotIndex);
+
+template const USaveGamePlayerSettings* SaveLoadCommon::LoadFromSlot(const FString& InSlotName,
+	const int32 InSlotIndex);
+
+template const USaveGamePlayerScore* SaveLoadCommon::LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex);
+
+template bool SaveLoadCommon::ModifySlot(const FString& InSlotName, const int32 InSlotIndex,
+	TFunctionRef<bool(USaveGameCustomGameMode&)> Modify);
+
+template bool SaveLoadCommon::ModifySlot(const FString& InSlotName, const int32 InSlotIndex,
+	TFunctionRef<bool(USaveGamePlayerSettings&)> Modify);
+
+template bool SaveLoadCommon::ModifySlot(const FString& InSlotName, const int32 InSlotIndex,
+	TFunctionRef<bool(USaveGamePlayerScore&)> Modify);
+
 template <>
-USaveGameCustomGameMode* SaveLoadCommon::LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex);
+void SaveLoadCommon::LoadFromSlotAsync(const FString& InSlotName, const int32 InSlotIndex,
+	TFunction<void(const USaveGameCustomGameMode*)> OnLoaded);
 
-template USaveGamePlayerSettings* SaveLoadCommon::LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex);
+template void SaveLoadCommon::LoadFromSlotAsync(const FString& InSlotName, const int32 InSlotIndex,
+	TFunction<void(const USaveGamePlayerSettings*)> OnLoaded);
 
-template USaveGamePlayerScore* SaveLoadCommon::LoadFromSlot(const FString& InSlotName, const int32 InSlotIndex);
+template void SaveLoadCommon::LoadFromSlotAsync(const FString& InSlotName, const int32 InSlotIndex,
+	TFunction<void(const USaveGamePlayerScore*)> OnLoaded);
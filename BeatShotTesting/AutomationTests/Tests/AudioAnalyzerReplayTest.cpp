@@ -0,0 +1,113 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "../TestBase/TargetManagerTestWithWorld.h"
+#include "Audio/AudioAnalyzerReplay.h"
+#include "HAL/FileManager.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+#include "SaveGames/SaveGamePlayerSettings.h"
+#include "Target/Target.h"
+#include "Target/TargetManager.h"
+
+/** Records a random beat stream for each default game mode, saves and loads it, and verifies that feeding the
+ *  recorded and loaded beats to the TargetManager with the recorded seed spawns the same targets. */
+IMPLEMENT_CUSTOM_COMPLEX_AUTOMATION_TEST(FAudioAnalyzerReplayTest, FTargetManagerTestWithWorld,
+	"TargetManager.AudioAnalyzerReplay",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+void FAudioAnalyzerReplayTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	if (InitGameModeDataAsset(TargetManagerTestHelpers::DefaultGameModeDataAssetPath))
+	{
+		for (const auto& Mode : GameModeDataAsset->GetGameModesMap())
+		{
+			const FString GameModeString = UEnum::GetDisplayValueAsText(Mode.Key.BaseGameMode).ToString();
+			OutBeautifiedNames.Add(GameModeString);
+			OutTestCommands.Add(GameModeString);
+			TestMap.Add(GameModeString, Mode.Value);
+		}
+	}
+}
+
+bool FAudioAnalyzerReplayTest::RunTest(const FString& Parameters)
+{
+	if (!Init())
+	{
+		return false;
+	}
+
+	const auto FoundConfig = TestMap.Find(Parameters);
+	if (!FoundConfig)
+	{
+		AddError(FString::Printf(TEXT("Failed to find Config for Parameters: %s"), *Parameters));
+		return false;
+	}
+
+	FAudioAnalyzerReplay Recording;
+	Recording.BeginRecording(30, *FoundConfig);
+	FRandomStream Stream(30);
+	for (int32 Frame = 0; Frame < 300; Frame++)
+	{
+		TArray<bool> Beats;
+		TArray<float> SpectrumValues;
+		for (int32 Channel = 0; Channel < 4; Channel++)
+		{
+			Beats.Add(Stream.FRand() < 0.1f);
+			SpectrumValues.Add(Stream.FRand());
+		}
+		Recording.RecordFrame(1.f / 60.f, Beats, SpectrumValues, SpectrumValues);
+	}
+
+	const FString FileName = TEXT("AudioAnalyzerReplayTest.bsreplay");
+	FAudioAnalyzerReplay Playback;
+	TestTrue(TEXT("Saved recording"), Recording.SaveToFile(FileName));
+	TestTrue(TEXT("Loaded recording"), Playback.LoadFromFile(FileName));
+	IFileManager::Get().Delete(*FAudioAnalyzerReplay::GetReplayFilePath(FileName));
+	TestEqual(TEXT("Random seed"), Playback.GetRandomSeed(), Recording.GetRandomSeed());
+
+	// Returns the location and scale of every target spawned from the beats, in the order they were spawned
+	auto PlayBeats = [this](FAudioAnalyzerReplay& Replay)
+	{
+		FBSConfig ReplayConfig;
+		TestTrue(TEXT("Read config"), Replay.GetConfig(ReplayConfig));
+		BSConfig = MakeShared<FBSConfig>(ReplayConfig);
+		TargetManager->Init(BSConfig, FCommonScoreInfo(), FPlayerSettings_Game(), Replay.GetRandomSeed());
+		TargetManager->SetShouldSpawn(true);
+
+		TArray<FVector> Spawned;
+		FAudioAnalyzerReplayFrame Frame;
+		Replay.RewindPlayback();
+		while (Replay.ReadNextFrame(Frame))
+		{
+			for (const bool Beat : Frame.Beats)
+			{
+				if (!Beat)
+				{
+					continue;
+				}
+				TargetManager->OnAudioAnalyzerBeat();
+				for (auto [Guid, Target] : GetManagedTargets())
+				{
+					Spawned.Add(Target->GetActorLocation());
+					Spawned.Add(Target->GetActorScale3D());
+					Target->DamageSelf(true);
+					TickWorld(UE_KINDA_SMALL_NUMBER);
+				}
+			}
+		}
+		TargetManager->Clear();
+		BSConfig.Reset();
+		return Spawned;
+	};
+
+	const TArray<FVector> Recorded = PlayBeats(Recording);
+	const TArray<FVector> Replayed = PlayBeats(Playback);
+	TestFalse(TEXT("Spawned targets"), Recorded.IsEmpty());
+	TestEqual(TEXT("Number of spawned targets"), Replayed.Num(), Recorded.Num());
+	TestTrue(TEXT("Same spawned targets"), Replayed == Recorded);
+
+	CleanUpWorld();
+
+	return true;
+}
@@ -0,0 +1,59 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "System/BSFixedTimestep.h"
+
+/** Verifies that fixed timesteps simulate the same number of steps regardless of how time is split into frames. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBSFixedTimestepTest, "System.FixedTimestep",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FBSFixedTimestepTest::RunTest(const FString& Parameters)
+{
+	constexpr double StepSeconds = 1.0 / 120.0;
+	constexpr int32 MaxStepsPerFrame = 8;
+	constexpr int32 NumFrames = 10000;
+
+	FBSFixedTimestep Disabled;
+	TestFalse(TEXT("Disabled by default"), Disabled.IsEnabled());
+	TestEqual(TEXT("Disabled steps"), Disabled.Advance(1.0), 0);
+
+	// Frames that are exact multiples of the step aren't lost to rounding
+	FBSFixedTimestep Exact(StepSeconds, MaxStepsPerFrame);
+	for (int32 i = 0; i < NumFrames; i++)
+	{
+		if (!TestEqual(TEXT("Two steps per 60 Hz frame"), Exact.Advance(static_cast<float>(1.0 / 60.0)), 2))
+		{
+			break;
+		}
+	}
+	TestEqual(TEXT("Exact steps simulated"), Exact.GetNumStepsSimulated(), static_cast<int64>(2 * NumFrames));
+
+	// Random frame times simulate the same time as one long frame, minus less than a step
+	const FRandomStream Stream(49);
+	FBSFixedTimestep Variable(StepSeconds, MaxStepsPerFrame);
+	double TotalTime = 0.0;
+	int64 TotalSteps = 0;
+	for (int32 i = 0; i < NumFrames; i++)
+	{
+		const double DeltaSeconds = Stream.FRandRange(0.001f, 0.05f);
+		TotalTime += DeltaSeconds;
+		const int32 NumSteps = Variable.Advance(DeltaSeconds);
+		TestTrue(TEXT("Steps within limit"), NumSteps >= 0 && NumSteps <= MaxStepsPerFrame);
+		TestTrue(TEXT("Alpha within a step"), Variable.GetAlpha() >= 0.0 && Variable.GetAlpha() < 1.0);
+		TotalSteps += NumSteps;
+	}
+	TestEqual(TEXT("Steps returned"), Variable.GetNumStepsSimulated(), TotalSteps);
+	const double RemainingTime = TotalTime - Variable.GetSimulationTime();
+	TestTrue(TEXT("Simulated time matches frame time"), RemainingTime > -UE_KINDA_SMALL_NUMBER &&
+		RemainingTime < StepSeconds);
+	TestEqual(TEXT("Alpha is the remaining time"), Variable.GetAlpha(), RemainingTime / StepSeconds, 1e-3);
+
+	// A hitch longer than MaxStepsPerFrame steps is dropped
+	FBSFixedTimestep Hitch(StepSeconds, MaxStepsPerFrame);
+	TestEqual(TEXT("Hitch steps"), Hitch.Advance(1.0), MaxStepsPerFrame);
+	TestEqual(TEXT("Hitch time dropped"), Hitch.GetAlpha(), 0.0);
+	TestEqual(TEXT("No steps after hitch"), Hitch.Advance(0.0), 0);
+	return true;
+}
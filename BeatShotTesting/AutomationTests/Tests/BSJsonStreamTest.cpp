@@ -0,0 +1,120 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "JsonObjectConverter.h"
+#include "BSGameModeConfig/BSConfig.h"
+#include "Misc/AutomationTest.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+#include "Utilities/BSJsonStream.h"
+
+/** Verifies that the streaming writer and reader match FJsonObjectConverter for the preset game mode configs and for
+ *  player scores, including old style JSON with different casing, unknown fields, and numbers stored as strings. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBSJsonStreamTest, "Json.BSJsonStream",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FBSJsonStreamTest::RunTest(const FString& Parameters)
+{
+	constexpr int64 ConfigSkipFlags = CPF_Transient | CPF_SkipSerialization;
+
+	auto ConverterToString = [](const UStruct* StructDefinition, const void* Struct, const int64 SkipFlags,
+		const bool bPrettyPrint)
+	{
+		const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		FJsonObjectConverter::UStructToJsonObject(StructDefinition, Struct, JsonObject, 0, SkipFlags);
+		FString JsonString;
+		if (bPrettyPrint)
+		{
+			FJsonSerializer::Serialize(JsonObject, TJsonWriterFactory<>::Create(&JsonString));
+		}
+		else
+		{
+			FJsonSerializer::Serialize(JsonObject,
+				TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString));
+		}
+		return JsonString;
+	};
+
+	for (const EBaseGameMode BaseGameMode : TEnumRange<EBaseGameMode>())
+	{
+		const FBSConfig Config(BaseGameMode, EGameModeDifficulty::Hard);
+		for (const bool bPrettyPrint : {true, false})
+		{
+			FString StreamString;
+			TestTrue(TEXT("Wrote config"), BSJsonStream::UStructToJsonString(Config, StreamString, 0, ConfigSkipFlags,
+				bPrettyPrint));
+			TestEqual(*UEnum::GetValueAsString(BaseGameMode), StreamString,
+				ConverterToString(FBSConfig::StaticStruct(), &Config, ConfigSkipFlags, bPrettyPrint));
+		}
+
+		FBSConfig StreamConfig;
+		TestTrue(TEXT("Read config"), FBSConfig::FromString(Config.ToString(), StreamConfig));
+		TestEqual(TEXT("Config round trip"), StreamConfig.ToString(), Config.ToString());
+	}
+
+	// Fractional floats, escaped characters, and a filled in accuracy grid
+	FRandomStream Stream(37);
+	FJsonScore JsonScores;
+	for (int32 i = 0; i < 20; i++)
+	{
+		FPlayerScore Score;
+		Score.DefiningConfig.BaseGameMode = static_cast<EBaseGameMode>(Stream.RandRange(0, 4));
+		Score.SongTitle = FString::Printf(TEXT("Song \"%d\"\t\\ %s"), i, TEXT("\u00E9\u4E2D"));
+		Score.Score = Stream.FRandRange(0.f, 100000.f);
+		Score.Accuracy = Stream.FRand();
+		Score.ShotsFired = Stream.RandRange(0, 2000);
+		Score.Time = (FDateTime(2023, 1, 1) + FTimespan::FromMinutes(i)).ToIso8601();
+		Score.bSavedToDatabase = i % 2 == 0;
+		for (int32 Row = 0; Row < 5; Row++)
+		{
+			FAccuracyRow AccuracyRow(5);
+			for (int32 Column = 0; Column < 5; Column++)
+			{
+				AccuracyRow.TotalSpawns[Column] = Stream.RandRange(0, 100);
+				AccuracyRow.Accuracy[Column] = Stream.FRand();
+			}
+			Score.LocationAccuracy.Add(AccuracyRow);
+		}
+		JsonScores.Scores.Add(Score);
+	}
+
+	FString JsonString;
+	TestTrue(TEXT("Wrote scores"), BSJsonStream::UStructToJsonString(JsonScores, JsonString, 0, 0, false));
+	TestEqual(TEXT("Scores match converter"), JsonString,
+		ConverterToString(FJsonScore::StaticStruct(), &JsonScores, 0, false));
+	FJsonScore StreamScores;
+	TestTrue(TEXT("Read scores"), BSJsonStream::JsonStringToUStruct(JsonString, &StreamScores));
+	FString StreamString;
+	BSJsonStream::UStructToJsonString(StreamScores, StreamString, 0, 0, false);
+	TestEqual(TEXT("Scores round trip"), StreamString, JsonString);
+
+	const FString LooseJson = TEXT("{ \"SONGTITLE\": \"Loose\", \"score\": \"125.5\", \"shotsFired\": 12.9, "
+		"\"unknown\": { \"nested\": [1, 2, { \"a\": null }] }, \"bSavedToDatabase\": 1, \"accuracy\": null, "
+		"\"definingConfig\": { \"baseGameMode\": \"ChargedBeatTrack\", \"difficulty\": \"Death\" } }");
+	FPlayerScore StreamScore;
+	StreamScore.Accuracy = 0.5f;
+	FPlayerScore ConverterScore = StreamScore;
+	TSharedPtr<FJsonObject> LooseObject;
+	TestTrue(TEXT("Read loose score"), BSJsonStream::JsonStringToUStruct(LooseJson, &StreamScore));
+	TestTrue(TEXT("Converter read loose score"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(LooseJson),
+		LooseObject) && FJsonObjectConverter::JsonObjectToUStruct(LooseObject.ToSharedRef(), &ConverterScore));
+	TestEqual(TEXT("Null accuracy unchanged"), StreamScore.Accuracy, 0.5f);
+	BSJsonStream::UStructToJsonString(StreamScore, StreamString);
+	TestEqual(TEXT("Loose score matches converter"), StreamString,
+		ConverterToString(FPlayerScore::StaticStruct(), &ConverterScore, 0, true));
+
+	FPlayerScore InvalidScore;
+	FText FailReason;
+	TestFalse(TEXT("Truncated JSON"), BSJsonStream::JsonStringToUStruct(TEXT("{ \"score\": 1, "), &InvalidScore, 0,
+		0, &FailReason));
+	TestFalse(TEXT("Truncated JSON has a fail reason"), FailReason.IsEmpty());
+	TestFalse(TEXT("Unknown enum name"), BSJsonStream::JsonStringToUStruct(
+		TEXT("{ \"definingConfig\": { \"baseGameMode\": \"NotAGameMode\" } }"), &InvalidScore));
+	TestFalse(TEXT("Root array"), BSJsonStream::JsonStringToUStruct(TEXT("[]"), &InvalidScore));
+	TestFalse(TEXT("Trailing content"), BSJsonStream::JsonStringToUStruct(TEXT("{ \"score\": 1 } { }"),
+		&InvalidScore));
+	TestTrue(TEXT("Trailing whitespace"), BSJsonStream::JsonStringToUStruct(TEXT("{ \"score\": 1 }\r\n"),
+		&InvalidScore));
+	return true;
+}
@@ -0,0 +1,113 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "BSConstants.h"
+#include "Misc/AutomationTest.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+using namespace Constants;
+
+/** Verifies that the compact format reproduces every member, that the quantized QTable is within a quantization step,
+ *  and that data saved with tagged property serialization before the custom serializer still loads. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonScoreInfoSerializationTest, "SaveGames.CommonScoreInfo.Serialization",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FCommonScoreInfoSerializationTest::RunTest(const FString& Parameters)
+{
+	// A random QTable and training samples, and accuracy from a session that leaves some entries untouched
+	const FRandomStream Stream(33);
+	FCommonScoreInfo Info;
+	for (float& Value : Info.QTable)
+	{
+		Value = Stream.FRandRange(-1.f, 1.f);
+	}
+	for (int32& Sample : Info.TrainingSamples)
+	{
+		Sample = Stream.RandRange(0, 5000);
+		Info.TotalTrainingSamples += Sample;
+	}
+	FAccuracyData Update(DefaultNumberOfAccuracyDataRows, DefaultNumberOfAccuracyDataColumns);
+	for (FAccuracyRow& Row : Update.AccuracyRows)
+	{
+		for (int i = 0; i < Row.Size; i += 2)
+		{
+			Row.TotalSpawns[i] = Stream.RandRange(1, 500);
+			Row.TotalHits[i] = Stream.RandRange(0, Row.TotalSpawns[i]);
+		}
+	}
+	Info.UpdateAccuracy(Update);
+
+	auto TestInfoEqual = [this, &Info](const TCHAR* What, const FCommonScoreInfo& Actual, const float Tolerance)
+	{
+		TestEqual(FString(What) + TEXT(" TotalTrainingSamples"), Actual.TotalTrainingSamples,
+			Info.TotalTrainingSamples);
+		TestTrue(FString(What) + TEXT(" TrainingSamples"), Actual.TrainingSamples == Info.TrainingSamples);
+		TestTrue(FString(What) + TEXT(" AccuracyData"), Actual.AccuracyData.SpawnAreaSize == Info.AccuracyData.
+			SpawnAreaSize && Actual.AccuracyData.AccuracyRows.Num() == Info.AccuracyData.AccuracyRows.Num());
+		for (int i = 0; i < Info.AccuracyData.AccuracyRows.Num() && i < Actual.AccuracyData.AccuracyRows.Num(); i++)
+		{
+			TestTrue(FString::Printf(TEXT("%s AccuracyRows[%d]"), What, i), Actual.AccuracyData.AccuracyRows[i].
+				TotalSpawns == Info.AccuracyData.AccuracyRows[i].TotalSpawns && Actual.AccuracyData.AccuracyRows[i].
+				TotalHits == Info.AccuracyData.AccuracyRows[i].TotalHits);
+		}
+		if (TestEqual(FString(What) + TEXT(" QTable.Num"), Actual.QTable.Num(), Info.QTable.Num()))
+		{
+			for (int i = 0; i < Info.QTable.Num(); i++)
+			{
+				if (!TestEqual(FString::Printf(TEXT("%s QTable[%d]"), What, i), Actual.QTable[i], Info.QTable[i],
+					Tolerance))
+				{
+					break;
+				}
+			}
+		}
+	};
+
+	// Reads with SerializeItem, as if saved with Version, or before the custom version existed if Version is negative
+	auto Deserialize = [](const TArray<uint8>& Data, const int32 Version)
+	{
+		FCommonScoreInfo Loaded;
+		Loaded.QTable.Empty();
+		Loaded.TrainingSamples.Empty();
+		Loaded.AccuracyData.AccuracyRows.Empty();
+		FMemoryReader Reader(Data);
+		if (Version >= 0)
+		{
+			Reader.SetCustomVersion(FCommonScoreInfoCustomVersion::GUID, Version, TEXT("CommonScoreInfoVer"));
+		}
+		FObjectAndNameAsStringProxyArchive Ar(Reader, false);
+		FCommonScoreInfo::StaticStruct()->SerializeItem(Ar, &Loaded, nullptr);
+		return Loaded;
+	};
+
+	TArray<uint8> CompactData;
+	FMemoryWriter CompactWriter(CompactData);
+	FObjectAndNameAsStringProxyArchive CompactAr(CompactWriter, false);
+	FCommonScoreInfo::StaticStruct()->SerializeItem(CompactAr, &Info, nullptr);
+	TestInfoEqual(TEXT("Compact"), Deserialize(CompactData, FCommonScoreInfoCustomVersion::LatestVersion), 0.f);
+
+	TArray<uint8> QuantizedData;
+	FMemoryWriter QuantizedWriter(QuantizedData);
+	Info.SerializeCompact(QuantizedWriter, true);
+	FCommonScoreInfo Quantized;
+	FMemoryReader QuantizedReader(QuantizedData);
+	Quantized.SerializeCompact(QuantizedReader, false);
+	TestFalse(TEXT("Quantized reader has no errors"), QuantizedReader.IsError());
+	TestInfoEqual(TEXT("Quantized"), Quantized, (FMath::Max(Info.QTable) - FMath::Min(Info.QTable)) / 65535.f);
+
+	TArray<uint8> TaggedData;
+	FMemoryWriter TaggedWriter(TaggedData);
+	FObjectAndNameAsStringProxyArchive TaggedAr(TaggedWriter, false);
+	FCommonScoreInfo::StaticStruct()->SerializeTaggedProperties(TaggedAr, reinterpret_cast<uint8*>(&Info),
+		FCommonScoreInfo::StaticStruct(), nullptr);
+	TestInfoEqual(TEXT("Tagged without custom version"), Deserialize(TaggedData, -1), 0.f);
+	TestInfoEqual(TEXT("Tagged"), Deserialize(TaggedData, FCommonScoreInfoCustomVersion::BeforeCustomVersionWasAdded),
+		0.f);
+	AddInfo(FString::Printf(TEXT("Tagged %d bytes, Compact %d bytes, Quantized %d bytes"), TaggedData.Num(),
+		CompactData.Num(), QuantizedData.Num()));
+	return true;
+}
@@ -0,0 +1,67 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "BSConstants.h"
+#include "BSGameModeConfig/BSConfig.h"
+#include "Misc/AutomationTest.h"
+#include "SaveGames/CustomGameModeMigrationRegistry.h"
+#include "SaveGames/SaveGameCustomGameMode.h"
+
+/** Verifies that the registered migrations upgrade a Version 0 slot once and stamp it with the latest version. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCustomGameModeMigrationTest, "SaveGames.CustomGameModeMigration.UpgradeSlot",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FCustomGameModeMigrationTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Migration from Version 0 is registered"), FCustomGameModeMigrationRegistry::Get().HasMigration(0));
+
+	// Version 0 custom game modes used the persistent conditions, and static bounds scaling without StartBounds
+	USaveGameCustomGameMode* SaveGame = NewObject<USaveGameCustomGameMode>();
+	for (const EBoundsScalingPolicy Policy : {EBoundsScalingPolicy::Static, EBoundsScalingPolicy::Dynamic})
+	{
+		FBSConfig Config;
+		Config.DefiningConfig.GameModeType = EGameModeType::Custom;
+		Config.DefiningConfig.CustomGameModeName = UEnum::GetValueAsString(Policy);
+		Config.TargetConfig.BoundsScalingPolicy = Policy;
+		Config.TargetConfig.BoxBounds = FVector(0.f, 2000.f, 800.f);
+		Config.TargetConfig.TargetDeactivationConditions.Add(ETargetDeactivationCondition::Persistent_DEPRECATED);
+		Config.TargetConfig.TargetDestructionConditions = {ETargetDestructionCondition::Persistent_DEPRECATED};
+		SaveGame->SaveCustomGameMode(Config);
+	}
+	TestTrue(TEXT("Version 0 slot needs upgrade"), SaveGame->NeedsUpgrade());
+
+	SaveGame->UpgradeCustomGameModes();
+	TestFalse(TEXT("Upgraded slot needs upgrade"), SaveGame->NeedsUpgrade());
+	TestEqual(TEXT("Version"), SaveGame->GetVersion(), Constants::CustomGameModeVersion);
+
+	const TArray<FBSConfig> Modes = SaveGame->GetCustomGameModes();
+	TestEqual(TEXT("Num custom game modes"), Modes.Num(), 2);
+	for (const FBSConfig& Mode : Modes)
+	{
+		const FBS_TargetConfig& TargetConfig = Mode.TargetConfig;
+		if (TargetConfig.TargetDeactivationConditions.Contains(ETargetDeactivationCondition::Persistent_DEPRECATED)
+			|| TargetConfig.TargetDestructionConditions.Contains(ETargetDestructionCondition::Persistent_DEPRECATED))
+		{
+			AddError(FString::Printf(TEXT("%s still has deprecated conditions"),
+				*Mode.DefiningConfig.CustomGameModeName));
+			return false;
+		}
+		TestTrue(TEXT("Destruction conditions replaced"),
+			TargetConfig.TargetDestructionConditions.Contains(ETargetDestructionCondition::OnHealthReachedZero));
+		TestEqual(TEXT("MaxHealth"), TargetConfig.MaxHealth, -1.f);
+		if (TargetConfig.BoundsScalingPolicy == EBoundsScalingPolicy::Static)
+		{
+			TestEqual(TEXT("StartBounds"), Mode.DynamicSpawnAreaScaling.StartBounds, TargetConfig.BoxBounds);
+		}
+	}
+
+	// Running the upgrade again must not modify anything
+	SaveGame->UpgradeCustomGameModes();
+	const TArray<FBSConfig> ModesAfterSecondUpgrade = SaveGame->GetCustomGameModes();
+	for (int32 i = 0; i < Modes.Num(); i++)
+	{
+		TestTrue(TEXT("Second upgrade is a no-op"), ModesAfterSecondUpgrade[i].TargetConfig == Modes[i].TargetConfig);
+	}
+	return true;
+}
@@ -0,0 +1,58 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "BSGameModeInterface.h"
+#include "BSGameModeConfig/BSConfig.h"
+#include "Misc/AutomationTest.h"
+#include "SaveGames/SaveGameCustomGameMode.h"
+
+/** Verifies that custom game mode lookups stay correct as game modes are saved, overwritten, and removed. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameModeCatalogueTest, "GameModes.Catalogue",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FGameModeCatalogueTest::RunTest(const FString& Parameters)
+{
+	auto MakeCustomGameMode = [](const FString& Name, const int32 MaxNumActivatedTargetsAtOnce = 1)
+	{
+		FBSConfig Config;
+		Config.DefiningConfig.GameModeType = EGameModeType::Custom;
+		Config.DefiningConfig.CustomGameModeName = Name;
+		Config.TargetConfig.MaxNumActivatedTargetsAtOnce = MaxNumActivatedTargetsAtOnce;
+		return Config;
+	};
+
+	USaveGameCustomGameMode* SaveGame = NewObject<USaveGameCustomGameMode>();
+	for (int32 i = 0; i < 10; i++)
+	{
+		SaveGame->SaveCustomGameMode(MakeCustomGameMode(FString::Printf(TEXT("Custom Game Mode %d"), i)));
+	}
+	TestTrue(TEXT("Found by name"), SaveGame->IsCustomGameMode(TEXT("Custom Game Mode 3")));
+	TestTrue(TEXT("Found by name ignoring case"), SaveGame->IsCustomGameMode(TEXT("custom game MODE 3")));
+	TestFalse(TEXT("Missing name"), SaveGame->IsCustomGameMode(TEXT("Custom Game Mode 10")));
+
+	FBSConfig Found;
+	TestFalse(TEXT("FindCustomGameMode is case sensitive"), SaveGame->FindCustomGameMode(TEXT("custom game mode 3"),
+		Found));
+
+	SaveGame->SaveCustomGameMode(MakeCustomGameMode(TEXT("CUSTOM GAME MODE 3"), 5));
+	TestEqual(TEXT("Overwritten instead of added"), SaveGame->GetNumCustomGameModes(), 10);
+	TestTrue(TEXT("Found overwritten"), SaveGame->FindCustomGameMode(TEXT("CUSTOM GAME MODE 3"), Found));
+	TestEqual(TEXT("Overwritten value"), Found.TargetConfig.MaxNumActivatedTargetsAtOnce, 5);
+
+	TestEqual(TEXT("Removed"), SaveGame->RemoveCustomGameMode(MakeCustomGameMode(TEXT("Custom Game Mode 2"))), 1);
+	TestFalse(TEXT("Removed name"), SaveGame->IsCustomGameMode(TEXT("Custom Game Mode 2")));
+	TestTrue(TEXT("Found after removal"), SaveGame->FindCustomGameMode(TEXT("Custom Game Mode 9"), Found));
+	TestEqual(TEXT("Found the right game mode after removal"), Found.DefiningConfig.CustomGameModeName,
+		FString(TEXT("Custom Game Mode 9")));
+
+	SaveGame->SaveCustomGameMode(MakeCustomGameMode(TEXT("Custom Game Mode 2")));
+	TestTrue(TEXT("Found after adding again"), SaveGame->IsCustomGameMode(TEXT("Custom Game Mode 2")));
+	TestEqual(TEXT("Removed all"), SaveGame->RemoveAll(), 10);
+	TestFalse(TEXT("Empty after removing all"), SaveGame->IsCustomGameMode(TEXT("Custom Game Mode 2")));
+
+	TestTrue(TEXT("Preset name"), IBSGameModeInterface::IsPresetGameMode(
+		UEnum::GetDisplayValueAsText(EBaseGameMode::MultiBeat).ToString().ToLower()));
+	TestFalse(TEXT("Not a preset name"), IBSGameModeInterface::IsPresetGameMode(TEXT("Custom Game Mode 2")));
+	return true;
+}
@@ -0,0 +1,75 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "BSConstants.h"
+#include "BSGameModeConfig/BSConfig.h"
+#include "Misc/AutomationTest.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Utilities/BSStructDelta.h"
+
+/** Verifies that share codes round trip every field for every supported version, are shorter than legacy codes,
+ *  that legacy codes still import, and that corrupt or newer codes are rejected. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameModeShareCodeTest, "GameModes.ShareCode",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FGameModeShareCodeTest::RunTest(const FString& Parameters)
+{
+	using namespace Constants;
+	FText FailReason;
+	for (const EBaseGameMode BaseGameMode : TEnumRange<EBaseGameMode>())
+	{
+		FBSConfig Config(BaseGameMode, EGameModeDifficulty::Hard);
+		Config.DefiningConfig.GameModeType = EGameModeType::Custom;
+		Config.DefiningConfig.CustomGameModeName = TEXT("Share Code Test");
+		Config.TargetConfig.MaxNumActivatedTargetsAtOnce = 7;
+		Config.TargetConfig.TargetSpawnResponses.Add(ETargetSpawnResponse::ChangeDirection);
+
+		const FString ShareCode = Config.EncodeToShareCode();
+		const FString LegacyCode = Config.EncodeToString();
+		TestTrue(TEXT("Share code has prefix"), ShareCode.StartsWith(GameModeShareCodePrefix));
+		TestTrue(TEXT("Share code is shorter than legacy code"), ShareCode.Len() < LegacyCode.Len());
+
+		FBSConfig Decoded;
+		TestTrue(TEXT("Decoded legacy code"), FBSConfig::DecodeFromShareCode(LegacyCode, Decoded, &FailReason));
+		TestEqual(TEXT("Legacy code round trip"), Decoded.ToString(), Config.ToString());
+		for (uint8 Version = MinGameModeShareCodeVersion; Version <= GameModeShareCodeVersion; Version++)
+		{
+			TestTrue(TEXT("Decoded share code"), FBSConfig::DecodeFromShareCode(Config.EncodeToShareCode(Version),
+				Decoded, &FailReason));
+			TestEqual(FString::Printf(TEXT("Version %d round trip"), Version), Decoded.ToString(), Config.ToString());
+			TestEqual(TEXT("Hash after round trip"), Decoded.GetContentHash(), Config.GetContentHash());
+		}
+
+		FBSConfig Changed = Config;
+		Changed.TargetConfig.MaxNumActivatedTargetsAtOnce++;
+		TestNotEqual(TEXT("Hash after changing a field"), Changed.GetContentHash(), Config.GetContentHash());
+
+		FBSConfig Invalid;
+		TestFalse(TEXT("Truncated share code"), FBSConfig::DecodeFromShareCode(ShareCode.LeftChop(8), Invalid));
+		TestFalse(TEXT("Newer version"), FBSConfig::DecodeFromShareCode(Config.EncodeToShareCode(
+			GameModeShareCodeVersion + 1), Invalid, &FailReason));
+		TestFalse(TEXT("Newer version has a fail reason"), FailReason.IsEmpty());
+	}
+
+	FBSConfig Invalid;
+	TestFalse(TEXT("Garbage share code"), FBSConfig::DecodeFromShareCode(FString(GameModeShareCodePrefix) +
+		TEXT("AAAA"), Invalid));
+
+	// A string field whose length is larger than the field
+	TArray<uint8> Corrupt;
+	FMemoryWriter Writer(Corrupt);
+	uint8 NumFields = 1;
+	uint32 Tag = FCrc::StrCrc32(TEXT("SongTitle"));
+	uint8 Size = sizeof(int32);
+	int32 Length = MAX_int32;
+	Writer << NumFields << Tag << Size << Length;
+	FMemoryReader Reader(Corrupt);
+	FPlayerScore Score;
+	TestFalse(TEXT("Oversized string length"), BSStructDelta::ReadStruct(Reader, FPlayerScore::StaticStruct(),
+		&Score));
+	TestTrue(TEXT("Song title unchanged"), Score.SongTitle.IsEmpty());
+	return true;
+}
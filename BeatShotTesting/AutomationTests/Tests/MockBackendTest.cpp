@@ -0,0 +1,169 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "BSConstants.h"
+#include "BSMockBackend.h"
+#include "HttpRequestInterface.h"
+#include "ScoreUploadOutbox.h"
+#include "Misc/AutomationTest.h"
+
+/** Verifies that every route used by IHttpRequestInterface responds in a way the client parses, and that requests
+ *  are captured. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMockBackendRoutesTest, "Http.MockBackend.Routes",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FMockBackendRoutesTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FBSMockBackend> MockBackend = FBSMockBackend::Start(30311);
+	if (!TestNotNull(TEXT("Started mock backend"), MockBackend.Get()))
+	{
+		return false;
+	}
+	AddExpectedError(TEXT("Login Request failed Http Status: 401"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("Successfully s"), EAutomationExpectedErrorFlags::Contains, 0);
+	TestEqual(TEXT("Resolved URL"), IHttpRequestInterface::ResolveURL(Constants::Endpoint_Login),
+		MockBackend->GetOriginURL() + TEXT("/api/login"));
+
+	const auto Login = MakeShared<FLoginResponse, ESPMode::ThreadSafe>();
+	const auto BadLogin = MakeShared<FLoginResponse, ESPMode::ThreadSafe>();
+	const auto AccessToken = MakeShared<FAccessTokenResponse, ESPMode::ThreadSafe>();
+	const auto PostScores = MakeShared<FBSHttpResponse, ESPMode::ThreadSafe>();
+	const auto DeleteScores = MakeShared<FDeleteScoresResponse, ESPMode::ThreadSafe>();
+	const auto Feedback = MakeShared<FBSHttpResponse, ESPMode::ThreadSafe>();
+	const auto SteamAuth = MakeShared<FSteamAuthTicketResponse, ESPMode::ThreadSafe>();
+	const TSharedRef<int32> NumReceived = MakeShared<int32>(0);
+	for (FBSHttpResponse* Response : TArray<FBSHttpResponse*>{&*Login, &*BadLogin, &*AccessToken, &*DeleteScores,
+		&*Feedback, &*SteamAuth})
+	{
+		Response->OnHttpResponseReceived.BindLambda([NumReceived] { ++*NumReceived; });
+	}
+
+	// Every other score belongs to the custom game mode, and scores are only deleted once they have been saved
+	const FString CustomGameModeName = TEXT("Mock Custom Game Mode");
+	TArray<FPlayerScore> Scores;
+	for (int32 i = 0; i < 15; i++)
+	{
+		FPlayerScore& Score = Scores.AddDefaulted_GetRef();
+		Score.Time = (FDateTime(2023, 1, 1) + FTimespan::FromMinutes(i)).ToIso8601();
+		Score.DefiningConfig.CustomGameModeName = i % 2 == 0 ? CustomGameModeName : FString();
+	}
+	const FString Username = TEXT("MockUser");
+	const FString UserID = FBSMockBackend::GetUserID(Username);
+	PostScores->OnHttpResponseReceived.BindLambda([NumReceived, CustomGameModeName, UserID, DeleteScores]
+	{
+		++*NumReceived;
+		IHttpRequestInterface::DeleteScores(CustomGameModeName, UserID, FBSMockBackend::AccessToken, DeleteScores);
+	});
+
+	IHttpRequestInterface::LoginUser(FLoginPayload(Username, TEXT(""), TEXT("password")), Login);
+	IHttpRequestInterface::LoginUser(FLoginPayload(Username, TEXT(""), TEXT("")), BadLogin);
+	IHttpRequestInterface::RequestAccessToken(FString(TEXT("jwt=")) + FBSMockBackend::RefreshToken, AccessToken);
+	IHttpRequestInterface::PostPlayerScores(Scores, UserID, FBSMockBackend::AccessToken, PostScores);
+	IHttpRequestInterface::PostFeedback(FJsonFeedback(TEXT("Title"), TEXT("Content")), Feedback);
+	IHttpRequestInterface::AuthenticateSteamUser(TEXT("Ticket"), SteamAuth);
+
+	const double StartTime = FPlatformTime::Seconds();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([=, this]()
+	{
+		if (*NumReceived < 7 && FPlatformTime::Seconds() - StartTime < 20.0)
+		{
+			return false;
+		}
+		TestTrue(TEXT("Login OK"), Login->OK);
+		TestEqual(TEXT("Login userID"), Login->UserID, UserID);
+		TestEqual(TEXT("Login access token"), Login->AccessToken, FString(FBSMockBackend::AccessToken));
+		TestTrue(TEXT("Login refresh token valid"), IHttpRequestInterface::IsRefreshTokenValid(Login->RefreshToken));
+		TestEqual(TEXT("Bad login status"), BadLogin->HttpStatus, 401);
+		TestEqual(TEXT("Refreshed access token"), AccessToken->AccessToken, FString(FBSMockBackend::AccessToken));
+		TestTrue(TEXT("Post scores OK"), PostScores->OK);
+		TestTrue(TEXT("Delete scores OK"), DeleteScores->OK);
+		TestEqual(TEXT("Num scores removed"), DeleteScores->NumRemoved, 8);
+		TestEqual(TEXT("Num scores left"), MockBackend->GetScores(UserID).Num(), 7);
+		TestTrue(TEXT("Feedback OK"), Feedback->OK);
+		TestTrue(TEXT("Steam auth OK"), SteamAuth->OK);
+		TestEqual(TEXT("Steam ID"), SteamAuth->SteamID, FString(FBSMockBackend::SteamID));
+		TestFalse(TEXT("Steam refresh cookie"), SteamAuth->RefreshCookie.IsEmpty());
+
+		const TArray<FBSMockBackendRequest>& Requests = MockBackend->GetCapturedRequests();
+		TestEqual(TEXT("Num captured requests"), Requests.Num(), 7);
+		const FBSMockBackendRequest* Delete = Requests.FindByPredicate([](const FBSMockBackendRequest& Request)
+		{
+			return Request.Verb == TEXT("DELETE");
+		});
+		if (TestNotNull(TEXT("Captured delete request"), Delete))
+		{
+			TestEqual(TEXT("Delete path"), Delete->Path, TEXT("/api/profile/") + UserID + TEXT("/deletescores"));
+			TestTrue(TEXT("Delete body"), Delete->Body.Contains(CustomGameModeName));
+			TestEqual(TEXT("Delete response code"), Delete->ResponseCode, 200);
+		}
+		FBSMockBackend::Stop();
+		return true;
+	}));
+	return true;
+}
+
+/** Verifies that responses are delayed by the configured latency, and that the score upload outbox retries an
+ *  injected failure until the mock backend stores every score. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMockBackendFailureInjectionTest, "Http.MockBackend.FailureInjection",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FMockBackendFailureInjectionTest::RunTest(const FString& Parameters)
+{
+	FBSMockBackendOptions Options;
+	Options.Latency = 0.25f;
+	const TSharedPtr<FBSMockBackend> MockBackend = FBSMockBackend::Start(30311, Options);
+	if (!TestNotNull(TEXT("Started mock backend"), MockBackend.Get()))
+	{
+		return false;
+	}
+	MockBackend->FailNextRequests(1, 503);
+	AddExpectedError(TEXT("Score upload failed Http Status: 503"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	const int32 NumScores = Constants::ScoreUploadBatchSize + 1;
+	TArray<FPlayerScore> Scores;
+	for (int32 i = 0; i < NumScores; i++)
+	{
+		FPlayerScore& Score = Scores.AddDefaulted_GetRef();
+		Score.Time = (FDateTime(2023, 1, 1) + FTimespan::FromMinutes(i)).ToIso8601();
+	}
+
+	const FString UserID = FBSMockBackend::GetUserID(TEXT("MockUser"));
+	const TSharedRef<FScoreUploadOutbox, ESPMode::ThreadSafe> Outbox = MakeShared<FScoreUploadOutbox,
+		ESPMode::ThreadSafe>(UserID, [](TFunction<void(const FString&)> OnAccessToken)
+	{
+		OnAccessToken(FBSMockBackend::AccessToken);
+	}, Constants::Segment_ApiProfile);
+	Outbox->Enqueue(Scores);
+
+	const TSharedRef<TArray<bool>> FlushResults = MakeShared<TArray<bool>>();
+	const TSharedRef<double> FirstResponseTime = MakeShared<double>(0.0);
+	const double StartTime = FPlatformTime::Seconds();
+	Outbox->Flush([FlushResults, FirstResponseTime, StartTime](const bool bSucceeded)
+	{
+		*FirstResponseTime = FPlatformTime::Seconds() - StartTime;
+		FlushResults->Add(bSucceeded);
+	});
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([=, this]()
+	{
+		if ((Outbox->GetNumPending() > 0 || Outbox->IsUploading()) && FPlatformTime::Seconds() - StartTime < 20.0)
+		{
+			return false;
+		}
+		TestTrue(TEXT("First flush failed"), FlushResults->Num() == 1 && !(*FlushResults)[0]);
+		TestTrue(TEXT("Delayed by latency"), *FirstResponseTime >= Options.Latency);
+		TestEqual(TEXT("Num scores saved"), MockBackend->GetScores(UserID).Num(), NumScores);
+
+		const TArray<FBSMockBackendRequest>& Requests = MockBackend->GetCapturedRequests();
+		if (TestEqual(TEXT("Num captured requests"), Requests.Num(), 3))
+		{
+			TestEqual(TEXT("Injected failure"), Requests[0].ResponseCode, 503);
+			TestEqual(TEXT("Retried"), Requests[1].ResponseCode, 200);
+		}
+		FBSMockBackend::Stop();
+		return true;
+	}));
+	return true;
+}
@@ -0,0 +1,63 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Target/MovingTargetDirectionTable.h"
+
+/** Verifies that the moving target direction table is only rebuilt when the spawn box changes, and that sampled
+ *  directions point into a different sector than the target is in. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMovingTargetDirectionTableTest, "TargetManager.MovingTargetDirectionTable",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FMovingTargetDirectionTableTest::RunTest(const FString& Parameters)
+{
+	constexpr float Depth = 400.f;
+	const FVector Origin(3700.f, 0.f, 1100.f);
+	const FVector Extents(0.f, 1600.f, 500.f);
+	const FRandomStream Stream(48);
+	FMovingTargetDirectionTable Table;
+	TestTrue(TEXT("Empty before update"), Table.IsEmpty());
+	TestEqual(TEXT("Empty table direction"), Table.SampleDirection(Origin, Stream), FVector::ZeroVector);
+
+	TestTrue(TEXT("Built on first update"), Table.Update(Origin, Extents, Depth, Stream));
+	TestFalse(TEXT("Not rebuilt for the same spawn box"), Table.Update(Origin, Extents, Depth, Stream));
+	TestTrue(TEXT("Rebuilt when extents change"), Table.Update(Origin, Extents * 0.5f, Depth, Stream));
+	TestTrue(TEXT("Rebuilt when depth changes"), Table.Update(Origin, Extents * 0.5f, 0.f, Stream));
+	TestTrue(TEXT("Rebuilt when extents and depth change back"), Table.Update(Origin, Extents, Depth, Stream));
+	TestTrue(TEXT("Rebuilt when origin changes"), Table.Update(Origin + FVector(0.f, 100.f, 0.f), Extents, Depth,
+		Stream));
+	TestTrue(TEXT("Rebuilt when origin changes back"), Table.Update(Origin, Extents, Depth, Stream));
+
+	const FBox SpawnBox(Origin - Extents - FVector(Depth, 0.f, 0.f), Origin + Extents);
+	for (int32 i = 0; i < 1000; i++)
+	{
+		const FVector Location(Origin.X, Stream.FRandRange(-Extents.Y, Extents.Y),
+			Origin.Z + Stream.FRandRange(-Extents.Z, Extents.Z));
+		FVector NewLocation;
+		const FVector Direction = Table.SampleDirection(Location, Stream, &NewLocation);
+
+		TestTrue(TEXT("Direction is a unit vector"), Direction.IsUnit());
+		TestTrue(TEXT("Direction points at the new location"), Direction.Equals((NewLocation - Location)
+			.GetSafeNormal()));
+		TestTrue(TEXT("New location inside spawn box"), SpawnBox.ExpandBy(UE_KINDA_SMALL_NUMBER)
+			.IsInsideOrOn(NewLocation));
+		TestNotEqual(TEXT("New location in a different sector"), Table.GetSectorIndex(NewLocation),
+			Table.GetSectorIndex(Location));
+	}
+
+	// The same seed produces the same table and samples
+	const FRandomStream StreamA(48);
+	const FRandomStream StreamB(48);
+	FMovingTargetDirectionTable TableA;
+	FMovingTargetDirectionTable TableB;
+	TableA.Update(Origin, Extents, Depth, StreamA);
+	TableB.Update(Origin, Extents, Depth, StreamB);
+	for (int32 i = 0; i < 1000; i++)
+	{
+		const FVector Location(Origin.X, 0.f, Origin.Z);
+		TestEqual(TEXT("Deterministic"), TableA.SampleDirection(Location, StreamA),
+			TableB.SampleDirection(Location, StreamB));
+	}
+	return true;
+}
@@ -0,0 +1,70 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "SaveGames/PlayerScoreStore.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+
+/** Verifies that a store file with a corrupt header is never appended to, and that scores are kept in the score save
+ *  game slot instead. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlayerScoreStoreCorruptHeaderTest, "SaveGames.PlayerScoreStore.CorruptHeader",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FPlayerScoreStoreCorruptHeaderTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("CorruptHeader.log"));
+	auto MakeScore = [](const int32 Minute)
+	{
+		FPlayerScore Score;
+		Score.Time = (FDateTime(2023, 1, 1) + FTimespan::FromMinutes(Minute)).ToIso8601();
+		return Score;
+	};
+
+	const TArray<uint8> CorruptData = {'N', 'O', 'T', 'A', 'L', 'O', 'G', 0, 1, 2, 3, 4};
+	if (!TestTrue(TEXT("Wrote corrupt file"), FFileHelper::SaveArrayToFile(CorruptData, *FilePath)))
+	{
+		return false;
+	}
+
+	FPlayerScoreStore Store(FilePath);
+	TestFalse(TEXT("Store loaded"), Store.Load());
+
+	USaveGamePlayerScore* SaveGame = NewObject<USaveGamePlayerScore>();
+	TestFalse(TEXT("Scores migrated"), SaveGame->InitializeScoreStore(FilePath));
+	TestTrue(TEXT("Score added to the slot"), SaveGame->AddPlayerScoreInstance(MakeScore(0)));
+	TestTrue(TEXT("Score added to the slot"), SaveGame->AddPlayerScoreInstance(MakeScore(1)));
+	TestFalse(TEXT("Duplicate score added"), SaveGame->AddPlayerScoreInstance(MakeScore(1)));
+	TestFalse(TEXT("Store loaded again"), SaveGame->InitializeScoreStore(FilePath));
+
+	TestEqual(TEXT("Num scores"), SaveGame->GetPlayerScores().Num(), 2);
+	TestEqual(TEXT("Num unsaved scores"), SaveGame->GetPlayerScores_UnsavedToDatabase().Num(), 2);
+	const FPlayerScore* MostRecent = SaveGame->GetMostRecentPlayerScore();
+	if (TestNotNull(TEXT("Most recent score"), MostRecent))
+	{
+		TestEqual(TEXT("Most recent score time"), MostRecent->Time, MakeScore(1).Time);
+	}
+	TestTrue(TEXT("Scores marked saved"), SaveGame->SetAllScoresSavedToDatabase());
+	TestEqual(TEXT("Num unsaved scores"), SaveGame->GetPlayerScores_UnsavedToDatabase().Num(), 0);
+
+	TArray<uint8> FileData;
+	FFileHelper::LoadFileToArray(FileData, *FilePath);
+	TestTrue(TEXT("Corrupt file unchanged"), FileData == CorruptData);
+
+	// Once the file is readable again, the scores added to the slot are moved into the store
+	IFileManager::Get().Delete(*FilePath);
+	USaveGamePlayerScore* NextSessionSaveGame = NewObject<USaveGamePlayerScore>();
+	NextSessionSaveGame->AddPlayerScoreInstance(MakeScore(2));
+	TestTrue(TEXT("Scores migrated"), NextSessionSaveGame->InitializeScoreStore(FilePath));
+	TestFalse(TEXT("Score added to the slot"), NextSessionSaveGame->AddPlayerScoreInstance(MakeScore(3)));
+
+	FPlayerScoreStore ReloadedStore(FilePath);
+	TestTrue(TEXT("Store loaded"), ReloadedStore.Load());
+	TestEqual(TEXT("Num stored scores"), ReloadedStore.GetScores().Num(), 2);
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
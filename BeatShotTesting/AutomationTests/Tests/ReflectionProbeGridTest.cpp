@@ -0,0 +1,167 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Audio/BSReflectionProbeGrid.h"
+
+/** Verifies that the probe grid stores exact reflections at the probes, interpolates between them close to live
+ *  traces, and refuses queries it can't answer. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionProbeGridTest, "Audio.ReflectionProbeGrid",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FReflectionProbeGridTest::RunTest(const FString& Parameters)
+{
+	// The inside of a closed room like the shooting range, divided by a thin wall halfway between two planes of probes
+	const FBox Room(FVector(-1000.0, -1000.0, 0.0), FVector(1000.0, 1000.0, 600.0));
+	const FBox ProbeBounds(FVector(-900.0, -900.0, 50.0), FVector(900.0, 900.0, 550.0));
+	constexpr double WallX = 50.0;
+	constexpr float ProbeSpacing = 100.f;
+	constexpr int32 NumValidationSamples = 2000;
+
+	auto TraceRoom = [&Room](const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		OutHit = FHitResult(Start, End);
+		FVector Direction;
+		double Length;
+		(End - Start).ToDirectionAndLength(Direction, Length);
+
+		double Distance = UE_BIG_NUMBER;
+		FVector Normal = FVector::ZeroVector;
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			if (FMath::IsNearlyZero(Direction[Axis]))
+			{
+				continue;
+			}
+			const double Wall = Direction[Axis] > 0.0 ? Room.Max[Axis] : Room.Min[Axis];
+			const double AxisDistance = (Wall - Start[Axis]) / Direction[Axis];
+			if (AxisDistance < Distance)
+			{
+				Distance = AxisDistance;
+				Normal = FVector::ZeroVector;
+				Normal[Axis] = Direction[Axis] > 0.0 ? -1.0 : 1.0;
+			}
+		}
+		if (Distance > Length)
+		{
+			return false;
+		}
+
+		OutHit.bBlockingHit = true;
+		OutHit.Distance = Distance;
+		OutHit.Time = Distance / Length;
+		OutHit.Location = Start + Direction * Distance;
+		OutHit.ImpactPoint = OutHit.Location;
+		OutHit.Normal = Normal;
+		OutHit.ImpactNormal = Normal;
+		return true;
+	};
+	auto TraceDividedRoom = [&TraceRoom](const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		const bool bHit = TraceRoom(Start, End, OutHit);
+		const double StartSide = Start.X - WallX;
+		const double EndSide = End.X - WallX;
+		if (StartSide * EndSide >= 0.0)
+		{
+			return bHit;
+		}
+		const double Time = StartSide / (StartSide - EndSide);
+		if (bHit && OutHit.Time <= Time)
+		{
+			return true;
+		}
+
+		const FVector Normal(StartSide > 0.0 ? 1.0 : -1.0, 0.0, 0.0);
+		OutHit = FHitResult(Start, End);
+		OutHit.bBlockingHit = true;
+		OutHit.Time = Time;
+		OutHit.Distance = (End - Start).Length() * Time;
+		OutHit.Location = Start + (End - Start) * Time;
+		OutHit.ImpactPoint = OutHit.Location;
+		OutHit.Normal = Normal;
+		OutHit.ImpactNormal = Normal;
+		return true;
+	};
+	auto MakeGrid = [&ProbeBounds]
+	{
+		UBSReflectionProbeGrid* NewGrid = NewObject<UBSReflectionProbeGrid>();
+		NewGrid->Bounds = ProbeBounds;
+		NewGrid->ProbeSpacing = ProbeSpacing;
+		return NewGrid;
+	};
+
+	UBSReflectionProbeGrid* Grid = MakeGrid();
+	FHitResult Hit;
+	TestFalse(TEXT("Not baked"), Grid->IsBaked());
+	TestFalse(TEXT("Unbaked grid can't answer"), Grid->Trace(FVector(0.0, 0.0, 300.0), FVector(0.0, 0.0, 0.0),
+		Hit));
+
+	Grid->Bake(TraceRoom);
+	TestTrue(TEXT("Baked"), Grid->IsBaked());
+
+	// Probes store their own reflections up to the precision of the encoding
+	const FVector ProbeLocation = ProbeBounds.Min + FVector(3.0, 5.0, 2.0) * ProbeSpacing;
+	for (const FVector& Direction : UBSReflectionProbeGrid::GetDirections())
+	{
+		FHitResult Expected;
+		TraceRoom(ProbeLocation, ProbeLocation + Direction * Grid->MaxDistance, Expected);
+		if (!TestTrue(TEXT("Probe answers"), Grid->Trace(ProbeLocation, ProbeLocation + Direction * Grid->MaxDistance,
+			Hit)))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Probe hit"), Hit.bBlockingHit, Expected.bBlockingHit);
+		TestNearlyEqual(TEXT("Probe distance"), Hit.Distance, Expected.Distance, 0.5f);
+		TestTrue(TEXT("Probe normal"), Hit.ImpactNormal.Equals(Expected.ImpactNormal, 0.02));
+	}
+
+	TestFalse(TEXT("Outside of the grid"), Grid->Trace(FVector(950.0, 0.0, 300.0), FVector(2000.0, 0.0, 300.0), Hit));
+	TestTrue(TEXT("Short trace answered"), Grid->Trace(FVector(0.0, 0.0, 300.0), FVector(0.0, 0.0, 200.0), Hit));
+	TestFalse(TEXT("Short trace misses"), Hit.bBlockingHit);
+
+	// Interpolated reflections from anywhere inside the grid
+	const FBSReflectionProbeValidation Validation = Grid->Validate(TraceRoom, NumValidationSamples, 43);
+	TestEqual(TEXT("None skipped"), Validation.NumSkipped, 0);
+	TestTrue(TEXT("Few hit mismatches"), Validation.NumHitMismatches <= NumValidationSamples / 100);
+	TestTrue(TEXT("Mean distance error"), Validation.MeanDistanceError < 150.0);
+	AddInfo(FString::Printf(TEXT("%d hit mismatches, distance error mean %.1f, median %.1f, max %.1f"),
+		Validation.NumHitMismatches, Validation.MeanDistanceError, Validation.MedianDistanceError,
+		Validation.MaxDistanceError));
+
+	// Changing the settings requires baking again
+	Grid->ProbeSpacing = ProbeSpacing * 2.f;
+	TestFalse(TEXT("Not baked after changing spacing"), Grid->IsBaked());
+
+	// Probes inside geometry are ignored
+	UBSReflectionProbeGrid* SolidGrid = MakeGrid();
+	SolidGrid->Bake([&TraceRoom](const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		const bool bHit = TraceRoom(Start, End, OutHit);
+		OutHit.bStartPenetrating = Start.X > 0.0;
+		return bHit || OutHit.bStartPenetrating;
+	});
+	TestTrue(TEXT("Open side answered"), SolidGrid->Trace(FVector(-500.0, 0.0, 300.0), FVector(-500.0, 0.0, 0.0),
+		Hit));
+	TestFalse(TEXT("Solid side not answered"), SolidGrid->Trace(FVector(500.0, 0.0, 300.0),
+		FVector(500.0, 0.0, 0.0), Hit));
+
+	// Probes on the other side of the surface a trace starts on are ignored
+	UBSReflectionProbeGrid* DividedGrid = MakeGrid();
+	DividedGrid->Bake(TraceDividedRoom);
+	const FVector WallStart(WallX, 0.0, 300.0);
+	const FVector WallEnd = WallStart - FVector(DividedGrid->MaxDistance, 0.0, 0.0);
+	const FVector WallNormal(-1.0, 0.0, 0.0);
+	if (TestTrue(TEXT("Trace from wall answered"), DividedGrid->Trace(WallStart, WallEnd, Hit, WallNormal)))
+	{
+		TestTrue(TEXT("Trace from wall hit"), Hit.bBlockingHit);
+		TestNearlyEqual(TEXT("Trace from wall distance"), Hit.Distance, WallX - Room.Min.X, 150.0);
+	}
+
+	// Only queries on the channel the grid stands in for can be answered
+	TestTrue(TEXT("Answered channel"), UBSReflectionProbeGrid::CanAnswer(ECC_Visibility,
+		FCollisionQueryParams::DefaultQueryParam));
+	TestFalse(TEXT("Other channel"), UBSReflectionProbeGrid::CanAnswer(ECC_Camera,
+		FCollisionQueryParams::DefaultQueryParam));
+	return true;
+}
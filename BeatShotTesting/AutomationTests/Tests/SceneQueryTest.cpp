@@ -0,0 +1,123 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Physics/BSSceneQuerySubsystem.h"
+
+/** Verifies that duplicate rays are merged, that queries are issued in order of their remaining latency tolerance
+ *  within the budget, and that queries are dropped once they exceed their latency tolerance. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneQueryBatchTest, "Physics.SceneQuery.Batch",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FSceneQueryBatchTest::RunTest(const FString& Parameters)
+{
+	constexpr double MergeTolerance = 1.0;
+	const FVector Start(0.0, 0.0, 100.0);
+	const FVector End(4000.0, 0.0, 100.0);
+	TArray<int32> Delivered;
+	FBSSceneQueryBatch Batch;
+
+	auto MakeQuery = [](const FVector& QueryStart, const FVector& QueryEnd, const int32 LatencyTolerance = 2)
+	{
+		FBSSceneQuery Query;
+		Query.Start = QueryStart;
+		Query.End = QueryEnd;
+		Query.LatencyTolerance = LatencyTolerance;
+		return Query;
+	};
+	auto MakeDelegate = [&Delivered](const int32 ID)
+	{
+		return FBSSceneQueryDelegate::CreateLambda([&Delivered, ID](const FHitResult&) { Delivered.Add(ID); });
+	};
+	auto DeliverAll = [](const TArray<FBSPendingSceneQuery>& Queries)
+	{
+		for (const FBSPendingSceneQuery& Query : Queries)
+		{
+			for (const FBSSceneQueryDelegate& Delegate : Query.Delegates)
+			{
+				Delegate.ExecuteIfBound(FHitResult());
+			}
+		}
+	};
+
+	// Merging
+	TestFalse(TEXT("First query"), Batch.Add(MakeQuery(Start, End), MakeDelegate(0), 10, MergeTolerance));
+	TestTrue(TEXT("Same ray merged"), Batch.Add(MakeQuery(Start, End), MakeDelegate(1), 10,
+		MergeTolerance));
+	TestTrue(TEXT("Nearly the same ray merged"), Batch.Add(MakeQuery(Start + FVector(0.1), End - FVector(0.1)),
+		MakeDelegate(2), 10, MergeTolerance));
+	TestFalse(TEXT("Different end"), Batch.Add(MakeQuery(Start, End + FVector(0.0, 50.0, 0.0)),
+		MakeDelegate(3), 10, MergeTolerance));
+
+	FBSSceneQuery OtherChannel = MakeQuery(Start, End);
+	OtherChannel.Channel = ECC_Camera;
+	TestFalse(TEXT("Different channel"), Batch.Add(OtherChannel, MakeDelegate(4), 10, MergeTolerance));
+
+	FBSSceneQuery OtherParams = MakeQuery(Start, End);
+	OtherParams.Params.bReturnPhysicalMaterial = true;
+	TestFalse(TEXT("Different params"), Batch.Add(OtherParams, MakeDelegate(5), 10, MergeTolerance));
+
+	FBSSceneQuery IgnoreBlocks = MakeQuery(Start, End);
+	IgnoreBlocks.Params.bIgnoreBlocks = true;
+	TestFalse(TEXT("Different bIgnoreBlocks"), Batch.Add(IgnoreBlocks, MakeDelegate(6), 10,
+		MergeTolerance));
+
+	FBSSceneQuery StaticOnly = MakeQuery(Start, End);
+	StaticOnly.Params.MobilityType = EQueryMobilityType::Static;
+	TestFalse(TEXT("Different MobilityType"), Batch.Add(StaticOnly, MakeDelegate(7), 10, MergeTolerance));
+	TestEqual(TEXT("Num pending"), Batch.Num(), 6);
+
+	TArray<FBSPendingSceneQuery> Queries;
+	TestEqual(TEXT("None dropped"), Batch.Take(MAX_int32, 10, Queries), 0);
+	TestEqual(TEXT("All taken"), Queries.Num(), 6);
+	TestEqual(TEXT("Merged delegates"), Queries[0].Delegates.Num(), 3);
+	DeliverAll(Queries);
+	TestTrue(TEXT("Every delegate called"), Delivered == TArray<int32>({0, 1, 2, 3, 4, 5, 6, 7}));
+	TestEqual(TEXT("Batch empty"), Batch.Num(), 0);
+
+	// Budget and latency tolerance
+	Delivered.Reset();
+	Queries.Reset();
+	Batch.Add(MakeQuery(Start, End, 5), MakeDelegate(0), 10, MergeTolerance);
+	Batch.Add(MakeQuery(Start, End * 2.0, 1), MakeDelegate(1), 10, MergeTolerance);
+	Batch.Add(MakeQuery(Start, End * 3.0, -1), MakeDelegate(2), 10, MergeTolerance);
+	Batch.Add(MakeQuery(Start, End * 4.0, 0), MakeDelegate(3), 10, MergeTolerance);
+
+	TestEqual(TEXT("None dropped within tolerance"), Batch.Take(2, 10, Queries), 0);
+	DeliverAll(Queries);
+	TestTrue(TEXT("Least tolerance issued first"), Delivered == TArray<int32>({3, 1}));
+
+	Delivered.Reset();
+	Queries.Reset();
+	TestEqual(TEXT("None dropped with budget exhausted"), Batch.Take(0, 11, Queries), 0);
+	TestEqual(TEXT("Nothing issued with budget exhausted"), Queries.Num(), 0);
+
+	TestEqual(TEXT("Dropped past tolerance"), Batch.Take(MAX_int32, 16, Queries), 1);
+	DeliverAll(Queries);
+	TestTrue(TEXT("Never dropped"), Delivered == TArray<int32>({2}));
+
+	// A merged query keeps the least latency tolerance
+	Delivered.Reset();
+	Queries.Reset();
+	Batch.Add(MakeQuery(Start, End, 10), MakeDelegate(0), 20, MergeTolerance);
+	Batch.Add(MakeQuery(Start, End, 1), MakeDelegate(1), 20, MergeTolerance);
+	TestEqual(TEXT("Merged query dropped"), Batch.Take(MAX_int32, 22, Queries), 1);
+	TestEqual(TEXT("Merged query not delivered"), Delivered.Num(), 0);
+
+	// A query that is never dropped is issued ahead of newer queries once it has waited long enough
+	Delivered.Reset();
+	Queries.Reset();
+	Batch.Reset();
+	constexpr uint64 FirstFrame = 30;
+	Batch.Add(MakeQuery(Start, End, -1), MakeDelegate(-1), FirstFrame, MergeTolerance);
+	for (int32 i = 0; i <= FBSSceneQueryBatch::NeverDropPriorityLatency && !Delivered.Contains(-1); i++)
+	{
+		Batch.Add(MakeQuery(Start, End * (i + 2.0), 2), MakeDelegate(i), FirstFrame + i, MergeTolerance);
+		Queries.Reset();
+		Batch.Take(1, FirstFrame + i, Queries);
+		DeliverAll(Queries);
+	}
+	TestTrue(TEXT("Never dropped query not starved"), Delivered.Contains(-1));
+	return true;
+}
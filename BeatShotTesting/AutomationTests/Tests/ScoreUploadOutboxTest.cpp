@@ -0,0 +1,117 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "BSConstants.h"
+#include "BSMockBackend.h"
+#include "ScoreUploadOutbox.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "SaveGames/PlayerScoreStore.h"
+
+/** Verifies that flushing the outbox uploads every pending score through the mock backend in batches, and that a
+ *  rejected compressed batch is sent again uncompressed. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScoreUploadOutboxFlushTest, "Http.ScoreUploadOutbox.Flush",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FScoreUploadOutboxFlushTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FBSMockBackend> MockBackend = FBSMockBackend::Start(30312);
+	if (!TestNotNull(TEXT("Started mock backend"), MockBackend.Get()))
+	{
+		return false;
+	}
+	MockBackend->FailNextRequests(1, 415);
+	AddExpectedError(TEXT("Compressed score upload rejected"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	const int32 NumScores = Constants::ScoreUploadBatchSize + 50;
+	TArray<FPlayerScore> Scores;
+	for (int32 i = 0; i < NumScores; i++)
+	{
+		FPlayerScore& Score = Scores.AddDefaulted_GetRef();
+		Score.Time = (FDateTime(2023, 1, 1) + FTimespan::FromMinutes(i)).ToIso8601();
+	}
+	Scores[0].bSavedToDatabase = true;
+
+	const FString UserID = FBSMockBackend::GetUserID(TEXT("MockUser"));
+	const TSharedRef<FScoreUploadOutbox, ESPMode::ThreadSafe> Outbox = MakeShared<FScoreUploadOutbox,
+		ESPMode::ThreadSafe>(UserID, [](TFunction<void(const FString&)> OnAccessToken)
+	{
+		OnAccessToken(FBSMockBackend::AccessToken);
+	}, Constants::Segment_ApiProfile, true);
+	TestEqual(TEXT("Enqueued unsaved scores"), Outbox->Enqueue(Scores), NumScores - 1);
+	TestEqual(TEXT("Enqueued duplicate scores"), Outbox->Enqueue(Scores), 0);
+
+	const TSharedRef<int32> NumAcknowledged = MakeShared<int32>(0);
+	Outbox->OnScoresAcknowledged = [NumAcknowledged](const TArray<FString>& Times) { *NumAcknowledged += Times.Num(); };
+	const TSharedRef<TArray<bool>> FlushResults = MakeShared<TArray<bool>>();
+	Outbox->Flush([FlushResults](const bool bSucceeded) { FlushResults->Add(bSucceeded); });
+
+	const double StartTime = FPlatformTime::Seconds();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([=, this]()
+	{
+		if (FlushResults->IsEmpty() && FPlatformTime::Seconds() - StartTime < 20.0)
+		{
+			return false;
+		}
+		TestTrue(TEXT("Flush succeeded"), FlushResults->Num() == 1 && (*FlushResults)[0]);
+		TestEqual(TEXT("Num pending"), Outbox->GetNumPending(), 0);
+		TestEqual(TEXT("Num acknowledged"), *NumAcknowledged, NumScores - 1);
+		TestEqual(TEXT("Num scores saved"), MockBackend->GetScores(UserID).Num(), NumScores - 1);
+
+		const TArray<FBSMockBackendRequest>& Requests = MockBackend->GetCapturedRequests();
+		if (TestEqual(TEXT("Num requests"), Requests.Num(), 3))
+		{
+			TestEqual(TEXT("Compressed"), Requests[0].Headers.FindRef(TEXT("Content-Encoding")), TEXT("gzip"));
+			TestEqual(TEXT("Compressed rejected"), Requests[0].ResponseCode, 415);
+			TestEqual(TEXT("Resent uncompressed"), Requests[1].Headers.FindRef(TEXT("Content-Encoding")), TEXT(""));
+			TestEqual(TEXT("Second batch uncompressed"), Requests[2].Headers.FindRef(TEXT("Content-Encoding")),
+				TEXT(""));
+		}
+		FBSMockBackend::Stop();
+		return true;
+	}));
+	return true;
+}
+
+/** Verifies that scores acknowledged by the database are marked individually and stay marked after reloading. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScoreUploadOutboxAcknowledgeTest, "Http.ScoreUploadOutbox.Acknowledge",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FScoreUploadOutboxAcknowledgeTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("ScoreUploadOutboxTest.log"));
+	IFileManager::Get().Delete(*FilePath);
+
+	TArray<FPlayerScore> Scores;
+	TArray<FString> Acknowledged;
+	for (int32 i = 0; i < 10; i++)
+	{
+		FPlayerScore& Score = Scores.AddDefaulted_GetRef();
+		Score.Time = (FDateTime(2023, 1, 1) + FTimespan::FromMinutes(i)).ToIso8601();
+		if (i % 2 == 0)
+		{
+			Acknowledged.Add(Score.Time);
+		}
+	}
+	{
+		FPlayerScoreStore Store(FilePath);
+		Store.Import(Scores);
+		Store.MarkSavedToDatabase(Acknowledged);
+		TestEqual(TEXT("Unsaved after acknowledgement"), Store.GetScores_UnsavedToDatabase().Num(), 5);
+	}
+
+	FPlayerScoreStore Reloaded(FilePath);
+	TestTrue(TEXT("Reloaded"), Reloaded.Load());
+	const TArray<FPlayerScore> Unsaved = Reloaded.GetScores_UnsavedToDatabase();
+	TestEqual(TEXT("Unsaved after reload"), Unsaved.Num(), 5);
+	for (const FPlayerScore& Score : Unsaved)
+	{
+		TestFalse(TEXT("Acknowledged score is saved"), Acknowledged.Contains(Score.Time));
+	}
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
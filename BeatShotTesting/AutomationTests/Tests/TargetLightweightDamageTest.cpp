@@ -0,0 +1,64 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Target/Target.h"
+
+/** Verifies that only one-hit targets that only take hit damage and never change immunity use lightweight damage. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetLightweightDamageTest, "Target.LightweightDamage",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FTargetLightweightDamageTest::RunTest(const FString& Parameters)
+{
+	// A one-hit target without any immunity responses
+	FBS_TargetConfig OneHitConfig;
+	OneHitConfig.TargetDamageType = ETargetDamageType::Hit;
+	OneHitConfig.MaxHealth = 100.f;
+	OneHitConfig.BasePlayerHitDamage = 100.f;
+	OneHitConfig.TargetActivationResponses = {ETargetActivationResponse::ChangeVelocity};
+	OneHitConfig.TargetDeactivationConditions = {ETargetDeactivationCondition::OnAnyExternalDamageTaken};
+	OneHitConfig.TargetDeactivationResponses = {ETargetDeactivationResponse::Destroy};
+	OneHitConfig.TargetDestructionConditions = {ETargetDestructionCondition::OnExpiration};
+	TestTrue(TEXT("One-hit target"), ATarget::CanUseLightweightDamage(OneHitConfig));
+
+	FBS_TargetConfig Config = OneHitConfig;
+	Config.BasePlayerHitDamage = 200.f;
+	TestTrue(TEXT("More damage than health"), ATarget::CanUseLightweightDamage(Config));
+
+	Config = OneHitConfig;
+	Config.BasePlayerHitDamage = 50.f;
+	TestFalse(TEXT("Multiple hits"), ATarget::CanUseLightweightDamage(Config));
+
+	Config = OneHitConfig;
+	Config.MaxHealth = 0.f;
+	TestFalse(TEXT("Unlimited health"), ATarget::CanUseLightweightDamage(Config));
+
+	for (const ETargetDamageType DamageType : {ETargetDamageType::Tracking, ETargetDamageType::Combined})
+	{
+		Config = OneHitConfig;
+		Config.TargetDamageType = DamageType;
+		TestFalse(TEXT("Tracking damage"), ATarget::CanUseLightweightDamage(Config));
+	}
+
+	Config = OneHitConfig;
+	Config.TargetSpawnResponses = {ETargetSpawnResponse::AddImmunity};
+	TestFalse(TEXT("Spawn immunity"), ATarget::CanUseLightweightDamage(Config));
+
+	for (const ETargetActivationResponse Response : {ETargetActivationResponse::AddImmunity,
+		ETargetActivationResponse::RemoveImmunity, ETargetActivationResponse::ToggleImmunity})
+	{
+		Config = OneHitConfig;
+		Config.TargetActivationResponses.Add(Response);
+		TestFalse(TEXT("Activation immunity"), ATarget::CanUseLightweightDamage(Config));
+	}
+
+	for (const ETargetDeactivationResponse Response : {ETargetDeactivationResponse::AddImmunity,
+		ETargetDeactivationResponse::RemoveImmunity, ETargetDeactivationResponse::ToggleImmunity})
+	{
+		Config = OneHitConfig;
+		Config.TargetDeactivationResponses.Add(Response);
+		TestFalse(TEXT("Deactivation immunity"), ATarget::CanUseLightweightDamage(Config));
+	}
+	return true;
+}
@@ -0,0 +1,107 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Target/TargetQuerySubsystem.h"
+
+/** Verifies that the vectorized raycast finds the same nearest sphere as a scalar ray-sphere intersection, that rays
+ *  starting inside a sphere hit it at zero, and that ignored, moved, and removed spheres are respected. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetQuerySphereRaycastTest, "Target.Query.SphereRaycast",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FTargetQuerySphereRaycastTest::RunTest(const FString& Parameters)
+{
+	constexpr double MaxDistance = 10000.0;
+	FRandomStream Stream(41);
+	TArray<FSphere> Spheres;
+	FTargetSphereSet SphereSet;
+	for (int32 i = 0; i < 61; i++)
+	{
+		const FSphere& Sphere = Spheres.Emplace_GetRef(FVector(Stream.FRandRange(2000.0, 4000.0),
+			Stream.FRandRange(-1500.0, 1500.0), Stream.FRandRange(-800.0, 800.0)), Stream.FRandRange(15.0, 120.0));
+		SphereSet.Add(Sphere.Center, Sphere.W);
+	}
+	TestEqual(TEXT("Num spheres"), SphereSet.Num(), Spheres.Num());
+
+	int32 NumHits = 0;
+	int32 NumGrazing = 0;
+	for (int32 i = 0; i < 5000; i++)
+	{
+		const FVector Origin(Stream.FRandRange(-200.0, 200.0), Stream.FRandRange(-200.0, 200.0), 0.0);
+		const FVector Direction = FVector(1.0, Stream.FRandRange(-0.5, 0.5), Stream.FRandRange(-0.3, 0.3)).
+			GetSafeNormal();
+		int32 ExpectedIndex = INDEX_NONE;
+		double Expected = MaxDistance;
+		for (int32 j = 0; j < Spheres.Num(); j++)
+		{
+			const FVector ToCenter = Spheres[j].Center - Origin;
+			const double Closest = ToCenter | Direction;
+			const double HalfChordSquared = FMath::Square(Spheres[j].W) - (ToCenter.SizeSquared() - Closest * Closest);
+			const double Distance = Closest - FMath::Sqrt(FMath::Max(HalfChordSquared, 0.0));
+			if (HalfChordSquared >= 0.0 && Distance >= 0.0 && Distance <= Expected)
+			{
+				ExpectedIndex = j;
+				Expected = Distance;
+			}
+		}
+
+		double Actual;
+		const int32 ActualIndex = SphereSet.Raycast(Origin, Direction, MaxDistance, Actual);
+		if (ExpectedIndex == ActualIndex && FMath::IsNearlyEqual(Expected, Actual, 0.05))
+		{
+			NumHits += ActualIndex != INDEX_NONE;
+			continue;
+		}
+
+		// Float and double precision may disagree on rays that pass close to the edge of a sphere
+		const int32 GrazedIndex = ExpectedIndex != INDEX_NONE ? ExpectedIndex : ActualIndex;
+		const FVector ToCenter = Spheres[GrazedIndex].Center - Origin;
+		if (FMath::Abs((ToCenter - (ToCenter | Direction) * Direction).Size() - Spheres[GrazedIndex].W) < 1.0)
+		{
+			NumGrazing++;
+			continue;
+		}
+		AddError(FString::Printf(TEXT("Ray %d: expected sphere %d at %f, found sphere %d at %f"), i, ExpectedIndex,
+			Expected, ActualIndex, Actual));
+		return false;
+	}
+	TestTrue(TEXT("Some rays hit"), NumHits > 0 && NumHits < 5000);
+	TestTrue(TEXT("Few grazing rays"), NumGrazing < 5);
+
+	// Three spheres in a row along the X axis
+	SphereSet.Reset();
+	for (int32 i = 1; i <= 3; i++)
+	{
+		SphereSet.Add(FVector(i * 1000.0, 0.0, 0.0), 50.f);
+	}
+	double Distance;
+	TestEqual(TEXT("Nearest"), SphereSet.Raycast(FVector::ZeroVector, FVector::ForwardVector, MaxDistance, Distance),
+		0);
+	TestEqual(TEXT("Nearest distance"), Distance, 950.0, 0.01);
+	TestEqual(TEXT("Ignored"), SphereSet.Raycast(FVector::ZeroVector, FVector::ForwardVector, MaxDistance, Distance,
+		TSet<int32>{0}), 1);
+	TestEqual(TEXT("Origin inside sphere"), SphereSet.Raycast(FVector(1010.0, 0.0, 0.0), FVector::ForwardVector,
+		MaxDistance, Distance), 0);
+	TestEqual(TEXT("Origin inside sphere distance"), Distance, 0.0);
+	TestEqual(TEXT("Origin past sphere"), SphereSet.Raycast(FVector(1100.0, 0.0, 0.0), FVector::ForwardVector, 500.0,
+		Distance), INDEX_NONE);
+
+	SphereSet.Set(0, FVector(1000.0, 0.0, 0.0), -1.f);
+	TestEqual(TEXT("Disabled"), SphereSet.Raycast(FVector::ZeroVector, FVector::ForwardVector, MaxDistance, Distance),
+		1);
+	SphereSet.Set(0, FVector(500.0, 0.0, 0.0), 50.f);
+	TestEqual(TEXT("Moved"), SphereSet.Raycast(FVector::ZeroVector, FVector::ForwardVector, MaxDistance, Distance), 0);
+	TestEqual(TEXT("Moved distance"), Distance, 450.0, 0.01);
+
+	// The last sphere takes the place of a removed sphere
+	SphereSet.RemoveAtSwap(0);
+	TestEqual(TEXT("Num after removal"), SphereSet.Num(), 2);
+	TestEqual(TEXT("Moved into removed index"), SphereSet.Raycast(FVector(2500.0, 0.0, 0.0), FVector::ForwardVector,
+		MaxDistance, Distance), 0);
+
+	SphereSet.Reset();
+	TestEqual(TEXT("Empty"), SphereSet.Raycast(FVector::ZeroVector, FVector::ForwardVector, MaxDistance, Distance),
+		INDEX_NONE);
+	return true;
+}
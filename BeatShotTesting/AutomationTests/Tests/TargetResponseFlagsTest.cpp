@@ -0,0 +1,139 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "../TestBase/TargetManagerTestBase.h"
+#include "BSGameModeConfig/BSGameModeDataAsset.h"
+#include "BSGameModeConfig/TargetResponseFlags.h"
+
+/** Verifies that the compiled response flags give the same results as searching the response and condition arrays,
+ *  for every default game mode and for random configs. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetResponseFlagsTest, "TargetManager.ResponseFlags",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FTargetResponseFlagsTest::RunTest(const FString& Parameters)
+{
+	const UBSGameModeDataAsset* GameModeDataAsset = Cast<UBSGameModeDataAsset>(StaticLoadObject(
+		UBSGameModeDataAsset::StaticClass(), nullptr, TargetManagerTestHelpers::DefaultGameModeDataAssetPath));
+	if (!TestNotNull(TEXT("Default game modes"), GameModeDataAsset))
+	{
+		return false;
+	}
+
+	// The array based ShouldDeactivateTarget and ShouldDestroyTarget that the flags replaced
+	auto ShouldDeactivate = [](const FBS_TargetConfig& Config, const bool bExpired, const float CurrentHealth,
+		const float DeactivationThreshold)
+	{
+		const TArray<ETargetDeactivationCondition>& Conditions = Config.TargetDeactivationConditions;
+		if (bExpired && Conditions.Contains(ETargetDeactivationCondition::OnExpiration))
+		{
+			return true;
+		}
+		if (CurrentHealth <= 0.f && Conditions.Contains(ETargetDeactivationCondition::OnHealthReachedZero))
+		{
+			return true;
+		}
+		if (CurrentHealth <= DeactivationThreshold && Conditions.Contains(
+			ETargetDeactivationCondition::OnSpecificHealthLost))
+		{
+			return true;
+		}
+		return !bExpired && Conditions.Contains(ETargetDeactivationCondition::OnAnyExternalDamageTaken);
+	};
+	auto ShouldDestroy = [](const FBS_TargetConfig& Config, const bool bExpired, const bool bOutOfHealth)
+	{
+		const TArray<ETargetDestructionCondition>& Conditions = Config.TargetDestructionConditions;
+		if (Config.TargetDeactivationResponses.Contains(ETargetDeactivationResponse::Destroy) || Conditions.Contains(
+			ETargetDestructionCondition::OnDeactivation))
+		{
+			return true;
+		}
+		if (bExpired && Conditions.Contains(ETargetDestructionCondition::OnExpiration))
+		{
+			return true;
+		}
+		if (bOutOfHealth && Conditions.Contains(ETargetDestructionCondition::OnHealthReachedZero))
+		{
+			return true;
+		}
+		return !bExpired && Conditions.Contains(ETargetDestructionCondition::OnAnyExternalDamageTaken);
+	};
+
+	// Whether Flags contains exactly the values in Array, including None and deprecated values
+	auto HasSameValues = [](const auto& Flags, const auto& Array)
+	{
+		using EnumType = typename TDecay<decltype(Array)>::Type::ElementType;
+		for (int64 Value = 0; Value <= StaticEnum<EnumType>()->GetMaxEnumValue(); Value++)
+		{
+			if (Flags.Contains(static_cast<EnumType>(Value)) != Array.Contains(static_cast<EnumType>(Value)))
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	// Random subsets of the values of each enum, possibly with duplicates
+	const FRandomStream Stream(44);
+	auto AddRandomValues = [&Stream](auto& Array)
+	{
+		using EnumType = typename TDecay<decltype(Array)>::Type::ElementType;
+		const int32 MaxValue = StaticEnum<EnumType>()->GetMaxEnumValue() - 1;
+		const int32 Num = Stream.RandRange(0, MaxValue + 1);
+		for (int32 i = 0; i < Num; i++)
+		{
+			Array.Add(static_cast<EnumType>(Stream.RandRange(0, MaxValue)));
+		}
+	};
+
+	TArray<TPair<FString, FBS_TargetConfig>> Configs;
+	for (const auto& Mode : GameModeDataAsset->GetGameModesMap())
+	{
+		Configs.Emplace(FString::Printf(TEXT("%s %s"), *UEnum::GetDisplayValueAsText(Mode.Key.BaseGameMode).ToString(),
+			*UEnum::GetDisplayValueAsText(Mode.Key.Difficulty).ToString()), Mode.Value.TargetConfig);
+	}
+	for (int32 i = 0; i < 200; i++)
+	{
+		FBS_TargetConfig& Config = Configs.Emplace_GetRef(FString::Printf(TEXT("Random %d"), i), FBS_TargetConfig()).
+			Value;
+		AddRandomValues(Config.TargetActivationResponses);
+		AddRandomValues(Config.TargetDeactivationConditions);
+		AddRandomValues(Config.TargetDeactivationResponses);
+		AddRandomValues(Config.TargetDestructionConditions);
+	}
+
+	for (const TPair<FString, FBS_TargetConfig>& Pair : Configs)
+	{
+		const FBS_TargetConfig& Config = Pair.Value;
+		const FBS_TargetResponseFlags Flags(Config);
+
+		TestTrue(Pair.Key + TEXT(" activation responses"), HasSameValues(Flags.ActivationResponses,
+			Config.TargetActivationResponses));
+		TestTrue(Pair.Key + TEXT(" deactivation conditions"), HasSameValues(Flags.DeactivationConditions,
+			Config.TargetDeactivationConditions));
+		TestTrue(Pair.Key + TEXT(" deactivation responses"), HasSameValues(Flags.DeactivationResponses,
+			Config.TargetDeactivationResponses));
+		TestTrue(Pair.Key + TEXT(" destruction conditions"), HasSameValues(Flags.DestructionConditions,
+			Config.TargetDestructionConditions));
+
+		for (const bool bExpired : {false, true})
+		{
+			for (const float Health : {-50.f, 0.f, 25.f, 50.f, 100.f, 150.f})
+			{
+				for (const float Threshold : {-100.f, 0.f, 50.f, 100.f})
+				{
+					TestEqual(Pair.Key + TEXT(" should deactivate"),
+						Flags.ShouldDeactivate(bExpired, Health, Threshold),
+						ShouldDeactivate(Config, bExpired, Health, Threshold));
+				}
+			}
+			for (const bool bOutOfHealth : {false, true})
+			{
+				TestEqual(Pair.Key + TEXT(" should destroy"), Flags.ShouldDestroy(bExpired, bOutOfHealth),
+					ShouldDestroy(Config, bExpired, bOutOfHealth));
+			}
+		}
+	}
+	return true;
+}
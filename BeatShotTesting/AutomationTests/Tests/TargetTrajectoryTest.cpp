@@ -0,0 +1,110 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Target/TargetTrajectory.h"
+
+/** Verifies that analytic trajectories match a small step simulation, stay inside their bounds, and are periodic. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTargetTrajectoryTest, "Target.Trajectory",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FTargetTrajectoryTest::RunTest(const FString& Parameters)
+{
+	constexpr double SimulationTime = 10.0;
+	constexpr double Tolerance = 0.5;
+	const FBox Bounds(FVector(0.0, -1600.0, 100.0), FVector(0.0, 1600.0, 1000.0));
+
+	// Moves Location by Velocity in small steps, reflecting off the faces of Bounds like the projectile movement
+	// component bouncing off the directional boxes
+	auto Simulate = [&Bounds](FVector& Location, FVector& Velocity)
+	{
+		constexpr double Step = 1.0 / 2000.0;
+		for (double Elapsed = 0.0; Elapsed < SimulationTime; Elapsed += Step)
+		{
+			Location += Velocity * FMath::Min(Step, SimulationTime - Elapsed);
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				if (Location[Axis] < Bounds.Min[Axis])
+				{
+					Location[Axis] = 2.0 * Bounds.Min[Axis] - Location[Axis];
+					Velocity[Axis] = FMath::Abs(Velocity[Axis]);
+				}
+				else if (Location[Axis] > Bounds.Max[Axis])
+				{
+					Location[Axis] = 2.0 * Bounds.Max[Axis] - Location[Axis];
+					Velocity[Axis] = -FMath::Abs(Velocity[Axis]);
+				}
+			}
+		}
+	};
+
+	const FRandomStream Stream(47);
+	for (int32 i = 0; i < 100; i++)
+	{
+		const FVector Start(0.0, Stream.FRandRange(Bounds.Min.Y, Bounds.Max.Y),
+			Stream.FRandRange(Bounds.Min.Z, Bounds.Max.Z));
+		const FVector Direction = FVector(0.0, Stream.FRandRange(-1.0, 1.0), Stream.FRandRange(-1.0, 1.0))
+			.GetSafeNormal();
+		const FVector StartVelocity = Direction * Stream.FRandRange(200.0, 1500.0);
+		const double StartTime = Stream.FRandRange(0.0, 100.0);
+		const FTargetTrajectory Trajectory(StartTime, Start, StartVelocity, Bounds);
+
+		FVector SimulatedLocation = Start;
+		FVector SimulatedVelocity = StartVelocity;
+		Simulate(SimulatedLocation, SimulatedVelocity);
+
+		FVector Velocity;
+		const FVector Location = Trajectory.Evaluate(StartTime + SimulationTime, &Velocity);
+		TestTrue(FString::Printf(TEXT("Trajectory %d matches simulation"), i),
+			Location.Equals(SimulatedLocation, Tolerance));
+		TestTrue(FString::Printf(TEXT("Trajectory %d velocity matches simulation"), i),
+			Velocity.Equals(SimulatedVelocity, UE_KINDA_SMALL_NUMBER));
+		TestTrue(FString::Printf(TEXT("Trajectory %d stays inside bounds"), i),
+			Bounds.ExpandBy(UE_KINDA_SMALL_NUMBER).IsInsideOrOn(Location));
+		TestTrue(FString::Printf(TEXT("Trajectory %d starts at start location"), i),
+			Trajectory.Evaluate(StartTime).Equals(Start, UE_KINDA_SMALL_NUMBER));
+
+		// Each axis repeats after traveling twice the length of the box
+		const double PeriodY = 2.0 * Bounds.GetSize().Y / FMath::Abs(StartVelocity.Y);
+		TestTrue(FString::Printf(TEXT("Trajectory %d is periodic"), i), FMath::IsNearlyEqual(
+			Trajectory.Evaluate(StartTime + PeriodY).Y, Start.Y, Tolerance));
+
+		// Rewinding retraces the path in reverse
+		FVector RewoundVelocity;
+		const FVector Rewound = Trajectory.Evaluate(StartTime - SimulationTime, &RewoundVelocity);
+		FVector ReversedLocation = Start;
+		FVector ReversedVelocity = -StartVelocity;
+		Simulate(ReversedLocation, ReversedVelocity);
+		TestTrue(FString::Printf(TEXT("Trajectory %d rewinds"), i), Rewound.Equals(ReversedLocation, Tolerance));
+		TestTrue(FString::Printf(TEXT("Trajectory %d rewound velocity"), i),
+			RewoundVelocity.Equals(-ReversedVelocity, UE_KINDA_SMALL_NUMBER));
+	}
+
+	// A start location outside the bounds is clamped
+	const FTargetTrajectory Clamped(0.0, FVector(0.0, 5000.0, 0.0), FVector::ZeroVector, Bounds);
+	TestEqual(TEXT("Clamped start location"), Clamped.Evaluate(10.0), FVector(0.0, Bounds.Max.Y, Bounds.Min.Z));
+
+	// Axes without room to move keep their location and velocity
+	const FVector FlatVelocity(300.0, 0.0, 400.0);
+	FVector Velocity;
+	const FTargetTrajectory Flat(0.0, FVector(0.0, 0.0, 500.0), FlatVelocity, Bounds);
+	TestEqual(TEXT("Zero extent axis location"), Flat.Evaluate(3.0, &Velocity).X, 0.0);
+	TestEqual(TEXT("Zero extent axis velocity"), Velocity.X, FlatVelocity.X);
+
+	// Reflections are found in order, along with the face that is hit
+	const FTargetTrajectory Horizontal(0.0, FVector(0.0, 0.0, 500.0), FVector(0.0, 400.0, 0.0), Bounds);
+	FVector Normal;
+	TestNearlyEqual(TEXT("First reflection time"), Horizontal.GetNextReflectionTime(0.0, Normal), 4.0);
+	TestEqual(TEXT("First reflection normal"), Normal, FVector(0.0, -1.0, 0.0));
+	TestTrue(TEXT("First reflection location"), Horizontal.Evaluate(4.0).Equals(FVector(0.0, Bounds.Max.Y, 500.0),
+		Tolerance));
+	TestNearlyEqual(TEXT("Second reflection time"), Horizontal.GetNextReflectionTime(4.5, Normal), 12.0);
+	TestEqual(TEXT("Second reflection normal"), Normal, FVector(0.0, 1.0, 0.0));
+
+	const FTargetTrajectory Diagonal(0.0, FVector(0.0, 0.0, 500.0), FVector(0.0, 400.0, -400.0), Bounds);
+	TestNearlyEqual(TEXT("Nearest face reflects first"), Diagonal.GetNextReflectionTime(0.0, Normal), 1.0);
+	TestEqual(TEXT("Nearest face normal"), Normal, FVector(0.0, 0.0, 1.0));
+	TestEqual(TEXT("Stationary never reflects"), Clamped.GetNextReflectionTime(0.0, Normal), MAX_dbl);
+	return true;
+}
@@ -0,0 +1,136 @@
+// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "BSConstants.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Misc/AutomationTest.h"
+#include "Visualizers/VisualizerBandProcessor.h"
+
+using namespace Constants;
+
+/** Scalar reference implementation, matching the per-band loop previously inside
+ *  AVisualizerManager::UpdateVisualizers. */
+struct FVisualizerBandProcessorReference
+{
+	TArray<float> CurrentSpectrumValues;
+	TArray<float> CurrentCubeSpectrumValues;
+	TArray<float> MaxSpectrumValues;
+	TArray<float> BeamAlpha;
+	TArray<float> CubeAlpha;
+	TArray<bool> BeamTriggered;
+
+	void Init(const int32 NumBands)
+	{
+		CurrentSpectrumValues.Init(0, NumBands);
+		CurrentCubeSpectrumValues.Init(0, NumBands);
+		MaxSpectrumValues.Init(1.f, NumBands);
+		BeamAlpha.Init(0, NumBands);
+		CubeAlpha.Init(0, NumBands);
+		BeamTriggered.Init(false, NumBands);
+	}
+
+	void Process(const TArray<float>& SpectrumValues, const TArray<float>& AvgSpectrumValues)
+	{
+		for (int i = 0; i < SpectrumValues.Num(); i++)
+		{
+			BeamTriggered[i] = false;
+			if (SpectrumValues[i] > MaxSpectrumValues[i])
+			{
+				MaxSpectrumValues[i] = SpectrumValues[i];
+			}
+			if (SpectrumValues[i] > CurrentCubeSpectrumValues[i])
+			{
+				CurrentCubeSpectrumValues[i] = SpectrumValues[i];
+			}
+			if (SpectrumValues[i] > 0 && CurrentSpectrumValues[i] < 0)
+			{
+				CurrentSpectrumValues[i] = SpectrumValues[i];
+				BeamTriggered[i] = true;
+				BeamAlpha[i] = UKismetMathLibrary::MapRangeClamped(CurrentSpectrumValues[i], 0,
+					MaxSpectrumValues[i], 0, 1);
+			}
+			CubeAlpha[i] = UKismetMathLibrary::MapRangeClamped(
+				CurrentCubeSpectrumValues[i] - AvgSpectrumValues[i], 0, MaxSpectrumValues[i], 0, 1);
+			if (CurrentSpectrumValues[i] >= 0)
+			{
+				CurrentSpectrumValues[i] -= AvgSpectrumValues[i] / CurrentSpectrumValueDecrementDivide;
+			}
+			if (CurrentCubeSpectrumValues[i] >= 0)
+			{
+				CurrentCubeSpectrumValues[i] -= CurrentCubeSpectrumValueDecrement;
+			}
+			if (MaxSpectrumValues[i] >= 0)
+			{
+				MaxSpectrumValues[i] -= AvgSpectrumValues[i] / MaxSpectrumValueDecrementDivide;
+			}
+		}
+	}
+};
+
+/** Verifies that FVisualizerBandProcessor produces exactly the same output as the scalar reference for every
+ *  supported band count. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVisualizerBandProcessorTest, "Visualizers.BandProcessor",
+	EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::
+	HighPriorityAndAbove | EAutomationTestFlags::ProductFilter);
+
+bool FVisualizerBandProcessorTest::RunTest(const FString& Parameters)
+{
+	for (const int32 NumBands : {1, 3, 4, DefaultNumBandChannels, 17, DefaultMaxNumBandChannels})
+	{
+		FRandomStream Stream(NumBands);
+		FVisualizerBandProcessorReference Reference;
+		Reference.Init(NumBands);
+		FVisualizerBandProcessor Processor;
+		Processor.Init(NumBands);
+
+		TArray<float> Spectrum;
+		TArray<float> Avg;
+		Spectrum.Init(0, NumBands);
+		Avg.Init(0, NumBands);
+
+		int32 NumTriggered = 0;
+		for (int32 Frame = 0; Frame < 20000; Frame++)
+		{
+			// Every third block of 200 frames is silent, so that beams decay below zero and retrigger
+			const bool bSilent = (Frame / 200) % 3 == 2;
+			for (int i = 0; i < NumBands; i++)
+			{
+				Spectrum[i] = bSilent ? 0.f : Stream.FRandRange(0.f, 3.f);
+				Avg[i] = Stream.FRandRange(0.f, 2.f);
+			}
+			Reference.Process(Spectrum, Avg);
+			Processor.Process(Spectrum, Avg);
+
+			for (int i = 0; i < NumBands; i++)
+			{
+				if (Reference.BeamTriggered[i] != Processor.IsBeamTriggered(i))
+				{
+					AddError(FString::Printf(TEXT("NumBands %d Frame %d Band %d: BeamTriggered mismatch"), NumBands,
+						Frame, i));
+					return false;
+				}
+				if (Reference.BeamTriggered[i])
+				{
+					NumTriggered++;
+					if (Reference.BeamAlpha[i] != Processor.GetBeamAlpha(i))
+					{
+						AddError(FString::Printf(TEXT("NumBands %d Frame %d Band %d: BeamAlpha %f != %f"), NumBands,
+							Frame, i, Reference.BeamAlpha[i], Processor.GetBeamAlpha(i)));
+						return false;
+					}
+				}
+				if (Reference.CubeAlpha[i] != Processor.GetCubeAlpha(i) || Reference.MaxSpectrumValues[i] !=
+					Processor.GetMaxSpectrumValue(i) || Reference.CurrentSpectrumValues[i] != Processor.
+					GetCurrentSpectrumValue(i) || Reference.CurrentCubeSpectrumValues[i] != Processor.
+					GetCurrentCubeSpectrumValue(i))
+				{
+					AddError(FString::Printf(TEXT("NumBands %d Frame %d Band %d: state mismatch"), NumBands, Frame,
+						i));
+					return false;
+				}
+			}
+		}
+		TestTrue(FString::Printf(TEXT("NumBands %d triggered at least one beam"), NumBands), NumTriggered > 0);
+	}
+	return true;
+}
@@ -0,0 +1,13 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Assets loaded by the commandlets, which can't include the automation test headers. */
+namespace BSTestingAssetPaths
+{
+	inline const TCHAR* DefaultGameModeDataAssetPath = TEXT(
+		"/Game/Blueprints/GameModes/DA_DefaultGameModes.DA_DefaultGameModes");
+	inline const TCHAR* TargetManagerAssetPath = TEXT("/Game/Blueprints/Targets/BP_TargetManager.BP_TargetManager");
+}
@@ -10,7 +10,7 @@ public class BeatShotTesting : ModuleRules
 		PublicDependencyModuleNames.AddRange(new[]
 		{
 			"Core", "CoreUObject", "Engine", "UnrealEd", "FunctionalTesting", "BeatShot", "BeatShotGlobal",
-			"Json", "JsonUtilities"
+			"Json", "JsonUtilities", "HTTP", "GameplayAbilities"
 		});
 	}
 }
\ No newline at end of file
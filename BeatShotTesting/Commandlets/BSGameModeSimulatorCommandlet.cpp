@@ -0,0 +1,508 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#include "BSGameModeSimulatorCommandlet.h"
+#include "AbilitySystemComponent.h"
+#include "BSConstants.h"
+#include "BSGameMode.h"
+#include "BSGameModeInterface.h"
+#include "GameplayEffect.h"
+#include "PackageTools.h"
+#include "AbilitySystem/Globals/BSAttributeSetBase.h"
+#include "BSGameModeConfig/BSConfig.h"
+#include "BSGameModeConfig/BSGameModeDataAsset.h"
+#include "Misc/FileHelper.h"
+#include "SaveGames/SaveGamePlayerSettings.h"
+#include "Target/Target.h"
+#include "Target/TargetManager.h"
+#include "Utilities/BSJsonStream.h"
+#include "../BSTestingAssetPaths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBSGameModeSimulator, Log, All);
+
+namespace
+{
+	/** Number of world ticks between garbage collections. */
+	constexpr int32 TicksPerGarbageCollection = 1000;
+
+	/** Longest time to keep simulating after the last beat, for targets that never expire. */
+	constexpr float MaxTimeAfterLastBeat = 10.f;
+
+	const TCHAR* DefaultOutputFile = TEXT("Simulations/GameModeSimulation.json");
+
+	/** The set by caller magnitude of HitDamageEffect. */
+	const FName HitDamageMagnitudeName(TEXT("HitDamage"));
+
+	/** A shot the synthetic player will take at a target. */
+	struct FPendingShot
+	{
+		TWeakObjectPtr<ATarget> Target;
+		double Time;
+	};
+
+	/** Returns the value at Percentile, between 0 and 1, of sorted values. */
+	double GetPercentile(const TArray<double>& SortedValues, const double Percentile)
+	{
+		const int32 Index = FMath::CeilToInt32(Percentile * SortedValues.Num()) - 1;
+		return SortedValues[FMath::Clamp(Index, 0, SortedValues.Num() - 1)];
+	}
+}
+
+FBSSimulatorTimingStats FBSSimulatorTimingStats::FromSeconds(TArray<double> Times)
+{
+	FBSSimulatorTimingStats Stats;
+	if (Times.IsEmpty())
+	{
+		return Stats;
+	}
+
+	for (double& Time : Times)
+	{
+		Time *= 1000.0;
+		Stats.Total += Time;
+	}
+	Times.Sort();
+
+	Stats.Count = Times.Num();
+	Stats.Mean = Stats.Total / Stats.Count;
+	Stats.P50 = GetPercentile(Times, 0.5);
+	Stats.P95 = GetPercentile(Times, 0.95);
+	Stats.P99 = GetPercentile(Times, 0.99);
+	Stats.Max = Times.Last();
+	return Stats;
+}
+
+UBSGameModeSimulatorCommandlet::UBSGameModeSimulatorCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+
+	NumBeats = 200;
+	BeatInterval = 0.f;
+	BeatJitter = 0.f;
+	TickRate = 120.f;
+}
+
+int32 UBSGameModeSimulatorCommandlet::Main(const FString& Params)
+{
+	FParse::Value(*Params, TEXT("Beats="), NumBeats);
+	FParse::Value(*Params, TEXT("BeatInterval="), BeatInterval);
+	FParse::Value(*Params, TEXT("BeatJitter="), BeatJitter);
+	FParse::Value(*Params, TEXT("TickRate="), TickRate);
+	FParse::Value(*Params, TEXT("ReactionTime="), PlayerParams.ReactionTime);
+	FParse::Value(*Params, TEXT("ReactionTimeStdDev="), PlayerParams.ReactionTimeStdDev);
+	FParse::Value(*Params, TEXT("MinReactionTime="), PlayerParams.MinReactionTime);
+	FParse::Value(*Params, TEXT("TimingStdDev="), PlayerParams.TimingStdDev);
+	FParse::Value(*Params, TEXT("AimErrorStdDev="), PlayerParams.AimErrorStdDev);
+	FParse::Value(*Params, TEXT("FollowUpShotTime="), PlayerParams.FollowUpShotTime);
+
+	int32 NumRuns = 1;
+	int32 Seed = 1;
+	FString OutputFile = FPaths::ProjectSavedDir() / DefaultOutputFile;
+	FParse::Value(*Params, TEXT("Runs="), NumRuns);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Output="), OutputFile);
+
+	if (NumBeats <= 0 || NumRuns <= 0 || TickRate <= 0.f)
+	{
+		UE_LOG(LogBSGameModeSimulator, Error, TEXT("Beats, Runs, and TickRate must be greater than zero."));
+		return 1;
+	}
+
+	TArray<FBSConfig> Configs;
+	if (!GetGameModes(Params, Configs))
+	{
+		return 1;
+	}
+
+	if (!InitWorld())
+	{
+		CleanUpWorld();
+		return 1;
+	}
+
+	FBSSimulatorReport Report;
+	for (const FBSConfig& Config : Configs)
+	{
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			const FBSSimulatorRunReport& RunReport = Report.Runs.Add_GetRef(SimulateRun(Config, Seed + Run));
+			const FPlayerScore& Score = RunReport.PlayerScore;
+			UE_LOG(LogBSGameModeSimulator, Display,
+				TEXT("%s (seed %d): score %.0f, %d/%d targets hit, accuracy %.2f, %d spawn beats averaging %.3f ms, "
+					"%.1f s simulated in %.2f s"), *RunReport.GameMode, RunReport.Seed, Score.Score, Score.TargetsHit,
+				Score.TargetsSpawned, Score.Accuracy, RunReport.NumSpawnBeats, RunReport.BeatTimings.Mean,
+				RunReport.SimulatedSeconds, RunReport.WallSeconds);
+		}
+	}
+
+	CleanUpWorld();
+
+	FString JsonString;
+	if (!BSJsonStream::UStructToJsonString(Report, JsonString) || !FFileHelper::SaveStringToFile(JsonString,
+		*OutputFile))
+	{
+		UE_LOG(LogBSGameModeSimulator, Error, TEXT("Failed to write simulation report to %s"), *OutputFile);
+		return 1;
+	}
+
+	UE_LOG(LogBSGameModeSimulator, Display, TEXT("Wrote %d runs to %s"), Report.Runs.Num(), *OutputFile);
+	return 0;
+}
+
+bool UBSGameModeSimulatorCommandlet::GetGameModes(const FString& Params, TArray<FBSConfig>& OutConfigs)
+{
+	FString GameModeName;
+	const bool bAllPresets = FParse::Param(*Params, TEXT("AllPresets"));
+	if (bAllPresets || FParse::Value(*Params, TEXT("GameMode="), GameModeName, false))
+	{
+		const UBSGameModeDataAsset* GameModeDataAsset = Cast<UBSGameModeDataAsset>(StaticLoadObject(
+			UBSGameModeDataAsset::StaticClass(), nullptr, BSTestingAssetPaths::DefaultGameModeDataAssetPath));
+		if (!GameModeDataAsset)
+		{
+			UE_LOG(LogBSGameModeSimulator, Error, TEXT("Failed to load the preset game modes."));
+			return false;
+		}
+
+		if (bAllPresets)
+		{
+			OutConfigs.Append(GameModeDataAsset->GetDefaultGameModes());
+		}
+		else
+		{
+			FString DifficultyName = TEXT("Normal");
+			FParse::Value(*Params, TEXT("Difficulty="), DifficultyName);
+			const int64 Difficulty = StaticEnum<EGameModeDifficulty>()->GetValueByNameString(DifficultyName);
+			if (Difficulty == INDEX_NONE || !IBSGameModeInterface::FindPresetGameMode(GameModeName,
+				static_cast<EGameModeDifficulty>(Difficulty), GameModeDataAsset, OutConfigs.AddDefaulted_GetRef()))
+			{
+				UE_LOG(LogBSGameModeSimulator, Error, TEXT("Preset game mode %s with difficulty %s not found."),
+					*GameModeName, *DifficultyName);
+				return false;
+			}
+		}
+	}
+
+	FString CustomGameModeName;
+	if (FParse::Value(*Params, TEXT("Custom="), CustomGameModeName, false))
+	{
+		if (!IBSGameModeInterface::FindCustomGameMode(CustomGameModeName, OutConfigs.AddDefaulted_GetRef()))
+		{
+			UE_LOG(LogBSGameModeSimulator, Error, TEXT("Custom game mode %s not found."), *CustomGameModeName);
+			return false;
+		}
+	}
+
+	FString ShareCode;
+	if (FParse::Value(*Params, TEXT("ShareCode="), ShareCode, false))
+	{
+		FText FailReason;
+		if (!FBSConfig::DecodeFromShareCode(ShareCode, OutConfigs.AddDefaulted_GetRef(), &FailReason))
+		{
+			UE_LOG(LogBSGameModeSimulator, Error, TEXT("Failed to decode share code: %s"), *FailReason.ToString());
+			return false;
+		}
+	}
+
+	if (OutConfigs.IsEmpty())
+	{
+		UE_LOG(LogBSGameModeSimulator, Error,
+			TEXT("No game modes selected. Use -GameMode=, -Custom=, -ShareCode=, or -AllPresets."));
+		return false;
+	}
+	return true;
+}
+
+FString UBSGameModeSimulatorCommandlet::GetGameModeName(const FBSConfig& Config)
+{
+	if (Config.DefiningConfig.GameModeType == EGameModeType::Custom)
+	{
+		return Config.DefiningConfig.CustomGameModeName;
+	}
+	return FString::Printf(TEXT("%s %s"), *UEnum::GetDisplayValueAsText(Config.DefiningConfig.BaseGameMode).ToString(),
+		*UEnum::GetDisplayValueAsText(Config.DefiningConfig.Difficulty).ToString());
+}
+
+FBSSimulatorRunReport UBSGameModeSimulatorCommandlet::SimulateRun(const FBSConfig& Config, const int32 Seed) const
+{
+	FBSSimulatorRunReport Report;
+	Report.GameMode = GetGameModeName(Config);
+	Report.Seed = Seed;
+	Report.NumBeats = NumBeats;
+
+	const FRandomStream Stream(Seed);
+
+	const FBS_TargetConfig& TargetConfig = Config.TargetConfig;
+	const float MaxScorePerTarget = ABSGameMode::GetMaxScorePerTarget(Config);
+	FPlayerScore& Score = Report.PlayerScore;
+	Score.DefiningConfig = Config.DefiningConfig;
+	Score.SongTitle = Config.AudioConfig.SongTitle;
+	Score.SongLength = Config.AudioConfig.SongLength;
+
+	TArray<FPendingShot> PendingShots;
+	TMap<FIntVector, int32> ActivationLocations;
+	TArray<double> BeatTimes;
+	TArray<double> SpawnSelectionTimes;
+	TArray<double> TickTimes;
+	BeatTimes.Reserve(NumBeats);
+
+	TargetManager->Init(MakeShared<FBSConfig>(Config), FCommonScoreInfo(), FPlayerSettings_Game(), Seed);
+
+	const FDelegateHandle SpawnedHandle = TargetManager->OnTargetActivated.AddLambda(
+		[&Score](const ETargetDamageType& DamageType)
+		{
+			if (DamageType == ETargetDamageType::Hit)
+			{
+				Score.TargetsSpawned++;
+			}
+		});
+
+	const FDelegateHandle ActivatedHandle = TargetManager->OnTargetActivated_AimBot.AddLambda(
+		[this, &Stream, &Report, &PendingShots, &ActivationLocations, &TargetConfig](ATarget* Target)
+		{
+			Report.TargetsActivated++;
+			ActivationLocations.FindOrAdd(FIntVector(Target->GetActorLocation()))++;
+			if (Target->GetTargetDamageType() != ETargetDamageType::Hit)
+			{
+				return;
+			}
+
+			// The player tries to shoot on the beat, but can't shoot before reacting to the target
+			const float ReactionTime = FMath::Max(PlayerParams.MinReactionTime,
+				PlayerParams.ReactionTime + SampleNormal(Stream) * PlayerParams.ReactionTimeStdDev);
+			const float BeatTime = TargetConfig.SpawnBeatDelay + SampleNormal(Stream) * PlayerParams.TimingStdDev;
+			PendingShots.Add({Target, World->GetTimeSeconds() + FMath::Max(ReactionTime, BeatTime)});
+		});
+
+	const FDelegateHandle DamageHandle = TargetManager->PostTargetDamageEvent.AddLambda(
+		[&Score, &TargetConfig, MaxScorePerTarget](const FTargetDamageEvent& Event)
+		{
+			if (Event.bDamagedSelf || Event.DamageType != ETargetDamageType::Hit)
+			{
+				return;
+			}
+			Score.Score += ABSGameMode::GetScoreFromTimeAlive(TargetConfig, MaxScorePerTarget, Event.TimeAlive);
+			Score.TotalTimeOffset += FMath::Abs(Event.TimeAlive - TargetConfig.SpawnBeatDelay);
+			Score.TargetsHit++;
+			Score.Streak = FMath::Max(Score.Streak, Event.Streak);
+			Score.HighScore = FMath::Max(Score.HighScore, Score.Score);
+		});
+
+#if !UE_BUILD_SHIPPING
+	TargetManager->ExecutionTimeDelegate.BindLambda([&SpawnSelectionTimes](const double Time)
+	{
+		SpawnSelectionTimes.Add(Time);
+	});
+#endif
+
+	TargetManager->SetShouldSpawn(true);
+
+	const double Step = 1.0 / TickRate;
+	const double Interval = BeatInterval > 0.f ? BeatInterval : TargetConfig.TargetSpawnCD;
+	const double StartTime = World->GetTimeSeconds();
+	const double WallStartTime = FPlatformTime::Seconds();
+	double NextBeatTime = StartTime;
+	double LastSpawnBeatTime = StartTime - TargetConfig.TargetSpawnCD;
+	double EndTime = TNumericLimits<double>::Max();
+	int32 BeatIndex = 0;
+	int32 NumTicks = 0;
+
+	while (World->GetTimeSeconds() < EndTime)
+	{
+		const double Time = World->GetTimeSeconds();
+		while (BeatIndex < NumBeats && NextBeatTime <= Time)
+		{
+			// Beats during the target spawn cooldown are ignored, like in ABSGameMode::SpawnNewTarget
+			if (Time - LastSpawnBeatTime >= TargetConfig.TargetSpawnCD - Step / 2.0)
+			{
+				const double BeatStartTime = FPlatformTime::Seconds();
+				TargetManager->OnAudioAnalyzerBeat();
+				BeatTimes.Add(FPlatformTime::Seconds() - BeatStartTime);
+				LastSpawnBeatTime = Time;
+			}
+			NextBeatTime += FMath::Max(Step, Interval + Stream.FRandRange(-BeatJitter, BeatJitter));
+			if (++BeatIndex == NumBeats)
+			{
+				// Give the last targets time to be shot or expire
+				EndTime = Time + FMath::Clamp(TargetConfig.TargetMaxLifeSpan, 0.f, MaxTimeAfterLastBeat) + Step;
+			}
+		}
+
+		for (int32 i = PendingShots.Num() - 1; i >= 0; i--)
+		{
+			if (PendingShots[i].Time > Time)
+			{
+				continue;
+			}
+			ATarget* Target = PendingShots[i].Target.Get();
+			PendingShots.RemoveAtSwap(i);
+
+			// The target expired or was destroyed before the player could shoot it
+			if (!Target || !Target->IsActivated())
+			{
+				continue;
+			}
+			Score.ShotsFired++;
+			if (SampleHit(Stream, Target->GetLocationAtTime(Time), Target->GetRadius()))
+			{
+				ApplyHitDamage(Target, TargetConfig.BasePlayerHitDamage);
+			}
+
+			// Missed targets and targets that take more than one hit are shot again until they deactivate
+			if (Target->IsActivated())
+			{
+				const double FollowUpTime = PlayerParams.FollowUpShotTime + SampleNormal(Stream) *
+					PlayerParams.TimingStdDev;
+				PendingShots.Add({Target, Time + FMath::Max(Step, FollowUpTime)});
+			}
+		}
+
+		const double TickStartTime = FPlatformTime::Seconds();
+		World->Tick(LEVELTICK_All, Step);
+		TickTimes.Add(FPlatformTime::Seconds() - TickStartTime);
+		GFrameCounter++;
+
+		if (++NumTicks % TicksPerGarbageCollection == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	Report.WallSeconds = FPlatformTime::Seconds() - WallStartTime;
+	Report.SimulatedSeconds = World->GetTimeSeconds() - StartTime;
+	Report.NumSpawnBeats = BeatTimes.Num();
+	Report.BeatTimings = FBSSimulatorTimingStats::FromSeconds(MoveTemp(BeatTimes));
+	Report.SpawnSelectionTimings = FBSSimulatorTimingStats::FromSeconds(MoveTemp(SpawnSelectionTimes));
+	Report.TickTimings = FBSSimulatorTimingStats::FromSeconds(MoveTemp(TickTimes));
+	Report.UniqueActivationLocations = ActivationLocations.Num();
+	for (const TPair<FIntVector, int32>& ActivationLocation : ActivationLocations)
+	{
+		Report.MaxActivationsAtOneLocation = FMath::Max(Report.MaxActivationsAtOneLocation, ActivationLocation.Value);
+	}
+
+	TargetManager->OnTargetActivated.Remove(SpawnedHandle);
+	TargetManager->OnTargetActivated_AimBot.Remove(ActivatedHandle);
+	TargetManager->PostTargetDamageEvent.Remove(DamageHandle);
+#if !UE_BUILD_SHIPPING
+	TargetManager->ExecutionTimeDelegate.Unbind();
+#endif
+	TargetManager->SetShouldSpawn(false);
+	TargetManager->Clear();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	ABSGameMode::FinalizePlayerScore(Config, Score);
+	return Report;
+}
+
+bool UBSGameModeSimulatorCommandlet::InitWorld()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false);
+	UPackage* Package = World->GetPackage();
+	Package->SetFlags(RF_Transient | RF_Public);
+	Package->AddToRoot();
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(StaticLoadObject(UObject::StaticClass(), nullptr,
+		BSTestingAssetPaths::TargetManagerAssetPath));
+	if (!Blueprint)
+	{
+		UE_LOG(LogBSGameModeSimulator, Error, TEXT("Failed to load Target Manager"));
+		return false;
+	}
+
+	const FTransform Transform(FRotator(), Constants::DefaultTargetManagerLocation, FVector(1.f));
+	TargetManager = World->SpawnActor<ATargetManager>(Blueprint->GeneratedClass, Transform, FActorSpawnParameters());
+	if (!TargetManager)
+	{
+		UE_LOG(LogBSGameModeSimulator, Error, TEXT("Failed to spawn Target Manager"));
+		return false;
+	}
+
+	TargetManager->AddToRoot();
+	TargetManager->DispatchBeginPlay();
+
+	// There is no player ability system to execute the weapon's damage effect from, so the modifier it outputs is
+	// applied directly
+	FSetByCallerFloat SetByCallerMagnitude;
+	SetByCallerMagnitude.DataName = HitDamageMagnitudeName;
+	HitDamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_SimulatedHitDamage"));
+	HitDamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+	FGameplayModifierInfo& Modifier = HitDamageEffect->Modifiers.AddDefaulted_GetRef();
+	Modifier.Attribute = UBSAttributeSetBase::GetIncomingHitDamageAttribute();
+	Modifier.ModifierOp = EGameplayModOp::Additive;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCallerMagnitude);
+	return true;
+}
+
+void UBSGameModeSimulatorCommandlet::CleanUpWorld()
+{
+	HitDamageEffect = nullptr;
+
+	if (TargetManager)
+	{
+		TargetManager->RemoveFromRoot();
+		TargetManager->Destroy();
+		TargetManager = nullptr;
+	}
+
+	if (World)
+	{
+		UPackage* Package = World->GetPackage();
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		World->MarkAsGarbage();
+		World = nullptr;
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		if (Package)
+		{
+			Package->RemoveFromRoot();
+			TArray<UPackage*> PackagesToUnload;
+			PackagesToUnload.Add(Package);
+			UPackageTools::UnloadPackages(PackagesToUnload);
+		}
+	}
+}
+
+bool UBSGameModeSimulatorCommandlet::SampleHit(const FRandomStream& Stream, const FVector& Location,
+	const float Radius) const
+{
+	// The player stands at the origin, so the same angular error misses by more the further away the target is
+	const float AimError = PlayerParams.AimErrorStdDev * FVector2f(SampleNormal(Stream), SampleNormal(Stream)).Size();
+	return Location.Size() * FMath::Tan(FMath::DegreesToRadians(FMath::Min(AimError, 89.f))) <= Radius;
+}
+
+void UBSGameModeSimulatorCommandlet::ApplyHitDamage(ATarget* Target, const float Damage) const
+{
+	if (Target->UsesLightweightDamage())
+	{
+		Target->ApplyLightweightDamage(Damage, ETargetDamageType::Hit, TargetManager.Get(), TargetManager.Get());
+		return;
+	}
+
+	// The damage execution ignores hit damage to immune targets
+	UAbilitySystemComponent* Comp = Target->GetAbilitySystemComponent();
+	if (!Comp || Target->IsImmuneToHitDamage())
+	{
+		return;
+	}
+
+	FGameplayEffectContextHandle EffectContextHandle = Comp->MakeEffectContext();
+	EffectContextHandle.AddInstigator(TargetManager.Get(), TargetManager.Get());
+	FGameplayEffectSpec Spec(HitDamageEffect, EffectContextHandle, 1.f);
+	Spec.SetSetByCallerMagnitude(HitDamageMagnitudeName, Damage);
+	Comp->ApplyGameplayEffectSpecToSelf(Spec);
+}
+
+float UBSGameModeSimulatorCommandlet::SampleNormal(const FRandomStream& Stream)
+{
+	// Box-Muller transform
+	const float U1 = FMath::Max(Stream.GetFraction(), UE_SMALL_NUMBER);
+	const float U2 = Stream.GetFraction();
+	return FMath::Sqrt(-2.f * FMath::Loge(U1)) * FMath::Cos(UE_TWO_PI * U2);
+}
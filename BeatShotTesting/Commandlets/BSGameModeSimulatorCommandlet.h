@@ -0,0 +1,202 @@
+﻿// Copyright 2022-2023 Markoleptic Games, SP. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SaveGames/SaveGamePlayerScore.h"
+#include "BSGameModeSimulatorCommandlet.generated.h"
+
+class ATarget;
+class ATargetManager;
+class UGameplayEffect;
+struct FBSConfig;
+
+/** Summary of a set of execution times, in milliseconds. */
+USTRUCT()
+struct FBSSimulatorTimingStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Count = 0;
+
+	UPROPERTY()
+	double Total = 0.0;
+
+	UPROPERTY()
+	double Mean = 0.0;
+
+	UPROPERTY()
+	double P50 = 0.0;
+
+	UPROPERTY()
+	double P95 = 0.0;
+
+	UPROPERTY()
+	double P99 = 0.0;
+
+	UPROPERTY()
+	double Max = 0.0;
+
+	/** Returns the stats for Times, which are in seconds. */
+	static FBSSimulatorTimingStats FromSeconds(TArray<double> Times);
+};
+
+/** Results of simulating one game mode with one seed. */
+USTRUCT()
+struct FBSSimulatorRunReport
+{
+	GENERATED_BODY()
+
+	/** The preset game mode and difficulty, or the custom game mode name. */
+	UPROPERTY()
+	FString GameMode;
+
+	UPROPERTY()
+	int32 Seed = 0;
+
+	/** The number of beats in the synthetic beat stream. */
+	UPROPERTY()
+	int32 NumBeats = 0;
+
+	/** The number of beats that were passed to the TargetManager, after the target spawn cooldown. */
+	UPROPERTY()
+	int32 NumSpawnBeats = 0;
+
+	/** Game time simulated. */
+	UPROPERTY()
+	double SimulatedSeconds = 0.0;
+
+	/** Real time taken to simulate. */
+	UPROPERTY()
+	double WallSeconds = 0.0;
+
+	/** Time taken by each call to ATargetManager::OnAudioAnalyzerBeat. */
+	UPROPERTY()
+	FBSSimulatorTimingStats BeatTimings;
+
+	/** Time taken by each search for spawnable spawn areas. */
+	UPROPERTY()
+	FBSSimulatorTimingStats SpawnSelectionTimings;
+
+	/** Time taken by each world tick. */
+	UPROPERTY()
+	FBSSimulatorTimingStats TickTimings;
+
+	/** The number of target activations. */
+	UPROPERTY()
+	int32 TargetsActivated = 0;
+
+	/** The number of distinct locations that targets were activated at. */
+	UPROPERTY()
+	int32 UniqueActivationLocations = 0;
+
+	/** The most activations at any one location. */
+	UPROPERTY()
+	int32 MaxActivationsAtOneLocation = 0;
+
+	/** The synthetic player's final score. */
+	UPROPERTY()
+	FPlayerScore PlayerScore;
+};
+
+/** All runs of one invocation of the commandlet. */
+USTRUCT()
+struct FBSSimulatorReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FBSSimulatorRunReport> Runs;
+};
+
+/** Parameters of the synthetic player, in seconds and degrees. */
+struct FBSSyntheticPlayerParams
+{
+	/** Mean and standard deviation of the time between a target activating and the player being able to shoot it. */
+	float ReactionTime = 0.25f;
+	float ReactionTimeStdDev = 0.05f;
+
+	/** The fastest possible reaction. */
+	float MinReactionTime = 0.1f;
+
+	/** Standard deviation of the shot time around the target's SpawnBeatDelay, which is a perfect shot. */
+	float TimingStdDev = 0.05f;
+
+	/** Standard deviation of the aim error on each axis. */
+	float AimErrorStdDev = 0.3f;
+
+	/** Mean time between shots at a target that is still activated after being shot at, with a standard deviation
+	 *  of TimingStdDev. */
+	float FollowUpShotTime = 0.15f;
+};
+
+/** Runs game modes without rendering or a player character. A synthetic beat stream drives the TargetManager, and a
+ *  synthetic player shoots activated hit targets with a random reaction time, timing error, and aim error, and keeps
+ *  shooting targets until they deactivate. Writes per-beat timings, spawn selection statistics, and the final
+ *  FPlayerScore of each run to a JSON file.
+ *
+ *  Example:
+ *  UnrealEditor-Cmd BeatShot.uproject -run=BSGameModeSimulator -AllPresets -Beats=500 -Runs=4 -nullrhi
+ *
+ *  Game modes: -GameMode=<BaseGameMode> -Difficulty=<Difficulty>, -Custom=<name>, -ShareCode=<code>, or -AllPresets
+ *  Beats: -Beats=200 -BeatInterval=<TargetSpawnCD> -BeatJitter=0 -TickRate=120
+ *  Player: -ReactionTime=0.25 -ReactionTimeStdDev=0.05 -MinReactionTime=0.1 -TimingStdDev=0.05 -AimErrorStdDev=0.3
+ *  -FollowUpShotTime=0.15
+ *  Runs: -Runs=1 -Seed=1, each run uses the next seed
+ *  Output: -Output=<Saved/Simulations/GameModeSimulation.json>
+ *
+ *  Only hit targets are shot, so tracking game modes report spawning statistics with an empty score. */
+UCLASS()
+class BEATSHOTTESTING_API UBSGameModeSimulatorCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBSGameModeSimulatorCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Adds the game modes selected by Params to OutConfigs. Returns false if any could not be found. */
+	static bool GetGameModes(const FString& Params, TArray<FBSConfig>& OutConfigs);
+
+	/** Returns a display name for a game mode. */
+	static FString GetGameModeName(const FBSConfig& Config);
+
+	/** Simulates one game mode with one seed. */
+	FBSSimulatorRunReport SimulateRun(const FBSConfig& Config, const int32 Seed) const;
+
+	/** Creates the world and spawns the TargetManager. */
+	bool InitWorld();
+
+	/** Destroys the world and the TargetManager. */
+	void CleanUpWorld();
+
+	/** Returns true if the synthetic player hits a target at Location with the given radius. */
+	bool SampleHit(const FRandomStream& Stream, const FVector& Location, const float Radius) const;
+
+	/** Applies Damage as hit damage from the synthetic player, through ApplyLightweightDamage or HitDamageEffect. */
+	void ApplyHitDamage(ATarget* Target, const float Damage) const;
+
+	/** Returns a sample from a normal distribution with mean 0 and standard deviation 1. */
+	static float SampleNormal(const FRandomStream& Stream);
+
+	UPROPERTY()
+	TObjectPtr<UWorld> World;
+
+	UPROPERTY()
+	TObjectPtr<ATargetManager> TargetManager;
+
+	/** Instant effect adding a set by caller magnitude to IncomingHitDamage, which is what the weapon's damage
+	 *  execution does for targets using the ability system. */
+	UPROPERTY()
+	TObjectPtr<UGameplayEffect> HitDamageEffect;
+
+	FBSSyntheticPlayerParams PlayerParams;
+	int32 NumBeats;
+	float BeatInterval;
+	float BeatJitter;
+	float TickRate;
+};
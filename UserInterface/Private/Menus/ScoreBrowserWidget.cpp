@@ -54,19 +54,8 @@ void UScoreBrowserWidget::InitScoreBrowser(const EScoreBrowserType InScoreBrowse
 			return;
 		}
 
-		int64 MinTimeDifference = FDateTime::MinValue().ToUnixTimestamp();
 		FPlayerScore MinDateScore = FPlayerScore();
-		// Could probably just use the last value in PlayerScoreArray, but just to be sure
-		for (const FPlayerScore& Score : LoadPlayerScores())
-		{
-			FDateTime ParsedTime;
-			FDateTime::ParseIso8601(*Score.Time, ParsedTime);
-			if (ParsedTime.ToUnixTimestamp() > MinTimeDifference)
-			{
-				MinTimeDifference = ParsedTime.ToUnixTimestamp();
-				MinDateScore = Score;
-			}
-		}
+		GetMostRecentPlayerScore(MinDateScore);
 		if (MinDateScore.DefiningConfig.GameModeType == EGameModeType::Preset)
 		{
 			BrowserWidget->LoadDefaultGameModesURL(IBSPlayerSettingsInterface::LoadPlayerSettings().User.UserID);
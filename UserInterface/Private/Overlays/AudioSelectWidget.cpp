@@ -61,7 +61,31 @@ void UAudioSelectWidget::NativeConstruct()
 		ComboBox_InAudioDevices->AddOption(AudioDevice);
 	}
 
-	for (const FPlayerScore& SavedScoreObj : LoadPlayerScores())
+	ComboBox_SongTitle->AddOption("");
+	ComboBox_SongTitle->SetSelectedOption("");
+
+	// Song titles are filled in once the player scores have loaded
+	ComboBox_SongTitle->SetIsEnabled(false);
+	LoadPlayerScoresAsync([WeakThis = TWeakObjectPtr<ThisClass>(this)](const TArray<FPlayerScore>& PlayerScores)
+	{
+		if (UAudioSelectWidget* Widget = WeakThis.Get())
+		{
+			Widget->OnPlayerScoresLoaded(PlayerScores);
+		}
+	});
+
+	Box_AudioDevice->SetVisibility(ESlateVisibility::Collapsed);
+	Box_SongTitleLength->SetVisibility(ESlateVisibility::Collapsed);
+
+	Checkbox_PlaybackAudio->SetIsChecked(true);
+
+	OnValueChanged_Seconds(FText::AsNumber(0), ETextCommit::Type::Default);
+	OnValueChanged_Minutes(FText::AsNumber(0), ETextCommit::Type::Default);
+}
+
+void UAudioSelectWidget::OnPlayerScoresLoaded(const TArray<FPlayerScore>& PlayerScores)
+{
+	for (const FPlayerScore& SavedScoreObj : PlayerScores)
 	{
 		SongDurationMap.Add(SavedScoreObj.SongTitle, SavedScoreObj.SongLength);
 	}
@@ -73,21 +97,11 @@ void UAudioSelectWidget::NativeConstruct()
 	}
 	Songs.Sort();
 
-	ComboBox_SongTitle->AddOption("");
-	ComboBox_SongTitle->SetSelectedOption("");
-
 	for (const FString& Song : Songs)
 	{
 		ComboBox_SongTitle->AddOption(Song);
 	}
-
-	Box_AudioDevice->SetVisibility(ESlateVisibility::Collapsed);
-	Box_SongTitleLength->SetVisibility(ESlateVisibility::Collapsed);
-
-	Checkbox_PlaybackAudio->SetIsChecked(true);
-
-	OnValueChanged_Seconds(FText::AsNumber(0), ETextCommit::Type::Default);
-	OnValueChanged_Minutes(FText::AsNumber(0), ETextCommit::Type::Default);
+	ComboBox_SongTitle->SetIsEnabled(true);
 }
 
 void UAudioSelectWidget::FadeIn()
@@ -122,6 +122,10 @@ private:
 	UFUNCTION()
 	void OnCheckStateChanged_PlaybackAudio(const bool bIsChecked);
 
+	/** Fills SongDurationMap and ComboBox_SongTitle with the songs from all player scores, and enables
+	 *  ComboBox_SongTitle. */
+	void OnPlayerScoresLoaded(const TArray<FPlayerScore>& PlayerScores);
+
 	/** Displays an error message upon failed AudioAnalyzer initialization. */
 	UFUNCTION()
 	void ShowSongPathErrorMessage();